@@ -9,17 +9,18 @@
 *         scale - Size of menu item text
 *         color - Color of text
 *         print3D - Pointer to an already set up CPVRTPrint3D object
+*         measureCache - Optional cache used to memoize text measurements, may be NULL
 * RETURNS: BannerView instance
 * THROWS: None
 */
-BannerView::BannerView(vector<char*> bannerLinesText, Position position, int spacing, float scale, unsigned int color, CPVRTPrint3D *print3D, bool isScreenRotated) {
+BannerView::BannerView(vector<char*> bannerLinesText, Position position, int spacing, float scale, unsigned int color, CPVRTPrint3D *print3D, bool isScreenRotated, UIMeasureCache *measureCache) {
     this->bannerLinesText = bannerLinesText;
     this->position = position;
     this->spacing = spacing;
     this->scale = scale;
     this->color = color;
     this->print3D = print3D;
-    this->print2D = new Print2D(print3D, isScreenRotated);
+    this->print2D = new Print2D(print3D, isScreenRotated, measureCache);
 }
 
 /**
@@ -135,7 +136,7 @@ float BannerView::maxTextWidth() {
     for (int ii = 0; ii < size; ii++) {
         float textWidth;
         float textHeight;
-        print3D->MeasureText(&textWidth, &textHeight, scale, bannerLinesText[ii]);
+        print2D->measureText(&textWidth, &textHeight, scale, bannerLinesText[ii]);
 
         if (textWidth > maxWidth) { maxWidth = textWidth; }
     }
@@ -12,7 +12,7 @@ public:
     enum Position { TOP, CENTER };
 
     // BannerView Constructor
-    BannerView(vector<char*> bannerLinesText, Position position, int spacing, float scale, unsigned int color, CPVRTPrint3D *print3D, bool isScreenRotated);
+    BannerView(vector<char*> bannerLinesText, Position position, int spacing, float scale, unsigned int color, CPVRTPrint3D *print3D, bool isScreenRotated, UIMeasureCache *measureCache = NULL);
 
     // BannerView Destructor
     ~BannerView();
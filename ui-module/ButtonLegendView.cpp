@@ -8,10 +8,11 @@
 *         disabledButtonColor - Color of button glyphs when disabled
 *         spacing - Spacing between button glyphs
 *         print3D - Pointer to an already set up CPVRTPrint3D object
+*         measureCache - Optional cache used to memoize text measurements, may be NULL
 * RETURNS: ButtonLegendView instance
 * THROWS: None
 */
-ButtonLegendView::ButtonLegendView(unsigned enabledNavigationButtonColor, unsigned enabledOkButtonColor, unsigned disabledButtonColor, int spacing, CPVRTPrint3D *print3D, bool isScreenRotated) {
+ButtonLegendView::ButtonLegendView(unsigned enabledNavigationButtonColor, unsigned enabledOkButtonColor, unsigned disabledButtonColor, int spacing, CPVRTPrint3D *print3D, bool isScreenRotated, UIMeasureCache *measureCache) {
     const int BUTTON_COUNT = 3;
     for (int ii = 0; ii < BUTTON_COUNT; ii++) {
         Print2D::AttributedText attributedText;
@@ -25,7 +26,7 @@ ButtonLegendView::ButtonLegendView(unsigned enabledNavigationButtonColor, unsign
     this->enabledOkButtonColor = enabledOkButtonColor;
     this->disabledButtonColor = disabledButtonColor;
     this->spacing = spacing;
-    print2D = new Print2D(print3D, isScreenRotated);
+    print2D = new Print2D(print3D, isScreenRotated, measureCache);
 }
 
 /**
@@ -10,10 +10,11 @@
  *         selectedItemColor - Color of menu item when selected
  *         unselectedItemColor - Color of menu item when unselected
  *         print3D - Pointer to an already set up CPVRTPrint3D object
+ *         measureCache - Optional cache used to memoize text measurements, may be NULL
  * RETURNS: MenuView instance
  * THROWS: None
  */
-MenuView::MenuView(vector<char*> menuItemsText, int selectedItemIndex, int spacing, float scale, unsigned int selectedItemColor, unsigned int unselectedItemColor, CPVRTPrint3D *print3D, bool isScreenRotated) {
+MenuView::MenuView(vector<char*> menuItemsText, int selectedItemIndex, int spacing, float scale, unsigned int selectedItemColor, unsigned int unselectedItemColor, CPVRTPrint3D *print3D, bool isScreenRotated, UIMeasureCache *measureCache) {
     int size = menuItemsText.size();
 
     bool selectedItemIndexIsValid = selectedItemIndex >= 0 && selectedItemIndex < size;
@@ -30,7 +31,7 @@ MenuView::MenuView(vector<char*> menuItemsText, int selectedItemIndex, int spaci
     this->itemSpacing = spacing;
     this->selectedItemColor = selectedItemColor;
     this->unselectedItemColor = unselectedItemColor;
-    this->print2D = new Print2D(print3D, isScreenRotated);
+    this->print2D = new Print2D(print3D, isScreenRotated, measureCache);
 }
 
 /**
@@ -9,10 +9,10 @@ using std::vector;
 class MenuView {
 public:
     // MenuView Constructor
-    MenuView(vector<char*> menuItemsText, int spacing, float scale, unsigned int selectedItemColor, unsigned int unselectedItemColor, CPVRTPrint3D* print3D, bool isScreenRotated) : MenuView(menuItemsText, 0, spacing, scale, selectedItemColor, unselectedItemColor, print3D, isScreenRotated) {};
+    MenuView(vector<char*> menuItemsText, int spacing, float scale, unsigned int selectedItemColor, unsigned int unselectedItemColor, CPVRTPrint3D* print3D, bool isScreenRotated, UIMeasureCache *measureCache = NULL) : MenuView(menuItemsText, 0, spacing, scale, selectedItemColor, unselectedItemColor, print3D, isScreenRotated, measureCache) {};
 
     // MenuView Constructor
-    MenuView(vector<char*> menuItemsText, int selectedItemIndex, int spacing, float scale, unsigned int selectedItemColor, unsigned int unselectedItemColor, CPVRTPrint3D *print3D, bool isScreenRotated);
+    MenuView(vector<char*> menuItemsText, int selectedItemIndex, int spacing, float scale, unsigned int selectedItemColor, unsigned int unselectedItemColor, CPVRTPrint3D *print3D, bool isScreenRotated, UIMeasureCache *measureCache = NULL);
     
     // MenuView Destructor
     ~MenuView();
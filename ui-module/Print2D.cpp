@@ -3,11 +3,14 @@
 /**
  * DOES: Creates new instance of Print2D class
  * PARAMS: print3D - Pointer to an already set up CPVRTPrint3D object
+ *         isScreenRotated - Whether the display is side projected
+ *         measureCache - Optional cache used to memoize text measurements, may be NULL
  * RETURNS: Print2D instance
  * THROWS: None
  */
-Print2D::Print2D(CPVRTPrint3D *print3D, bool isScreenRotated) {
+Print2D::Print2D(CPVRTPrint3D *print3D, bool isScreenRotated, UIMeasureCache *measureCache) {
     this->print3D = print3D;
+    this->measureCache = measureCache;
     if (isScreenRotated) {
         print3D->GetAspectRatio(&this->screenHeight, &this->screenWidth);
     } else {
@@ -161,6 +164,24 @@ void Print2D::renderVerticalMenuCenteredAt(float xRelativePosition, float yRelat
     renderMenuItems(menuItems);
 }
 
+/**
+ * DOES: Measures text. If a measurement cache was provided, each distinct
+ *       text/scale combination is only measured by print3D once.
+ * PARAMS: textWidth - Output width of text
+ *         textHeight - Output height of text
+ *         scale - Size of text, 1 corresponds to 100% size
+ *         text - Text to measure
+ * RETURNS: None
+ * THROWS: None
+ */
+void Print2D::measureText(float *textWidth, float *textHeight, float scale, char *text) {
+    if (measureCache != NULL) {
+        measureCache->Measure(print3D, textWidth, textHeight, scale, text);
+    } else {
+        print3D->MeasureText(textWidth, textHeight, scale, text);
+    }
+}
+
 /**
  * DOES: Gets width of screen
  * PARAMS: None
@@ -201,7 +222,7 @@ void Print2D::setMenuItemsSpacing(vector<MenuItem> &menuItems, int spacing) {
         float menuItemScale = menuItems[ii].attributedText.scale;
         float textWidth;
         float textHeight;
-        print3D->MeasureText(&textWidth, &textHeight, menuItemScale, menuItemText);
+        measureText(&textWidth, &textHeight, menuItemScale, menuItemText);
 
         yOffset += textHeight + spacing;
     }
@@ -224,7 +245,7 @@ void Print2D::justifyMenuItems(vector<MenuItem> &menuItems) {
         float menuItemScale = menuItems[ii].attributedText.scale;
         float textWidth;
         float textHeight;
-        print3D->MeasureText(&textWidth, &textHeight, menuItemScale, menuItemText);
+        measureText(&textWidth, &textHeight, menuItemScale, menuItemText);
 
         float widthDifference = maxTextWidth - textWidth;
         if (widthDifference > 0) {
@@ -318,7 +339,7 @@ float Print2D::calculateMaxTextWidth(vector<MenuItem> menuItems) {
         float menuItemScale = menuItems[ii].attributedText.scale;
         float textWidth;
         float textHeight;
-        print3D->MeasureText(&textWidth, &textHeight, menuItemScale, menuItemText);
+        measureText(&textWidth, &textHeight, menuItemScale, menuItemText);
 
         if (textWidth > maxTextWidth) { maxTextWidth = textWidth; }
     }
@@ -344,7 +365,7 @@ float Print2D::calculateTotalTextHeight(vector<MenuItem> menuItems, int spacing)
         float menuItemScale = menuItems[ii].attributedText.scale;
         float textWidth;
         float textHeight;
-        print3D->MeasureText(&textWidth, &textHeight, menuItemScale, menuItemText);
+        measureText(&textWidth, &textHeight, menuItemScale, menuItemText);
         
         totalTextHeight += textHeight + (float) spacing;
     }
@@ -385,7 +406,7 @@ Print2D::Coordinate Print2D::convertCenterRelativeToOriginRelative(Print2D::Coor
 Print2D::Coordinate Print2D::convertCenterAbsoluteToOriginAbsolute(Print2D::Coordinate centerAbsoluteCoordinate, char* text, float scale) {
     float textWidth;
     float textHeight;
-    print3D->MeasureText(&textWidth, &textHeight, scale, text);
+    measureText(&textWidth, &textHeight, scale, text);
 
     Coordinate originAbsoluteCoordinate;
     originAbsoluteCoordinate.x = centerAbsoluteCoordinate.x - textWidth / 2;
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include "OGLES2Tools.h"
+#include "UIMeasureCache.h"
 
 using std::vector;
 
@@ -16,7 +17,8 @@ public:
     };
 
     // Print2D Constructor
-    Print2D(CPVRTPrint3D *print3D, bool isScreenRotated);
+    // measureCache is optional, pass the UIPrinter's cache to share measurements with the UIKit
+    Print2D(CPVRTPrint3D *print3D, bool isScreenRotated, UIMeasureCache *measureCache = NULL);
 
     // Renders text with top left coordinate of bounding box at (xRelativePosition, yRelativePosition)
     // xRelativePosition and yRelativePosition need to be between 0-100 inclusive
@@ -37,6 +39,9 @@ public:
     // xRelativePosition and yRelative Position need to be between 0-100 inclusive
     void renderVerticalMenuCenteredAt(float xRelativePosition, float yRelativePosition, int spacing, vector<AttributedText> menuItemsAttributedText);
 
+    // Measures text, using the measurement cache when one was provided
+    void measureText(float *textWidth, float *textHeight, float scale, char *text);
+
     // Gets screen width
     float getScreenWidth();
 
@@ -55,6 +60,7 @@ private:
     };
 
     CPVRTPrint3D *print3D;
+    UIMeasureCache *measureCache;
     unsigned int screenWidth;
     unsigned int screenHeight;
 
@@ -0,0 +1,271 @@
+/******************************************************************************
+ @File          UIAnimator.cpp
+ @Title         UIAnimator
+ @Author        Siddharth Hathi
+ @Description   Implements the UIAnimator object class defined in
+				UIAnimator.h
+******************************************************************************/
+
+#include "UIAnimator.h"
+
+// Cubic coefficients (a, b, c) of each easing curve
+static const float c_easingCoefficients[UIENumEasings][3] = {
+	{ 1, 0, 0 },		// UIELinear:		t
+	{ 0, 1, 0 },		// UIEEaseIn:		t^2
+	{ 2, -1, 0 },		// UIEEaseOut:		1 - (1 - t)^2
+	{ 0, 3, -2 }		// UIEEaseInOut:	smoothstep
+};
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Starts the animator's clock. Only used by Get.
+******************************************************************************/
+UIAnimator::UIAnimator()
+{
+	m_numTweens = 0;
+	clock_gettime(CLOCK_MONOTONIC, &m_epoch);
+}
+
+/*!****************************************************************************
+ @Function		Get
+ @Return		UIAnimator*		The animator
+ @Description	Returns the animator shared by the whole UI
+******************************************************************************/
+UIAnimator*
+UIAnimator::Get()
+{
+	static UIAnimator animator;
+	return &animator;
+}
+
+/*!****************************************************************************
+ @Function		Now
+ @Return		float		Seconds since the animator was created
+ @Description	Reads the monotonic clock
+******************************************************************************/
+float
+UIAnimator::Now()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (float)(now.tv_sec - m_epoch.tv_sec) + (now.tv_nsec - m_epoch.tv_nsec) * 1e-9f;
+}
+
+/*!****************************************************************************
+ @Function		Tween
+ @Input			target		The float being animated
+ @Input			to			Value the float ends at
+ @Input			duration	Length of the animation in seconds
+ @Input			easing		Easing curve
+ @Return		bool		False if the float was set straight to its end value
+ @Description	Animates a float from its current value. Any tween already
+				running on the float is replaced.
+******************************************************************************/
+bool
+UIAnimator::Tween(float* target, float to, float duration, UIEasing easing)
+{
+	float from = *target;
+	int index = addTween(target, UITFloat, duration, easing);
+	if (index < 0) {
+		*target = to;
+		return false;
+	}
+	m_from[index] = from;
+	m_to[index] = to;
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		TweenColor
+ @Input			target		The colour being animated (Print3D ABGR format)
+ @Input			to			Colour it ends at
+ @Input			duration	Length of the animation in seconds
+ @Input			easing		Easing curve
+ @Return		bool		False if the colour was set straight to its end value
+ @Description	Animates each channel of a colour, alpha included, from its
+				current value. Any tween already running on it is replaced.
+******************************************************************************/
+bool
+UIAnimator::TweenColor(GLuint* target, GLuint to, float duration, UIEasing easing)
+{
+	GLuint from = *target;
+	int index = addTween(target, UITColor, duration, easing);
+	if (index < 0) {
+		*target = to;
+		return false;
+	}
+	m_fromColor[index] = from;
+	m_toColor[index] = to;
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		Cancel
+ @Input			target		A float or colour that may be animating
+ @Description	Stops any tween on the target, leaving it at its current value.
+				Elements should cancel their tweens before they are deleted.
+******************************************************************************/
+void
+UIAnimator::Cancel(const void* target)
+{
+	for ( int i = m_numTweens - 1; i >= 0; i -- ) {
+		if (m_target[i] == target) {
+			removeTween(i);
+		}
+	}
+}
+
+/*!****************************************************************************
+ @Function		IsAnimating
+ @Input			target		A float or colour
+ @Return		bool		Is a tween running on it?
+ @Description	Checks whether a target is being animated
+******************************************************************************/
+bool
+UIAnimator::IsAnimating(const void* target)
+{
+	for ( int i = 0; i < m_numTweens; i ++ ) {
+		if (m_target[i] == target) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*!****************************************************************************
+ @Function		GetTweenCount
+ @Return		int		Number of running tweens
+ @Description	Returns the number of running tweens
+******************************************************************************/
+int
+UIAnimator::GetTweenCount()
+{
+	return m_numTweens;
+}
+
+/*!****************************************************************************
+ @Function		Update
+ @Return		bool	Were any targets written?
+ @Description	Advances every tween to the current time
+******************************************************************************/
+bool
+UIAnimator::Update()
+{
+	if (m_numTweens == 0) {
+		return false;
+	}
+	return Update(Now());
+}
+
+/*!****************************************************************************
+ @Function		Update
+ @Input			now		Time in seconds on the animator's clock
+ @Return		bool	Were any targets written?
+ @Description	Advances every tween to the given time and writes the results
+				to their targets. Progress and easing are worked out over the
+				flat arrays with no branches, so the compiler can vectorise
+				them; only writing the results back scatters.
+******************************************************************************/
+bool
+UIAnimator::Update(float now)
+{
+	int numTweens = m_numTweens;
+	if (numTweens == 0) {
+		return false;
+	}
+
+	// Eased progress of every tween
+	for ( int i = 0; i < numTweens; i ++ ) {
+		float t = (now - m_start[i]) * m_invDuration[i];
+		t = t < 0 ? 0 : (t > 1 ? 1 : t);
+		m_eased[i] = t * (m_a[i] + t * (m_b[i] + t * m_c[i]));
+	}
+
+	// Write the results back. Finished tweens (t = 1) ease to exactly 1,
+	// so they land on their end values
+	for ( int i = 0; i < numTweens; i ++ ) {
+		float e = m_eased[i];
+		if (m_kind[i] == UITFloat) {
+			*(float*)m_target[i] = m_from[i] + (m_to[i] - m_from[i]) * e;
+		} else {
+			GLuint color = 0;
+			for ( int shift = 0; shift < 32; shift += 8 ) {
+				float from = (m_fromColor[i] >> shift) & 0xFF;
+				float to = (m_toColor[i] >> shift) & 0xFF;
+				color |= ((GLuint)(from + (to - from) * e + 0.5f) & 0xFF) << shift;
+			}
+			*(GLuint*)m_target[i] = color;
+		}
+	}
+
+	// Drop the tweens that have finished
+	for ( int i = numTweens - 1; i >= 0; i -- ) {
+		if ((now - m_start[i]) * m_invDuration[i] >= 1) {
+			removeTween(i);
+		}
+	}
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		addTween
+ @Input			target		What the tween writes
+ @Input			kind		Float or colour
+ @Input			duration	Length of the animation in seconds
+ @Input			easing		Easing curve
+ @Return		int			Index of the new tween, -1 if it can't be added
+ @Description	HELPER - replaces any tween on the target and fills in the
+				timing and easing of a new one
+******************************************************************************/
+int
+UIAnimator::addTween(void* target, UITweenKind kind, float duration, UIEasing easing)
+{
+	Cancel(target);
+	if (duration <= 0) {
+		return -1;
+	}
+	if (m_numTweens >= c_maxTweens) {
+		fprintf(stderr, "UIAnimator is full (%d tweens)\n", c_maxTweens);
+		return -1;
+	}
+	if (easing < 0 || easing >= UIENumEasings) {
+		easing = UIELinear;
+	}
+
+	int index = m_numTweens ++;
+	m_start[index] = Now();
+	m_invDuration[index] = 1 / duration;
+	m_a[index] = c_easingCoefficients[easing][0];
+	m_b[index] = c_easingCoefficients[easing][1];
+	m_c[index] = c_easingCoefficients[easing][2];
+	m_kind[index] = kind;
+	m_target[index] = target;
+	return index;
+}
+
+/*!****************************************************************************
+ @Function		removeTween
+ @Input			index		Index of the tween
+ @Description	HELPER - removes a tween by moving the last tween into its
+				place, keeping the arrays dense
+******************************************************************************/
+void
+UIAnimator::removeTween(int index)
+{
+	int last = -- m_numTweens;
+	if (index == last) {
+		return;
+	}
+	m_start[index] = m_start[last];
+	m_invDuration[index] = m_invDuration[last];
+	m_a[index] = m_a[last];
+	m_b[index] = m_b[last];
+	m_c[index] = m_c[last];
+	m_from[index] = m_from[last];
+	m_to[index] = m_to[last];
+	m_fromColor[index] = m_fromColor[last];
+	m_toColor[index] = m_toColor[last];
+	m_eased[index] = m_eased[last];
+	m_kind[index] = m_kind[last];
+	m_target[index] = m_target[last];
+}
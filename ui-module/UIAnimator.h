@@ -0,0 +1,87 @@
+/******************************************************************************
+ @File          UIAnimator.h
+ @Title         UIAnimator Header File
+ @Author        Siddharth Hathi
+ @Description   Header file for the UIAnimator class.
+******************************************************************************/
+
+#include "OGLES2Tools.h"
+
+#include <time.h>
+
+#ifndef _UIANIMATOR_H
+#define _UIANIMATOR_H
+
+// Maximum number of tweens running at once
+const int c_maxTweens = 256;
+
+// Easing curves. Every curve is a cubic a*t + b*t^2 + c*t^3, so the animator
+// can ease all tweens in one branch free pass
+enum UIEasing { UIELinear, UIEEaseIn, UIEEaseOut, UIEEaseInOut, UIENumEasings };
+
+// What a tween writes: a float, or a packed ABGR colour interpolated per channel
+enum UITweenKind { UITFloat, UITColor };
+
+/*!****************************************************************************
+ @class UIAnimator
+ Object class. The UIAnimator owns every running tween in the UI. A tween moves
+ a float (a sprite's position or scale in the UISpriteStore, a progress bar's
+ fill) or a packed colour from its current value to a target over a duration,
+ along an easing curve. Tweens are stored as flat arrays and advanced together
+ by Update, in a few passes over the arrays (progress, easing, write back), so
+ animating costs O(running tweens) however many elements the UI has. Finished
+ tweens write their final value and are removed.
+
+ Time comes from a monotonic clock, in seconds since the animator was created.
+ There is one animator, returned by UIAnimator::Get. Update should be called
+ once per frame, before the UI renders.
+******************************************************************************/
+class UIAnimator
+{
+	protected:
+		// Instance variables
+
+		// Start time and 1/duration of each tween
+		float m_start[c_maxTweens], m_invDuration[c_maxTweens];
+
+		// Easing coefficients of each tween
+		float m_a[c_maxTweens], m_b[c_maxTweens], m_c[c_maxTweens];
+
+		// Start and end values of float tweens
+		float m_from[c_maxTweens], m_to[c_maxTweens];
+
+		// Start and end values of colour tweens
+		GLuint m_fromColor[c_maxTweens], m_toColor[c_maxTweens];
+
+		// Eased progress of each tween, worked out by Update
+		float m_eased[c_maxTweens];
+
+		// What each tween writes, and where
+		UITweenKind m_kind[c_maxTweens];
+		void* m_target[c_maxTweens];
+
+		// Number of running tweens
+		int m_numTweens;
+
+		// Time of the monotonic clock when the animator was created
+		struct timespec m_epoch;
+
+		// Local functions
+		UIAnimator();
+		int addTween(void* target, UITweenKind kind, float duration, UIEasing easing);
+		void removeTween(int index);
+
+	public:
+		// Exported functions
+		static UIAnimator* Get();
+		float Now();
+		bool Tween(float* target, float to, float duration, UIEasing easing);
+		bool TweenColor(GLuint* target, GLuint to, float duration, UIEasing easing);
+		void Cancel(const void* target);
+		bool IsAnimating(const void* target);
+		int GetTweenCount();
+		bool Update();
+		bool Update(float now);
+};
+
+#endif
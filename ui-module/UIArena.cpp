@@ -0,0 +1,180 @@
+/******************************************************************************
+ @File          UIArena.cpp
+ @Title         UIArena
+ @Author        Siddharth Hathi
+ @Description   Implements the UIArena object class defined in UIArena.h
+******************************************************************************/
+
+#include "UIArena.h"
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes an empty arena
+******************************************************************************/
+UIArena::UIArena()
+{
+	m_blocks = NULL;
+	m_finalizers = NULL;
+	m_blockSize = c_arenaDefaultBlockSize;
+	m_used = 0;
+	m_capacity = 0;
+	m_numBlocks = 0;
+	m_numObjects = 0;
+}
+
+/*!****************************************************************************
+ @Function		Destructor
+ @Description	Destroys the arena's objects and frees its blocks if Delete
+				wasn't called
+******************************************************************************/
+UIArena::~UIArena()
+{
+	Delete();
+}
+
+/*!****************************************************************************
+ @Function		Init
+ @Input			size		Number of bytes the arena is expected to hold
+ @Return		bool		Was the first block allocated?
+ @Description	Allocates the arena's first block. Later blocks are allocated
+				with the same size.
+******************************************************************************/
+bool
+UIArena::Init(size_t size)
+{
+	m_blockSize = size > 0 ? UIArenaAlign(size) : c_arenaDefaultBlockSize;
+	return addBlock(m_blockSize);
+}
+
+/*!****************************************************************************
+ @Function		Alloc
+ @Input			size		Number of bytes to allocate
+ @Return		void*		The allocated memory (NULL on failure)
+ @Description	Bumps an aligned allocation out of the current block, adding a
+				new block if it doesn't fit
+******************************************************************************/
+void*
+UIArena::Alloc(size_t size)
+{
+	size = UIArenaAlign(size);
+	if (m_blocks == NULL || m_blocks->size - m_blocks->used < size) {
+		if (!addBlock(size > m_blockSize ? size : m_blockSize)) {
+			return NULL;
+		}
+	}
+	char* memory = (char*) m_blocks + UIArenaAlign(sizeof(UIArenaBlock)) + m_blocks->used;
+	m_blocks->used += size;
+	m_used += size;
+	return memory;
+}
+
+/*!****************************************************************************
+ @Function		GetUsed
+ @Return		size_t		Bytes allocated from the arena
+ @Description	Returns the number of bytes handed out by the arena
+******************************************************************************/
+size_t
+UIArena::GetUsed()
+{
+	return m_used;
+}
+
+/*!****************************************************************************
+ @Function		GetCapacity
+ @Return		size_t		Bytes held by the arena's blocks
+ @Description	Returns the total size of the arena's blocks
+******************************************************************************/
+size_t
+UIArena::GetCapacity()
+{
+	return m_capacity;
+}
+
+/*!****************************************************************************
+ @Function		GetBlockCount
+ @Return		int			Number of blocks
+ @Description	Returns the number of blocks the arena has allocated. More than
+				one means the arena's budget was too small.
+******************************************************************************/
+int
+UIArena::GetBlockCount()
+{
+	return m_numBlocks;
+}
+
+/*!****************************************************************************
+ @Function		GetObjectCount
+ @Return		int			Number of objects
+ @Description	Returns the number of objects created in the arena
+******************************************************************************/
+int
+UIArena::GetObjectCount()
+{
+	return m_numObjects;
+}
+
+/*!****************************************************************************
+ @Function		Delete
+ @Description	Destroys every object created in the arena and frees its blocks
+******************************************************************************/
+void
+UIArena::Delete()
+{
+	destroyObjects();
+	freeBlocks();
+	m_used = 0;
+}
+
+/*!****************************************************************************
+ @Function		addBlock
+ @Input			minSize		Minimum usable size of the block
+ @Return		bool		Was the block allocated?
+ @Description	HELPER - allocates a new block and makes it the current block
+******************************************************************************/
+bool
+UIArena::addBlock(size_t minSize)
+{
+	UIArenaBlock* block = (UIArenaBlock*) malloc(UIArenaAlign(sizeof(UIArenaBlock)) + minSize);
+	if (block == NULL) {
+		fprintf(stderr, "UIArena failed to allocate %u bytes\n", (unsigned int) minSize);
+		return false;
+	}
+	block->next = m_blocks;
+	block->size = minSize;
+	block->used = 0;
+	m_blocks = block;
+	m_capacity += minSize;
+	m_numBlocks ++;
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		destroyObjects
+ @Description	HELPER - destroys every object created in the arena, newest
+				first
+******************************************************************************/
+void
+UIArena::destroyObjects()
+{
+	for ( UIArenaFinalizer* finalizer = m_finalizers; finalizer != NULL; finalizer = finalizer->next ) {
+		finalizer->destroy(finalizer->object);
+	}
+	m_finalizers = NULL;
+	m_numObjects = 0;
+}
+
+/*!****************************************************************************
+ @Function		freeBlocks
+ @Description	HELPER - frees every block of the arena
+******************************************************************************/
+void
+UIArena::freeBlocks()
+{
+	while (m_blocks != NULL) {
+		UIArenaBlock* next = m_blocks->next;
+		free(m_blocks);
+		m_blocks = next;
+	}
+	m_capacity = 0;
+	m_numBlocks = 0;
+}
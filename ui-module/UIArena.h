@@ -0,0 +1,156 @@
+/******************************************************************************
+ @File          UIArena.h
+ @Title         UIArena Header File
+ @Author        Siddharth Hathi
+ @Description   Header file for the UIArena class.
+******************************************************************************/
+
+#include "OGLES2Tools.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include <utility>
+
+#ifndef _UIARENA_H
+#define _UIARENA_H
+
+// Alignment of every allocation made from an arena
+const size_t c_arenaAlignment = 16;
+
+// Block size used by arenas that were never given a size
+const size_t c_arenaDefaultBlockSize = 1024;
+
+// Header at the start of every block of arena memory
+struct UIArenaBlock {
+	UIArenaBlock* next;
+	size_t size, used;
+};
+
+// Record of an object created in an arena, used to destroy it on Delete
+struct UIArenaFinalizer {
+	void (*destroy)(void* object);
+	void* object;
+	UIArenaFinalizer* next;
+};
+
+// Rounds a size up to the arena alignment
+constexpr size_t UIArenaAlign(size_t size)
+{
+	return (size + c_arenaAlignment - 1) & ~(c_arenaAlignment - 1);
+}
+
+// Arena space taken by count objects of type T created with UIArena::Create
+template <typename T>
+constexpr size_t UIArenaSize(int count)
+{
+	return count * (UIArenaAlign(sizeof(T)) + UIArenaAlign(sizeof(UIArenaFinalizer)));
+}
+
+// Arena space taken by an array of count T allocated with UIArena::AllocArray
+template <typename T>
+constexpr size_t UIArenaArraySize(int count)
+{
+	return UIArenaAlign(count * sizeof(T));
+}
+
+/*!****************************************************************************
+ @class UIArena
+ Object class. A UIArena is a bump allocator that views use to own their child
+ elements and child element arrays. Children are placed next to each other in
+ one block sized from the view's budget (see UIArenaSize), so building a view
+ costs a single allocation. The arena chains on extra blocks if the budget was
+ too small rather than failing. Delete destroys every object created in the
+ arena, newest first, and frees the blocks in one go, so the elements' own
+ Delete functions should be called before it to release their GL objects. The
+ destructor does the same for an arena that was never deleted. Arenas can't
+ be copied, since both copies would free the same blocks.
+******************************************************************************/
+class UIArena
+{
+	protected:
+		// Instance variables
+
+		// Most recently added block (blocks are chained through next)
+		UIArenaBlock* m_blocks;
+
+		// Objects to destroy on Delete, newest first
+		UIArenaFinalizer* m_finalizers;
+
+		// Size of the blocks the arena allocates
+		size_t m_blockSize;
+
+		// Allocation statistics
+		size_t m_used, m_capacity;
+		int m_numBlocks, m_numObjects;
+
+		// Local functions
+		bool addBlock(size_t minSize);
+		void destroyObjects();
+		void freeBlocks();
+
+		template <typename T>
+		static void destroy(void* object)
+		{
+			static_cast<T*>(object)->~T();
+		}
+
+	public:
+		// Exported functions
+		UIArena();
+		~UIArena();
+		UIArena(const UIArena&) = delete;
+		UIArena& operator=(const UIArena&) = delete;
+		bool Init(size_t size);
+		void* Alloc(size_t size);
+		size_t GetUsed();
+		size_t GetCapacity();
+		int GetBlockCount();
+		int GetObjectCount();
+		void Delete();
+
+		/*!********************************************************************
+		 @Function		Create
+		 @Input			args		Arguments passed to T's constructor
+		 @Return		T*			The new object (NULL on failure)
+		 @Description	Constructs a T in the arena. The object is destroyed
+						when the arena is deleted.
+		**********************************************************************/
+		template <typename T, typename... Args>
+		T*
+		Create(Args&&... args)
+		{
+			UIArenaFinalizer* finalizer = (UIArenaFinalizer*) Alloc(sizeof(UIArenaFinalizer));
+			void* memory = Alloc(sizeof(T));
+			if (finalizer == NULL || memory == NULL) {
+				return NULL;
+			}
+			T* object = new (memory) T(std::forward<Args>(args)...);
+			finalizer->destroy = &UIArena::destroy<T>;
+			finalizer->object = object;
+			finalizer->next = m_finalizers;
+			m_finalizers = finalizer;
+			m_numObjects ++;
+			return object;
+		}
+
+		/*!********************************************************************
+		 @Function		AllocArray
+		 @Input			count		Number of elements
+		 @Return		T*			The zeroed array (NULL on failure)
+		 @Description	Allocates an array of plain data (such as element
+						pointers) in the arena
+		**********************************************************************/
+		template <typename T>
+		T*
+		AllocArray(int count)
+		{
+			void* memory = Alloc(count * sizeof(T));
+			if (memory != NULL) {
+				memset(memory, 0, count * sizeof(T));
+			}
+			return (T*) memory;
+		}
+};
+
+#endif
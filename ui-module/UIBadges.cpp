@@ -11,6 +11,7 @@
 ******************************************************************************/
 
 #include "UIBadges.h"
+#include "UIDispatcher.h"
 
 /*!****************************************************************************
  @Function		Constructor
@@ -27,6 +28,7 @@ UIBadges::UIBadges(float x, float y)
 	for ( int i = 0; i < c_numBadges; i ++) {
 		UIBadge badge = c_Badges[i];
 		m_badges[badge.identifier] = new UIImage(badge.imageName, m_x, m_y, 2*c_badgeDim, 2*c_badgeDim);
+		UIDispatcher::Get()->Subscribe(this, badge.identifier);
 	}
 	m_hidden = true;
 	Test();
@@ -49,28 +51,36 @@ UIBadges::Test()
  @Input			identifier		UIBool used to identify the badge in the m_badges
 								map
  @Description	Moves the badge specified in the m_badges map by the inputted
-				indentifier into the array of badges being displayed.
+				indentifier into the array of badges being displayed. The row
+				stays centred on the object's position: the badges already
+				showing slide to their new places and the new badge grows into
+				the free one. Badges already showing are left alone.
 ******************************************************************************/
 bool
 UIBadges::AddBadge(UIBool identifier)
 {
 	if (!m_badges.Exists(identifier)) {
 		return false;
-	} else {
-		UIImage* badge = m_badges[identifier];
-		int numImages;
-		if ((numImages = m_activeBadges.GetSize()) == 0) {
-			m_activeBadges.Append(badge);
-			return true;
-		} else {
-			for ( int i = 0; i < numImages; i ++ ) {
-				m_activeBadges[i]->Move(-c_badgeDim-c_badgePadding, 0);
-			}
-			badge->Move(numImages*c_badgeDim+c_badgePadding, 0);
-			m_activeBadges.Append(badge);
+	}
+	UIImage* badge = m_badges[identifier];
+	int numImages = m_activeBadges.GetSize();
+	for ( int i = 0; i < numImages; i ++ ) {
+		if (m_activeBadges[i] == badge) {
 			return true;
 		}
 	}
+	m_activeBadges.Append(badge);
+	numImages ++;
+
+	// Badge i of n sits (i - (n-1)/2) steps from the centre
+	float step = 2*c_badgeDim + c_badgePadding;
+	float left = m_x - (numImages - 1)*step/2;
+	for ( int i = 0; i < numImages - 1; i ++ ) {
+		m_activeBadges[i]->AnimateTo(left + i*step, m_y, c_badgeSlideDuration, UIEEaseInOut);
+	}
+	badge->SetPosition(left + (numImages - 1)*step, m_y);
+	badge->Scale(0, 0, 1);
+	badge->AnimateScale(1, 1, c_badgePopDuration, UIEEaseOut);
 	return true;
 }
 
@@ -179,6 +189,7 @@ UIBadges::Show()
 void
 UIBadges::Delete()
 {
+	UIDispatcher::Get()->Unsubscribe(this);
 	if (m_badges.GetSize() > 0) {
 		for ( int i = 0; i < c_numBadges; i ++) {
 			UIBool key = c_Badges[i].identifier;
@@ -42,13 +42,17 @@ const UIBadge c_Badges[] = {
 const float c_badgeDim = 40;
 // The padding between each badge
 const float c_badgePadding = 8;
+// Length in seconds of the slide and pop animations of a new badge
+const float c_badgeSlideDuration = 0.3f;
+const float c_badgePopDuration = 0.25f;
 
 /*!****************************************************************************
  @class UIBadges
  Object class. A UIBadges object dynamically displays acheivement badges in the
  UISummaryView. It supports loading badges from .pvr texture files, building and
  rendering the badges as UIImage elements, and dynmaically displaying multiple
- inline badges with even spacing and centering.
+ inline badges with even spacing and centering. New badges pop in while the
+ badges already showing slide aside to make room.
 ******************************************************************************/
 class UIBadges : public UIElement
 {
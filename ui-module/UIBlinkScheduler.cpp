@@ -0,0 +1,155 @@
+/******************************************************************************
+ @File          UIBlinkScheduler.cpp
+ @Title         UIBlinkScheduler
+ @Author        Siddharth Hathi
+ @Description   Implements the UIBlinkScheduler object class defined in
+				UIBlinkScheduler.h
+******************************************************************************/
+
+#include "UIBlinkScheduler.h"
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes an empty scheduler. Only used by Get.
+******************************************************************************/
+UIBlinkScheduler::UIBlinkScheduler()
+{
+	m_numBlinks = 0;
+}
+
+/*!****************************************************************************
+ @Function		Get
+ @Return		UIBlinkScheduler*		The scheduler
+ @Description	Returns the scheduler shared by the whole UI
+******************************************************************************/
+UIBlinkScheduler*
+UIBlinkScheduler::Get()
+{
+	static UIBlinkScheduler scheduler;
+	return &scheduler;
+}
+
+/*!****************************************************************************
+ @Function		Start
+ @Input			off			Flag set while the element is flashed off
+ @Input			period		Length in seconds of one on/off cycle
+ @Input			phase		Seconds into its cycle the blink starts at
+ @Return		bool		Is the element blinking?
+ @Description	Starts an element blinking. An element that is already
+				blinking keeps its cycle, so this can be called every frame
+				while the element should blink.
+******************************************************************************/
+bool
+UIBlinkScheduler::Start(bool* off, float period, float phase)
+{
+	if (find(off) >= 0) {
+		return true;
+	}
+	if (period <= 0) {
+		return false;
+	}
+	if (m_numBlinks >= c_maxBlinks) {
+		fprintf(stderr, "UIBlinkScheduler is full (%d blinks)\n", c_maxBlinks);
+		return false;
+	}
+	int index = m_numBlinks ++;
+	m_start[index] = UIAnimator::Get()->Now() - phase;
+	m_period[index] = period;
+	m_off[index] = off;
+	*off = false;
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		Stop
+ @Input			off			Flag of a blinking element
+ @Description	Stops an element blinking and leaves it shown. Elements should
+				stop their blinks before they are deleted.
+******************************************************************************/
+void
+UIBlinkScheduler::Stop(bool* off)
+{
+	int index = find(off);
+	if (index >= 0) {
+		int last = -- m_numBlinks;
+		m_start[index] = m_start[last];
+		m_period[index] = m_period[last];
+		m_off[index] = m_off[last];
+	}
+	*off = false;
+}
+
+/*!****************************************************************************
+ @Function		IsBlinking
+ @Input			off			Flag of an element
+ @Return		bool		Is the element blinking?
+ @Description	Checks whether an element is blinking
+******************************************************************************/
+bool
+UIBlinkScheduler::IsBlinking(const bool* off)
+{
+	return find(off) >= 0;
+}
+
+/*!****************************************************************************
+ @Function		GetBlinkCount
+ @Return		int		Number of blinking elements
+ @Description	Returns the number of blinking elements
+******************************************************************************/
+int
+UIBlinkScheduler::GetBlinkCount()
+{
+	return m_numBlinks;
+}
+
+/*!****************************************************************************
+ @Function		Update
+ @Return		bool	Did any element flash on or off?
+ @Description	Updates every blinking element to the current frame time
+******************************************************************************/
+bool
+UIBlinkScheduler::Update()
+{
+	if (m_numBlinks == 0) {
+		return false;
+	}
+	return Update(UIAnimator::Get()->Now());
+}
+
+/*!****************************************************************************
+ @Function		Update
+ @Input			now		Time in seconds on the UIAnimator's clock
+ @Return		bool	Did any element flash on or off?
+ @Description	Sets the flag of every blinking element: on for the first half
+				of each cycle, off for the second
+******************************************************************************/
+bool
+UIBlinkScheduler::Update(float now)
+{
+	bool changed = false;
+	for ( int i = 0; i < m_numBlinks; i ++ ) {
+		float elapsed = now - m_start[i];
+		float cycles = elapsed / m_period[i];
+		bool off = cycles - (int)cycles >= 0.5f;
+		changed |= (off != *m_off[i]);
+		*m_off[i] = off;
+	}
+	return changed;
+}
+
+/*!****************************************************************************
+ @Function		find
+ @Input			off			Flag of an element
+ @Return		int			Index of the element's blink, -1 if it has none
+ @Description	HELPER - looks up a blink by its flag
+******************************************************************************/
+int
+UIBlinkScheduler::find(const bool* off)
+{
+	for ( int i = 0; i < m_numBlinks; i ++ ) {
+		if (m_off[i] == off) {
+			return i;
+		}
+	}
+	return -1;
+}
@@ -0,0 +1,63 @@
+/******************************************************************************
+ @File          UIBlinkScheduler.h
+ @Title         UIBlinkScheduler Header File
+ @Author        Siddharth Hathi
+ @Description   Header file for the UIBlinkScheduler class.
+******************************************************************************/
+
+#include "OGLES2Tools.h"
+#include "UIAnimator.h"
+
+#ifndef _UIBLINKSCHEDULER_H
+#define _UIBLINKSCHEDULER_H
+
+// Maximum number of elements blinking at once
+const int c_maxBlinks = 32;
+
+// Default length in seconds of one on/off cycle
+const float c_defaultBlinkPeriod = 0.8f;
+
+/*!****************************************************************************
+ @class UIBlinkScheduler
+ Object class. The UIBlinkScheduler makes elements blink without the app layer
+ sending a flash flag in every UIMessage. An element hands the scheduler a bool
+ that says whether it is flashed off, with a period and a phase; each frame
+ Update works out from the frame clock which half of its cycle every blinking
+ element is in and writes the flag. A blink starts in its on half (offset by its
+ phase), so an element that starts blinking is shown straight away.
+
+ Blinks are kept in flat arrays, so a frame costs O(blinking elements). The
+ clock is the UIAnimator's. There is one scheduler, returned by
+ UIBlinkScheduler::Get. Update should be called once per frame, before the UI
+ renders.
+******************************************************************************/
+class UIBlinkScheduler
+{
+	protected:
+		// Instance variables
+
+		// Start time (offset by the phase) and period of each blink
+		float m_start[c_maxBlinks], m_period[c_maxBlinks];
+
+		// Flag each blink writes: true while the element is flashed off
+		bool* m_off[c_maxBlinks];
+
+		// Number of blinking elements
+		int m_numBlinks;
+
+		// Local functions
+		UIBlinkScheduler();
+		int find(const bool* off);
+
+	public:
+		// Exported functions
+		static UIBlinkScheduler* Get();
+		bool Start(bool* off, float period, float phase);
+		void Stop(bool* off);
+		bool IsBlinking(const bool* off);
+		int GetBlinkCount();
+		bool Update();
+		bool Update(float now);
+};
+
+#endif
@@ -11,6 +11,7 @@
 ******************************************************************************/
 
 #include "UIButton.h"
+#include "UIDispatcher.h"
 
 /*!****************************************************************************
  @Function		Constructor
@@ -53,6 +54,9 @@ UIButton::UIButton(char* text, float x, float y, GLuint activeColor, GLuint inac
 	m_fontActive = c_UIBDefaults.fontActive;
 	m_fontInactive = c_UIBDefaults.fontInactive;
 	m_updateKey = updateKey;
+	m_activeLabel = UIStaticText(text, x, y, m_textScale, activeColor, m_fontActive);
+	m_inactiveLabel = UIStaticText(text, x, y, m_textScale, inactiveColor, m_fontInactive);
+	UIDispatcher::Get()->Subscribe(this, updateKey);
 }
 
 /*!****************************************************************************
@@ -84,6 +88,8 @@ UIButton::UIButton(char* activeBG, char* inactiveBG, char* text, float x, float
     // m_print2D = NULL;
 	m_fontActive = font;
 	m_fontInactive = font;
+	m_activeLabel = UIStaticText(text, x, y, textScale, activeColor, font);
+	m_inactiveLabel = UIStaticText(text, x, y, textScale, inactiveColor, font);
 }
 
 /*!****************************************************************************
@@ -116,6 +122,8 @@ UIButton::BuildVertices()
 {
     m_activeBG.BuildVertices();
 	m_inactiveBG.BuildVertices();
+	m_activeLabel.BuildVertices();
+	m_inactiveLabel.BuildVertices();
 }
 
 /*!****************************************************************************
@@ -141,20 +149,13 @@ UIButton::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 		m_inactiveBG.Render(uiMVPMatrixLoc, printer);
 	}
 
-	GLuint textColor;
-	UIFont font;
+	// The labels are laid out once, the printer just redraws their quads
 	if (m_active) {
-		textColor = m_activeColor;
-		font = m_fontActive;
-		// fprintf(stderr, "Active status + %d\n", m_active);
-		// fprintf(stderr, "Text color : %x\n", textColor);
+		m_activeLabel.Render(uiMVPMatrixLoc, printer);
 	} else {
-		textColor = m_inactiveColor;
-		font = m_fontInactive;
-		// fprintf(stderr, "Text color : %x\n", textColor);
+		m_inactiveLabel.Render(uiMVPMatrixLoc, printer);
 	}
-    printer -> Print(m_x, m_y, m_textScale, textColor, font, m_text);
-	
+
     return true;
 }
 
@@ -198,5 +199,9 @@ UIButton::Show()
 void
 UIButton::Delete()
 {
-	return;
+	UIDispatcher::Get()->Unsubscribe(this);
+	m_activeLabel.Delete();
+	m_inactiveLabel.Delete();
+	m_activeBG.Delete();
+	m_inactiveBG.Delete();
 }
\ No newline at end of file
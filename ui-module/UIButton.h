@@ -13,6 +13,7 @@
 #include "OGLES2Tools.h"
 #include "UIElement.h"
 #include "UIImage.h"
+#include "UIStaticText.h"
 
 #ifndef _UIBUTTON_H
 #define _UIBUTTON_H
@@ -51,6 +52,10 @@ class UIButton : public UIElement
 		// Button text
         char* m_text;
 
+		// Pre-laid-out button text in the active and inactive styles
+		UIStaticText m_activeLabel;
+		UIStaticText m_inactiveLabel;
+
 		// Active font
 		UIFont m_fontActive;
 
@@ -0,0 +1,372 @@
+/******************************************************************************
+ @File          UICoalescer.cpp
+ @Title         UICoalescer
+ @Author        Siddharth Hathi
+ @Description   Implements the UICoalescer object class defined in
+				UICoalescer.h
+******************************************************************************/
+
+#include "UICoalescer.h"
+#include <string.h>
+
+/*!****************************************************************************
+ @Function		flushValues
+ @Input			count		Number of keys
+ @Modified		pendingMask	Keys with a value waiting
+ @Input			pending		Values waiting
+ @Modified		mask		Keys shown
+ @Modified		values		Values shown
+ @Input			intervals	Seconds between showings of each key
+ @Modified		due			When each key can next be shown
+ @Input			time		Time of the frame
+ @Return		bool		Did a shown value change?
+ @Description	HELPER - shows the waiting numeric values that are due. A value
+				that isn't due stays waiting, and one that matches what is
+				shown (bit for bit) is dropped without restarting its
+				interval.
+******************************************************************************/
+static bool
+flushValues(int count, uint32_t* pendingMask, const float* pending, uint32_t* mask, float* values,
+	const double* intervals, double* due, double time)
+{
+	bool changed = false;
+	for ( int i = 0; i < count; i ++ ) {
+		uint32_t bit = 1u << i;
+		if ((*pendingMask & bit) == 0 || time + c_coalesceSlack < due[i]) {
+			continue;
+		}
+		*pendingMask &= ~bit;
+		if ((*mask & bit) == 0 || memcmp(&pending[i], &values[i], sizeof(float)) != 0) {
+			values[i] = pending[i];
+			*mask |= bit;
+			due[i] = time + intervals[i];
+			changed = true;
+		}
+	}
+	return changed;
+}
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes a coalescer that shows every change
+******************************************************************************/
+UICoalescer::UICoalescer()
+{
+	memset(m_floatIntervals, 0, sizeof(m_floatIntervals));
+	memset(m_metricIntervals, 0, sizeof(m_metricIntervals));
+	memset(m_textIntervals, 0, sizeof(m_textIntervals));
+	Reset();
+}
+
+/*!****************************************************************************
+ @Function		SetRate
+ @Input			key		Enum key for float data
+ @Input			hz		Most times a second to show the key (0 for every
+						change)
+ @Description	Limits how often a float is shown
+******************************************************************************/
+void
+UICoalescer::SetRate(UIFloat key, float hz)
+{
+	if (key >= 0 && key < UINumFloats) {
+		m_floatIntervals[key] = hz > 0 ? 1.0 / hz : 0;
+	}
+}
+
+/*!****************************************************************************
+ @Function		SetRate
+ @Input			key		Enum key for numeric telemetry
+ @Input			hz		Most times a second to show the key (0 for every
+						change)
+ @Description	Limits how often a metric is shown
+******************************************************************************/
+void
+UICoalescer::SetRate(UIMetric key, float hz)
+{
+	if (key >= 0 && key < UIMNone) {
+		m_metricIntervals[key] = hz > 0 ? 1.0 / hz : 0;
+	}
+}
+
+/*!****************************************************************************
+ @Function		SetRate
+ @Input			key		Enum key for text data
+ @Input			hz		Most times a second to show the key (0 for every
+						change)
+ @Description	Limits how often a text value is shown
+******************************************************************************/
+void
+UICoalescer::SetRate(UITextType key, float hz)
+{
+	if (key >= 0 && key < UINone) {
+		m_textIntervals[key] = hz > 0 ? 1.0 / hz : 0;
+	}
+}
+
+/*!****************************************************************************
+ @Function		Write
+ @Input			key		Enum key for float data
+ @Input			value	Float being stored
+ @Description	Replaces the float's waiting value
+******************************************************************************/
+void
+UICoalescer::Write(UIFloat key, float value)
+{
+	if (key >= 0 && key < UINumFloats) {
+		m_pendingFloats[key] = value;
+		m_pendingFloatMask |= 1u << key;
+	}
+}
+
+/*!****************************************************************************
+ @Function		Write
+ @Input			key		Enum key for numeric telemetry
+ @Input			value	Value being stored, in the metric's units
+ @Description	Replaces the metric's waiting value
+******************************************************************************/
+void
+UICoalescer::Write(UIMetric key, float value)
+{
+	if (key >= 0 && key < UIMNone) {
+		m_pendingMetrics[key] = value;
+		m_pendingMetricMask |= 1u << key;
+	}
+}
+
+/*!****************************************************************************
+ @Function		Write
+ @Input			key		Enum key for text data
+ @Input			value	Text being stored
+ @Description	Copies text into the coalescer's string blocks and replaces
+				the key's waiting value. NULL is ignored.
+******************************************************************************/
+void
+UICoalescer::Write(UITextType key, const char* value)
+{
+	if (key < 0 || key >= UINone || value == NULL) {
+		return;
+	}
+	m_pendingTexts[key] = m_strings.Copy(value);
+	if (!m_pendingTexts[key].IsNull()) {
+		m_pendingTextMask |= 1u << key;
+	}
+}
+
+/*!****************************************************************************
+ @Function		Write
+ @Input			key		Enum key for boolean data
+ @Input			value	Bool being stored
+ @Description	Replaces the bool's waiting value
+******************************************************************************/
+void
+UICoalescer::Write(UIBool key, bool value)
+{
+	if (key < 0 || key >= UINumBools) {
+		return;
+	}
+	m_pendingBoolMask |= 1u << key;
+	if (value) {
+		m_pendingBoolValues |= 1u << key;
+	} else {
+		m_pendingBoolValues &= ~(1u << key);
+	}
+}
+
+/*!****************************************************************************
+ @Function		Write
+ @Input			state	The UI's current display state
+ @Description	Stores the UIState for the next Flush
+******************************************************************************/
+void
+UICoalescer::Write(UIState state)
+{
+	m_fieldsChanged |= state != m_state;
+	m_state = state;
+}
+
+/*!****************************************************************************
+ @Function		Write
+ @Input			action	A new action enum
+ @Description	Stores the UIAction for the next Flush
+******************************************************************************/
+void
+UICoalescer::Write(UIAction action)
+{
+	m_fieldsChanged |= action != m_action;
+	m_action = action;
+}
+
+/*!****************************************************************************
+ @Function		Write
+ @Input			stage	A new workout stage
+ @Description	Stores the workout stage for the next Flush
+******************************************************************************/
+void
+UICoalescer::Write(UIWorkoutStage stage)
+{
+	m_fieldsChanged |= stage != m_stage;
+	m_stage = stage;
+}
+
+/*!****************************************************************************
+ @Function		SetTotalRacers
+ @Input			total	Total number of racers
+ @Description	Stores the total number of racers for the next Flush
+******************************************************************************/
+void
+UICoalescer::SetTotalRacers(int total)
+{
+	m_fieldsChanged |= total != m_totalRacers;
+	m_totalRacers = total;
+}
+
+/*!****************************************************************************
+ @Function		Merge
+ @Input			message		A message written for the tree
+ @Description	Writes every key a message carries, and its state, action,
+				stage and racer count. Text is shared with the message rather
+				than copied.
+******************************************************************************/
+void
+UICoalescer::Merge(UIMessage& message)
+{
+	for ( int i = 0; i < UINumFloats; i ++ ) {
+		if (message.Has((UIFloat) i)) {
+			Write((UIFloat) i, message.Read((UIFloat) i));
+		}
+	}
+	for ( int i = 0; i < UIMNone; i ++ ) {
+		if (message.Has((UIMetric) i)) {
+			Write((UIMetric) i, message.Read((UIMetric) i));
+		}
+	}
+	for ( int i = 0; i < UINone; i ++ ) {
+		if (message.Has((UITextType) i)) {
+			m_pendingTexts[i] = message.ReadRef((UITextType) i);
+			m_pendingTextMask |= 1u << i;
+		}
+	}
+	for ( int i = 0; i < UINumBools; i ++ ) {
+		if (message.Has((UIBool) i)) {
+			Write((UIBool) i, message.Read((UIBool) i));
+		}
+	}
+	Write(message.ReadState());
+	Write(message.ReadAction());
+	Write(message.ReadWorkoutStage());
+	SetTotalRacers(message.GetTotalRacers());
+}
+
+/*!****************************************************************************
+ @Function		Flush
+ @Output		message		Message to show the frame's values in
+ @Input			time		Time of the frame, in seconds
+ @Return		bool		Did anything shown change?
+ @Description	Shows the waiting values that are due. If anything shown
+				changed, the message is recycled and filled with every value
+				shown, ready for Update; otherwise it isn't touched and the
+				frame needs no Update. The first Flush after Reset always
+				fills the message.
+******************************************************************************/
+bool
+UICoalescer::Flush(UIMessage* message, double time)
+{
+	bool changed = !m_started || m_fieldsChanged;
+	changed |= flushValues(UINumFloats, &m_pendingFloatMask, m_pendingFloats, &m_floatMask, m_floats,
+		m_floatIntervals, m_floatDue, time);
+	changed |= flushValues(UIMNone, &m_pendingMetricMask, m_pendingMetrics, &m_metricMask, m_metrics,
+		m_metricIntervals, m_metricDue, time);
+	for ( int i = 0; i < UINone; i ++ ) {
+		uint32_t bit = 1u << i;
+		if ((m_pendingTextMask & bit) == 0 || time + c_coalesceSlack < m_textDue[i]) {
+			continue;
+		}
+		m_pendingTextMask &= ~bit;
+		const char* text = m_pendingTexts[i].Get();
+		const char* shown = m_texts[i].Get();
+		if ((m_textMask & bit) == 0 || (text != shown && strcmp(text, shown) != 0)) {
+			m_texts[i] = m_pendingTexts[i];
+			m_textMask |= bit;
+			m_textDue[i] = time + m_textIntervals[i];
+			changed = true;
+		}
+		m_pendingTexts[i].Release();
+	}
+	uint32_t boolValues = (m_boolValues & ~m_pendingBoolMask) | (m_pendingBoolValues & m_pendingBoolMask);
+	changed |= (m_boolMask | m_pendingBoolMask) != m_boolMask || boolValues != m_boolValues;
+	m_boolMask |= m_pendingBoolMask;
+	m_boolValues = boolValues;
+	m_pendingBoolMask = 0;
+	m_pendingBoolValues = 0;
+	m_strings.Recycle();
+
+	m_fieldsChanged = false;
+	m_started = true;
+	if (!changed) {
+		return false;
+	}
+
+	message->Recycle();
+	for ( int i = 0; i < UINumFloats; i ++ ) {
+		if ((m_floatMask & (1u << i)) != 0) {
+			message->Write((UIFloat) i, m_floats[i]);
+		}
+	}
+	for ( int i = 0; i < UIMNone; i ++ ) {
+		if ((m_metricMask & (1u << i)) != 0) {
+			message->Write((UIMetric) i, m_metrics[i]);
+		}
+	}
+	for ( int i = 0; i < UINone; i ++ ) {
+		if ((m_textMask & (1u << i)) != 0) {
+			message->Write((UITextType) i, m_texts[i]);
+		}
+	}
+	for ( int i = 0; i < UINumBools; i ++ ) {
+		if ((m_boolMask & (1u << i)) != 0) {
+			message->Write((UIBool) i, (m_boolValues & (1u << i)) != 0);
+		}
+	}
+	message->Write(m_state);
+	message->Write(m_action);
+	message->Write(m_stage);
+	message->SetTotalRacers(m_totalRacers);
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		Reset
+ @Description	Forgets every value shown or waiting, so the next Flush only
+				shows what is written after this. The rates are kept.
+******************************************************************************/
+void
+UICoalescer::Reset()
+{
+	memset(m_pendingFloats, 0, sizeof(m_pendingFloats));
+	memset(m_pendingMetrics, 0, sizeof(m_pendingMetrics));
+	memset(m_floats, 0, sizeof(m_floats));
+	memset(m_metrics, 0, sizeof(m_metrics));
+	memset(m_floatDue, 0, sizeof(m_floatDue));
+	memset(m_metricDue, 0, sizeof(m_metricDue));
+	memset(m_textDue, 0, sizeof(m_textDue));
+	for ( int i = 0; i < UINone; i ++ ) {
+		m_pendingTexts[i].Release();
+		m_texts[i].Release();
+	}
+	m_pendingFloatMask = 0;
+	m_pendingMetricMask = 0;
+	m_pendingTextMask = 0;
+	m_pendingBoolMask = 0;
+	m_pendingBoolValues = 0;
+	m_floatMask = 0;
+	m_metricMask = 0;
+	m_textMask = 0;
+	m_boolMask = 0;
+	m_boolValues = 0;
+	m_state = UIMain;
+	m_action = UINoAction;
+	m_stage = UIWarmup;
+	m_totalRacers = 0;
+	m_fieldsChanged = false;
+	m_started = false;
+}
@@ -0,0 +1,102 @@
+/******************************************************************************
+ @File          UICoalescer.h
+ @Title         UICoalescer Header File
+ @Author        Siddharth Hathi
+ @Description   Header file for the UICoalescer class.
+******************************************************************************/
+
+#include "OGLES2Tools.h"
+#include "UIElement.h"
+#include <stdint.h>
+
+#ifndef _UICOALESCER_H
+#define _UICOALESCER_H
+
+// Frames don't land exactly on a key's interval, so a key is shown this many
+// seconds early rather than a whole frame late
+const double c_coalesceSlack = 0.001;
+
+/*!****************************************************************************
+ @class UICoalescer
+ Object class. A UICoalescer sits between the sensors and the UIKit. Sensor
+ readings are written into it as they arrive, however often that is, and
+ each key keeps only its latest value. Once a frame, Flush shows the keys
+ whose values changed in a UIMessage for the tree, holding back any key
+ that was shown less than its interval ago until the interval has passed.
+ Flush returns false when nothing shown changed, so the frame needs no
+ Update at all.
+
+	coalescer.SetRate(UIMTimeS, 1);
+	coalescer.SetRate(UIMBPM, 2);
+	coalescer.SetRate(UIStageProgress, 30);
+	... whenever a sensor reports:
+	coalescer.Write(UIMBPM, bpm);
+	... every frame:
+	if (coalescer.Flush(&message, UIAnimator::Get()->Now())) {
+		UIFrameCache::Get()->Update(root, message);
+	}
+
+ State, action, stage, racer count and bools are never held back. Keys stay
+ shown until Reset. Nothing is locked, so readings from other threads have
+ to be handed to the thread that flushes.
+******************************************************************************/
+class UICoalescer
+{
+	protected:
+		// Instance variables
+
+		// Latest values written since they were last shown, and a bit per key
+		// with a value waiting
+		float m_pendingFloats[UINumFloats];
+		float m_pendingMetrics[UIMNone];
+		UIStringRef m_pendingTexts[UINone];
+		uint32_t m_pendingFloatMask, m_pendingMetricMask, m_pendingTextMask;
+		uint32_t m_pendingBoolMask, m_pendingBoolValues;
+
+		// Values shown by the last Flush, and a bit per key shown
+		float m_floats[UINumFloats];
+		float m_metrics[UIMNone];
+		UIStringRef m_texts[UINone];
+		uint32_t m_floatMask, m_metricMask, m_textMask, m_boolMask, m_boolValues;
+		UIState m_state;
+		UIAction m_action;
+		UIWorkoutStage m_stage;
+		int m_totalRacers;
+
+		// Did a field that is never held back change, and has anything been
+		// flushed since Reset?
+		bool m_fieldsChanged;
+		bool m_started;
+
+		// Seconds between showings of each key (0 shows every change), and
+		// when each key can next be shown
+		double m_floatIntervals[UINumFloats];
+		double m_metricIntervals[UIMNone];
+		double m_textIntervals[UINone];
+		double m_floatDue[UINumFloats];
+		double m_metricDue[UIMNone];
+		double m_textDue[UINone];
+
+		// Backing memory of text written by the sensors
+		UIStringWriter m_strings;
+
+	public:
+		// Exported functions
+		UICoalescer();
+		void SetRate(UIFloat key, float hz);
+		void SetRate(UIMetric key, float hz);
+		void SetRate(UITextType key, float hz);
+		void Write(UIFloat key, float value);
+		void Write(UIMetric key, float value);
+		void Write(UITextType key, const char* value);
+		void Write(UIBool key, bool value);
+		void Write(UIState state);
+		void Write(UIAction action);
+		void Write(UIWorkoutStage stage);
+		void SetTotalRacers(int total);
+		void Merge(UIMessage& message);
+		bool Flush(UIMessage* message, double time);
+		void Reset();
+};
+
+#endif
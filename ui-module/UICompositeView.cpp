@@ -6,6 +6,7 @@
 ******************************************************************************/
 
 #include "UICompositeView.h"
+#include "UIDispatcher.h"
 
 /*!****************************************************************************
  @Function		Constructor
@@ -21,6 +22,7 @@ UICompositeView::UICompositeView(float x, float y)
 	m_height = c_bgHeightDefault;
 	m_children = CPVRTArray<UIElement*>();
 	m_text = CPVRTArray<UITextSpec>();
+	m_textMetrics = CPVRTArray<UIMetricText>();
 	m_hidden = false;
 }
 
@@ -45,6 +47,7 @@ UICompositeView::UICompositeView(char* bgTex, float x, float y, float width, flo
 	m_height = height;
 	m_children = CPVRTArray<UIElement*>();
 	m_text = CPVRTArray<UITextSpec>();
+	m_textMetrics = CPVRTArray<UIMetricText>();
 	m_hidden = false;
 }
 
@@ -79,15 +82,62 @@ UICompositeView::AddImage(char* textureName, float xRel, float yRel, float width
  @Input			text			The actual text being added to the view
  @Input			color			The color of the text
  @Input			xRel, yRel		Position of th etext relative to the UICV's pos
- @Input			width, height	Dimensions of the object
- @Description	Initializes the UICompositeView with given background texture
-				and dimensions.
+ @Input			scale			Text scale
+ @Input			updateKey		The UIMessage key used to update the text
+ @Input			font			The font of the text
+ @Description	Adds text to the UICV. Text that never updates (updateKey
+				UINone) becomes a UIStaticText child that is laid out once,
+				text with an update key is printed every frame.
 ******************************************************************************/
 void
 UICompositeView::AddText(char* text, GLuint color, float xRel, float yRel, float scale, UITextType updateKey, UIFont font)
 {
+	if (updateKey == UINone) {
+		UIElement* newText = new UIStaticText(text, m_x + xRel, m_y + yRel, scale, color, font);
+		m_children.Append(newText);
+		return;
+	}
 	UITextSpec newText = { text, color, xRel, yRel, scale, updateKey, font };
 	m_text.Append(newText);
+
+	UIMetricText metric;
+	UIFormatter format;
+	if (UIMessage::MetricForText(updateKey, &metric.metric, &format)) {
+		metric.value = UIFormattedValue(format);
+	} else {
+		metric.metric = UIMNone;
+	}
+	metric.shown = false;
+	m_textMetrics.Append(metric);
+	UIDispatcher::Get()->Subscribe(this, updateKey);
+	if (metric.metric != UIMNone) {
+		UIDispatcher::Get()->Subscribe(this, metric.metric);
+	}
+}
+
+/*!****************************************************************************
+ @Function		AddMetric
+ @Input			key				The numeric metric displayed
+ @Input			format			How the metric is formatted
+ @Input			color			The color of the text
+ @Input			xRel, yRel		Position of the text relative to the UICV's pos
+ @Input			scale			Text scale
+ @Input			font			The font of the text
+ @Description	Adds text that displays a numeric metric from the UIMessage.
+				Nothing is shown until the metric is first received.
+******************************************************************************/
+void
+UICompositeView::AddMetric(UIMetric key, UIFormatter format, GLuint color, float xRel, float yRel, float scale, UIFont font)
+{
+	UITextSpec newText = { (char*) "", color, xRel, yRel, scale, UINone, font };
+	m_text.Append(newText);
+
+	UIMetricText metric;
+	metric.metric = key;
+	metric.value = UIFormattedValue(format);
+	metric.shown = false;
+	m_textMetrics.Append(metric);
+	UIDispatcher::Get()->Subscribe(this, key);
 }
 
 /*!****************************************************************************
@@ -172,7 +222,14 @@ UICompositeView::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 		float textWidth, textHeight;
 		for ( int i = 0; i < m_text.GetSize(); i ++ ) {
 			UITextSpec iText = m_text[i];
-			printer->Print(m_x + iText.xRel, m_y + iText.yRel, iText.scale, iText.color, iText.font, iText.text);
+			UIMetricText& metric = m_textMetrics[i];
+			char* text = iText.text;
+			if (metric.shown) {
+				text = metric.value.GetText();
+			} else if (!metric.received.IsNull()) {
+				text = metric.received.Get();
+			}
+			printer->Print(m_x + iText.xRel, m_y + iText.yRel, iText.scale, iText.color, iText.font, text);
 		}
 	}
 
@@ -187,7 +244,9 @@ UICompositeView::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 void
 UICompositeView::Update(UIMessage updateMessage)
 {
-	if (m_children.GetSize() > 0) {
+	// During a dispatch the children that read the message are updated by
+	// the UIDispatcher
+	if (m_children.GetSize() > 0 && !UIDispatcher::Get()->IsDispatching()) {
 		for (int i = 0; i < m_children.GetSize(); i ++ ) {
 			m_children[i]->Update(updateMessage);
 		}
@@ -195,11 +254,20 @@ UICompositeView::Update(UIMessage updateMessage)
 
 	if (m_text.GetSize() > 0) {
 		for ( int i = 0; i < m_text.GetSize(); i ++ ){
-			UITextType updateKey = m_text[i].updateKey;
-			if (updateMessage.Read(updateKey) == NULL) {
+			UIMetricText& metric = m_textMetrics[i];
+			if (metric.metric != UIMNone && updateMessage.Has(metric.metric)) {
+				// Only formats when the displayed text changes
+				metric.value.Set(updateMessage.Read(metric.metric));
+				metric.shown = true;
+				continue;
+			}
+			UIStringRef text = updateMessage.ReadRef(m_text[i].updateKey);
+			if (text.IsNull()) {
 				continue;
 			} else {
-				m_text[i].text = updateMessage.Read(updateKey);
+				// Keeps the message's text alive rather than copying it
+				metric.received = text;
+				metric.shown = false;
 			}
 		}
 	}
@@ -232,6 +300,7 @@ UICompositeView::Show()
 void
 UICompositeView::Delete()
 {
+	UIDispatcher::Get()->Unsubscribe(this);
 	if (m_bg != NULL) {
 		m_bg->Delete();
 		delete m_bg;
@@ -244,4 +313,7 @@ UICompositeView::Delete()
 			m_children[i] = NULL;
 		}
 	}
+	for ( int i = 0; i < m_textMetrics.GetSize(); i ++ ) {
+		m_textMetrics[i].received.Release();
+	}
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "OGLES2Tools.h"
 #include "UIElement.h"
 #include "UIImage.h"
+#include "UIStaticText.h"
 
 #ifndef _UICOMPVIEW_H
 #define _UICOMPVIEW_H
@@ -18,12 +19,25 @@ const char c_bgTexDefault[] = "basicBox.pvr";
 const float c_bgWidthDefault = 220;
 const float c_bgHeightDefault = 70;
 
+// Numeric metric bound to a piece of updating text and its formatted value,
+// and a reference to the last text received for the text's update key
+struct UIMetricText {
+	UIMetric metric;
+	UIFormattedValue value;
+	bool shown;
+	UIStringRef received;
+};
+
 /*!****************************************************************************
  @class UICompoositeView
  Object class. A UICompositeView is a an object that stores, loads, builds and
  renders a collection of UIElements and text over a background UIImage. It supports 
  adding any number of images and text objects to the array of elements being displayed.
- It implements the UIElement interface 
+ Text that has no update key is added as a UIStaticText child so that it is only
+ laid out once. Updating text can be bound to a numeric metric in the UIMessage
+ (by default the one behind its text key), which the view formats into its own
+ buffer only when the value crosses a display precision boundary. It implements
+ the UIElement interface 
 ******************************************************************************/
 class UICompositeView : public UIElement
 {
@@ -45,6 +59,9 @@ class UICompositeView : public UIElement
 		// Array of text specs contained within the UICompositeView
 		CPVRTArray<UITextSpec> m_text;
 
+		// Metric bound to each text spec (UIMNone if it has none)
+		CPVRTArray<UIMetricText> m_textMetrics;
+
 	public:
 		// Exported functions:
 		UICompositeView(float x, float y);
@@ -52,6 +69,7 @@ class UICompositeView : public UIElement
 		void AddElement(UIElement* newElement);
 		void AddImage(char* textureName, float xRel, float yRel, float width, float height);
 		void AddText(char* text, GLuint color, float xRel, float yRel, float scale, UITextType updateKey, UIFont font);
+		void AddMetric(UIMetric key, UIFormatter format, GLuint color, float xRel, float yRel, float scale, UIFont font);
         virtual bool LoadTextures(CPVRTString* const pErrorStr);
         virtual void BuildVertices();
         virtual bool Render(GLuint uiMVPMatrixLoc, UIPrinter* printer);
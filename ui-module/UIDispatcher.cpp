@@ -0,0 +1,420 @@
+/******************************************************************************
+ @File          UIDispatcher.cpp
+ @Title         UIDispatcher
+ @Author        Siddharth Hathi
+ @Description   Implements the UIDispatcher object class defined in
+				UIDispatcher.h
+******************************************************************************/
+
+#include "UIDispatcher.h"
+#include <string.h>
+
+// Where each kind of key starts in the dispatch key numbering
+const int c_textKeysStart = UINumFloats;
+const int c_metricKeysStart = c_textKeysStart + UINone;
+const int c_boolKeysStart = c_metricKeysStart + UIMNone;
+const int c_fieldKeysStart = c_boolKeysStart + UINumBools;
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes a dispatcher with no subscribers. Only used by Get.
+******************************************************************************/
+UIDispatcher::UIDispatcher()
+{
+	memset(m_subscribers, 0, sizeof(m_subscribers));
+	memset(m_keySubscribers, 0, sizeof(m_keySubscribers));
+	memset(m_pending, 0, sizeof(m_pending));
+	m_enabled = false;
+	m_dispatching = false;
+	memset(m_overflowed, 0, sizeof(m_overflowed));
+	m_numOverflowed = 0;
+	m_overflowLost = false;
+	m_overflow = false;
+	Reset();
+}
+
+/*!****************************************************************************
+ @Function		Get
+ @Return		UIDispatcher*		The dispatcher
+ @Description	Returns the dispatcher shared by the whole UI
+******************************************************************************/
+UIDispatcher*
+UIDispatcher::Get()
+{
+	static UIDispatcher dispatcher;
+	return &dispatcher;
+}
+
+/*!****************************************************************************
+ @Function		Subscribe
+ @Input			element		Element that reads the key
+ @Input			key			Enum key for float data
+ @Return		bool		Is the element subscribed?
+ @Description	Updates the element whenever the float changes
+******************************************************************************/
+bool
+UIDispatcher::Subscribe(UIElement* element, UIFloat key)
+{
+	return key >= 0 && key < UINumFloats && subscribe(element, key);
+}
+
+/*!****************************************************************************
+ @Function		Subscribe
+ @Input			element		Element that reads the key
+ @Input			key			Enum key for text data
+ @Return		bool		Is the element subscribed?
+ @Description	Updates the element whenever the text changes
+******************************************************************************/
+bool
+UIDispatcher::Subscribe(UIElement* element, UITextType key)
+{
+	return key >= 0 && key < UINone && subscribe(element, c_textKeysStart + key);
+}
+
+/*!****************************************************************************
+ @Function		Subscribe
+ @Input			element		Element that reads the key
+ @Input			key			Enum key for numeric telemetry
+ @Return		bool		Is the element subscribed?
+ @Description	Updates the element whenever the metric changes
+******************************************************************************/
+bool
+UIDispatcher::Subscribe(UIElement* element, UIMetric key)
+{
+	return key >= 0 && key < UIMNone && subscribe(element, c_metricKeysStart + key);
+}
+
+/*!****************************************************************************
+ @Function		Subscribe
+ @Input			element		Element that reads the key
+ @Input			key			Enum key for boolean data
+ @Return		bool		Is the element subscribed?
+ @Description	Updates the element whenever the bool changes
+******************************************************************************/
+bool
+UIDispatcher::Subscribe(UIElement* element, UIBool key)
+{
+	return key >= 0 && key < UINumBools && subscribe(element, c_boolKeysStart + key);
+}
+
+/*!****************************************************************************
+ @Function		Subscribe
+ @Input			element		Element that reads the field
+ @Input			field		The state, action, stage or racer count
+ @Return		bool		Is the element subscribed?
+ @Description	Updates the element whenever the field changes
+******************************************************************************/
+bool
+UIDispatcher::Subscribe(UIElement* element, UIMessageField field)
+{
+	return field >= 0 && field < UINumFields && subscribe(element, c_fieldKeysStart + field);
+}
+
+/*!****************************************************************************
+ @Function		Unsubscribe
+ @Input			element		A subscribed element
+ @Description	Drops all of an element's subscriptions. Elements call this
+				from Delete, and containers that update a child themselves
+				call it for the child. Once every element that couldn't
+				subscribe has been dropped, dispatch works again.
+******************************************************************************/
+void
+UIDispatcher::Unsubscribe(UIElement* element)
+{
+	if (element == NULL) {
+		return;
+	}
+	int index = find(element);
+	if (index < 0) {
+		// An element without a slot may have failed to subscribe
+		for ( int i = 0; i < m_numOverflowed; i ++ ) {
+			if (m_overflowed[i] == element) {
+				m_overflowed[i] = m_overflowed[-- m_numOverflowed];
+				m_overflow = m_numOverflowed > 0 || m_overflowLost;
+				break;
+			}
+		}
+		return;
+	}
+	uint32_t keep = ~(1u << (index % 32));
+	for ( int i = 0; i < c_numDispatchKeys; i ++ ) {
+		m_keySubscribers[i][index / 32] &= keep;
+	}
+	m_pending[index / 32] &= keep;
+	m_subscribers[index] = NULL;
+}
+
+/*!****************************************************************************
+ @Function		Dispatch
+ @Input			message		The frame's message
+ @Return		int			Number of elements updated (-1 if the tree has
+							to be updated instead)
+ @Description	Updates the subscribers of every key that is new, changed or
+				gone since the last message, and any element that hasn't
+				been updated since it subscribed. The first message after
+				Reset reaches every subscriber. Returns -1 without updating
+				anything if an element couldn't subscribe, since it would
+				never be reached.
+******************************************************************************/
+int
+UIDispatcher::Dispatch(UIMessage& message)
+{
+	if (m_overflow) {
+		return -1;
+	}
+
+	uint32_t due[c_subscriberWords];
+	memcpy(due, m_pending, sizeof(due));
+	memset(m_pending, 0, sizeof(m_pending));
+	if (!m_started) {
+		for ( int i = 0; i < c_maxSubscribers; i ++ ) {
+			if (m_subscribers[i] != NULL) {
+				due[i / 32] |= 1u << (i % 32);
+			}
+		}
+	}
+
+	// Floats and metrics are compared bit for bit, so a NaN that stays NaN
+	// isn't a change
+	for ( int i = 0; i < UINumFloats; i ++ ) {
+		bool has = message.Has((UIFloat) i);
+		float value = has ? message.Read((UIFloat) i) : 0;
+		bool had = (m_floatMask & (1u << i)) != 0;
+		if (has != had || (has && memcmp(&value, &m_floats[i], sizeof(float)) != 0)) {
+			addChanged(i, due);
+			m_floats[i] = value;
+			m_floatMask ^= has != had ? 1u << i : 0;
+		}
+	}
+	for ( int i = 0; i < UIMNone; i ++ ) {
+		bool has = message.Has((UIMetric) i);
+		float value = has ? message.Read((UIMetric) i) : 0;
+		bool had = (m_metricMask & (1u << i)) != 0;
+		if (has != had || (has && memcmp(&value, &m_metrics[i], sizeof(float)) != 0)) {
+			addChanged(c_metricKeysStart + i, due);
+			m_metrics[i] = value;
+			m_metricMask ^= has != had ? 1u << i : 0;
+		}
+	}
+	for ( int i = 0; i < UINone; i ++ ) {
+		UIStringRef text = message.ReadRef((UITextType) i);
+		const char* last = m_texts[i].Get();
+		if (text.Get() != last && (text.IsNull() || last == NULL || strcmp(text.Get(), last) != 0)) {
+			addChanged(c_textKeysStart + i, due);
+		}
+		// Keeps the newest reference either way, so the last message's
+		// blocks can be reused
+		m_texts[i] = text;
+	}
+	for ( int i = 0; i < UINumBools; i ++ ) {
+		bool has = message.Has((UIBool) i);
+		bool value = has && message.Read((UIBool) i);
+		bool had = (m_boolMask & (1u << i)) != 0;
+		bool was = (m_boolValues & (1u << i)) != 0;
+		if (has != had || value != was) {
+			addChanged(c_boolKeysStart + i, due);
+			m_boolMask ^= has != had ? 1u << i : 0;
+			m_boolValues ^= value != was ? 1u << i : 0;
+		}
+	}
+	if (message.ReadState() != m_state) {
+		addChanged(c_fieldKeysStart + UIFieldState, due);
+		m_state = message.ReadState();
+	}
+	if (message.ReadAction() != m_action) {
+		addChanged(c_fieldKeysStart + UIFieldAction, due);
+		m_action = message.ReadAction();
+	}
+	if (message.ReadWorkoutStage() != m_stage) {
+		addChanged(c_fieldKeysStart + UIFieldStage, due);
+		m_stage = message.ReadWorkoutStage();
+	}
+	if (message.GetTotalRacers() != m_totalRacers) {
+		addChanged(c_fieldKeysStart + UIFieldRacers, due);
+		m_totalRacers = message.GetTotalRacers();
+	}
+	m_started = true;
+
+	int numUpdated = 0;
+	m_dispatching = true;
+	for ( int word = 0; word < c_subscriberWords; word ++ ) {
+		uint32_t bits = due[word];
+		while (bits != 0) {
+			int index = word * 32 + __builtin_ctz(bits);
+			bits &= bits - 1;
+			// An element unsubscribed by an earlier update is skipped
+			if (m_subscribers[index] != NULL) {
+				m_subscribers[index]->Update(message);
+				numUpdated ++;
+			}
+		}
+	}
+	m_dispatching = false;
+	return numUpdated;
+}
+
+/*!****************************************************************************
+ @Function		Reset
+ @Description	Forgets the last message, so the next one reaches every
+				subscriber. Call it when the layer shows, hides or changes the
+				state of elements itself.
+******************************************************************************/
+void
+UIDispatcher::Reset()
+{
+	memset(m_floats, 0, sizeof(m_floats));
+	memset(m_metrics, 0, sizeof(m_metrics));
+	for ( int i = 0; i < UINone; i ++ ) {
+		m_texts[i].Release();
+	}
+	m_floatMask = 0;
+	m_metricMask = 0;
+	m_boolMask = 0;
+	m_boolValues = 0;
+	m_state = UIMain;
+	m_action = UINoAction;
+	m_stage = UIWarmup;
+	m_totalRacers = 0;
+	m_started = false;
+}
+
+/*!****************************************************************************
+ @Function		SetEnabled
+ @Input			enabled		Should UIFrameCache::Update dispatch?
+ @Description	Turns dispatch on or off. Turning it on resets the dispatcher
+				so the first message reaches every subscriber.
+******************************************************************************/
+void
+UIDispatcher::SetEnabled(bool enabled)
+{
+	if (enabled && !m_enabled) {
+		Reset();
+	}
+	m_enabled = enabled;
+}
+
+/*!****************************************************************************
+ @Function		IsEnabled
+ @Return		bool		Is dispatch on?
+ @Description	Getter for m_enabled
+******************************************************************************/
+bool
+UIDispatcher::IsEnabled()
+{
+	return m_enabled;
+}
+
+/*!****************************************************************************
+ @Function		IsDispatching
+ @Return		bool		Is a dispatch updating elements?
+ @Description	Tells containers whether to skip forwarding the message to
+				their children
+******************************************************************************/
+bool
+UIDispatcher::IsDispatching()
+{
+	return m_dispatching;
+}
+
+/*!****************************************************************************
+ @Function		GetSubscriberCount
+ @Return		int			Number of subscribed elements
+ @Description	Returns the number of elements with subscriptions
+******************************************************************************/
+int
+UIDispatcher::GetSubscriberCount()
+{
+	int count = 0;
+	for ( int i = 0; i < c_maxSubscribers; i ++ ) {
+		if (m_subscribers[i] != NULL) {
+			count ++;
+		}
+	}
+	return count;
+}
+
+/*!****************************************************************************
+ @Function		find
+ @Input			element		An element
+ @Return		int			The element's slot (-1 if it isn't subscribed)
+ @Description	HELPER - looks up an element's slot
+******************************************************************************/
+int
+UIDispatcher::find(const UIElement* element)
+{
+	for ( int i = 0; i < c_maxSubscribers; i ++ ) {
+		if (m_subscribers[i] == element) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*!****************************************************************************
+ @Function		addOverflowed
+ @Input			element		Element that couldn't get a slot
+ @Description	HELPER - records an element that failed to subscribe, once, so
+				that Unsubscribe can tell when none are left
+******************************************************************************/
+void
+UIDispatcher::addOverflowed(UIElement* element)
+{
+	for ( int i = 0; i < m_numOverflowed; i ++ ) {
+		if (m_overflowed[i] == element) {
+			return;
+		}
+	}
+	if (m_numOverflowed == c_maxSubscribers) {
+		// Too many to track, so dispatch stays off
+		m_overflowLost = true;
+		return;
+	}
+	m_overflowed[m_numOverflowed ++] = element;
+}
+
+/*!****************************************************************************
+ @Function		subscribe
+ @Input			element		Element that reads the key
+ @Input			key			Dispatch key number
+ @Return		bool		Is the element subscribed?
+ @Description	HELPER - adds a key to an element's subscriptions, giving the
+				element a slot if it has none. A new subscriber is updated by
+				the next dispatch whether or not its keys change.
+******************************************************************************/
+bool
+UIDispatcher::subscribe(UIElement* element, int key)
+{
+	if (element == NULL) {
+		return false;
+	}
+	int index = find(element);
+	if (index < 0) {
+		index = find(NULL);
+		if (index < 0) {
+			if (!m_overflow) {
+				fprintf(stderr, "UIDispatcher is full (%d elements), updating the whole tree instead\n", c_maxSubscribers);
+			}
+			m_overflow = true;
+			addOverflowed(element);
+			return false;
+		}
+		m_subscribers[index] = element;
+		m_pending[index / 32] |= 1u << (index % 32);
+	}
+	m_keySubscribers[key][index / 32] |= 1u << (index % 32);
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		addChanged
+ @Input			key			Dispatch key number of a changed key
+ @Modified		due			Slots to update
+ @Description	HELPER - adds the subscribers of a key to the slots to update
+******************************************************************************/
+void
+UIDispatcher::addChanged(int key, uint32_t* due)
+{
+	for ( int i = 0; i < c_subscriberWords; i ++ ) {
+		due[i] |= m_keySubscribers[key][i];
+	}
+}
@@ -0,0 +1,112 @@
+/******************************************************************************
+ @File          UIDispatcher.h
+ @Title         UIDispatcher Header File
+ @Author        Siddharth Hathi
+ @Description   Header file for the UIDispatcher class.
+******************************************************************************/
+
+#include "OGLES2Tools.h"
+#include "UIElement.h"
+#include <stdint.h>
+
+#ifndef _UIDISPATCHER_H
+#define _UIDISPATCHER_H
+
+// Message fields other than the keyed values an element can subscribe to
+enum UIMessageField {
+	UIFieldState,
+	UIFieldAction,
+	UIFieldStage,
+	UIFieldRacers,
+	UINumFields
+};
+
+// Most elements that can subscribe, and the words of a bitset of them
+const int c_maxSubscribers = 256;
+const int c_subscriberWords = c_maxSubscribers / 32;
+
+// Every key and field an element can subscribe to, numbered floats first,
+// then text, metrics, bools and the other fields
+const int c_numDispatchKeys = UINumFloats + UINone + UIMNone + UINumBools + UINumFields;
+
+/*!****************************************************************************
+ @class UIDispatcher
+ Object class. The UIDispatcher passes each message only to the elements that
+ read something in it that changed. Elements subscribe to the keys and fields
+ they read when they are constructed and unsubscribe in Delete. Dispatch
+ compares the message with the last one dispatched, ORs together the bitsets
+ of subscribers of the keys that changed, and updates just those elements.
+ Its cost grows with the number of changed keys, not with the size of the
+ tree.
+
+ While a dispatch is running, containers that only forward messages to their
+ children skip the forwarding (IsDispatching): the children that read the
+ message are subscribed themselves. Containers that drive their children
+ with their own logic (UIPWorkoutView's bars, for example) unsubscribe them
+ and keep updating them.
+
+ There is one dispatcher, returned by UIDispatcher::Get. Dispatch is off by
+ default; once it is enabled, UIFrameCache::Update dispatches instead of
+ passing the message down the whole tree.
+******************************************************************************/
+class UIDispatcher
+{
+	protected:
+		// Instance variables
+
+		// Subscribed elements (NULL for a free slot), and a bitset of the
+		// slots subscribed to each key
+		UIElement* m_subscribers[c_maxSubscribers];
+		uint32_t m_keySubscribers[c_numDispatchKeys][c_subscriberWords];
+
+		// Slots that haven't been updated since they subscribed
+		uint32_t m_pending[c_subscriberWords];
+
+		// The last message dispatched, and has there been one since Reset?
+		float m_floats[UINumFloats];
+		float m_metrics[UIMNone];
+		UIStringRef m_texts[UINone];
+		uint32_t m_floatMask, m_metricMask, m_boolMask, m_boolValues;
+		UIState m_state;
+		UIAction m_action;
+		UIWorkoutStage m_stage;
+		int m_totalRacers;
+		bool m_started;
+
+		// Is dispatch on, and is one running?
+		bool m_enabled;
+		bool m_dispatching;
+
+		// Elements that failed to subscribe because every slot was taken,
+		// and did more fail than could be recorded? Dispatch is off
+		// (m_overflow) until all of them have unsubscribed.
+		UIElement* m_overflowed[c_maxSubscribers];
+		int m_numOverflowed;
+		bool m_overflowLost;
+		bool m_overflow;
+
+		// Local functions
+		UIDispatcher();
+		int find(const UIElement* element);
+		bool subscribe(UIElement* element, int key);
+		void addOverflowed(UIElement* element);
+		void addChanged(int key, uint32_t* due);
+
+	public:
+		// Exported functions
+		static UIDispatcher* Get();
+		bool Subscribe(UIElement* element, UIFloat key);
+		bool Subscribe(UIElement* element, UITextType key);
+		bool Subscribe(UIElement* element, UIMetric key);
+		bool Subscribe(UIElement* element, UIBool key);
+		bool Subscribe(UIElement* element, UIMessageField field);
+		void Unsubscribe(UIElement* element);
+		int Dispatch(UIMessage& message);
+		void Reset();
+		void SetEnabled(bool enabled);
+		bool IsEnabled();
+		bool IsDispatching();
+		int GetSubscriberCount();
+};
+
+#endif
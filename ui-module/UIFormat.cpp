@@ -0,0 +1,298 @@
+/******************************************************************************
+ @File          UIFormat.cpp
+ @Title         UIFormat
+ @Author        Siddharth Hathi
+ @Description   Implements the formatters and the UIFormattedValue object
+				class defined in UIFormat.h
+******************************************************************************/
+
+#include "UIFormat.h"
+
+#include <math.h>
+
+// Scaled values are clamped to this before being rounded to ticks, which keeps
+// every tick inside a 32 bit long and its text inside c_maxFormatChars
+const float c_maxFormatTicks = 999999999.0f;
+
+// Every two digit number, 00 to 99, so digits are written two at a time
+static const char c_digitPairs[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+/*!****************************************************************************
+ @Function		roundTicks
+ @Input			scaled		A value scaled to its display precision
+ @Return		long		The nearest tick
+ @Description	HELPER - rounds a scaled value to a tick, mapping NaN to 0 and
+				clamping out of range values
+******************************************************************************/
+static long
+roundTicks(float scaled)
+{
+	if (scaled != scaled) {
+		return 0;
+	}
+	return lroundf(fmaxf(-c_maxFormatTicks, fminf(c_maxFormatTicks, scaled)));
+}
+
+/*!****************************************************************************
+ @Function		writePair
+ @Input			value		A number from 0 to 99
+ @Output		out			Its two digits
+ @Description	HELPER - writes a zero padded two digit number
+******************************************************************************/
+static inline void
+writePair(unsigned long value, char* out)
+{
+	out[0] = c_digitPairs[2 * value];
+	out[1] = c_digitPairs[2 * value + 1];
+}
+
+/*!****************************************************************************
+ @Function		UIFormatDigits
+ @Input			value		The value
+ @Input			minDigits	Number of digits to zero pad to
+ @Output		out			The digits (not terminated)
+ @Return		int			Number of digits written
+ @Description	Writes the decimal digits of a value, two at a time from the
+				digit pair table
+******************************************************************************/
+int
+UIFormatDigits(unsigned long value, int minDigits, char* out)
+{
+	// Digits are built back to front at the end of a scratch buffer
+	char digits[24];
+	char* end = digits + sizeof(digits);
+	char* pos = end;
+	while (value >= 100) {
+		pos -= 2;
+		writePair(value % 100, pos);
+		value /= 100;
+	}
+	if (value >= 10) {
+		pos -= 2;
+		writePair(value, pos);
+	} else {
+		*(-- pos) = (char)('0' + value);
+	}
+	while (end - pos < minDigits && pos > digits) {
+		*(-- pos) = '0';
+	}
+
+	int length = (int)(end - pos);
+	for ( int i = 0; i < length; i ++ ) {
+		out[i] = pos[i];
+	}
+	return length;
+}
+
+/*!****************************************************************************
+ @Function		UIFormatTicks
+ @Input			format		How the value is displayed
+ @Input			value		The value
+ @Return		long		The value's display tick
+ @Description	Quantises a value to the precision it is displayed at
+******************************************************************************/
+long
+UIFormatTicks(UIFormatter format, float value)
+{
+	switch (format) {
+		case UIFmtFixed1:
+			return roundTicks(value * 10);
+		case UIFmtFixed2:
+			return roundTicks(value * 100);
+		case UIFmtClock:
+			// Clocks count whole seconds rather than rounding
+			return value > 0 ? roundTicks(floorf(value)) : 0;
+		case UIFmtMiles:
+			return roundTicks(value * 100 / c_metresPerMile);
+		case UIFmtPace:
+			if (!(value >= c_minPaceSpeed)) {
+				return -1;
+			}
+			return roundTicks(c_metresPerMile / value);
+		case UIFmtInteger:
+		default:
+			return roundTicks(value);
+	}
+}
+
+/*!****************************************************************************
+ @Function		UIFormatWrite
+ @Input			format		How the value is displayed
+ @Input			ticks		The value's display tick
+ @Output		out			The display text
+ @Return		int			Length of the text
+ @Description	Writes the text of a display tick. Uses integer arithmetic
+				only, so the text never depends on the C locale.
+******************************************************************************/
+int
+UIFormatWrite(UIFormatter format, long ticks, char* out)
+{
+	int length = 0;
+	unsigned long magnitude = ticks < 0 ? -(unsigned long)ticks : ticks;
+	switch (format) {
+		case UIFmtFixed1:
+			if (ticks < 0) {
+				out[length ++] = '-';
+			}
+			length += UIFormatDigits(magnitude / 10, 1, out + length);
+			out[length ++] = '.';
+			out[length ++] = (char)('0' + magnitude % 10);
+			break;
+		case UIFmtFixed2:
+		case UIFmtMiles:
+			if (ticks < 0) {
+				out[length ++] = '-';
+			}
+			length += UIFormatDigits(magnitude / 100, 1, out + length);
+			out[length ++] = '.';
+			writePair(magnitude % 100, out + length);
+			length += 2;
+			break;
+		case UIFmtClock:
+		case UIFmtPace:
+			if (ticks < 0) {
+				out[length ++] = '-';
+				out[length ++] = ':';
+				out[length ++] = '-';
+				out[length ++] = '-';
+			} else if (magnitude >= 3600) {
+				length += UIFormatDigits(magnitude / 3600, 1, out);
+				out[length ++] = ':';
+				writePair(magnitude / 60 % 60, out + length);
+				length += 2;
+				out[length ++] = ':';
+				writePair(magnitude % 60, out + length);
+				length += 2;
+			} else {
+				length += UIFormatDigits(magnitude / 60, 1, out);
+				out[length ++] = ':';
+				writePair(magnitude % 60, out + length);
+				length += 2;
+			}
+			break;
+		case UIFmtInteger:
+		default:
+			if (ticks < 0) {
+				out[length ++] = '-';
+			}
+			length += UIFormatDigits(magnitude, 1, out + length);
+			break;
+	}
+	out[length] = '\0';
+	return length;
+}
+
+/*!****************************************************************************
+ @Function		UIFormatValue
+ @Input			format		How the value is displayed
+ @Input			value		The value
+ @Output		out			The display text
+ @Return		int			Length of the text
+ @Description	Writes the display text of a value
+******************************************************************************/
+int
+UIFormatValue(UIFormatter format, float value, char* out)
+{
+	return UIFormatWrite(format, UIFormatTicks(format, value), out);
+}
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes an integer value with no text
+******************************************************************************/
+UIFormattedValue::UIFormattedValue()
+{
+	m_format = UIFmtInteger;
+	m_ticks = 0;
+	m_valid = false;
+	m_text[0] = '\0';
+	m_length = 0;
+}
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Input			format		How the value is displayed
+ @Description	Initializes a value with no text
+******************************************************************************/
+UIFormattedValue::UIFormattedValue(UIFormatter format)
+{
+	m_format = format;
+	m_ticks = 0;
+	m_valid = false;
+	m_text[0] = '\0';
+	m_length = 0;
+}
+
+/*!****************************************************************************
+ @Function		Set
+ @Input			value		The new value
+ @Return		bool		Did the display text change?
+ @Description	Updates the value, formatting it only if its display tick
+				changed
+******************************************************************************/
+bool
+UIFormattedValue::Set(float value)
+{
+	long ticks = UIFormatTicks(m_format, value);
+	if (m_valid && ticks == m_ticks) {
+		return false;
+	}
+	m_ticks = ticks;
+	m_valid = true;
+	m_length = UIFormatWrite(m_format, ticks, m_text);
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		IsSet
+ @Return		bool		Has a value been set?
+ @Description	Checks whether the value has any text yet
+******************************************************************************/
+bool
+UIFormattedValue::IsSet()
+{
+	return m_valid;
+}
+
+/*!****************************************************************************
+ @Function		GetText
+ @Return		char*		The display text ("" until a value is set)
+ @Description	Returns the value's display text
+******************************************************************************/
+char*
+UIFormattedValue::GetText()
+{
+	return m_text;
+}
+
+/*!****************************************************************************
+ @Function		GetLength
+ @Return		int			Length of the display text
+ @Description	Returns the length of the value's display text
+******************************************************************************/
+int
+UIFormattedValue::GetLength()
+{
+	return m_length;
+}
+
+/*!****************************************************************************
+ @Function		GetFormat
+ @Return		UIFormatter		How the value is displayed
+ @Description	Returns the value's formatter
+******************************************************************************/
+UIFormatter
+UIFormattedValue::GetFormat()
+{
+	return m_format;
+}
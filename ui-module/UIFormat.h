@@ -0,0 +1,83 @@
+/******************************************************************************
+ @File          UIFormat.h
+ @Title         UIFormat Header File
+ @Author        Siddharth Hathi
+ @Description   Formatters that turn telemetry values into display text.
+				Makes no GL calls, so it can be built and tested without the
+				SDK.
+******************************************************************************/
+
+#include <stddef.h>
+
+#ifndef _UIFORMAT_H
+#define _UIFORMAT_H
+
+// Longest text a formatter writes
+const int c_maxFormatChars = 16;
+
+// Metres in a mile, for distances and paces shown in miles
+const float c_metresPerMile = 1609.344f;
+
+// Slowest speed (m/s) shown as a pace. Anything slower shows -:--
+const float c_minPaceSpeed = 0.3f;
+
+// Formatters (all locale independent, and none goes through printf):
+//	UIFmtInteger	rounded to a whole number					"412"
+//	UIFmtFixed1		one decimal place							"12.5"
+//	UIFmtFixed2		two decimal places							"3.14"
+//	UIFmtClock		seconds as m:ss, or h:mm:ss past an hour	"7:05"
+//	UIFmtMiles		metres as miles to two decimal places		"2.41"
+//	UIFmtPace		m/s as minutes per mile (m:ss)				"8:30"
+enum UIFormatter { UIFmtInteger, UIFmtFixed1, UIFmtFixed2, UIFmtClock, UIFmtMiles, UIFmtPace, UIFmtNumFormatters };
+
+// Writes the decimal digits of value, zero padded to minDigits, into out (no
+// terminator) and returns how many were written
+int UIFormatDigits(unsigned long value, int minDigits, char* out);
+
+// Display tick of a value: two values format to the same text exactly when
+// they have the same tick, so text only has to be rebuilt when the tick changes
+long UIFormatTicks(UIFormatter format, float value);
+
+// Writes the text of a tick into out (c_maxFormatChars + 1 chars) and returns
+// its length
+int UIFormatWrite(UIFormatter format, long ticks, char* out);
+
+// Writes the text of a value into out (c_maxFormatChars + 1 chars) and returns
+// its length
+int UIFormatValue(UIFormatter format, float value, char* out);
+
+/*!****************************************************************************
+ @class UIFormattedValue
+ Object class. A UIFormattedValue is a telemetry value with its display text,
+ kept in its own buffer. Set only formats the value again when it crosses a
+ display precision boundary (its tick changes), so a readout fed the same
+ rounded value every frame costs one integer compare and no string work.
+******************************************************************************/
+class UIFormattedValue
+{
+	protected:
+		// Instance variables
+
+		// How the value is displayed
+		UIFormatter m_format;
+
+		// Tick of the displayed text, and has a value been set?
+		long m_ticks;
+		bool m_valid;
+
+		// Display text
+		char m_text[c_maxFormatChars + 1];
+		int m_length;
+
+	public:
+		// Exported functions
+		UIFormattedValue();
+		UIFormattedValue(UIFormatter format);
+		bool Set(float value);
+		bool IsSet();
+		char* GetText();
+		int GetLength();
+		UIFormatter GetFormat();
+};
+
+#endif
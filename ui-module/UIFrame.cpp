@@ -0,0 +1,336 @@
+/******************************************************************************
+ @File          UIFrame.cpp
+ @Title         UIFrame
+ @Author        Siddharth Hathi
+ @Description   Implements the UIFrame functions and the UIFrameWriter object
+				class defined in UIFrame.h
+******************************************************************************/
+
+#include "UIFrame.h"
+
+/*!****************************************************************************
+ @Function		hashName
+ @Input			hash		Hash so far
+ @Input			name		Name to add
+ @Return		uint32_t	The new hash
+ @Description	HELPER - adds a name and its terminator to an FNV-1a hash
+******************************************************************************/
+static uint32_t
+hashName(uint32_t hash, const char* name)
+{
+	do {
+		hash ^= (uint8_t) *name;
+		hash *= 16777619u;
+	} while (*name ++ != '\0');
+	return hash;
+}
+
+/*!****************************************************************************
+ @Function		hashSchema
+ @Return		uint32_t	Hash of the frame schema
+ @Description	HELPER - hashes the kind and name of every frame field, and
+				the state, stage and action names, in order
+******************************************************************************/
+static uint32_t
+hashSchema()
+{
+	uint32_t hash = 2166136261u;
+	for ( int i = 0; i < c_numFrameFields; i ++ ) {
+		hash = (hash ^ c_frameSchema[i].kind) * 16777619u;
+		hash = hashName(hash, c_frameSchema[i].name);
+	}
+	for ( int i = 0; i < UINumStates; i ++ ) {
+		hash = hashName(hash, c_stateNames[i]);
+	}
+	for ( int i = 0; i < UINumWorkoutStages; i ++ ) {
+		hash = hashName(hash, c_workoutStageNames[i]);
+	}
+	for ( int i = 0; i < UINumActions; i ++ ) {
+		hash = hashName(hash, c_actionNames[i]);
+	}
+	return hash;
+}
+
+/*!****************************************************************************
+ @Function		UIFrameSchema
+ @Return		uint32_t	Hash of the frame schema
+ @Description	Returns the hash of this build's frame schema
+******************************************************************************/
+uint32_t
+UIFrameSchema()
+{
+	static const uint32_t schema = hashSchema();
+	return schema;
+}
+
+/*!****************************************************************************
+ @Function		UIFrameCheck
+ @Input			data		The frame
+ @Input			size		Bytes available at data
+ @Output		pError		Why the frame can't be read
+ @Return		bool		Can the frame be read?
+ @Description	Checks a frame's header, its enum values and that every text
+				value it claims is terminated inside its string table, so it
+				can then be read in place without bounds checks
+******************************************************************************/
+bool
+UIFrameCheck(const void* data, size_t size, const char** pError)
+{
+	const UIFrame* frame = (const UIFrame*) data;
+	if (data == NULL || size < sizeof(UIFrame) || ((uintptr_t) data & 3) != 0) {
+		*pError = "frame is truncated or misaligned";
+		return false;
+	}
+	if (frame->magic != c_frameMagic || frame->version != c_frameVersion || frame->headerSize != sizeof(UIFrame)) {
+		*pError = "not a UIFrame of this version";
+		return false;
+	}
+	if (frame->schema != UIFrameSchema()) {
+		*pError = "frame was written with different message keys";
+		return false;
+	}
+	if (frame->size > size || frame->size != sizeof(UIFrame) + frame->textSize) {
+		*pError = "frame size doesn't match its string table";
+		return false;
+	}
+	if (frame->state < 0 || frame->state >= UINumStates || frame->action < 0 || frame->action >= UINumActions
+		|| frame->stage < 0 || frame->stage >= UINumWorkoutStages) {
+		*pError = "frame has an unknown state, action or stage";
+		return false;
+	}
+	if ((frame->floatMask >> UINumFloats) != 0 || (frame->textMask >> UINone) != 0
+		|| (frame->metricMask >> UIMNone) != 0 || (frame->boolMask >> UINumBools) != 0) {
+		*pError = "frame has unknown keys";
+		return false;
+	}
+
+	// Every text value ends at or before the last byte of the table, which
+	// must be a terminator
+	if (frame->textMask != 0) {
+		if (frame->textSize == 0 || UIFrameStrings(frame)[frame->textSize - 1] != '\0') {
+			*pError = "frame's string table isn't terminated";
+			return false;
+		}
+		for ( int i = 0; i < UINone; i ++ ) {
+			if ((frame->textMask & (1u << i)) != 0 && frame->textOffsets[i] >= frame->textSize) {
+				*pError = "frame text is outside its string table";
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		UIFrameStrings
+ @Input			frame		A checked frame
+ @Return		const char*	Start of the frame's string table
+ @Description	Returns the string table that follows a frame's header
+******************************************************************************/
+const char*
+UIFrameStrings(const UIFrame* frame)
+{
+	return (const char*) frame + sizeof(UIFrame);
+}
+
+/*!****************************************************************************
+ @Function		UIFrameText
+ @Input			frame		A checked frame
+ @Input			key			Enum key for text data
+ @Return		const char*	The text (NULL if the frame has none for key)
+ @Description	Reads a text value in place
+******************************************************************************/
+const char*
+UIFrameText(const UIFrame* frame, UITextType key)
+{
+	if (key < 0 || key >= UINone || (frame->textMask & (1u << key)) == 0) {
+		return NULL;
+	}
+	return UIFrameStrings(frame) + frame->textOffsets[key];
+}
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes a writer with no frame
+******************************************************************************/
+UIFrameWriter::UIFrameWriter()
+{
+	m_frame = NULL;
+	m_capacity = 0;
+	m_overflow = false;
+}
+
+/*!****************************************************************************
+ @Function		Begin
+ @Input			buffer		Memory the frame is written to (4 byte aligned)
+ @Input			capacity	Size of the buffer
+ @Input			sequence	The app layer's frame number
+ @Return		bool		Can the frame be written?
+ @Description	Starts an empty frame in a buffer
+******************************************************************************/
+bool
+UIFrameWriter::Begin(void* buffer, size_t capacity, uint32_t sequence)
+{
+	m_frame = NULL;
+	if (buffer == NULL || capacity < sizeof(UIFrame) || ((uintptr_t) buffer & 3) != 0) {
+		fprintf(stderr, "UIFrameWriter needs an aligned buffer of at least %u bytes\n", (unsigned int) sizeof(UIFrame));
+		return false;
+	}
+	m_frame = (UIFrame*) buffer;
+	m_capacity = capacity;
+	m_overflow = false;
+	memset(m_frame, 0, sizeof(UIFrame));
+	m_frame->magic = c_frameMagic;
+	m_frame->version = c_frameVersion;
+	m_frame->headerSize = sizeof(UIFrame);
+	m_frame->schema = UIFrameSchema();
+	m_frame->size = sizeof(UIFrame);
+	m_frame->sequence = sequence;
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		Write
+ @Input			key		Enum key for float data
+ @Input			value	Float being stored
+ @Description	Stores float data in the key's slot
+******************************************************************************/
+void
+UIFrameWriter::Write(UIFloat key, float value)
+{
+	if (m_frame != NULL && key >= 0 && key < UINumFloats) {
+		m_frame->floats[key] = value;
+		m_frame->floatMask |= 1u << key;
+	}
+}
+
+/*!****************************************************************************
+ @Function		Write
+ @Input			key		Enum key for numeric telemetry
+ @Input			value	Value being stored, in the metric's units
+ @Description	Stores a telemetry value in the metric's slot
+******************************************************************************/
+void
+UIFrameWriter::Write(UIMetric key, float value)
+{
+	if (m_frame != NULL && key >= 0 && key < UIMNone) {
+		m_frame->metrics[key] = value;
+		m_frame->metricMask |= 1u << key;
+	}
+}
+
+/*!****************************************************************************
+ @Function		Write
+ @Input			key		Enum key for text data
+ @Input			value	Text being stored
+ @Description	Appends text to the string table. Text that doesn't fit in
+				the buffer is left out and Finish reports the frame as full.
+******************************************************************************/
+void
+UIFrameWriter::Write(UITextType key, const char* value)
+{
+	if (m_frame == NULL || key < 0 || key >= UINone || value == NULL) {
+		return;
+	}
+	size_t length = strlen(value) + 1;
+	if (m_frame->size + length > m_capacity || m_frame->textSize + length > (size_t) c_maxFrameText) {
+		m_overflow = true;
+		return;
+	}
+	memcpy((char*) m_frame + m_frame->size, value, length);
+	m_frame->textOffsets[key] = m_frame->textSize;
+	m_frame->textSize += length;
+	m_frame->size += length;
+	m_frame->textMask |= 1u << key;
+}
+
+/*!****************************************************************************
+ @Function		Write
+ @Input			key		Enum key for boolean data
+ @Input			value	Bool being stored
+ @Description	Stores boolean data in the key's bit
+******************************************************************************/
+void
+UIFrameWriter::Write(UIBool key, bool value)
+{
+	if (m_frame != NULL && key >= 0 && key < UINumBools) {
+		m_frame->boolMask |= 1u << key;
+		if (value) {
+			m_frame->boolValues |= 1u << key;
+		} else {
+			m_frame->boolValues &= ~(1u << key);
+		}
+	}
+}
+
+/*!****************************************************************************
+ @Function		Write
+ @Input			state	The UI's current display state
+ @Description	Stores the UIState in the frame
+******************************************************************************/
+void
+UIFrameWriter::Write(UIState state)
+{
+	if (m_frame != NULL) {
+		m_frame->state = state;
+	}
+}
+
+/*!****************************************************************************
+ @Function		Write
+ @Input			action	A new action enum
+ @Description	Stores the UIAction in the frame
+******************************************************************************/
+void
+UIFrameWriter::Write(UIAction action)
+{
+	if (m_frame != NULL) {
+		m_frame->action = action;
+	}
+}
+
+/*!****************************************************************************
+ @Function		Write
+ @Input			stage	A new workout stage
+ @Description	Stores the workout stage in the frame
+******************************************************************************/
+void
+UIFrameWriter::Write(UIWorkoutStage stage)
+{
+	if (m_frame != NULL) {
+		m_frame->stage = stage;
+	}
+}
+
+/*!****************************************************************************
+ @Function		SetTotalRacers
+ @Input			total	Total number of racers
+ @Description	Stores the total number of racers in the frame
+******************************************************************************/
+void
+UIFrameWriter::SetTotalRacers(int total)
+{
+	if (m_frame != NULL) {
+		m_frame->totalRacers = total;
+	}
+}
+
+/*!****************************************************************************
+ @Function		Finish
+ @Return		size_t		Size of the frame in bytes (0 if it is invalid)
+ @Description	Ends the frame. The string table is terminated by the last
+				text written, so there is nothing to patch up. Returns 0 if
+				there was no frame or some text didn't fit.
+******************************************************************************/
+size_t
+UIFrameWriter::Finish()
+{
+	if (m_frame == NULL) {
+		return 0;
+	}
+	if (m_overflow) {
+		fprintf(stderr, "UIFrameWriter: text didn't fit in the %u byte frame buffer\n", (unsigned int) m_capacity);
+		return 0;
+	}
+	return m_frame->size;
+}
@@ -0,0 +1,141 @@
+/******************************************************************************
+ @File          UIFrame.h
+ @Title         UIFrame Header File
+ @Author        Siddharth Hathi
+ @Description   The binary telemetry frame the app layer sends the UIKit, its
+				schema, and the UIFrameWriter class. Makes no GL calls.
+******************************************************************************/
+
+#include "UIMessageKeys.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifndef _UIFRAME_H
+#define _UIFRAME_H
+
+// Identifies a telemetry frame ("UIFR" in memory) and the version of its layout
+const uint32_t c_frameMagic = 0x52464955;
+const uint16_t c_frameVersion = 1;
+
+// Most bytes of text (terminators included) a frame can carry
+const int c_maxFrameText = 0xffff;
+
+/*!****************************************************************************
+ A UIFrame is one frame of telemetry, laid out so that the UIKit can read it
+ in place: a fixed size header with a bitmap of the keys present, a slot for
+ every numeric key, and the offset of every text value in the string table
+ that follows the header. Values are in the writer's native byte order, and
+ the buffer must be 4 byte aligned.
+******************************************************************************/
+struct UIFrame {
+	// Magic number, layout version, sizeof(UIFrame) and UIFrameSchema() of
+	// the writer
+	uint32_t magic;
+	uint16_t version;
+	uint16_t headerSize;
+	uint32_t schema;
+
+	// Bytes in the frame including the string table, and the app layer's
+	// frame number
+	uint32_t size;
+	uint32_t sequence;
+
+	// UIState, UIAction, UIWorkoutStage and racer count
+	int32_t state, action, stage, totalRacers;
+
+	// Bit per key that is present, and the values of the bools
+	uint32_t floatMask, textMask, metricMask, boolMask, boolValues;
+
+	// Numeric slots, indexed by key
+	float floats[UINumFloats];
+	float metrics[UIMNone];
+
+	// Offset of each text value in the string table, indexed by key, and
+	// the size of the string table
+	uint16_t textOffsets[UINone];
+	uint16_t textSize;
+};
+
+// Kinds of frame field
+enum UIFrameFieldKind { UIFFFloat, UIFFText, UIFFMetric, UIFFBool };
+
+// A field of the frame schema
+struct UIFrameField {
+	const char* name;
+	UIFrameFieldKind kind;
+	int key;
+};
+
+// The frame schema, generated from the UIMessage key lists
+#define UIKIT_FRAME_FLOAT(key) { #key, UIFFFloat, key },
+#define UIKIT_FRAME_TEXT(key) { #key, UIFFText, key },
+#define UIKIT_FRAME_METRIC(key) { #key, UIFFMetric, key },
+#define UIKIT_FRAME_BOOL(key) { #key, UIFFBool, key },
+
+const UIFrameField c_frameSchema[] = {
+	UIKIT_FLOAT_KEYS(UIKIT_FRAME_FLOAT)
+	UIKIT_TEXT_KEYS(UIKIT_FRAME_TEXT)
+	UIKIT_METRIC_KEYS(UIKIT_FRAME_METRIC)
+	UIKIT_BOOL_KEYS(UIKIT_FRAME_BOOL)
+};
+
+const int c_numFrameFields = UINumFloats + UINone + UIMNone + UINumBools;
+
+// Hash of the schema and the state, stage and action names. Frames are only
+// read by a UIKit built with the same keys in the same order.
+uint32_t UIFrameSchema();
+
+// Checks that size bytes of data hold a frame this build can read, setting
+// *pError to the reason if not
+bool UIFrameCheck(const void* data, size_t size, const char** pError);
+
+// Start of a checked frame's string table
+const char* UIFrameStrings(const UIFrame* frame);
+
+// Text value of a key in a checked frame, read in place (NULL if absent)
+const char* UIFrameText(const UIFrame* frame, UITextType key);
+
+/*!****************************************************************************
+ @class UIFrameWriter
+ Object class. A UIFrameWriter is the app layer's side of the UIFrame: it
+ builds a frame in a caller's buffer with the same Write functions as a
+ UIMessage, so a frame is filled straight from the decoded protobufs. Text is
+ appended to the string table; keys that aren't written are left out of the
+ bitmaps.
+
+	UIFrameWriter writer;
+	writer.Begin(buffer, sizeof(buffer), frameNumber);
+	writer.Write(UIMTimeS, elapsed);
+	...
+	size_t size = writer.Finish();
+******************************************************************************/
+class UIFrameWriter
+{
+	protected:
+		// Instance variables
+
+		// Frame being written and the size of its buffer
+		UIFrame* m_frame;
+		size_t m_capacity;
+
+		// Did any text not fit?
+		bool m_overflow;
+
+	public:
+		// Exported functions
+		UIFrameWriter();
+		bool Begin(void* buffer, size_t capacity, uint32_t sequence);
+		void Write(UIFloat key, float value);
+		void Write(UIMetric key, float value);
+		void Write(UITextType key, const char* value);
+		void Write(UIBool key, bool value);
+		void Write(UIState state);
+		void Write(UIAction action);
+		void Write(UIWorkoutStage stage);
+		void SetTotalRacers(int total);
+		size_t Finish();
+};
+
+#endif
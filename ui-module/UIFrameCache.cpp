@@ -0,0 +1,404 @@
+/******************************************************************************
+ @File          UIFrameCache.cpp
+ @Title         UIFrameCache
+ @Author        Siddharth Hathi
+ @Description   Implements the UIFrameCache object class defined in
+				UIFrameCache.h
+******************************************************************************/
+
+#include "UIFrameCache.h"
+#include "UIDispatcher.h"
+#include "UIStateTable.h"
+
+// Attribute indices of the composite shader
+const GLuint c_cacheVertexAttrib = 0;
+const GLuint c_cacheTexCoordAttrib = 3;
+
+// Composite shaders. The overlay is stored with premultiplied alpha.
+static const char* c_cacheVertShader =
+	"attribute highp vec2 inVertex;\n"
+	"attribute mediump vec2 inTexCoord;\n"
+	"varying mediump vec2 TexCoord;\n"
+	"void main()\n"
+	"{\n"
+	"	gl_Position = vec4(inVertex, 0.0, 1.0);\n"
+	"	TexCoord = inTexCoord;\n"
+	"}\n";
+
+static const char* c_cacheFragShader =
+	"uniform sampler2D sTexture;\n"
+	"varying mediump vec2 TexCoord;\n"
+	"void main()\n"
+	"{\n"
+	"	gl_FragColor = texture2D(sTexture, TexCoord);\n"
+	"}\n";
+
+// Full screen quad (x, y, u, v) as a counter clockwise triangle strip
+static const float c_cacheQuad[] = {
+	-1, -1, 0, 0,
+	1, -1, 1, 0,
+	-1, 1, 0, 1,
+	1, 1, 1, 1
+};
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes a cache that renders every frame. Only used by Get.
+******************************************************************************/
+UIFrameCache::UIFrameCache()
+{
+	m_mode = UIFMAlways;
+	m_dirty = true;
+	m_redrawing = false;
+	m_width = 0;
+	m_height = 0;
+	m_fbo = 0;
+	m_texture = 0;
+	m_outputFbo = 0;
+	m_quadVbo = 0;
+	m_numFrames = 0;
+	m_numRedraws = 0;
+}
+
+/*!****************************************************************************
+ @Function		Get
+ @Return		UIFrameCache*		The cache
+ @Description	Returns the frame cache shared by the whole UI
+******************************************************************************/
+UIFrameCache*
+UIFrameCache::Get()
+{
+	static UIFrameCache cache;
+	return &cache;
+}
+
+/*!****************************************************************************
+ @Function		Init
+ @Input			mode		How the overlay is produced
+ @Input			width		Width of the viewport in pixels
+ @Input			height		Height of the viewport in pixels
+ @Output		pErrorStr	Error message on failure
+ @Return		bool		Was the mode set up?
+ @Description	Sets the frame mode. Cached mode builds the offscreen target and
+				remembers the framebuffer bound now as the one the overlay is
+				drawn to. If the target can't be built the cache keeps
+				rendering every frame.
+******************************************************************************/
+bool
+UIFrameCache::Init(UIFrameMode mode, int width, int height, CPVRTString* const pErrorStr)
+{
+	Delete();
+	m_width = width;
+	m_height = height;
+	m_dirty = true;
+	if (mode != UIFMCached) {
+		m_mode = mode;
+		return true;
+	}
+
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &m_outputFbo);
+	if (!buildTarget(pErrorStr)) {
+		Delete();
+		return false;
+	}
+	m_mode = mode;
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		MarkDirty
+ @Description	Records that the overlay has changed. The layer calls this when
+				it changes the tree outside of Update (Show, Hide, SetState).
+******************************************************************************/
+void
+UIFrameCache::MarkDirty()
+{
+	m_dirty = true;
+}
+
+/*!****************************************************************************
+ @Function		NeedsRedraw
+ @Return		bool		Might the overlay change next frame?
+ @Description	Checks whether the next BeginFrame could render the overlay:
+				the tree has been marked dirty, or animations or blinks are
+				running. The layer can use this to decide whether it needs to
+				wake up for the next frame at all.
+******************************************************************************/
+bool
+UIFrameCache::NeedsRedraw()
+{
+	return m_dirty || (m_mode == UIFMAlways && !UIStateTable::Get()->IsEmpty())
+		|| UIAnimator::Get()->GetTweenCount() > 0
+		|| UIBlinkScheduler::Get()->GetBlinkCount() > 0;
+}
+
+/*!****************************************************************************
+ @Function		Update
+ @Input			root			Root of the UI tree
+ @Input			updateMessage	UIMessage object containing frame info
+ @Description	Passes a message to the tree and marks the overlay dirty. The
+				app layer only sends messages when its data changes, so every
+				message is treated as a change. With the UIDispatcher enabled
+				the message only goes to the elements whose keys changed, and
+				the overlay is only dirty if one of them was updated.
+
+				The message's state is set in the UIStateTable first, which
+				shows and hides the top level views. A message in noUI goes
+				no further. When the UI comes back the dispatcher is reset,
+				so the elements catch up on what they missed.
+******************************************************************************/
+void
+UIFrameCache::Update(UIElement* root, UIMessage updateMessage)
+{
+	UIStateTable* states = UIStateTable::Get();
+	bool wasEmpty = states->IsEmpty();
+	if (states->SetState(updateMessage.ReadState())) {
+		m_dirty = true;
+		if (wasEmpty) {
+			UIDispatcher::Get()->Reset();
+		}
+	}
+	if (states->IsEmpty()) {
+		return;
+	}
+	if (UIDispatcher::Get()->IsEnabled()) {
+		int numUpdated = UIDispatcher::Get()->Dispatch(updateMessage);
+		if (numUpdated >= 0) {
+			if (numUpdated > 0) {
+				m_dirty = true;
+			}
+			return;
+		}
+	}
+	if (root != NULL) {
+		root->Update(updateMessage);
+	}
+	m_dirty = true;
+}
+
+/*!****************************************************************************
+ @Function		BeginFrame
+ @Return		bool		Should the layer render the tree this frame?
+ @Description	Advances the UIAnimator and UIBlinkScheduler (so the layer
+				doesn't call their Update itself) and works out whether the
+				overlay has changed. If it has, in cached mode the offscreen
+				target is bound and cleared, and blending is set up so the
+				overlay is stored with premultiplied alpha. In noUI there is
+				nothing to render, so UIFMAlways doesn't render either.
+******************************************************************************/
+bool
+UIFrameCache::BeginFrame()
+{
+	m_numFrames ++;
+	if (UIAnimator::Get()->Update()) {
+		m_dirty = true;
+	}
+	if (UIBlinkScheduler::Get()->Update()) {
+		m_dirty = true;
+	}
+
+	m_redrawing = m_dirty || (m_mode == UIFMAlways && !UIStateTable::Get()->IsEmpty());
+	if (!m_redrawing) {
+		return false;
+	}
+	m_dirty = false;
+	m_numRedraws ++;
+
+	if (m_mode == UIFMCached) {
+		GLfloat clearColor[4];
+		glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+		glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+		glClearColor(0, 0, 0, 0);
+		glClear(GL_COLOR_BUFFER_BIT);
+		glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+		RestoreBlend();
+	}
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		RestoreBlend
+ @Description	Sets the offscreen blend function again while the cached
+				overlay is being rendered. composite() assumes the overlay
+				holds premultiplied alpha, which only holds if the alpha
+				channel is blended with GL_ONE, GL_ONE_MINUS_SRC_ALPHA. Print3D
+				sets its own blend function with glBlendFunc when it flushes,
+				which would blend alpha with GL_SRC_ALPHA instead and leave
+				antialiased and translucent pixels too faint, so UIPrinter
+				calls this after every Print3D flush. Does nothing outside a
+				cached redraw.
+******************************************************************************/
+void
+UIFrameCache::RestoreBlend()
+{
+	if (m_mode != UIFMCached || !m_redrawing) {
+		return;
+	}
+	glEnable(GL_BLEND);
+	glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+/*!****************************************************************************
+ @Function		EndFrame
+ @Description	Finishes the frame. In cached mode the layer's framebuffer is
+				rebound if the overlay was rendered, and the cached overlay is
+				drawn over it unless the UI is in noUI, when it is blank. The
+				other modes have nothing to do.
+******************************************************************************/
+void
+UIFrameCache::EndFrame()
+{
+	if (m_mode != UIFMCached) {
+		return;
+	}
+	if (m_redrawing) {
+		glBindFramebuffer(GL_FRAMEBUFFER, m_outputFbo);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		m_redrawing = false;
+	}
+	if (!UIStateTable::Get()->IsEmpty()) {
+		composite();
+	}
+}
+
+/*!****************************************************************************
+ @Function		GetMode
+ @Return		UIFrameMode		How the overlay is produced
+ @Description	Returns the frame mode
+******************************************************************************/
+UIFrameMode
+UIFrameCache::GetMode()
+{
+	return m_mode;
+}
+
+/*!****************************************************************************
+ @Function		GetFrameCount
+ @Return		int		Number of frames begun
+ @Description	Returns the number of frames begun since Init
+******************************************************************************/
+int
+UIFrameCache::GetFrameCount()
+{
+	return m_numFrames;
+}
+
+/*!****************************************************************************
+ @Function		GetRedrawCount
+ @Return		int		Number of frames the overlay was rendered in
+ @Description	Returns the number of frames since Init in which the tree was
+				rendered. Compared with GetFrameCount it shows how much work
+				the cache is saving.
+******************************************************************************/
+int
+UIFrameCache::GetRedrawCount()
+{
+	return m_numRedraws;
+}
+
+/*!****************************************************************************
+ @Function		Delete
+ @Description	Frees the cache's GL objects and goes back to rendering every
+				frame
+******************************************************************************/
+void
+UIFrameCache::Delete()
+{
+	if (m_fbo != 0) {
+		glDeleteFramebuffers(1, &m_fbo);
+		m_fbo = 0;
+	}
+	if (m_texture != 0) {
+		glDeleteTextures(1, &m_texture);
+		m_texture = 0;
+	}
+	if (m_quadVbo != 0) {
+		glDeleteBuffers(1, &m_quadVbo);
+		m_quadVbo = 0;
+	}
+	m_shader.Delete();
+	m_mode = UIFMAlways;
+	m_dirty = true;
+	m_redrawing = false;
+	m_numFrames = 0;
+	m_numRedraws = 0;
+}
+
+/*!****************************************************************************
+ @Function		buildTarget
+ @Output		pErrorStr	Error message on failure
+ @Return		bool		Was the target built?
+ @Description	HELPER - builds the offscreen texture and framebuffer the
+				overlay is cached in, the composite shader and its quad
+******************************************************************************/
+bool
+UIFrameCache::buildTarget(CPVRTString* const pErrorStr)
+{
+	glGenTextures(1, &m_texture);
+	glBindTexture(GL_TEXTURE_2D, m_texture);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_width, m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	glGenFramebuffers(1, &m_fbo);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_texture, 0);
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, m_outputFbo);
+	if (status != GL_FRAMEBUFFER_COMPLETE) {
+		fprintf(stderr, "UIFrameCache framebuffer incomplete (0x%x)\n", status);
+		*pErrorStr = "ERROR: Frame cache framebuffer incomplete";
+		return false;
+	}
+
+	const UIShaderAttrib attribs[] = {
+		{ "inVertex", c_cacheVertexAttrib },
+		{ "inTexCoord", c_cacheTexCoordAttrib }
+	};
+	if (!m_shader.Build(c_cacheVertShader, c_cacheFragShader, attribs, 2, pErrorStr)) {
+		return false;
+	}
+
+	glGenBuffers(1, &m_quadVbo);
+	glBindBuffer(GL_ARRAY_BUFFER, m_quadVbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(c_cacheQuad), c_cacheQuad, GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		composite
+ @Description	HELPER - draws the cached overlay over the layer's framebuffer
+				with premultiplied alpha blending
+******************************************************************************/
+void
+UIFrameCache::composite()
+{
+	GLboolean blend = glIsEnabled(GL_BLEND);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+	m_shader.Use();
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, m_texture);
+	glBindBuffer(GL_ARRAY_BUFFER, m_quadVbo);
+	GLsizei stride = 4 * sizeof(float);
+	glEnableVertexAttribArray(c_cacheVertexAttrib);
+	glEnableVertexAttribArray(c_cacheTexCoordAttrib);
+	glVertexAttribPointer(c_cacheVertexAttrib, 2, GL_FLOAT, GL_FALSE, stride, (GLvoid*)0);
+	glVertexAttribPointer(c_cacheTexCoordAttrib, 2, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(2 * sizeof(float)));
+	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+	glDisableVertexAttribArray(c_cacheVertexAttrib);
+	glDisableVertexAttribArray(c_cacheTexCoordAttrib);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	m_shader.Restore();
+
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	if (!blend) {
+		glDisable(GL_BLEND);
+	}
+}
@@ -0,0 +1,92 @@
+/******************************************************************************
+ @File          UIFrameCache.h
+ @Title         UIFrameCache Header File
+ @Author        Siddharth Hathi
+ @Description   Header file for the UIFrameCache class.
+******************************************************************************/
+
+#include "OGLES2Tools.h"
+#include "UIElement.h"
+#include "UIShader.h"
+#include "UIAnimator.h"
+#include "UIBlinkScheduler.h"
+
+#ifndef _UIFRAMECACHE_H
+#define _UIFRAMECACHE_H
+
+// How the overlay is produced each frame:
+//	UIFMAlways		rendered every frame (no caching)
+//	UIFMCached		rendered into a texture when it changes, and the texture is
+//					drawn to the screen every frame
+//	UIFMPreserved	rendered straight to the back buffer when it changes; the
+//					layer keeps the back buffer between frames (EGL_SWAP_BEHAVIOR
+//					set to EGL_BUFFER_PRESERVED) or skips the swap
+enum UIFrameMode { UIFMAlways, UIFMCached, UIFMPreserved };
+
+/*!****************************************************************************
+ @class UIFrameCache
+ Object class. The UIFrameCache lets the layer skip rendering the UI on frames
+ where nothing in it changed. It keeps a dirty flag for the overlay, set when
+ the layer passes the tree a message (Update) or marks it (MarkDirty), and each
+ frame BeginFrame advances the UIAnimator and the UIBlinkScheduler, which report
+ whether they changed anything. Only when something did does the layer need to
+ render the tree; otherwise the last overlay is reused, either from the cache's
+ texture or from the preserved back buffer.
+
+ There is one cache, returned by UIFrameCache::Get. Each frame the layer calls:
+
+	if (UIFrameCache::Get()->BeginFrame()) {
+		root->Render(uiMVPMatrixLoc, printer);
+	}
+	UIFrameCache::Get()->EndFrame();
+******************************************************************************/
+class UIFrameCache
+{
+	protected:
+		// Instance variables
+
+		// How the overlay is produced
+		UIFrameMode m_mode;
+
+		// Has the overlay changed since it was last rendered?
+		bool m_dirty;
+
+		// Is the overlay being rendered this frame?
+		bool m_redrawing;
+
+		// Size of the overlay in pixels
+		int m_width, m_height;
+
+		// Offscreen target (cached mode) and the framebuffer the layer draws to
+		GLuint m_fbo, m_texture;
+		GLint m_outputFbo;
+
+		// Full screen quad and the shader that composites the cached overlay
+		GLuint m_quadVbo;
+		UIShader m_shader;
+
+		// Frames begun, and frames the overlay was rendered in
+		int m_numFrames, m_numRedraws;
+
+		// Local functions
+		UIFrameCache();
+		bool buildTarget(CPVRTString* const pErrorStr);
+		void composite();
+
+	public:
+		// Exported functions
+		static UIFrameCache* Get();
+		bool Init(UIFrameMode mode, int width, int height, CPVRTString* const pErrorStr);
+		void MarkDirty();
+		bool NeedsRedraw();
+		void Update(UIElement* root, UIMessage updateMessage);
+		bool BeginFrame();
+		void RestoreBlend();
+		void EndFrame();
+		UIFrameMode GetMode();
+		int GetFrameCount();
+		int GetRedrawCount();
+		void Delete();
+};
+
+#endif
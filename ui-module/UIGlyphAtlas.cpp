@@ -0,0 +1,196 @@
+/******************************************************************************
+ @File          UIGlyphAtlas.cpp
+ @Title         UIGlyphAtlas
+ @Author        Siddharth Hathi
+ @Description   Implements the UIGlyphAtlas object class defined in
+				UIGlyphAtlas.h
+******************************************************************************/
+
+#include "UIGlyphAtlas.h"
+
+// struct used to track where a glyph is packed
+struct UIAtlasEntry {
+	int font;
+	unsigned char code;
+	int srcX, srcY, width, height;
+	int dstX, dstY;
+};
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes an empty atlas
+******************************************************************************/
+UIGlyphAtlas::UIGlyphAtlas()
+{
+	m_uiTexture = 0;
+	m_width = 0;
+	m_height = 0;
+}
+
+/*!****************************************************************************
+ @Function		Build
+ @Input			fonts		Fonts to pack (already loaded with UIGlyphFont::Load)
+ @Input			numFonts	Number of fonts
+ @Output		pErrorStr	Error message on failure
+ @Description	Packs every glyph of the fonts into rows of a single texture,
+				tallest glyphs first, uploads it, and points the fonts at it.
+				Fails without touching the fonts if any of them isn't an
+				uncompressed 8 bit alpha texture or the atlas would be too big.
+******************************************************************************/
+bool
+UIGlyphAtlas::Build(UIGlyphFont** fonts, int numFonts, CPVRTString* const pErrorStr)
+{
+	Delete();
+
+	// Collect the glyph rectangles
+	CPVRTArray<UIAtlasEntry> entries;
+	for ( int f = 0; f < numFonts; f ++ ) {
+		if (fonts[f]->GetPixels() == NULL) {
+			*pErrorStr = "ERROR: UIGlyphAtlas needs 8 bit alpha font textures";
+			return false;
+		}
+		int texWidth = fonts[f]->GetTextureWidth();
+		int texHeight = fonts[f]->GetTextureHeight();
+		for ( int c = 0; c < c_numGlyphCodes; c ++ ) {
+			const UIGlyph* glyph = fonts[f]->GetGlyph((char)c);
+			if (glyph == NULL) {
+				continue;
+			}
+			UIAtlasEntry entry;
+			entry.font = f;
+			entry.code = (unsigned char)c;
+			entry.srcX = (int)(glyph->u0 * texWidth + 0.5f);
+			entry.srcY = (int)(glyph->v0 * texHeight + 0.5f);
+			entry.width = (int)glyph->width;
+			entry.height = (int)glyph->height;
+			entry.dstX = 0;
+			entry.dstY = 0;
+			entries.Append(entry);
+		}
+	}
+
+	// Sort tallest first (insertion sort, there are only a few hundred glyphs)
+	for ( int i = 1; i < (int)entries.GetSize(); i ++ ) {
+		UIAtlasEntry entry = entries[i];
+		int j = i - 1;
+		while (j >= 0 && entries[j].height < entry.height) {
+			entries[j + 1] = entries[j];
+			j --;
+		}
+		entries[j + 1] = entry;
+	}
+
+	// Pack into rows
+	int x = c_glyphAtlasPadding, y = c_glyphAtlasPadding, rowHeight = 0;
+	for ( int i = 0; i < (int)entries.GetSize(); i ++ ) {
+		if (x + entries[i].width + c_glyphAtlasPadding > c_glyphAtlasWidth) {
+			x = c_glyphAtlasPadding;
+			y += rowHeight + c_glyphAtlasPadding;
+			rowHeight = 0;
+		}
+		entries[i].dstX = x;
+		entries[i].dstY = y;
+		x += entries[i].width + c_glyphAtlasPadding;
+		if (entries[i].height > rowHeight) {
+			rowHeight = entries[i].height;
+		}
+	}
+	int height = 1;
+	while (height < y + rowHeight + c_glyphAtlasPadding) {
+		height *= 2;
+	}
+
+	GLint maxSize;
+	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+	if (height > maxSize || c_glyphAtlasWidth > maxSize) {
+		*pErrorStr = "ERROR: UIGlyphAtlas fonts don't fit in one texture";
+		return false;
+	}
+
+	// Copy the glyphs into the atlas
+	PVRTuint8* pixels = new PVRTuint8[c_glyphAtlasWidth * height];
+	memset(pixels, 0, c_glyphAtlasWidth * height);
+	for ( int i = 0; i < (int)entries.GetSize(); i ++ ) {
+		UIAtlasEntry entry = entries[i];
+		const PVRTuint8* src = fonts[entry.font]->GetPixels();
+		int srcWidth = fonts[entry.font]->GetTextureWidth();
+		for ( int row = 0; row < entry.height; row ++ ) {
+			memcpy(&pixels[(entry.dstY + row) * c_glyphAtlasWidth + entry.dstX],
+				&src[(entry.srcY + row) * srcWidth + entry.srcX], entry.width);
+		}
+	}
+
+	glGenTextures(1, &m_uiTexture);
+	glBindTexture(GL_TEXTURE_2D, m_uiTexture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, c_glyphAtlasWidth, height, 0, GL_ALPHA, GL_UNSIGNED_BYTE, pixels);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	delete[] pixels;
+
+	m_width = c_glyphAtlasWidth;
+	m_height = height;
+
+	// Point the fonts at the atlas
+	for ( int i = 0; i < (int)entries.GetSize(); i ++ ) {
+		UIAtlasEntry entry = entries[i];
+		fonts[entry.font]->RemapGlyph((char)entry.code,
+			(float)entry.dstX / m_width, (float)entry.dstY / m_height,
+			(float)(entry.dstX + entry.width) / m_width, (float)(entry.dstY + entry.height) / m_height);
+	}
+	for ( int f = 0; f < numFonts; f ++ ) {
+		fonts[f]->UseTexture(m_uiTexture);
+	}
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		GetTexture
+ @Return		GLuint		The atlas texture
+ @Description	Returns the atlas' GL texture
+******************************************************************************/
+GLuint
+UIGlyphAtlas::GetTexture()
+{
+	return m_uiTexture;
+}
+
+/*!****************************************************************************
+ @Function		GetWidth
+ @Return		int		Width of the atlas
+ @Description	Returns the width of the atlas texture
+******************************************************************************/
+int
+UIGlyphAtlas::GetWidth()
+{
+	return m_width;
+}
+
+/*!****************************************************************************
+ @Function		GetHeight
+ @Return		int		Height of the atlas
+ @Description	Returns the height of the atlas texture
+******************************************************************************/
+int
+UIGlyphAtlas::GetHeight()
+{
+	return m_height;
+}
+
+/*!****************************************************************************
+ @Function		Delete
+ @Description	Frees the atlas texture
+******************************************************************************/
+void
+UIGlyphAtlas::Delete()
+{
+	if (m_uiTexture != 0) {
+		glDeleteTextures(1, &m_uiTexture);
+		m_uiTexture = 0;
+	}
+	m_width = 0;
+	m_height = 0;
+}
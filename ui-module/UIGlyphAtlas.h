@@ -0,0 +1,46 @@
+/******************************************************************************
+ @File          UIGlyphAtlas.h
+ @Title         UIGlyphAtlas Header File
+ @Author        Siddharth Hathi
+ @Description   Header file for the UIGlyphAtlas class.
+******************************************************************************/
+
+#include "OGLES2Tools.h"
+#include "UIGlyphFont.h"
+
+#ifndef _UIGLYPHATLAS_H
+#define _UIGLYPHATLAS_H
+
+// Width of the combined atlas and the padding left around every glyph
+const int c_glyphAtlasWidth = 1024;
+const int c_glyphAtlasPadding = 1;
+
+/*!****************************************************************************
+ @class UIGlyphAtlas
+ Object class. A UIGlyphAtlas packs the glyphs of several UIGlyphFonts into a
+ single 8 bit alpha texture. Each font keeps its own metrics, but its glyphs'
+ texture coordinates are remapped into the atlas and it draws from the atlas'
+ texture, so text in any font can be drawn without switching textures (and can
+ share a UITextBatch draw). Only the glyph rectangles are copied, which leaves
+ out the unused space in the individual font textures.
+******************************************************************************/
+class UIGlyphAtlas
+{
+	protected:
+		// Instance variables
+
+		// The atlas texture and its dimensions
+		GLuint m_uiTexture;
+		int m_width, m_height;
+
+	public:
+		// Exported functions
+		UIGlyphAtlas();
+		bool Build(UIGlyphFont** fonts, int numFonts, CPVRTString* const pErrorStr);
+		GLuint GetTexture();
+		int GetWidth();
+		int GetHeight();
+		void Delete();
+};
+
+#endif
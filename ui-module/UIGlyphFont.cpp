@@ -0,0 +1,443 @@
+/******************************************************************************
+ @File          UIGlyphFont.cpp
+ @Title         UIGlyphFont
+ @Author        Siddharth Hathi
+ @Description   Implements the UIGlyphFont object class defined in UIGlyphFont.h
+******************************************************************************/
+
+#include "UIGlyphFont.h"
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes an empty font
+******************************************************************************/
+UIGlyphFont::UIGlyphFont()
+{
+	for ( int i = 0; i < c_numGlyphCodes; i ++ ) {
+		m_glyphs[i].valid = false;
+	}
+	m_spaceWidth = 0;
+	m_lineHeight = 0;
+	m_ascent = 0;
+	m_texWidth = 0;
+	m_texHeight = 0;
+	m_pixels = NULL;
+	m_pvrData = NULL;
+	m_uiTexture = 0;
+	m_ownsTexture = false;
+}
+
+/*!****************************************************************************
+ @Function		Load
+ @Input			pvrData		Pointer to a PVR v3 font texture in memory
+ @Output		pErrorStr	Error message on failure
+ @Description	Reads the font's glyph metrics out of the texture's meta data.
+				The texture itself is loaded separately, either by LoadTexture
+				or by packing the font into a UIGlyphAtlas. The data must stay
+				in memory for as long as the font is used.
+******************************************************************************/
+bool
+UIGlyphFont::Load(const void* pvrData, CPVRTString* const pErrorStr)
+{
+	const PVRTuint32* header = (const PVRTuint32*)pvrData;
+	if (header == NULL || header[0] != c_pvrV3Identifier) {
+		*pErrorStr = "ERROR: UIGlyphFont expects a PVR v3 font texture";
+		return false;
+	}
+
+	if (!parseMetaData(header, pErrorStr)) {
+		return false;
+	}
+	m_pvrData = pvrData;
+
+	// The pixels can only be repacked if they're uncompressed 8 bit alpha
+	// ('a' 8 pixel format, one surface, one face)
+	m_pixels = NULL;
+	if (header[2] == 0x61 && header[3] == 0x8 && header[9] == 1 && header[10] == 1) {
+		m_pixels = (const PVRTuint8*)(header + c_pvrV3HeaderWords) + header[12];
+	}
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		LoadTexture
+ @Output		pErrorStr	Error message on failure
+ @Description	Loads the font's own texture into graphics memory
+******************************************************************************/
+bool
+UIGlyphFont::LoadTexture(CPVRTString* const pErrorStr)
+{
+	if (m_pvrData == NULL) {
+		*pErrorStr = "ERROR: UIGlyphFont texture loaded before the font";
+		return false;
+	}
+	if (PVRTTextureLoadFromPointer(m_pvrData, &m_uiTexture, NULL, true, 0, NULL, NULL) != PVR_SUCCESS) {
+		*pErrorStr = "ERROR: UIGlyphFont failed to load font texture";
+		return false;
+	}
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	m_ownsTexture = true;
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		Measure
+ @Output		width		Pointer to the width of the text
+ @Output		height		Pointer to the height of the text
+ @Input			scale		Text scale
+ @Input			text		The text being measured
+ @Description	Measures a single line of text. Matches CPVRTPrint3D::MeasureText
+******************************************************************************/
+void
+UIGlyphFont::Measure(float* width, float* height, float scale, const char* text)
+{
+	float length = 0;
+	if (text != NULL) {
+		for ( int i = 0; text[i] != '\0'; i ++ ) {
+			const UIGlyph* glyph = GetGlyph(text[i]);
+			if (glyph == NULL) {
+				length += m_spaceWidth;
+			} else {
+				length += glyph->advance + kerning(text[i], text[i + 1]);
+			}
+		}
+	}
+	*width = length * scale;
+	*height = m_lineHeight * scale;
+}
+
+/*!****************************************************************************
+ @Function		Layout
+ @Input			x, y		Position of the center of the text
+ @Input			scale		Text scale
+ @Input			text		The text being laid out
+ @Output		vertices	Four vertices per glyph quad
+ @Input			maxQuads	Capacity of the vertex array in quads
+ @Return		int			Number of quads written
+ @Description	Lays out a line of text centered on (x, y), the same way that
+				UIPrinter::Print positions text
+******************************************************************************/
+int
+UIGlyphFont::Layout(float x, float y, float scale, const char* text, UIGlyphVertex* vertices, int maxQuads)
+{
+	if (text == NULL) {
+		return 0;
+	}
+	float width, height;
+	Measure(&width, &height, scale, text);
+	return LayoutRun(x - width/2, y + height/2, scale, text, strlen(text), vertices, maxQuads, NULL);
+}
+
+/*!****************************************************************************
+ @Function		LayoutRun
+ @Input			penX		Left edge of the run
+ @Input			top			Top of the line the run sits on
+ @Input			scale		Text scale
+ @Input			text		The characters being laid out
+ @Input			length		Number of characters to lay out
+ @Output		vertices	Four vertices per glyph quad
+ @Input			maxQuads	Capacity of the vertex array in quads
+ @Output		endX		Pen position after the run (may be NULL)
+ @Return		int			Number of quads written
+ @Description	Lays out a run of characters from a given pen position. Quads
+				are wound counter-clockwise in y-up pixel coordinates (top left,
+				top right, bottom left, bottom right).
+******************************************************************************/
+int
+UIGlyphFont::LayoutRun(float penX, float top, float scale, const char* text, int length,
+	UIGlyphVertex* vertices, int maxQuads, float* endX)
+{
+	int numQuads = 0;
+	for ( int i = 0; i < length; i ++ ) {
+		const UIGlyph* glyph = GetGlyph(text[i]);
+		if (glyph == NULL) {
+			penX += m_spaceWidth * scale;
+			continue;
+		}
+		if (numQuads >= maxQuads) {
+			break;
+		}
+
+		float left = penX + glyph->xOffset * scale;
+		float right = left + glyph->width * scale;
+		float glyphTop = top - glyph->yOffset * scale;
+		float bottom = glyphTop - glyph->height * scale;
+
+		UIGlyphVertex* quad = &vertices[4 * numQuads];
+		quad[0].x = left;	quad[0].y = glyphTop;	quad[0].u = glyph->u0;	quad[0].v = glyph->v0;
+		quad[1].x = right;	quad[1].y = glyphTop;	quad[1].u = glyph->u1;	quad[1].v = glyph->v0;
+		quad[2].x = left;	quad[2].y = bottom;		quad[2].u = glyph->u0;	quad[2].v = glyph->v1;
+		quad[3].x = right;	quad[3].y = bottom;		quad[3].u = glyph->u1;	quad[3].v = glyph->v1;
+		numQuads ++;
+
+		char next = (i + 1 < length) ? text[i + 1] : '\0';
+		penX += (glyph->advance + kerning(text[i], next)) * scale;
+	}
+	if (endX != NULL) {
+		*endX = penX;
+	}
+	return numQuads;
+}
+
+/*!****************************************************************************
+ @Function		GetGlyph
+ @Input			c			Character code
+ @Return		UIGlyph*	The glyph's metrics, NULL if the font doesn't have it
+ @Description	Looks up a glyph. Characters without glyphs render as spaces
+******************************************************************************/
+const UIGlyph*
+UIGlyphFont::GetGlyph(char c)
+{
+	unsigned char code = (unsigned char)c;
+	if (code >= c_numGlyphCodes || !m_glyphs[code].valid) {
+		return NULL;
+	}
+	return &m_glyphs[code];
+}
+
+/*!****************************************************************************
+ @Function		GetLineHeight
+ @Return		float	Unscaled height of a line of text
+ @Description	Returns the font's line height
+******************************************************************************/
+float
+UIGlyphFont::GetLineHeight()
+{
+	return m_lineHeight;
+}
+
+/*!****************************************************************************
+ @Function		GetSpaceWidth
+ @Return		float	Unscaled width of a space
+ @Description	Returns the width of a space character
+******************************************************************************/
+float
+UIGlyphFont::GetSpaceWidth()
+{
+	return m_spaceWidth;
+}
+
+/*!****************************************************************************
+ @Function		GetTexture
+ @Return		GLuint	The font's texture
+ @Description	Returns the font's GL texture
+******************************************************************************/
+GLuint
+UIGlyphFont::GetTexture()
+{
+	return m_uiTexture;
+}
+
+/*!****************************************************************************
+ @Function		GetPixels
+ @Return		PVRTuint8*	The font's 8 bit alpha pixels, NULL if the
+							texture is in any other format
+ @Description	Returns the font's pixels so that they can be packed into a
+				UIGlyphAtlas
+******************************************************************************/
+const PVRTuint8*
+UIGlyphFont::GetPixels()
+{
+	return m_pixels;
+}
+
+/*!****************************************************************************
+ @Function		GetTextureWidth
+ @Return		int		Width of the font's texture
+ @Description	Returns the width of the font's own texture
+******************************************************************************/
+int
+UIGlyphFont::GetTextureWidth()
+{
+	return m_texWidth;
+}
+
+/*!****************************************************************************
+ @Function		GetTextureHeight
+ @Return		int		Height of the font's texture
+ @Description	Returns the height of the font's own texture
+******************************************************************************/
+int
+UIGlyphFont::GetTextureHeight()
+{
+	return m_texHeight;
+}
+
+/*!****************************************************************************
+ @Function		RemapGlyph
+ @Input			c					Character code
+ @Input			u0, v0, u1, v1		New texture coordinates of the glyph
+ @Description	Points a glyph at its location in a UIGlyphAtlas
+******************************************************************************/
+void
+UIGlyphFont::RemapGlyph(char c, float u0, float v0, float u1, float v1)
+{
+	unsigned char code = (unsigned char)c;
+	if (code >= c_numGlyphCodes) {
+		return;
+	}
+	m_glyphs[code].u0 = u0;
+	m_glyphs[code].v0 = v0;
+	m_glyphs[code].u1 = u1;
+	m_glyphs[code].v1 = v1;
+}
+
+/*!****************************************************************************
+ @Function		UseTexture
+ @Input			texture		A texture owned by someone else
+ @Description	Makes the font draw from a shared texture (a UIGlyphAtlas),
+				freeing its own texture if it had one
+******************************************************************************/
+void
+UIGlyphFont::UseTexture(GLuint texture)
+{
+	if (m_ownsTexture && m_uiTexture != 0) {
+		glDeleteTextures(1, &m_uiTexture);
+	}
+	m_uiTexture = texture;
+	m_ownsTexture = false;
+}
+
+/*!****************************************************************************
+ @Function		Delete
+ @Description	Frees the font's texture if it owns it
+******************************************************************************/
+void
+UIGlyphFont::Delete()
+{
+	if (m_ownsTexture && m_uiTexture != 0) {
+		glDeleteTextures(1, &m_uiTexture);
+	}
+	m_uiTexture = 0;
+	m_ownsTexture = false;
+	m_kerning.Clear();
+}
+
+/*!****************************************************************************
+ @Function		parseMetaData
+ @Input			header		Pointer to the PVR v3 header of the font texture
+ @Output		pErrorStr	Error message on failure
+ @Description	HELPER - walks the texture's meta data blocks and builds the
+				glyph table from the font header, character list, rectangles,
+				metrics, y offsets and kerning blocks
+******************************************************************************/
+bool
+UIGlyphFont::parseMetaData(const PVRTuint32* header, CPVRTString* const pErrorStr)
+{
+	m_texHeight = header[6];
+	m_texWidth = header[7];
+	PVRTuint32 metaDataSize = header[12];
+
+	const PVRTuint8* block = (const PVRTuint8*)(header + c_pvrV3HeaderWords);
+	const PVRTuint8* end = block + metaDataSize;
+
+	const PVRTuint8* fontHeader = NULL;
+	const PVRTuint32* charList = NULL;
+	const PVRTint32* rects = NULL;
+	const PVRTint16* metrics = NULL;
+	const PVRTint32* yOffsets = NULL;
+	const PVRTuint8* kerningData = NULL;
+	PVRTuint32 kerningSize = 0;
+
+	while (block + 3 * sizeof(PVRTuint32) <= end) {
+		const PVRTuint32* blockHeader = (const PVRTuint32*)block;
+		PVRTuint32 key = blockHeader[1];
+		PVRTuint32 dataSize = blockHeader[2];
+		const PVRTuint8* data = block + 3 * sizeof(PVRTuint32);
+		switch (key) {
+			case c_pvrFontHeader:
+				fontHeader = data;
+				break;
+			case c_pvrFontCharList:
+				charList = (const PVRTuint32*)data;
+				break;
+			case c_pvrFontRects:
+				rects = (const PVRTint32*)data;
+				break;
+			case c_pvrFontMetrics:
+				metrics = (const PVRTint16*)data;
+				break;
+			case c_pvrFontYOffsets:
+				yOffsets = (const PVRTint32*)data;
+				break;
+			case c_pvrFontKerning:
+				kerningData = data;
+				kerningSize = dataSize;
+				break;
+			default:
+				break;
+		}
+		block = data + dataSize;
+	}
+
+	if (fontHeader == NULL || charList == NULL || rects == NULL || metrics == NULL || yOffsets == NULL) {
+		*pErrorStr = "ERROR: UIGlyphFont texture is missing font meta data";
+		return false;
+	}
+
+	// Font header: version, space width, character count, kerning pair count,
+	// ascent, line spacing and border width
+	PVRTint16 numChars, numKerningPairs, ascent, lineSpace;
+	m_spaceWidth = fontHeader[1];
+	memcpy(&numChars, fontHeader + 2, sizeof(PVRTint16));
+	memcpy(&numKerningPairs, fontHeader + 4, sizeof(PVRTint16));
+	memcpy(&ascent, fontHeader + 6, sizeof(PVRTint16));
+	memcpy(&lineSpace, fontHeader + 8, sizeof(PVRTint16));
+	m_ascent = ascent;
+	m_lineHeight = lineSpace;
+
+	for ( int i = 0; i < numChars; i ++ ) {
+		if (charList[i] >= (PVRTuint32)c_numGlyphCodes) {
+			continue;
+		}
+		UIGlyph* glyph = &m_glyphs[charList[i]];
+		const PVRTint32* rect = &rects[4 * i];
+		glyph->u0 = (float)rect[0] / m_texWidth;
+		glyph->v0 = (float)rect[1] / m_texHeight;
+		glyph->u1 = (float)(rect[0] + rect[2]) / m_texWidth;
+		glyph->v1 = (float)(rect[1] + rect[3]) / m_texHeight;
+		glyph->width = rect[2];
+		glyph->height = rect[3];
+		glyph->xOffset = metrics[2 * i];
+		glyph->advance = (PVRTuint16)metrics[2 * i + 1];
+		glyph->yOffset = yOffsets[i];
+		glyph->valid = true;
+	}
+
+	m_kerning.Clear();
+	if (kerningData != NULL && numKerningPairs > 0) {
+		// Each pair is a 64 bit character pair followed by a 32 bit offset
+		PVRTuint32 stride = kerningSize / numKerningPairs;
+		for ( int i = 0; i < numKerningPairs; i ++ ) {
+			PVRTuint64 pair;
+			PVRTint32 offset;
+			memcpy(&pair, kerningData + i * stride, sizeof(pair));
+			memcpy(&offset, kerningData + i * stride + sizeof(pair), sizeof(offset));
+			UIKerningPair kerningPair = { (PVRTuint32)(pair >> 32), (PVRTuint32)(pair & 0xFFFFFFFF), (float)offset };
+			m_kerning.Append(kerningPair);
+		}
+	}
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		kerning
+ @Input			first, second	Consecutive characters
+ @Return		float			Unscaled kerning offset between them
+ @Description	HELPER - returns the kerning adjustment for a character pair
+******************************************************************************/
+float
+UIGlyphFont::kerning(char first, char second)
+{
+	if (second == '\0') {
+		return 0;
+	}
+	for ( int i = 0; i < (int)m_kerning.GetSize(); i ++ ) {
+		if (m_kerning[i].first == (PVRTuint32)(unsigned char)first
+			&& m_kerning[i].second == (PVRTuint32)(unsigned char)second) {
+			return m_kerning[i].offset;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,115 @@
+/******************************************************************************
+ @File          UIGlyphFont.h
+ @Title         UIGlyphFont Header File
+ @Author        Siddharth Hathi
+ @Description   Header file for the UIGlyphFont class.
+******************************************************************************/
+
+#include "OGLES2Tools.h"
+
+#ifndef _UIGLYPHFONT_H
+#define _UIGLYPHFONT_H
+
+// PVR v3 texture identifier and header size (in 32 bit words)
+const PVRTuint32 c_pvrV3Identifier = 0x03525650;
+const int c_pvrV3HeaderWords = 13;
+
+// Meta data keys written into font textures by the PVR font tools
+// (these match the keys read by CPVRTPrint3D)
+const PVRTuint32 c_pvrFontHeader = 0xFCFC0050;
+const PVRTuint32 c_pvrFontCharList = 0xFCFC0051;
+const PVRTuint32 c_pvrFontRects = 0xFCFC0052;
+const PVRTuint32 c_pvrFontMetrics = 0xFCFC0053;
+const PVRTuint32 c_pvrFontYOffsets = 0xFCFC0054;
+const PVRTuint32 c_pvrFontKerning = 0xFCFC0055;
+
+// Number of character codes the glyph table covers (ASCII)
+const int c_numGlyphCodes = 128;
+
+// Maximum number of quads laid out into a single text run
+const int c_maxTextQuads = 128;
+
+// Vertex format used by all glyph based text
+struct UIGlyphVertex {
+	float x, y;
+	float u, v;
+};
+
+// Metrics and texture coordinates of a single glyph
+struct UIGlyph {
+	float u0, v0, u1, v1;
+	float width, height;
+	float xOffset, yOffset;
+	float advance;
+	bool valid;
+};
+
+// Kerning adjustment between two characters
+struct UIKerningPair {
+	PVRTuint32 first, second;
+	float offset;
+};
+
+/*!****************************************************************************
+ @class UIGlyphFont
+ Object class. A UIGlyphFont reads the glyph metrics that the PVR font tools
+ embed in a font texture and uses them to lay text out into glyph quads. It is
+ the UIKit's own alternative to the layout done inside CPVRTPrint3D: the quads
+ it produces can be cached in vertex buffers and redrawn every frame without
+ walking the string again. Text is laid out in the same pixel coordinate space
+ as UIPrinter::Print, centered on the requested position.
+******************************************************************************/
+class UIGlyphFont
+{
+	protected:
+		// Instance variables
+
+		// Glyph table indexed by character code
+		UIGlyph m_glyphs[c_numGlyphCodes];
+
+		// Kerning pairs defined by the font
+		CPVRTArray<UIKerningPair> m_kerning;
+
+		// Font wide metrics
+		float m_spaceWidth, m_lineHeight, m_ascent;
+
+		// Dimensions of the font texture
+		int m_texWidth, m_texHeight;
+
+		// The font's pixels within the PVR data (NULL if they aren't 8 bit alpha)
+		const PVRTuint8* m_pixels;
+
+		// Source PVR data
+		const void* m_pvrData;
+
+		// The font's GL texture, and whether the font created it (as opposed
+		// to sharing a UIGlyphAtlas' texture)
+		GLuint m_uiTexture;
+		bool m_ownsTexture;
+
+		// Local functions
+		bool parseMetaData(const PVRTuint32* header, CPVRTString* const pErrorStr);
+		float kerning(char first, char second);
+
+	public:
+		// Exported functions
+		UIGlyphFont();
+		bool Load(const void* pvrData, CPVRTString* const pErrorStr);
+		bool LoadTexture(CPVRTString* const pErrorStr);
+		void Measure(float* width, float* height, float scale, const char* text);
+		int Layout(float x, float y, float scale, const char* text, UIGlyphVertex* vertices, int maxQuads);
+		int LayoutRun(float penX, float top, float scale, const char* text, int length,
+			UIGlyphVertex* vertices, int maxQuads, float* endX);
+		const UIGlyph* GetGlyph(char c);
+		float GetLineHeight();
+		float GetSpaceWidth();
+		GLuint GetTexture();
+		const PVRTuint8* GetPixels();
+		int GetTextureWidth();
+		int GetTextureHeight();
+		void RemapGlyph(char c, float u0, float v0, float u1, float v1);
+		void UseTexture(GLuint texture);
+		void Delete();
+};
+
+#endif
@@ -6,6 +6,7 @@
 ******************************************************************************/
 
 #include "UIImage.h"
+#include "UISpriteBatch.h"
 
 /*!****************************************************************************
  @Function		Constructor
@@ -15,17 +16,8 @@
 UIImage::UIImage()
 {
     m_texName = NULL;
-    m_x = 0;
-    m_y = 0;
-    m_width = 0;
-    m_height = 0;
-    m_scale = {1, 1, 1};
-	m_hidden = false;
-
-    m_uiImgTex = 0;
-    m_uiVbo = 0;
-    m_uiOpaqueIndexVbo = 0;
-    m_iNumOpaque = 0;
+	m_sprite = c_noSprite;
+	m_generation = 0;
 }
 
 /*!****************************************************************************
@@ -40,18 +32,15 @@ UIImage::UIImage()
 ******************************************************************************/
 UIImage::UIImage(const char* textureName, float x, float y, float width, float height)
 {
+	UISpriteStore* store = UISpriteStore::Get();
+
     m_texName = textureName;
-    m_x = x;
-    m_y = y;
-    m_width = width;
-    m_height = height;
-    m_scale = {1, 1, 1};
-	m_hidden = false;
-
-    m_uiImgTex = 0;
-    m_uiVbo = 0;
-    m_uiOpaqueIndexVbo = 0;
-    m_iNumOpaque = 0;
+	m_sprite = store->Allocate();
+	m_generation = 0;
+	if (m_sprite != c_noSprite) {
+		m_generation = store->GetGeneration(m_sprite);
+		store->SetRect(m_sprite, x, y, width, height);
+	}
 }
 
 /*!****************************************************************************
@@ -67,10 +56,17 @@ UIImage::LoadTextures(CPVRTString* const pErrorStr)
 		fprintf(stderr, "NULL texture\n");
         return false;
     }
+	if (!valid()) {
+		// The UISpriteStore was full when the image was constructed
+		fprintf(stderr, "UIImage %s has no sprite, the UISpriteStore is full\n", m_texName);
+		*pErrorStr = "ERROR: UIImage has no sprite, the UISpriteStore is full";
+		return false;
+	}
 
     char* filename = (char*)malloc(strlen(m_texName) + strlen("../../../assets/") + 1);
     sprintf(filename, "../../../assets/%s", m_texName);
-	if (loadTextureFromFilename(filename, &m_uiImgTex, NULL) != true) {
+	GLuint texture = 0;
+	if (loadTextureFromFilename(filename, &texture, NULL) != true) {
 		//fprintf(stderr, "ERROR: Failed to load texture\n");
 		*pErrorStr = "ERROR: Failed to load texture";
     	free(filename);
@@ -78,236 +74,106 @@ UIImage::LoadTextures(CPVRTString* const pErrorStr)
 		return false;
 	}
     free(filename);
+	UISpriteStore::Get()->SetTexture(m_sprite, texture);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
     return true;
-
-    return true;
 }
 
 /*!****************************************************************************
  @Function		BuildVertices
- @Description	Creates and defines the vertices and vbos used that define the
-				shape of the image.
+ @Description	Makes sure the quad the image is drawn with exists. Images
+				showing their whole texture share the UISpriteStore's unit
+				quad; the others get one of their own. An image without a
+				sprite has already failed LoadTextures, and is reported again
+				here since BuildVertices can't fail.
 ******************************************************************************/
 void
 UIImage::BuildVertices()
 {
-	int i, row, col;
-	float dim = 0.5f; //initialise vertices to normalised size, can then also be used as uv coorda and scales up after
-	PVRTVec3 normal = PVRTVec3(0.0f, 1.0f, 0.0f); //all the normals are the same
-
-    /* The images are made up of 16 vertices, 9 quads, 18 triangles. The four colours of the center vertices are fully opaque while all the 
-	outside vertices are fully transparent. This produces a thin fade out at the edges which avoids antialiasing.
-	0--1------2--3
-	|  |      |  |
-	4--5------6--7
-	|  |      |  |
-	|  |      |  |
-	|  |      |  |
-	8--9-----10--11
-	|  |      |  |
-	12-13----14--15
-    */
-
-    m_vertices[0].p	=	PVRTVec3(-dim, dim, 0);
-	m_vertices[1].p	=	PVRTVec3(-dim, dim, 0); 
-	m_vertices[2].p	=	PVRTVec3(dim, dim, 0);
-	m_vertices[3].p	=	PVRTVec3(dim, dim, 0);
-	m_vertices[4].p	=	PVRTVec3(-dim, dim, 0);
-	m_vertices[5].p	=	PVRTVec3(-dim, dim, 0); 
-	m_vertices[6].p	=	PVRTVec3(dim, dim, 0);
-	m_vertices[7].p	=	PVRTVec3(dim, -dim, 0);
-	m_vertices[8].p	=	PVRTVec3(-dim, -dim, 0);
-	m_vertices[9].p	=	PVRTVec3(-dim, -dim, 0); 
-	m_vertices[10].p	=	PVRTVec3(dim, -dim, 0);
-	m_vertices[11].p	=	PVRTVec3(dim, -dim, 0);
-	m_vertices[12].p	=	PVRTVec3(-dim, -dim, 0);
-	m_vertices[13].p	=	PVRTVec3(-dim, -dim, 0); 
-	m_vertices[14].p	=	PVRTVec3(dim, -dim, 0);
-	m_vertices[15].p	=	PVRTVec3(dim, -dim, 0);
-
-    for(i = 0; i < 16; ++i)
-	{
-		m_vertices[i].n = normal;
-		m_vertices[i].c = PVRTVec4(1.0f, 1.0f, 1.0f, 0.0f);
-
-		//the uvs are matched to the positions (+0.5 for range 0-1)
-		m_vertices[i].t.x = m_vertices[i].p.x + 0.5f;
-		m_vertices[i].t.y = m_vertices[i].p.y + 0.5f;
-
-		//scale up to desired size
-		// m_vertices[i].p.x *= m_width;
-		// m_vertices[i].p.y *= m_height;
-
-	//	m_vertices[i].p.z = 1;
-	}
-	
-	//only the center 4 vertices are fully opaque all the rest around the edge are tranparent
-	m_vertices[5].c.w = 1.0f;
-	m_vertices[6].c.w = 1.0f;
-	m_vertices[9].c.w = 1.0f;
-	m_vertices[10].c.w = 1.0f;
-
-
-	//create indices for the 2 triangles for every square
-	m_iNumOpaque = 0;
-	//m_iNumBlend = 0;
-
-	for(row = 0; row < 3; ++row)
-	{
-		for(col = 0; col < 3; ++col)
-		{
-			int start = (row*4)+col;
-			//the centre indices are kept in a separate buffer to the border ones as they are going
-			//to be drawn in 2 separate passes. 
-			if(row==1 && col == 1)
-			{
-				m_indicesOpaque[m_iNumOpaque++] = (unsigned short) start+1;
-				m_indicesOpaque[m_iNumOpaque++] = (unsigned short) start;
-				m_indicesOpaque[m_iNumOpaque++] = (unsigned short) start+4;
-				m_indicesOpaque[m_iNumOpaque++] = (unsigned short) start+1;
-				m_indicesOpaque[m_iNumOpaque++] = (unsigned short) start+4;
-				m_indicesOpaque[m_iNumOpaque++] = (unsigned short) start+5;
-			}
+	if (!valid()) {
+		if (m_texName != NULL) {
+			fprintf(stderr, "UIImage %s has no sprite and won't be drawn\n", m_texName);
 		}
+		return;
 	}
+	UISpriteStore::Get()->BuildQuad(m_sprite);
+
 	// Enable culling
 	glEnable(GL_CULL_FACE);
-
-	m_iNumOpaque *= 2;
-
-	//create the vertex points for the mirrored cover.
-	for(row = 0; row < 4; ++row)
-	{
-		//the colours on the flip vertices are going to fade out the further away from the mirror they are
-		// using the y coordinate of the coverpoints 
-		float dark = 1 - ((m_vertices[(row*4)].p.y/m_height)+ 0.5f);
-		dark -= 0.5f; //made a little darker in the reflection to mimic properties of dull mirror
-
-		for(col = 0; col < 4; ++col)
-		{
-			//copy the vertices with y values reversed for the mirrored equivalents
-			m_vertices[((row*4)+col) + 16] = m_vertices[((row*4)+col)];
-			m_vertices[((row*4)+col) + 16].p.y *= -1.f;
-			// m_coverPoints[((row*4)+col) + 16].p.y -= (height + heightFromMirror);
-
-			m_vertices[((row*4)+col) + 16].c.x = dark;
-			m_vertices[((row*4)+col) + 16].c.y = dark;
-			m_vertices[((row*4)+col) + 16].c.z = dark;
-		}
-	}
-
-	glGenBuffers(1, &m_uiVbo);
-	glBindBuffer(GL_ARRAY_BUFFER, m_uiVbo);
-	glBufferData(GL_ARRAY_BUFFER, 32 * sizeof(SVertex), m_vertices, GL_STATIC_DRAW);
-
-	glGenBuffers(1, &m_uiOpaqueIndexVbo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_uiOpaqueIndexVbo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, 2*m_iNumOpaque, m_indicesOpaque, GL_STATIC_DRAW);
-	
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
 }
 
 /*!****************************************************************************
  @Function		Draw
  @Input			uiMVPMatrixLoc	GLuint reference to the shader Matrix
- @Input			rotate			Is the display side projected?
  @Description	Draws the image with the appropriate vertices and textures,
-                with the correct positions and scales. Switches coordinate
-				axes if rotate parameter is true
+                with the correct positions and scales. The image works in
+				pixel coordinates only; the root transform shared by every
+				image (set up by UIPrinter::SetViewport) takes them to the
+				screen, rotating them if the display is side projected.
 ******************************************************************************/
 void
-UIImage::Draw(GLuint uiMVPMatrixLoc, bool rotate)
+UIImage::Draw(GLuint uiMVPMatrixLoc)
 {
-	GLint viewport[4];
-    GLint vWidth;                           // Viewport width
-    GLint vHeight;                          // Viewport height
-	glGetIntegerv(GL_VIEWPORT, viewport);
-
-    if (viewport != NULL) {
-        vWidth = viewport[2];
-        vHeight = viewport[3];
-    } else {
-        // Default values
-        vWidth = 1280;
-        vHeight = 720;
-    }
-
 	// Unless the image is hidden
-	if (m_hidden) {
+	PVRTMat4 mMVP;
+	if (!GetMVP(&mMVP)) {
 		return;
 	}
 
-	// float yOffset;
-	// if (rotate) {
-	// 	if (m_y > 0) {
-	// 		yOffset = 200;
-	// 	} else if (m_y < 0) {
-	// 		yOffset = -200;
-	// 	} else {
-	// 		yOffset = 0;
-	// 	}
-	// }
-
-    PVRTVec3 pos;
-    // Scales pixel coordinates to device normalized coordinates,
-	// rotates coordinate axes if asked to
-	if (!rotate) {
-		pos.x = m_x/(vWidth/2);
-		pos.y = (m_y)/(vHeight/2);
-	} else {
-		//fprintf(stderr, "Image rotated\n");
-		pos.x = -(m_y)/(vWidth/2);
-		pos.y = m_x/(vHeight/2);
-	}
-	pos.z = 0;
-
-    // Builds scaling, sizing, and translation matrices
-	PVRTMat4 mTrans, mScale, mSize, mRotation;
-	PVRTMatrixTranslation(mTrans, pos.x, pos.y, pos.z);
-    mScale = PVRTMat4::Scale(m_scale);
-	if (rotate) {
-		mScale = PVRTMat4::Scale({m_scale.y, m_scale.x, m_scale.z});
-	}
-
-    mSize = PVRTMat4::Scale({m_width/(vWidth/2), m_height/(vHeight/2), 1});
-	if (rotate) {
-    	mSize = PVRTMat4::Scale({m_height/(vWidth/2), m_width/(vHeight/2), 1});
-	}
-	mRotation = PVRTMat4::RotationZ(0);
-	if (rotate) {
-		mRotation = PVRTMat4::RotationZ(-M_PI/2);
-	}
-
-    // Applies scaling and translations
-	PVRTMat4 mModelView, mMVP;
-	mModelView =  mTrans * mScale * mSize * mRotation;
-	mMVP = mModelView;
-
-
 	glUniformMatrix4fv(uiMVPMatrixLoc, 1, GL_FALSE, mMVP.f);
 		
-	glBindTexture(GL_TEXTURE_2D, m_uiImgTex);
+	glBindTexture(GL_TEXTURE_2D, GetTexture());
 
     DrawMesh();
 }
 
+/*!****************************************************************************
+ @Function		GetMVP
+ @Output		mvp			The image's model view projection matrix
+ @Return		bool		False if the image is hidden or has no sprite
+ @Description	Builds the matrix that takes the image's unit quad to the
+				screen, through the root transform
+******************************************************************************/
+bool
+UIImage::GetMVP(PVRTMat4* mvp)
+{
+	UISpriteStore* store = UISpriteStore::Get();
+	if (!valid() || !store->GetVisible()[m_sprite]) {
+		return false;
+	}
+	float x = store->GetX()[m_sprite];
+	float y = store->GetY()[m_sprite];
+	float width = store->GetWidth()[m_sprite] * store->GetScaleX()[m_sprite];
+	float height = store->GetHeight()[m_sprite] * store->GetScaleY()[m_sprite];
+
+	// MVP = root * translation(x, y) * scale(width, height). The model
+	// matrix only scales and translates in x and y, so the product is the
+	// root's columns scaled and summed rather than a full matrix multiply
+	const PVRTMat4& mRoot = *store->GetProjection();
+	*mvp = mRoot;
+	for ( int i = 0; i < 4; i ++ ) {
+		mvp->f[i] = mRoot.f[i] * width;
+		mvp->f[4 + i] = mRoot.f[4 + i] * height;
+		mvp->f[12 + i] = mRoot.f[i] * x + mRoot.f[4 + i] * y + mRoot.f[12 + i];
+	}
+	return true;
+}
+
 /*!****************************************************************************
  @Function		DrawMesh
- @Description	Draws the vertex mesh given the pregenerated vertex buffers
+ @Description	Draws the image's quad given the pregenerated vertex buffers
 ******************************************************************************/
 void
 UIImage::DrawMesh()
 {
+	UISpriteStore* store = UISpriteStore::Get();
 	int stride = sizeof(SVertex);
 
 	// bind the VBO for the mesh
-	glBindBuffer(GL_ARRAY_BUFFER, m_uiVbo);
+	glBindBuffer(GL_ARRAY_BUFFER, store->GetQuadVbo(m_sprite));
 
 	// Set the vertex attribute offsest
 	glVertexAttribPointer(IVERTEX_ARRAY, 3, GL_FLOAT, GL_FALSE, stride, 0);
@@ -315,9 +181,8 @@ UIImage::DrawMesh()
 	glVertexAttribPointer(ICOLOR_ARRAY, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)ColorOffset);
 	glVertexAttribPointer(ITEXCOORD_ARRAY, 2, GL_FLOAT, GL_FALSE, stride, (GLvoid*)TexCoordOffset);
 	
-	//firstly draw the opaque quad in the center
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_uiOpaqueIndexVbo);
-	glDrawElements(GL_TRIANGLES, m_iNumOpaque, GL_UNSIGNED_SHORT, 0);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, store->GetQuadIndexVbo());
+	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, 0);
 }
 
 /*!****************************************************************************
@@ -328,12 +193,22 @@ UIImage::DrawMesh()
 bool
 UIImage::Render(GLuint uiMVPMatrixLoc)
 {
+	// While a UISpriteBatch is capturing, it draws the image on its next
+	// flush instead
+	UISpriteBatch* batch = UISpriteBatch::GetCapturing();
+	if (batch != NULL) {
+		if (valid() && UISpriteStore::Get()->GetVisible()[m_sprite]) {
+			batch->Queue(m_sprite);
+		}
+		return true;
+	}
+
     glEnableVertexAttribArray(IVERTEX_ARRAY);
 	glEnableVertexAttribArray(INORMAL_ARRAY);
 	glEnableVertexAttribArray(ICOLOR_ARRAY);
 	glEnableVertexAttribArray(ITEXCOORD_ARRAY);
 
-    Draw(uiMVPMatrixLoc, false);
+    Draw(uiMVPMatrixLoc);
 
     // unbind the vertex buffers as we don't need them bound anymore
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -355,23 +230,7 @@ UIImage::Render(GLuint uiMVPMatrixLoc)
 bool
 UIImage::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 {
-    glEnableVertexAttribArray(IVERTEX_ARRAY);
-	glEnableVertexAttribArray(INORMAL_ARRAY);
-	glEnableVertexAttribArray(ICOLOR_ARRAY);
-	glEnableVertexAttribArray(ITEXCOORD_ARRAY);
-
-    Draw(uiMVPMatrixLoc, printer->Rotated());
-
-    // unbind the vertex buffers as we don't need them bound anymore
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-	glDisableVertexAttribArray(IVERTEX_ARRAY);
-	glDisableVertexAttribArray(INORMAL_ARRAY);
-	glDisableVertexAttribArray(ICOLOR_ARRAY);
-	glDisableVertexAttribArray(ITEXCOORD_ARRAY);
-
-	return true;
+	return Render(uiMVPMatrixLoc);
 }
 
 /*!****************************************************************************
@@ -415,14 +274,39 @@ UIImage::Update(UIMessage updateMessage)
 PVRTVec2
 UIImage::GetPosition()
 {
-    return {m_x, m_y};
+	if (!valid()) {
+		return {0, 0};
+	}
+	UISpriteStore* store = UISpriteStore::Get();
+    return {store->GetX()[m_sprite], store->GetY()[m_sprite]};
 }
 
-
+/*!****************************************************************************
+ @Function		GetSize
+ @Description	Returns image dimensions as 2d vector
+******************************************************************************/
 PVRTVec2
 UIImage::GetSize()
 {
-	return {m_width, m_height};
+	if (!valid()) {
+		return {0, 0};
+	}
+	UISpriteStore* store = UISpriteStore::Get();
+	return {store->GetWidth()[m_sprite], store->GetHeight()[m_sprite]};
+}
+
+/*!****************************************************************************
+ @Function		GetTexture
+ @Return		GLuint		The image's GL texture (0 if not loaded)
+ @Description	Returns the texture the image draws with
+******************************************************************************/
+GLuint
+UIImage::GetTexture()
+{
+	if (!valid()) {
+		return 0;
+	}
+	return UISpriteStore::Get()->GetTextures()[m_sprite];
 }
 
 /*!****************************************************************************
@@ -434,8 +318,11 @@ UIImage::GetSize()
 void
 UIImage::Move(float x, float y)
 {
-    m_x += x;
-    m_y += y;
+	if (!valid()) {
+		return;
+	}
+	UISpriteStore* store = UISpriteStore::Get();
+	store->SetPosition(m_sprite, store->GetX()[m_sprite] + x, store->GetY()[m_sprite] + y);
 }
 
 /*!****************************************************************************
@@ -447,15 +334,41 @@ UIImage::Move(float x, float y)
 void
 UIImage::SetPosition(float x, float y)
 {
-    m_x = x;
-    m_y = y;
+	if (valid()) {
+		UISpriteStore* store = UISpriteStore::Get();
+		UIAnimator::Get()->Cancel(&store->GetX()[m_sprite]);
+		UIAnimator::Get()->Cancel(&store->GetY()[m_sprite]);
+		store->SetPosition(m_sprite, x, y);
+	}
 }
 
+/*!****************************************************************************
+ @Function		SetSize
+ @Input         width      new width of the image
+ @Input         height     new height of the image
+ @Description	Resizes the image
+******************************************************************************/
 void
 UIImage::SetSize(float width, float height)
 {
-	m_width = width;
-	m_height = height;
+	if (valid()) {
+		UISpriteStore::Get()->SetSize(m_sprite, width, height);
+	}
+}
+
+/*!****************************************************************************
+ @Function		SetTexCoords
+ @Input			u0, v0		Texture coordinates of the image's bottom left
+ @Input			u1, v1		Texture coordinates of the image's top right
+ @Description	Sets the part of the texture the image shows (the whole
+				texture by default). Must be called before BuildVertices.
+******************************************************************************/
+void
+UIImage::SetTexCoords(float u0, float v0, float u1, float v1)
+{
+	if (valid()) {
+		UISpriteStore::Get()->SetTexCoords(m_sprite, u0, v0, u1, v1);
+	}
 }
 
 /*!****************************************************************************
@@ -468,29 +381,72 @@ UIImage::SetSize(float width, float height)
 void
 UIImage::Scale(float scaleX, float scaleY, float scaleZ)
 {
-    m_scale = {scaleX, scaleY, scaleZ};
+	// Images are flat, so scaleZ has no effect
+	if (valid()) {
+		UISpriteStore* store = UISpriteStore::Get();
+		UIAnimator::Get()->Cancel(&store->GetScaleX()[m_sprite]);
+		UIAnimator::Get()->Cancel(&store->GetScaleY()[m_sprite]);
+		store->SetScale(m_sprite, scaleX, scaleY);
+	}
+}
+
+/*!****************************************************************************
+ @Function		AnimateTo
+ @Input			x, y		Position the image ends at
+ @Input			duration	Length of the animation in seconds
+ @Input			easing		Easing curve
+ @Description	Slides the image from where it is to a new position. The
+				UIAnimator moves it a step each frame; SetPosition stops it.
+******************************************************************************/
+void
+UIImage::AnimateTo(float x, float y, float duration, UIEasing easing)
+{
+	if (valid()) {
+		UISpriteStore* store = UISpriteStore::Get();
+		UIAnimator::Get()->Tween(&store->GetX()[m_sprite], x, duration, easing);
+		UIAnimator::Get()->Tween(&store->GetY()[m_sprite], y, duration, easing);
+	}
+}
+
+/*!****************************************************************************
+ @Function		AnimateScale
+ @Input			scaleX, scaleY	Scale the image ends at
+ @Input			duration		Length of the animation in seconds
+ @Input			easing			Easing curve
+ @Description	Grows or shrinks the image from its current scale. The
+				UIAnimator scales it a step each frame; Scale stops it.
+******************************************************************************/
+void
+UIImage::AnimateScale(float scaleX, float scaleY, float duration, UIEasing easing)
+{
+	if (valid()) {
+		UISpriteStore* store = UISpriteStore::Get();
+		UIAnimator::Get()->Tween(&store->GetScaleX()[m_sprite], scaleX, duration, easing);
+		UIAnimator::Get()->Tween(&store->GetScaleY()[m_sprite], scaleY, duration, easing);
+	}
 }
 
 /*!****************************************************************************
  @Function		GetProjection
- @Return		The image's projection matrix
- @Description	Returns the projection matrix
+ @Return		The images' projection matrix
+ @Description	Returns the projection matrix shared by every image: the root
+				transform from pixel to device coordinates
 ******************************************************************************/
 PVRTMat4*
 UIImage::GetProjection()
 {
-	return &m_mProjection;
+	return UISpriteStore::Get()->GetProjection();
 }
 
 /*!****************************************************************************
  @Function		GetView
- @Return		The image's view matrix
- @Description	Returns the view matrix
+ @Return		The images' view matrix
+ @Description	Returns the view matrix shared by every image
 ******************************************************************************/
 PVRTMat4*
 UIImage::GetView()
 {
-	return &m_mView;
+	return UISpriteStore::Get()->GetView();
 }
 
 /*!****************************************************************************
@@ -500,7 +456,9 @@ UIImage::GetView()
 void
 UIImage::Hide()
 {
-	m_hidden = true;
+	if (valid()) {
+		UISpriteStore::Get()->SetVisible(m_sprite, false);
+	}
 }
 
 /*!****************************************************************************
@@ -510,7 +468,9 @@ UIImage::Hide()
 void
 UIImage::Show()
 {
-	m_hidden = false;
+	if (valid()) {
+		UISpriteStore::Get()->SetVisible(m_sprite, true);
+	}
 }
 
 /*!****************************************************************************
@@ -524,6 +484,28 @@ UIImage::Text()
 	return false;
 }
 
+/*!****************************************************************************
+ @Function		GetSprite
+ @Return 		int		Index of the image's sprite (c_noSprite if it has none)
+ @Description	Returns the image's index into the UISpriteStore
+******************************************************************************/
+int
+UIImage::GetSprite()
+{
+	return valid() ? m_sprite : c_noSprite;
+}
+
+/*!****************************************************************************
+ @Function		valid
+ @Return 		bool	Does the image refer to a live sprite?
+ @Description	HELPER - checks the image's handle into the UISpriteStore
+******************************************************************************/
+bool
+UIImage::valid()
+{
+	return UISpriteStore::Get()->IsValid(m_sprite, m_generation);
+}
+
 /*!****************************************************************************
  @Function		loadTextureFromFile
  @Input			pvr			Pointer to the pvr file	
@@ -566,10 +548,21 @@ UIImage::loadTextureFromFilename(char* filename, GLuint* texture, PVR_Texture_He
 
 /*!****************************************************************************
  @Function		Delete
- @Description	UIImage has no allocated memory - therefore Delete does nothing
+ @Description	Stops the image's animations and releases its sprite, freeing
+				its texture and quad. Copies of the image are left without a
+				sprite.
 ******************************************************************************/
 void
 UIImage::Delete()
 {
-	return;
+	if (valid()) {
+		UISpriteStore* store = UISpriteStore::Get();
+		UIAnimator* animator = UIAnimator::Get();
+		animator->Cancel(&store->GetX()[m_sprite]);
+		animator->Cancel(&store->GetY()[m_sprite]);
+		animator->Cancel(&store->GetScaleX()[m_sprite]);
+		animator->Cancel(&store->GetScaleY()[m_sprite]);
+		store->Release(m_sprite);
+	}
+	m_sprite = c_noSprite;
 }
\ No newline at end of file
@@ -9,6 +9,8 @@
 #include "OGLES2Tools.h"
 #include "../file.h"
 #include "UIElement.h"
+#include "UISpriteStore.h"
+#include "UIAnimator.h"
 
 #include <stdio.h>
 #include <stddef.h>
@@ -47,46 +49,25 @@ const unsigned int TexCoordOffset = ColorOffset+(unsigned int)sizeof(PVRTVec4);
  user-defined, and dynamic heights, widths, positions, and textures. The UIImage 
  respresents an evolution on the original StaticImage class in that it supports 
  pixel coordinate specifications and dynamic frame-by-frame scaling and movement.
+ The image's data lives in the UISpriteStore; a UIImage is a handle to its
+ sprite, so copies of an image refer to the same sprite. A default constructed
+ image has no sprite and ignores every call.
 ******************************************************************************/
 class UIImage : public UIElement
 {
     protected:
 		// Instance variables
 
-		// Address of the image's texture in graphic memory
-		GLuint  m_uiImgTex;
-
-		// Address of the image's vertex buffer
-        GLuint	m_uiVbo;
-
-		// Address of image's opaque vertex buffer
-        GLuint	m_uiOpaqueIndexVbo;
-
-		// Array of image's vertices
-        SVertex m_vertices[32];
-		
-		// Array of Image's opaque vertices
-        unsigned short m_indicesOpaque[12];
-
-		// Number of opaque vertices
-	    int m_iNumOpaque;
-
-		// Image's projection and view matrices
-        PVRTMat4		m_mProjection, m_mView;
-
 		// Name of the image's texture
 		const char* m_texName;
 
-		// Image's position and dimensions
-		float m_x, m_y, m_width, m_height;
-
-		// Image scaling matrix
-        PVRTVec3 m_scale;
-
-		// Is the image hidden
-		bool m_hidden;
+		// Handle into the UISpriteStore, which holds the image's texture,
+		// position, size, scale, texture coordinates and visibility
+		int m_sprite;
+		PVRTuint16 m_generation;
 
 		// Local Function
+		bool valid();
         bool loadTextureFromFile(FILE* pvr, GLuint* texture, PVR_Texture_Header* header);
 		bool loadTextureFromFilename(char* filename, GLuint* texture, PVR_Texture_Header* header);
 
@@ -100,11 +81,16 @@ class UIImage : public UIElement
 		PVRTMat4* GetView();
 		PVRTVec2 GetPosition();
 		PVRTVec2 GetSize();
+		GLuint GetTexture();
+		bool GetMVP(PVRTMat4* mvp);
         void Move(float x, float y);
 		void SetPosition(float x, float y);
 		void SetSize(float width, float height);
+		void SetTexCoords(float u0, float v0, float u1, float v1);
         void Scale(float scaleX, float scaleY, float scaleZ);
-        virtual void Draw(GLuint uiMVPMatrixLoc, bool rotate);
+		void AnimateTo(float x, float y, float duration, UIEasing easing);
+		void AnimateScale(float scaleX, float scaleY, float duration, UIEasing easing);
+        virtual void Draw(GLuint uiMVPMatrixLoc);
 		void DrawMesh();
 		bool Render(GLuint uiMVPMatrixLoc);
         virtual bool Render(GLuint uiMVPMatrixLoc, UIPrinter* printer);
@@ -113,6 +99,7 @@ class UIImage : public UIElement
 		virtual void Hide();
 		virtual void Show();
 		bool Text();
+		int GetSprite();
 		virtual void Delete();
         
 };
@@ -0,0 +1,131 @@
+/******************************************************************************
+ @File          UILayoutDSL.h
+ @Title         UILayoutDSL Header File
+ @Author        Siddharth Hathi
+ @Description   constexpr helpers used to compute fixed layouts at compile
+				time.
+******************************************************************************/
+
+#ifndef _UILAYOUTDSL_H
+#define _UILAYOUTDSL_H
+
+/*
+ * Layouts that never change at runtime are written with these helpers so that
+ * their pixel rects, texture coordinates and text anchors are worked out by the
+ * compiler. The results are constexpr, so views just read them at startup and
+ * layouts can be checked with static_assert (see UIContains).
+ *
+ * Rects use the UIKit's pixel coordinates: x and y are the center of the rect,
+ * relative to the center of the screen, with y pointing up.
+ */
+
+// A rect in pixel coordinates
+struct UIRect {
+	float x, y, width, height;
+};
+
+// A rect in texture coordinates
+struct UIUVRect {
+	float u0, v0, u1, v1;
+};
+
+// A point in pixel coordinates
+struct UIPoint {
+	float x, y;
+};
+
+// A sprite of a fixed layout: the element it belongs to, where it is drawn
+// and the part of its texture it shows
+struct UISpriteCommand {
+	int element;
+	UIRect rect;
+	UIUVRect uv;
+};
+
+// Texture coordinates covering a whole texture
+constexpr UIUVRect c_fullUV = { 0.0f, 0.0f, 1.0f, 1.0f };
+
+// Edges of a rect
+constexpr float UILeft(UIRect r) { return r.x - r.width / 2; }
+constexpr float UIRight(UIRect r) { return r.x + r.width / 2; }
+constexpr float UITop(UIRect r) { return r.y + r.height / 2; }
+constexpr float UIBottom(UIRect r) { return r.y - r.height / 2; }
+
+// Center of a rect, used as the anchor of centered text
+constexpr UIPoint UICenter(UIRect r) { return UIPoint{ r.x, r.y }; }
+
+// A rect shrunk by dx on the left and right and by dy on the top and bottom
+constexpr UIRect
+UIInset(UIRect r, float dx, float dy)
+{
+	return UIRect{ r.x, r.y, r.width - 2 * dx, r.height - 2 * dy };
+}
+
+// A rect of the given size whose center is offset from another rect's center
+constexpr UIRect
+UIOffset(UIRect r, float dx, float dy, float width, float height)
+{
+	return UIRect{ r.x + dx, r.y + dy, width, height };
+}
+
+// Does outer fully contain inner?
+constexpr bool
+UIContains(UIRect outer, UIRect inner)
+{
+	return UILeft(inner) >= UILeft(outer) && UIRight(inner) <= UIRight(outer)
+		&& UIBottom(inner) >= UIBottom(outer) && UITop(inner) <= UITop(outer);
+}
+
+// Offset of slot index from the left of a row of slots with the given widths
+constexpr float UIRowOffset(int, float) { return 0; }
+template <typename... Widths>
+constexpr float
+UIRowOffset(int index, float gap, float width, Widths... widths)
+{
+	return index <= 0 ? 0 : width + gap + UIRowOffset(index - 1, gap, widths...);
+}
+
+// Width of slot index in a row of slots with the given widths
+constexpr float UIRowWidth(int) { return 0; }
+template <typename... Widths>
+constexpr float
+UIRowWidth(int index, float width, Widths... widths)
+{
+	return index == 0 ? width : UIRowWidth(index - 1, widths...);
+}
+
+// Total width of a row of slots with the given widths
+constexpr float UIRowTotal(float gap) { return -gap; }
+template <typename... Widths>
+constexpr float
+UIRowTotal(float gap, float width, Widths... widths)
+{
+	return width + gap + UIRowTotal(gap, widths...);
+}
+
+// Rect of slot index in a row of slots laid out left to right from the left
+// edge of row, separated by gap pixels. Slots take the row's height.
+template <typename... Widths>
+constexpr UIRect
+UIRowSlot(UIRect row, float gap, int index, Widths... widths)
+{
+	return UIRect{ UILeft(row) + UIRowOffset(index, gap, widths...) + UIRowWidth(index, widths...) / 2,
+		row.y, UIRowWidth(index, widths...), row.height };
+}
+
+// Texture coordinates of a pixel rect within a texture, with y measured from
+// the texture's v = 0 edge
+constexpr UIUVRect
+UITexelUV(float x, float y, float width, float height, float texWidth, float texHeight)
+{
+	return UIUVRect{ x / texWidth, y / texHeight, (x + width) / texWidth, (y + height) / texHeight };
+}
+
+// A sprite command showing a whole texture unless told otherwise
+constexpr UISpriteCommand
+UISprite(int element, UIRect rect, UIUVRect uv = c_fullUV)
+{
+	return UISpriteCommand{ element, rect, uv };
+}
+
+#endif
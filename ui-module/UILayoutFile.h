@@ -0,0 +1,90 @@
+/******************************************************************************
+ @File          UILayoutFile.h
+ @Title         UILayoutFile Header File
+ @Author        Siddharth Hathi
+ @Description   Defines the binary layout format read by UILayoutView and
+				written by tools/UILayoutCompiler. Only uses fixed size types
+				so that it can be shared with the offline tools.
+******************************************************************************/
+
+#include <stdint.h>
+
+#ifndef _UILAYOUTFILE_H
+#define _UILAYOUTFILE_H
+
+// File identifier ("UILY" read as a little endian word) and format version
+const uint32_t c_layoutMagic = 0x594C4955;
+const uint16_t c_layoutVersion = 2;
+
+// Marks a record without a parent, a string or an update key
+const uint8_t c_layoutNoParent = 0xFF;
+const uint32_t c_layoutNoString = 0xFFFFFFFF;
+const int16_t c_layoutNoKey = -1;
+
+// Maximum number of records in a layout (parents are stored in a byte)
+const int c_maxLayoutRecords = 255;
+
+// Record flags
+const uint16_t c_layoutFlagHidden = 0x0001;
+
+// Element types a record can describe
+enum UILayoutType {
+	UILImage,
+	UILButton,
+	UILTextBlock,
+	UILStaticText,
+	UILProgressBar,
+	UILCompositeView,
+	UILBadges,
+	UILWorkoutView,
+	UILNumTypes
+};
+
+// File header. The records follow it directly and the string table follows
+// the records. Records store message keys as numbers, so the header carries
+// the UIFrameSchema() of the compiler and layouts compiled against other keys
+// are rejected.
+struct UILayoutHeader {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t numRecords;
+	uint32_t schema;
+	uint32_t stateMask;
+	uint32_t stringsOffset;
+	uint32_t stringsSize;
+};
+
+/*
+ * A single element. Which fields are used depends on the type:
+ *
+ *   UILImage			texture, x, y, width, height
+ *   UILButton			text, x, y, color (active), secondaryColor (inactive),
+ *						updateKey (UIBool)
+ *   UILTextBlock		secondaryText, font, secondaryFont, x, y, color,
+ *						updateKey (UITextType)
+ *   UILStaticText		text, x, y, scale, color, font, updateKey (UITextType,
+ *						children of composite views only)
+ *   UILProgressBar		texture, secondaryTexture, x, y, width, height,
+ *						insetX, insetY, value (initial completion)
+ *   UILCompositeView	texture (may be none), x, y, width, height
+ *   UILBadges			x, y
+ *   UILWorkoutView		updateKey (starting UIWorkoutStage)
+ *
+ * Records with a parent are children of the composite view record at that
+ * index and are positioned relative to it. Strings are byte offsets into the
+ * string table.
+ */
+struct UILayoutRecord {
+	uint8_t type;
+	uint8_t parent;
+	uint8_t font, secondaryFont;
+	int16_t updateKey;
+	uint16_t flags;
+	float x, y, width, height;
+	float scale, insetX, insetY, value;
+	uint32_t color, secondaryColor;
+	uint32_t texture, secondaryTexture;
+	uint32_t text, secondaryText;
+};
+
+#endif
@@ -0,0 +1,446 @@
+/******************************************************************************
+ @File          UILayoutView.cpp
+ @Title         UILayoutView
+ @Author        Siddharth Hathi
+ @Description   Implements the UILayoutView object class defined in UILayoutView.h
+******************************************************************************/
+
+#include "UILayoutView.h"
+#include "UIDispatcher.h"
+#include "UIStateTable.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*!****************************************************************************
+ @Function		layoutString
+ @Input			strings			The layout's string table
+ @Input			stringsSize		Size of the string table
+ @Input			offset			Offset of the string in the table
+ @Output		str				The string (NULL for c_layoutNoString)
+ @Return		bool			Is the offset valid?
+ @Description	Looks a string up in the layout's string table. The table is
+				checked to end with a terminator on load, so any offset inside
+				it gives a terminated string.
+******************************************************************************/
+static bool
+layoutString(const char* strings, PVRTuint32 stringsSize, PVRTuint32 offset, char** str)
+{
+	if (offset == c_layoutNoString) {
+		*str = NULL;
+		return true;
+	}
+	if (offset >= stringsSize) {
+		return false;
+	}
+	*str = (char*) strings + offset;
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		layoutKeysValid
+ @Input			record		A layout record
+ @Return		bool		Are the record's key and fonts in range?
+ @Description	Checks the update key and fonts of a record against the enums
+				they are cast to, so a corrupt layout can't index the message
+				key arrays out of bounds
+******************************************************************************/
+static bool
+layoutKeysValid(const UILayoutRecord& record)
+{
+	if (record.font >= UINumFonts || record.secondaryFont >= UINumFonts) {
+		return false;
+	}
+	int key = record.updateKey;
+	switch (record.type) {
+		case UILButton:			return key >= 0 && key < UINumBools;
+		case UILTextBlock:		return key >= 0 && key <= UINone;
+		case UILStaticText:		return key == c_layoutNoKey || (key >= 0 && key <= UINone);
+		case UILWorkoutView:	return key >= 0 && key < UINumWorkoutStages;
+		default:				return true;
+	}
+}
+
+/*!****************************************************************************
+ @Function		layoutFootprint
+ @Input			record		A layout record
+ @Return		size_t		Arena space the record's element takes
+ @Description	Returns the arena space needed by a record. Children of
+				composite views are owned by their parent and take none.
+******************************************************************************/
+static size_t
+layoutFootprint(const UILayoutRecord& record)
+{
+	if (record.parent != c_layoutNoParent) {
+		return 0;
+	}
+	switch (record.type) {
+		case UILImage:			return UIArenaSize<UIImage>(1);
+		case UILButton:			return UIArenaSize<UIButton>(1);
+		case UILTextBlock:		return UIArenaSize<UITextBlock>(1);
+		case UILStaticText:		return UIArenaSize<UIStaticText>(1);
+		case UILProgressBar:	return UIArenaSize<UIProgressBar>(1);
+		case UILCompositeView:	return UIArenaSize<UICompositeView>(1);
+		case UILBadges:			return UIArenaSize<UIBadges>(1);
+		case UILWorkoutView:	return UIArenaSize<UIPWorkoutView>(1);
+		default:				return 0;
+	}
+}
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes an empty, hidden view
+******************************************************************************/
+UILayoutView::UILayoutView()
+{
+	m_elements = NULL;
+	m_numElements = 0;
+	m_mapping = NULL;
+	m_mappingSize = 0;
+	m_stateMask = 0;
+	m_hidden = true;
+	m_stateSlot = -1;
+}
+
+/*!****************************************************************************
+ @Function		Load
+ @Input			path			Path of the binary layout file
+ @Output		pErrorStr		Error message on failure
+ @Return		bool			Was the layout loaded?
+ @Description	Maps the layout file and builds the view's elements from its
+				records. Textures still have to be loaded with LoadTextures.
+******************************************************************************/
+bool
+UILayoutView::Load(const char* path, CPVRTString* const pErrorStr)
+{
+	Delete();
+
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		*pErrorStr = "ERROR: UILayoutView could not open layout";
+		fprintf(stderr, "UILayoutView could not open %s\n", path);
+		return false;
+	}
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size < (off_t) sizeof(UILayoutHeader)) {
+		close(fd);
+		*pErrorStr = "ERROR: UILayoutView layout too small";
+		fprintf(stderr, "UILayoutView layout %s too small\n", path);
+		return false;
+	}
+	m_mappingSize = fileStat.st_size;
+	m_mapping = mmap(NULL, m_mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (m_mapping == MAP_FAILED) {
+		m_mapping = NULL;
+		*pErrorStr = "ERROR: UILayoutView could not map layout";
+		fprintf(stderr, "UILayoutView could not map %s\n", path);
+		return false;
+	}
+
+	// Validate the header and the table bounds before reading any records
+	const char* data = (const char*) m_mapping;
+	const UILayoutHeader* header = (const UILayoutHeader*) data;
+	size_t recordsEnd = sizeof(UILayoutHeader) + header->numRecords * sizeof(UILayoutRecord);
+	if (header->magic != c_layoutMagic || header->version != c_layoutVersion
+		|| header->schema != UIFrameSchema() || header->numRecords > c_maxLayoutRecords || recordsEnd > m_mappingSize
+		|| header->stringsOffset < recordsEnd || header->stringsSize == 0
+		|| header->stringsOffset + (size_t) header->stringsSize > m_mappingSize
+		|| data[header->stringsOffset + header->stringsSize - 1] != '\0') {
+		*pErrorStr = "ERROR: UILayoutView invalid layout";
+		fprintf(stderr, "UILayoutView invalid layout %s\n", path);
+		Delete();
+		return false;
+	}
+	const UILayoutRecord* records = (const UILayoutRecord*) (data + sizeof(UILayoutHeader));
+	const char* strings = data + header->stringsOffset;
+	int numRecords = header->numRecords;
+	m_stateMask = header->stateMask;
+
+	size_t arenaSize = UIArenaArraySize<UIElement*>(numRecords);
+	for ( int i = 0; i < numRecords; i ++ ) {
+		arenaSize += layoutFootprint(records[i]);
+	}
+	m_arena.Init(arenaSize);
+	m_elements = m_arena.AllocArray<UIElement*>(numRecords);
+
+	// Elements by record index, used to find the parents of child records
+	UIElement* created[c_maxLayoutRecords];
+	for ( int i = 0; i < numRecords; i ++ ) {
+		const UILayoutRecord& record = records[i];
+		created[i] = NULL;
+		if (!layoutKeysValid(record)) {
+			*pErrorStr = "ERROR: UILayoutView record key or font out of range";
+			fprintf(stderr, "UILayoutView record %d of %s has an invalid key or font\n", i, path);
+			Delete();
+			return false;
+		}
+		if (record.parent == c_layoutNoParent) {
+			created[i] = createElement(record, strings, header->stringsSize, pErrorStr);
+			if (created[i] == NULL) {
+				Delete();
+				return false;
+			}
+			if (record.flags & c_layoutFlagHidden) {
+				created[i]->Hide();
+			}
+			m_elements[m_numElements ++] = created[i];
+		} else {
+			if (record.parent >= i || records[record.parent].type != UILCompositeView
+				|| records[record.parent].parent != c_layoutNoParent) {
+				*pErrorStr = "ERROR: UILayoutView child record without a composite view parent";
+				Delete();
+				return false;
+			}
+			if (!addChild((UICompositeView*) created[record.parent], record, strings,
+				header->stringsSize, pErrorStr)) {
+				Delete();
+				return false;
+			}
+		}
+	}
+	m_hidden = false;
+	UIDispatcher::Get()->Subscribe(this, UIFieldState);
+	m_stateSlot = UIStateTable::Get()->Register(m_stateMask);
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		LoadTextures
+ @Output		pErrorStr		Pointer to the string returned on error
+ @Description	Loads the object's textures into graphics memory
+******************************************************************************/
+bool
+UILayoutView::LoadTextures(CPVRTString* const pErrorStr)
+{
+	for ( int i = 0; i < m_numElements; i ++ ) {
+		if (!m_elements[i]->LoadTextures(pErrorStr)) {
+			fprintf(stderr, "UILayoutView element %d texture failed to load\n", i);
+			return false;
+		}
+	}
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		BuildVertices
+ @Description	Builds the object's vertex buffers
+******************************************************************************/
+void
+UILayoutView::BuildVertices()
+{
+	for ( int i = 0; i < m_numElements; i ++ ) {
+		m_elements[i]->BuildVertices();
+	}
+}
+
+/*!****************************************************************************
+ @Function		Render
+ @Input			uiMVPMatrixLoc		Address of the shader's MVP matrix
+ @Input			printer				UIPrinter object used to display text
+ @Description	Renders the object using gl
+******************************************************************************/
+bool
+UILayoutView::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
+{
+	if (m_hidden || !UIStateTable::Get()->IsVisible(m_stateSlot)) {
+		return true;
+	}
+	for ( int i = 0; i < m_numElements; i ++ ) {
+		if (!m_elements[i]->Render(uiMVPMatrixLoc, printer)) {
+			fprintf(stderr, "UILayoutView element %d render failed\n", i);
+		}
+	}
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		Update
+ @Input			updateMessage		UIMessage object containing frame info
+ @Description	Passes the message on to the elements if the view is shown:
+				not hidden, and the UIStateTable shows it in the current state
+				(one of those in the layout's state mask)
+******************************************************************************/
+void
+UILayoutView::Update(UIMessage updateMessage)
+{
+	UIStateTable::Get()->SetState(updateMessage.ReadState());
+	// During a dispatch the elements are updated by the UIDispatcher
+	if (m_hidden || !UIStateTable::Get()->IsVisible(m_stateSlot) || UIDispatcher::Get()->IsDispatching()) {
+		return;
+	}
+	for ( int i = 0; i < m_numElements; i ++ ) {
+		m_elements[i]->Update(updateMessage);
+	}
+}
+
+/*!****************************************************************************
+ @Function		Hide
+ @Description	Makes object hidden
+******************************************************************************/
+void
+UILayoutView::Hide()
+{
+	m_hidden = true;
+}
+
+/*!****************************************************************************
+ @Function		Show
+ @Description	Makes object visibile
+******************************************************************************/
+void
+UILayoutView::Show()
+{
+	m_hidden = false;
+}
+
+/*!****************************************************************************
+ @Function		GetElementCount
+ @Return		int			Number of top level elements
+ @Description	Returns the number of top level elements in the view
+******************************************************************************/
+int
+UILayoutView::GetElementCount()
+{
+	return m_numElements;
+}
+
+/*!****************************************************************************
+ @Function		GetElement
+ @Input			index			Index of the element in layout order
+ @Return		UIElement*		The element (NULL if out of range)
+ @Description	Returns one of the view's top level elements
+******************************************************************************/
+UIElement*
+UILayoutView::GetElement(int index)
+{
+	if (index < 0 || index >= m_numElements) {
+		return NULL;
+	}
+	return m_elements[index];
+}
+
+/*!****************************************************************************
+ @Function		Delete
+ @Description	Frees the elements and unmaps the layout file
+******************************************************************************/
+void
+UILayoutView::Delete()
+{
+	UIDispatcher::Get()->Unsubscribe(this);
+	UIStateTable::Get()->Unregister(m_stateSlot);
+	m_stateSlot = -1;
+	for ( int i = 0; i < m_numElements; i ++ ) {
+		m_elements[i]->Delete();
+	}
+	m_arena.Delete();
+	m_elements = NULL;
+	m_numElements = 0;
+	if (m_mapping != NULL) {
+		munmap(m_mapping, m_mappingSize);
+		m_mapping = NULL;
+		m_mappingSize = 0;
+	}
+	m_hidden = true;
+}
+
+/*!****************************************************************************
+ @Function		createElement
+ @Input			record			A top level layout record
+ @Input			strings			The layout's string table
+ @Input			stringsSize		Size of the string table
+ @Output		pErrorStr		Error message on failure
+ @Return		UIElement*		The new element (NULL on failure)
+ @Description	HELPER - constructs the element a record describes in the arena
+******************************************************************************/
+UIElement*
+UILayoutView::createElement(const UILayoutRecord& record, const char* strings,
+	PVRTuint32 stringsSize, CPVRTString* const pErrorStr)
+{
+	char *texture, *secondaryTexture, *text, *secondaryText;
+	if (!layoutString(strings, stringsSize, record.texture, &texture)
+		|| !layoutString(strings, stringsSize, record.secondaryTexture, &secondaryTexture)
+		|| !layoutString(strings, stringsSize, record.text, &text)
+		|| !layoutString(strings, stringsSize, record.secondaryText, &secondaryText)) {
+		*pErrorStr = "ERROR: UILayoutView record string out of range";
+		return NULL;
+	}
+
+	UIElement* element = NULL;
+	switch (record.type) {
+		case UILImage:
+			element = m_arena.Create<UIImage>(texture, record.x, record.y, record.width, record.height);
+			break;
+		case UILButton:
+			element = m_arena.Create<UIButton>(text, record.x, record.y, (GLuint) record.color,
+				(GLuint) record.secondaryColor, (UIBool) record.updateKey);
+			break;
+		case UILTextBlock:
+			// By UITextBlock convention the main text starts as the constant "0"
+			element = m_arena.Create<UITextBlock>((char*) "0", secondaryText != NULL ? secondaryText : (char*) "",
+				(UIFont) record.font, (UIFont) record.secondaryFont, record.x, record.y,
+				(GLuint) record.color, (UITextType) record.updateKey);
+			break;
+		case UILStaticText:
+			element = m_arena.Create<UIStaticText>(text, record.x, record.y, record.scale,
+				(GLuint) record.color, (UIFont) record.font);
+			break;
+		case UILProgressBar:
+			element = m_arena.Create<UIProgressBar>(texture, secondaryTexture, record.x, record.y,
+				record.width, record.height, record.insetX, record.insetY, record.value);
+			break;
+		case UILCompositeView:
+			element = m_arena.Create<UICompositeView>(texture, record.x, record.y, record.width, record.height);
+			break;
+		case UILBadges:
+			element = m_arena.Create<UIBadges>(record.x, record.y);
+			break;
+		case UILWorkoutView:
+			element = m_arena.Create<UIPWorkoutView>((UIWorkoutStage) record.updateKey);
+			break;
+		default:
+			*pErrorStr = "ERROR: UILayoutView unknown record type";
+			return NULL;
+	}
+	if (element == NULL) {
+		*pErrorStr = "ERROR: UILayoutView failed to allocate element";
+	}
+	return element;
+}
+
+/*!****************************************************************************
+ @Function		addChild
+ @Input			parent			The composite view the record belongs to
+ @Input			record			A child layout record
+ @Input			strings			The layout's string table
+ @Input			stringsSize		Size of the string table
+ @Output		pErrorStr		Error message on failure
+ @Return		bool			Was the child added?
+ @Description	HELPER - adds an image or text child record to its composite
+				view. The composite view owns the child.
+******************************************************************************/
+bool
+UILayoutView::addChild(UICompositeView* parent, const UILayoutRecord& record, const char* strings,
+	PVRTuint32 stringsSize, CPVRTString* const pErrorStr)
+{
+	char *texture, *text;
+	if (!layoutString(strings, stringsSize, record.texture, &texture)
+		|| !layoutString(strings, stringsSize, record.text, &text)) {
+		*pErrorStr = "ERROR: UILayoutView record string out of range";
+		return false;
+	}
+	switch (record.type) {
+		case UILImage:
+			parent->AddImage(texture, record.x, record.y, record.width, record.height);
+			return true;
+		case UILStaticText:
+			parent->AddText(text, (GLuint) record.color, record.x, record.y, record.scale,
+				record.updateKey == c_layoutNoKey ? UINone : (UITextType) record.updateKey,
+				(UIFont) record.font);
+			return true;
+		default:
+			*pErrorStr = "ERROR: UILayoutView composite views can only hold image and text records";
+			return false;
+	}
+}
@@ -0,0 +1,81 @@
+/******************************************************************************
+ @File          UILayoutView.h
+ @Title         UILayoutView Header File
+ @Author        Siddharth Hathi
+ @Description   Header file for the UILayoutView class.
+******************************************************************************/
+
+#include "OGLES2Tools.h"
+#include "UIElement.h"
+#include "UIImage.h"
+#include "UIButton.h"
+#include "UITextBlock.h"
+#include "UIStaticText.h"
+#include "UIProgressBar.h"
+#include "UICompositeView.h"
+#include "UIBadges.h"
+#include "UIPWorkoutView.h"
+#include "UIArena.h"
+#include "UILayoutFile.h"
+#include "UIFrame.h"
+
+#ifndef _UILAYOUTVIEW_H
+#define _UILAYOUTVIEW_H
+
+/*!****************************************************************************
+ @class UILayoutView
+ Object class. A UILayoutView is a container UIElement whose children are
+ described by a binary layout file (see UILayoutFile.h) rather than by constant
+ layout specs compiled into the view. Load maps the file into memory and builds
+ the whole element tree in a single pass over its records, allocating the
+ children from the view's arena. The file stays mapped while the view is alive
+ since the elements keep pointers to its strings. The view is only shown in
+ the UIStates set in the layout's state mask.
+******************************************************************************/
+class UILayoutView : public UIElement
+{
+	protected:
+		// Instance variables
+
+		// Arena that owns the child elements and the element array
+		UIArena m_arena;
+
+		// Top level child elements
+		UIElement** m_elements;
+		int m_numElements;
+
+		// The mapped layout file
+		void* m_mapping;
+		size_t m_mappingSize;
+
+		// UIStates (as bits) in which the view is shown
+		PVRTuint32 m_stateMask;
+
+		// Is the view hidden?
+		bool m_hidden;
+
+		// Slot in the UIStateTable, registered with m_stateMask
+		int m_stateSlot;
+
+		// Local functions
+		UIElement* createElement(const UILayoutRecord& record, const char* strings,
+			PVRTuint32 stringsSize, CPVRTString* const pErrorStr);
+		bool addChild(UICompositeView* parent, const UILayoutRecord& record, const char* strings,
+			PVRTuint32 stringsSize, CPVRTString* const pErrorStr);
+
+	public:
+		// Exported functions
+		UILayoutView();
+		bool Load(const char* path, CPVRTString* const pErrorStr);
+		virtual bool LoadTextures(CPVRTString* const pErrorStr);
+		virtual void BuildVertices();
+		virtual bool Render(GLuint uiMVPMatrixLoc, UIPrinter* printer);
+		virtual void Update(UIMessage updateMessage);
+		virtual void Hide();
+		virtual void Show();
+		int GetElementCount();
+		UIElement* GetElement(int index);
+		virtual void Delete();
+};
+
+#endif
@@ -0,0 +1,150 @@
+/******************************************************************************
+ @File          UIMeasureCache.cpp
+ @Title         UIMeasureCache
+ @Author        Siddharth Hathi
+ @Description   Implements the UIMeasureCache object class defined in
+				UIMeasureCache.h
+******************************************************************************/
+
+#include "UIMeasureCache.h"
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes an empty cache
+******************************************************************************/
+UIMeasureCache::UIMeasureCache()
+{
+	Clear();
+}
+
+/*!****************************************************************************
+ @Function		Measure
+ @Input			print3D		The print3D object (font) used to measure the text
+ @Output		width		Pointer to the width of the text
+ @Output		height		Pointer to the height of the text
+ @Input			scale		Text scale
+ @Input			text		The text being measured
+ @Description	Returns the cached measurement of the text if there is one.
+				Otherwise the text is measured by print3D and the result is
+				stored, replacing the least recently used entry in its bucket.
+******************************************************************************/
+void
+UIMeasureCache::Measure(CPVRTPrint3D* print3D, float* width, float* height, float scale, const char* text)
+{
+	if (print3D == NULL || text == NULL) {
+		*width = 0;
+		*height = 0;
+		return;
+	}
+
+	int length;
+	unsigned int hash = hashKey(print3D, scale, text, &length);
+
+	// Strings that don't fit in an entry skip the cache
+	if (length >= c_measureCacheMaxText) {
+		m_misses ++;
+		print3D->MeasureText(width, height, scale, text);
+		return;
+	}
+
+	m_clock ++;
+	UIMeasureEntry* bucket = &m_entries[(hash & (c_measureCacheSets - 1)) * c_measureCacheWays];
+	UIMeasureEntry* victim = &bucket[0];
+	for ( int i = 0; i < c_measureCacheWays; i ++ ) {
+		UIMeasureEntry* entry = &bucket[i];
+		if (!entry->valid) {
+			victim = entry;
+			continue;
+		}
+		if (entry->hash == hash && entry->font == print3D && entry->scale == scale
+			&& strcmp(entry->text, text) == 0) {
+			entry->lastUse = m_clock;
+			*width = entry->width;
+			*height = entry->height;
+			m_hits ++;
+			return;
+		}
+		if (victim->valid && entry->lastUse < victim->lastUse) {
+			victim = entry;
+		}
+	}
+
+	m_misses ++;
+	print3D->MeasureText(width, height, scale, text);
+
+	victim->font = print3D;
+	victim->scale = scale;
+	victim->hash = hash;
+	victim->lastUse = m_clock;
+	victim->width = *width;
+	victim->height = *height;
+	memcpy(victim->text, text, length + 1);
+	victim->valid = true;
+}
+
+/*!****************************************************************************
+ @Function		Clear
+ @Description	Invalidates every entry in the cache. Must be called whenever
+				the fonts behind the cached print3D objects are reloaded.
+******************************************************************************/
+void
+UIMeasureCache::Clear()
+{
+	for ( int i = 0; i < c_measureCacheSets * c_measureCacheWays; i ++ ) {
+		m_entries[i].valid = false;
+		m_entries[i].lastUse = 0;
+	}
+	m_clock = 0;
+	m_hits = 0;
+	m_misses = 0;
+}
+
+/*!****************************************************************************
+ @Function		GetHits
+ @Return		unsigned int	Number of measurements served from the cache
+ @Description	Returns the cache hit count since the last Clear
+******************************************************************************/
+unsigned int
+UIMeasureCache::GetHits()
+{
+	return m_hits;
+}
+
+/*!****************************************************************************
+ @Function		GetMisses
+ @Return		unsigned int	Number of measurements that walked the glyphs
+ @Description	Returns the cache miss count since the last Clear
+******************************************************************************/
+unsigned int
+UIMeasureCache::GetMisses()
+{
+	return m_misses;
+}
+
+/*!****************************************************************************
+ @Function		hashKey
+ @Input			font		Font identifier
+ @Input			scale		Text scale
+ @Input			text		Text being hashed
+ @Output		length		Length of the text
+ @Return		unsigned int	Hash of the (font, scale, text) key
+ @Description	HELPER - FNV-1a hash of the text mixed with the font and scale
+******************************************************************************/
+unsigned int
+UIMeasureCache::hashKey(const void* font, float scale, const char* text, int* length)
+{
+	unsigned int hash = 2166136261u;
+	int i = 0;
+	for ( ; text[i] != '\0'; i ++ ) {
+		hash ^= (unsigned char)text[i];
+		hash *= 16777619u;
+	}
+	*length = i;
+
+	unsigned int scaleBits;
+	memcpy(&scaleBits, &scale, sizeof(scaleBits));
+	hash ^= scaleBits * 2654435761u;
+	hash ^= (unsigned int)((size_t)font >> 4);
+	hash ^= hash >> 16;
+	return hash;
+}
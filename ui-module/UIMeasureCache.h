@@ -0,0 +1,69 @@
+/******************************************************************************
+ @File          UIMeasureCache.h
+ @Title         UIMeasureCache Header File
+ @Author        Siddharth Hathi
+ @Description   Header file for the UIMeasureCache class.
+******************************************************************************/
+
+#include "OGLES2Tools.h"
+
+#ifndef _UIMEASURECACHE_H
+#define _UIMEASURECACHE_H
+
+// Number of hash buckets in the cache (must be a power of two)
+const int c_measureCacheSets = 16;
+
+// Number of entries per bucket. Eviction within a bucket is LRU
+const int c_measureCacheWays = 4;
+
+// Longest string (including terminator) that can be cached. Longer strings
+// are measured directly
+const int c_measureCacheMaxText = 32;
+
+// struct used to store one cached measurement
+struct UIMeasureEntry {
+	const void* font;
+	float scale;
+	unsigned int hash;
+	unsigned int lastUse;
+	float width, height;
+	char text[c_measureCacheMaxText];
+	bool valid;
+};
+
+/*!****************************************************************************
+ @class UIMeasureCache
+ Object class. A UIMeasureCache stores the results of CPVRTPrint3D::MeasureText
+ so that each distinct (font, scale, text) combination only has its glyphs
+ walked once. Entries live in a small set-associative hash table and the least
+ recently used entry of a bucket is evicted when the bucket is full. The font
+ is identified by its CPVRTPrint3D object, which lets both the UIPrinter and
+ the legacy Print2D classes share the cache.
+******************************************************************************/
+class UIMeasureCache
+{
+	protected:
+		// Instance variables
+
+		// Table of cached measurements, c_measureCacheWays entries per bucket
+		UIMeasureEntry m_entries[c_measureCacheSets * c_measureCacheWays];
+
+		// Counter used to timestamp entries for LRU eviction
+		unsigned int m_clock;
+
+		// Cache statistics
+		unsigned int m_hits, m_misses;
+
+		// Local functions
+		static unsigned int hashKey(const void* font, float scale, const char* text, int* length);
+
+	public:
+		// Exported functions
+		UIMeasureCache();
+		void Measure(CPVRTPrint3D* print3D, float* width, float* height, float scale, const char* text);
+		void Clear();
+		unsigned int GetHits();
+		unsigned int GetMisses();
+};
+
+#endif
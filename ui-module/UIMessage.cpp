@@ -12,40 +12,114 @@
 
 #include "UIMessage.h"
 
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes a message with no data
+******************************************************************************/
+UIMessage::UIMessage()
+{
+	m_floatMask = 0;
+	m_textMask = 0;
+	m_boolMask = 0;
+	m_boolValues = 0;
+	m_metricMask = 0;
+}
+
 /*!****************************************************************************
  @Function		Write
  @Input			key		Enum key for text data
  @Input			value	Text being stored
- @Description	Adds textual data to the corresponding data map
+ @Description	Copies textual data into the message's string blocks and
+				stores it in the key's slot. The caller keeps ownership of
+				value.
+******************************************************************************/
+void
+UIMessage::Write(UITextType key, const char* value)
+{
+	if (key < 0 || key >= UINone) {
+		return;
+	}
+	m_texts[key] = m_strings.Copy(value);
+	if (value != NULL) {
+		m_textMask |= 1u << key;
+	} else {
+		m_textMask &= ~(1u << key);
+	}
+}
+
+/*!****************************************************************************
+ @Function		Write
+ @Input			key		Enum key for text data
+ @Input			value	Shared text being stored
+ @Description	Stores a reference to text that is already in a string block,
+				without copying it. A null reference clears the key.
 ******************************************************************************/
 void
-UIMessage::Write(UITextType key, char* value)
+UIMessage::Write(UITextType key, const UIStringRef& value)
 {
-	m_sValueMap[key] = value;
+	if (key < 0 || key >= UINone) {
+		return;
+	}
+	m_texts[key] = value;
+	if (!value.IsNull()) {
+		m_textMask |= 1u << key;
+	} else {
+		m_textMask &= ~(1u << key);
+	}
 }
 
 /*!****************************************************************************
  @Function		Write
  @Input			key		Enum key for float data
  @Input			value	Float being stored
- @Description	Adds float data to the corresponding data map
+ @Description	Stores float data in the key's slot
 ******************************************************************************/
 void
 UIMessage::Write(UIFloat key, float value)
 {
-	m_fValueMap[key] = value;
+	if (key < 0 || key >= UINumFloats) {
+		return;
+	}
+	m_floats[key] = value;
+	m_floatMask |= 1u << key;
+}
+
+/*!****************************************************************************
+ @Function		Write
+ @Input			key		Enum key for numeric telemetry
+ @Input			value	Value being stored, in the metric's units
+ @Description	Stores a telemetry value as a number. Elements bound to the
+				metric format it themselves, so the app layer doesn't
+				allocate a string for it.
+******************************************************************************/
+void
+UIMessage::Write(UIMetric key, float value)
+{
+	if (key < 0 || key >= UIMNone) {
+		return;
+	}
+	m_metrics[key] = value;
+	m_metricMask |= 1u << key;
 }
 
 /*!****************************************************************************
  @Function		Write
  @Input			key		Enum key for boolean data
  @Input			value	Bool being stored
- @Description	Adds boolean data to the corresponding data map
+ @Description	Stores boolean data in the key's bit
 ******************************************************************************/
 void
 UIMessage::Write(UIBool key, bool value)
 {
-	m_bValueMap[key] = value;
+	if (key < 0 || key >= UINumBools) {
+		return;
+	}
+	m_boolMask |= 1u << key;
+	if (value) {
+		m_boolValues |= 1u << key;
+	} else {
+		m_boolValues &= ~(1u << key);
+	}
 }
 
 /*!****************************************************************************
@@ -81,16 +155,86 @@ UIMessage::Write(UIWorkoutStage newStage)
 	m_WorkoutStage = newStage;
 }
 
-void
-UIMessage::FreeStrings()
+/*!****************************************************************************
+ @Function		Load
+ @Input			frame		A telemetry frame written by a UIFrameWriter
+ @Input			size		Bytes available at frame
+ @Output		pErrorStr	Pointer to the string returned on error
+ @Return		bool		Was the frame loaded?
+ @Description	Replaces the message's data with a frame's. The frame is
+				checked once, then its slots and bitmaps are copied whole and
+				its string table is copied into one string block, so the
+				frame's buffer can be reused as soon as this returns.
+******************************************************************************/
+bool
+UIMessage::Load(const void* frame, size_t size, CPVRTString* const pErrorStr)
 {
-	for ( int i = UISpeedMPM; i <= UINone; i ++ ) {
-		UITextType type = static_cast<UITextType>(i);
-		if (m_sValueMap[type] != NULL) {
-			delete m_sValueMap[type];
-			m_sValueMap[type] = NULL;
+	const char* error;
+	if (!UIFrameCheck(frame, size, &error)) {
+		fprintf(stderr, "UIFrame rejected: %s\n", error);
+		*pErrorStr = "ERROR: Can't load UIFrame";
+		return false;
+	}
+	const UIFrame* data = (const UIFrame*) frame;
+
+	Recycle();
+	memcpy(m_floats, data->floats, sizeof(m_floats));
+	memcpy(m_metrics, data->metrics, sizeof(m_metrics));
+	m_floatMask = data->floatMask;
+	m_metricMask = data->metricMask;
+	m_boolMask = data->boolMask;
+	m_boolValues = data->boolValues & data->boolMask;
+	m_UIState = (UIState) data->state;
+	m_UIAction = (UIAction) data->action;
+	m_WorkoutStage = (UIWorkoutStage) data->stage;
+	m_totalRacers = data->totalRacers;
+
+	if (data->textMask != 0) {
+		UIStringRef table = m_strings.Copy(UIFrameStrings(data), data->textSize);
+		if (table.IsNull()) {
+			*pErrorStr = "ERROR: Can't copy UIFrame text";
+			return false;
 		}
+		for ( int i = 0; i < UINone; i ++ ) {
+			if ((data->textMask & (1u << i)) != 0) {
+				m_texts[i] = table.At(data->textOffsets[i]);
+			}
+		}
+		m_textMask = data->textMask;
 	}
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		Recycle
+ @Description	Empties the message so it can be filled with the next frame's
+				data. Clears the data slots, the telemetry and the action, and
+				recycles the string blocks that nothing else references. The
+				state, stage and racer count are kept.
+******************************************************************************/
+void
+UIMessage::Recycle()
+{
+	releaseStrings();
+	m_floatMask = 0;
+	m_boolMask = 0;
+	m_boolValues = 0;
+	m_metricMask = 0;
+	m_UIAction = UINoAction;
+	m_strings.Recycle();
+}
+
+/*!****************************************************************************
+ @Function		FreeStrings
+ @Description	Removes the text values and gives up the string blocks. Text
+				still referenced by elements stays valid until they let go
+				of it.
+******************************************************************************/
+void
+UIMessage::FreeStrings()
+{
+	releaseStrings();
+	m_strings.Delete();
 }
 
 /*!****************************************************************************
@@ -101,13 +245,72 @@ UIMessage::FreeStrings()
 float
 UIMessage::Read(UIFloat key)
 {
-	if (m_fValueMap.Exists(key)) {
-		return m_fValueMap[key];
+	if (Has(key)) {
+		return m_floats[key];
 	} else {
 		return 0;
 	}
 }
 
+/*!****************************************************************************
+ @Function		Read
+ @Input			key		Enum key for numeric telemetry
+ @Description	Retreives the telemetry value of a metric (0 if it wasn't written)
+******************************************************************************/
+float
+UIMessage::Read(UIMetric key)
+{
+	return Has(key) ? m_metrics[key] : 0;
+}
+
+/*!****************************************************************************
+ @Function		Has
+ @Input			key		Enum key for numeric telemetry
+ @Return		bool	Was the metric written?
+ @Description	Checks whether the message carries a value for a metric
+******************************************************************************/
+bool
+UIMessage::Has(UIMetric key)
+{
+	return key >= 0 && key < UIMNone && (m_metricMask & (1u << key)) != 0;
+}
+
+/*!****************************************************************************
+ @Function		Has
+ @Input			key		Enum key for float data
+ @Return		bool	Was the key written?
+ @Description	Checks whether the message carries a value for a float key
+******************************************************************************/
+bool
+UIMessage::Has(UIFloat key)
+{
+	return key >= 0 && key < UINumFloats && (m_floatMask & (1u << key)) != 0;
+}
+
+/*!****************************************************************************
+ @Function		Has
+ @Input			key		Enum key for text data
+ @Return		bool	Was the key written?
+ @Description	Checks whether the message carries a value for a text key
+******************************************************************************/
+bool
+UIMessage::Has(UITextType key)
+{
+	return key >= 0 && key < UINone && (m_textMask & (1u << key)) != 0;
+}
+
+/*!****************************************************************************
+ @Function		Has
+ @Input			key		Enum key for bool data
+ @Return		bool	Was the key written?
+ @Description	Checks whether the message carries a value for a bool key
+******************************************************************************/
+bool
+UIMessage::Has(UIBool key)
+{
+	return key >= 0 && key < UINumBools && (m_boolMask & (1u << key)) != 0;
+}
+
 /*!****************************************************************************
  @Function		Read
  @Input			key		Enum key for text data
@@ -116,13 +319,30 @@ UIMessage::Read(UIFloat key)
 char*
 UIMessage::Read(UITextType key)
 {
-	if (m_sValueMap.Exists(key)) {
-		return m_sValueMap[key];
+	if (Has(key)) {
+		return m_texts[key].Get();
 	} else {
 		return 0;
 	}
 }
 
+/*!****************************************************************************
+ @Function		ReadRef
+ @Input			key		Enum key for text data
+ @Return		UIStringRef		Reference to the text (null if there is none)
+ @Description	Retreives text data as a reference that keeps it valid after
+				the message is recycled
+******************************************************************************/
+UIStringRef
+UIMessage::ReadRef(UITextType key)
+{
+	if (Has(key)) {
+		return m_texts[key];
+	} else {
+		return UIStringRef();
+	}
+}
+
 /*!****************************************************************************
  @Function		Read
  @Input			key		Enum key for bool data
@@ -131,8 +351,8 @@ UIMessage::Read(UITextType key)
 bool
 UIMessage::Read(UIBool key)
 {
-	if (m_bValueMap.Exists(key)) {
-		return m_bValueMap[key];
+	if (Has(key)) {
+		return (m_boolValues & (1u << key)) != 0;
 	} else {
 		return false;
 	}
@@ -202,8 +422,8 @@ UIMessage
 UIMessage::Delegate(UIFloat key)
 {
 	UIMessage delegate = UIMessage();
-	if (m_fValueMap.Exists(key)) {
-		delegate.Write(key, m_fValueMap[key]);
+	if (Has(key)) {
+		delegate.Write(key, m_floats[key]);
 	}
 	delegate.SetTotalRacers(m_totalRacers);
 	delegate.Write(m_UIAction);
@@ -222,8 +442,10 @@ UIMessage
 UIMessage::Delegate(UITextType key)
 {
 	UIMessage delegate = UIMessage();
-	if (m_sValueMap.Exists(key)) {
-		delegate.Write(key, m_sValueMap[key]);
+	if (Has(key)) {
+		// The delegate shares the string rather than copying it
+		delegate.m_texts[key] = m_texts[key];
+		delegate.m_textMask |= 1u << key;
 	}
 	delegate.SetTotalRacers(m_totalRacers);
 	delegate.Write(m_UIAction);
@@ -242,12 +464,67 @@ UIMessage
 UIMessage::Delegate(UIBool key)
 {
 	UIMessage delegate = UIMessage();
-	if (m_bValueMap.Exists(key)) {
-		delegate.Write(key, m_bValueMap[key]);
+	if (Has(key)) {
+		delegate.Write(key, Read(key));
 	}
 	delegate.SetTotalRacers(m_totalRacers);
 	delegate.Write(m_UIAction);
 	delegate.Write(m_UIState);
 	delegate.Write(m_WorkoutStage);
 	return delegate;
-}
\ No newline at end of file
+}
+
+/*!****************************************************************************
+ @Function		Delegate
+ @Return		UIMessage	New message containing the specified data
+ @Description	Makes a copy of the current UIMessage that only contains the data
+				specified by the UIMetric key
+******************************************************************************/
+UIMessage
+UIMessage::Delegate(UIMetric key)
+{
+	UIMessage delegate = UIMessage();
+	if (Has(key)) {
+		delegate.Write(key, m_metrics[key]);
+	}
+	delegate.SetTotalRacers(m_totalRacers);
+	delegate.Write(m_UIAction);
+	delegate.Write(m_UIState);
+	delegate.Write(m_WorkoutStage);
+	return delegate;
+}
+
+/*!****************************************************************************
+ @Function		MetricForText
+ @Input			key			Enum key for text data
+ @Output		metric		The metric the text key displays
+ @Output		format		How the metric is formatted for the text key
+ @Return		bool		Does the text key have a numeric metric?
+ @Description	Looks up the numeric metric behind a text key in
+				c_metricBindings
+******************************************************************************/
+bool
+UIMessage::MetricForText(UITextType key, UIMetric* metric, UIFormatter* format)
+{
+	for ( int i = 0; i < c_numMetricBindings; i ++ ) {
+		if (c_metricBindings[i].textKey == key) {
+			*metric = c_metricBindings[i].metric;
+			*format = c_metricBindings[i].format;
+			return true;
+		}
+	}
+	return false;
+}
+
+/*!****************************************************************************
+ @Function		releaseStrings
+ @Description	HELPER - drops the message's references to its text values
+******************************************************************************/
+void
+UIMessage::releaseStrings()
+{
+	for ( int i = 0; i < UINone; i ++ ) {
+		m_texts[i].Release();
+	}
+	m_textMask = 0;
+}
@@ -6,78 +6,31 @@
 ******************************************************************************/
 
 #include "OGLES2Tools.h"
+#include "UIFormat.h"
+#include "UIMessageKeys.h"
+#include "UIStringRef.h"
+#include "UIFrame.h"
 
 #ifndef _UIMESSAGE_H
 #define _UIMESSAGE_H
 
-// Enum identifiers for messages containing float values
-enum UIFloat {
-	UIStageProgress,
-	UIBrightnessProg,
-	UIVolumeProg
+// The metric and formatter a text key displays when it is sent as a number
+struct UIMetricBinding {
+	UITextType textKey;
+	UIMetric metric;
+	UIFormatter format;
 };
 
+const int c_numMetricBindings = 7;
 
-// Enum identifiers for messages containing text values
-enum UITextType {
-	UISpeedMPM,
-	UIRank,
-	UIEnergyKJ,
-	UICalories,
-	UITimeS,
-	UIDistanceM,
-	UIBrightness,
-	UIVolume,
-	UIAvatarDistance,
-	UIBPM,
-	UIClock,
-	UINone
-};
-
-// Enum identifiers for messages containing bool values
-enum UIBool {
-	UIHidden,
-	UIButtonActive,
-	UIResumeButtonActive,
-	UIVolumeButtonActive,
-	UIBrightButtonActive,
-	UIEndButtonActive,
-	UIMileMarker,
-	UIBadge1,
-	UIBadge2,
-	UIBadge3,
-	UIMultiProg,
-	UIBrightnessSelected,
-	UISpeedSelected,
-	UIVolumeSelected,
-	UIFlash
-};
-
-// Enum identifiers for the UI's display states
-enum UIState {
-	UIMain,
-	UIInfo,
-	UIBPMView,
-	UIPause,
-	UISummary,
-	UIMenuBrightness,
-	UIMenuVolume,
-	UIMenuSpeed,
-	UIMenuMain,
-	noUI
-};
-
-// Enum identifiers for the peloton workout stages
-enum UIWorkoutStage {
-	UIWarmup, 
-	UIWorkout,
-	UICooldown
-};
-
-// Enum identifiers for action items
-enum UIAction {
-	UINoAction,
-	UIToggleActiveButton
+const UIMetricBinding c_metricBindings[] = {
+	{ UIClock, UIMTimeS, UIFmtClock },
+	{ UIDistanceM, UIMDistanceM, UIFmtMiles },
+	{ UISpeedMPM, UIMSpeedMPS, UIFmtPace },
+	{ UIEnergyKJ, UIMEnergyKJ, UIFmtInteger },
+	{ UICalories, UIMCalories, UIFmtInteger },
+	{ UIBPM, UIMBPM, UIFmtInteger },
+	{ UIRank, UIMRank, UIFmtInteger }
 };
 
 /*!****************************************************************************
@@ -85,16 +38,35 @@ enum UIAction {
  Object class. A UIMessage object stores the information needed to update the UI
  based on the current frame data. UIMessages are intended to be passed from 
  element to element through the UIElement's Update function.
+
+ Text values are copied into blocks owned by the message's UIStringWriter and
+ held as UIStringRefs, so the writer keeps its own buffer. Copies of a message
+ and its delegates share the text rather than copying it, and elements can keep
+ a value with ReadRef: the text stays valid for as long as anything references
+ it, even after the message is recycled. A message that is reused frame after
+ frame with Recycle stops allocating once enough blocks are in circulation.
+
+ Load fills a message from a binary UIFrame (UIFrame.h) written by the app
+ layer: the slots are copied whole and the frame's string table is copied into
+ one block, so no field is decoded or written one at a time.
 ******************************************************************************/
 class UIMessage
 {
 	protected:
 		// Instance variables
 
-		// Maps from enum identifiers to message data
-		CPVRTMap<UIFloat, float> m_fValueMap;
-		CPVRTMap<UITextType, char*> m_sValueMap;
-		CPVRTMap<UIBool, bool> m_bValueMap;
+		// Slots for the message data, indexed by key, and a bit per key that
+		// has been written. Bools are stored as bits.
+		float m_floats[UINumFloats];
+		UIStringRef m_texts[UINone];
+		unsigned int m_floatMask, m_textMask, m_boolMask, m_boolValues;
+
+		// Backing memory of the text values
+		UIStringWriter m_strings;
+
+		// Numeric telemetry, and a bit per metric that has been written
+		float m_metrics[UIMNone];
+		unsigned int m_metricMask;
 
 		// The current UI state
 		UIState m_UIState;
@@ -108,18 +80,32 @@ class UIMessage
 		// the total number of racers in the workout
 		int m_totalRacers;
 
+		// Local functions
+		void releaseStrings();
+
 	public:
 		// Exported functions
+		UIMessage();
 		void Write(UIFloat key, float value);
-		void Write(UITextType key, char* value);
+		void Write(UIMetric key, float value);
+		void Write(UITextType key, const char* value);
+		void Write(UITextType key, const UIStringRef& value);
 		void Write(UIBool key, bool value);
 		void Write(UIState state);
 		void Write(UIAction action);
 		void Write(UIWorkoutStage stage);
+		bool Load(const void* frame, size_t size, CPVRTString* const pErrorStr);
 		void SetTotalRacers(int total);
+		void Recycle();
 		void FreeStrings();
 		float Read(UIFloat key);
+		float Read(UIMetric key);
+		bool Has(UIMetric key);
+		bool Has(UIFloat key);
+		bool Has(UITextType key);
+		bool Has(UIBool key);
 		char* Read(UITextType key);
+		UIStringRef ReadRef(UITextType key);
 		bool Read(UIBool key);
 		UIState ReadState();
 		UIAction ReadAction();
@@ -128,6 +114,8 @@ class UIMessage
 		UIMessage Delegate(UIFloat key);
 		UIMessage Delegate(UITextType key);
 		UIMessage Delegate(UIBool key);
+		UIMessage Delegate(UIMetric key);
+		static bool MetricForText(UITextType key, UIMetric* metric, UIFormatter* format);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,133 @@
+/******************************************************************************
+ @File          UIMessageKeys.h
+ @Title         UIMessageKeys Header File
+ @Author        Siddharth Hathi
+ @Description   The UIMessage key enums, generated from the key lists below
+				so that the enums, their names and the UIFrame schema can't
+				drift apart. Makes no GL calls, so the offline tools can
+				include it.
+******************************************************************************/
+
+#ifndef _UIMESSAGEKEYS_H
+#define _UIMESSAGEKEYS_H
+
+// Key lists. Each entry expands X(key), in enum order. Adding a key is one
+// line here: keys should be added at the end of a list, since layout files
+// and telemetry frames store key values.
+
+// Keys for messages containing float values
+#define UIKIT_FLOAT_KEYS(X) \
+	X(UIStageProgress) \
+	X(UIBrightnessProg) \
+	X(UIVolumeProg)
+
+// Keys for messages containing text values
+#define UIKIT_TEXT_KEYS(X) \
+	X(UISpeedMPM) \
+	X(UIRank) \
+	X(UIEnergyKJ) \
+	X(UICalories) \
+	X(UITimeS) \
+	X(UIDistanceM) \
+	X(UIBrightness) \
+	X(UIVolume) \
+	X(UIAvatarDistance) \
+	X(UIBPM) \
+	X(UIClock)
+
+// Keys for numeric telemetry, written as numbers rather than text: elapsed
+// seconds, metres, m/s, kJ, kcal, beats per minute and rank
+#define UIKIT_METRIC_KEYS(X) \
+	X(UIMTimeS) \
+	X(UIMDistanceM) \
+	X(UIMSpeedMPS) \
+	X(UIMEnergyKJ) \
+	X(UIMCalories) \
+	X(UIMBPM) \
+	X(UIMRank)
+
+// Keys for messages containing bool values. UIFlash is no longer read:
+// blinking is timed by the UIBlinkScheduler
+#define UIKIT_BOOL_KEYS(X) \
+	X(UIHidden) \
+	X(UIButtonActive) \
+	X(UIResumeButtonActive) \
+	X(UIVolumeButtonActive) \
+	X(UIBrightButtonActive) \
+	X(UIEndButtonActive) \
+	X(UIMileMarker) \
+	X(UIBadge1) \
+	X(UIBadge2) \
+	X(UIBadge3) \
+	X(UIMultiProg) \
+	X(UIBrightnessSelected) \
+	X(UISpeedSelected) \
+	X(UIVolumeSelected) \
+	X(UIFlash)
+
+// The UI's display states
+#define UIKIT_STATES(X) \
+	X(UIMain) \
+	X(UIInfo) \
+	X(UIBPMView) \
+	X(UIPause) \
+	X(UISummary) \
+	X(UIMenuBrightness) \
+	X(UIMenuVolume) \
+	X(UIMenuSpeed) \
+	X(UIMenuMain) \
+	X(noUI)
+
+// The peloton workout stages
+#define UIKIT_WORKOUT_STAGES(X) \
+	X(UIWarmup) \
+	X(UIWorkout) \
+	X(UICooldown)
+
+// Action items
+#define UIKIT_ACTIONS(X) \
+	X(UINoAction) \
+	X(UIToggleActiveButton)
+
+// Expansions of a key list: an enum entry, and the key's name
+#define UIKIT_KEY_ENUM(key) key,
+#define UIKIT_KEY_NAME(key) #key,
+
+// Enum identifiers for messages containing float values
+enum UIFloat { UIKIT_FLOAT_KEYS(UIKIT_KEY_ENUM) UINumFloats };
+
+// Enum identifiers for messages containing text values. UINone marks text
+// that isn't updated and counts the text keys
+enum UITextType { UIKIT_TEXT_KEYS(UIKIT_KEY_ENUM) UINone };
+
+// Enum identifiers for numeric telemetry. UIMNone marks text without a metric
+// and counts the metrics
+enum UIMetric { UIKIT_METRIC_KEYS(UIKIT_KEY_ENUM) UIMNone };
+
+// Enum identifiers for messages containing bool values
+enum UIBool { UIKIT_BOOL_KEYS(UIKIT_KEY_ENUM) UINumBools };
+
+// Enum identifiers for the UI's display states
+enum UIState { UIKIT_STATES(UIKIT_KEY_ENUM) UINumStates };
+
+// Enum identifiers for the peloton workout stages
+enum UIWorkoutStage { UIKIT_WORKOUT_STAGES(UIKIT_KEY_ENUM) UINumWorkoutStages };
+
+// Enum identifiers for action items
+enum UIAction { UIKIT_ACTIONS(UIKIT_KEY_ENUM) UINumActions };
+
+// Names of the keys, indexed by key. UINone and UIMNone are named since
+// they are used as keys
+const char* const c_floatKeyNames[] = { UIKIT_FLOAT_KEYS(UIKIT_KEY_NAME) };
+const char* const c_textKeyNames[] = { UIKIT_TEXT_KEYS(UIKIT_KEY_NAME) "UINone" };
+const char* const c_metricKeyNames[] = { UIKIT_METRIC_KEYS(UIKIT_KEY_NAME) "UIMNone" };
+const char* const c_boolKeyNames[] = { UIKIT_BOOL_KEYS(UIKIT_KEY_NAME) };
+const char* const c_stateNames[] = { UIKIT_STATES(UIKIT_KEY_NAME) };
+const char* const c_workoutStageNames[] = { UIKIT_WORKOUT_STAGES(UIKIT_KEY_NAME) };
+const char* const c_actionNames[] = { UIKIT_ACTIONS(UIKIT_KEY_NAME) };
+
+// Present keys are tracked in 32 bit masks
+static_assert(UINumFloats <= 32 && UINone <= 32 && UIMNone <= 32 && UINumBools <= 32,
+	"UIMessage keys are tracked in 32 bit masks");
+
+#endif
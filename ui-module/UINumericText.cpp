@@ -0,0 +1,480 @@
+/******************************************************************************
+ @File          UINumericText.cpp
+ @Title         UINumericText
+ @Author        Siddharth Hathi
+ @Description   Implements the UINumericText object class defined in
+				UINumericText.h
+******************************************************************************/
+
+#include "UINumericText.h"
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes some default values
+******************************************************************************/
+UINumericText::UINumericText()
+{
+	m_chars[0] = '\0';
+	m_length = 0;
+	m_font = UIFBold;
+	m_x = 0;
+	m_y = 0;
+	m_scale = 0;
+	m_width = 0;
+	m_height = 0;
+	m_color = 0;
+	m_digitAdvance = 0;
+	m_top = 0;
+	m_uiVbo = 0;
+	m_dirtySlots = 0;
+	m_layoutEpoch = 0;
+	m_baked = false;
+	m_relayout = true;
+	m_hidden = false;
+}
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Input			x, y		Position of the center of the readout
+ @Input			scale		Text scale
+ @Input			color		Text color
+ @Input			font		Text font
+ @Description	Initializes an empty numeric readout
+******************************************************************************/
+UINumericText::UINumericText(float x, float y, float scale, GLuint color, UIFont font)
+{
+	m_chars[0] = '\0';
+	m_length = 0;
+	m_font = font;
+	m_x = x;
+	m_y = y;
+	m_scale = scale;
+	m_width = 0;
+	m_height = 0;
+	m_color = color;
+	m_digitAdvance = 0;
+	m_top = 0;
+	m_uiVbo = 0;
+	m_dirtySlots = 0;
+	m_layoutEpoch = 0;
+	m_baked = false;
+	m_relayout = true;
+	m_hidden = false;
+}
+
+/*!****************************************************************************
+ @Function		SetText
+ @Input			text		The new readout
+ @Return		bool		Could the text be displayed
+ @Description	Sets the readout from text. Only the slots whose characters
+				changed are rewritten. Returns false (and leaves the readout
+				unchanged) if the text contains characters without baked glyphs.
+******************************************************************************/
+bool
+UINumericText::SetText(const char* text)
+{
+	if (!Supports(text)) {
+		return false;
+	}
+
+	int length = strlen(text);
+	bool relayout = (length != m_length);
+	for ( int i = 0; i < length && !relayout; i ++ ) {
+		// Digits share a slot width, punctuation doesn't
+		int oldIndex = glyphIndex(m_chars[i]);
+		int newIndex = glyphIndex(text[i]);
+		if (oldIndex != newIndex && (oldIndex >= 10 || newIndex >= 10)) {
+			relayout = true;
+		}
+	}
+
+	for ( int i = 0; i < length; i ++ ) {
+		if (m_chars[i] != text[i]) {
+			m_chars[i] = text[i];
+			if (m_baked && !relayout) {
+				writeSlot(i);
+			}
+		}
+	}
+	m_chars[length] = '\0';
+	m_length = length;
+
+	if (relayout) {
+		m_relayout = true;
+	}
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		SetInteger
+ @Input			value		The new value
+ @Return		bool		Could the value be displayed
+ @Description	Sets the readout to an integer
+******************************************************************************/
+bool
+UINumericText::SetInteger(int value)
+{
+	char buffer[c_maxFormatChars + 1];
+	UIFormatWrite(UIFmtInteger, value, buffer);
+	return SetText(buffer);
+}
+
+/*!****************************************************************************
+ @Function		SetFixed
+ @Input			value		The new value
+ @Input			decimals	Number of digits after the decimal point
+ @Return		bool		Could the value be displayed
+ @Description	Sets the readout to a value rounded to a fixed number of
+				decimal places
+******************************************************************************/
+bool
+UINumericText::SetFixed(float value, int decimals)
+{
+	if (decimals < 0 || decimals > 6) {
+		return false;
+	}
+	unsigned long long scale = 1;
+	for ( int i = 0; i < decimals; i ++ ) {
+		scale *= 10;
+	}
+	if (!(fabs(value) < 1e9)) {
+		return false;
+	}
+	unsigned long long fixed = (unsigned long long)(fabs(value) * scale + 0.5);
+
+	char buffer[24];
+	int length = 0;
+	if (value < 0 && fixed != 0) {
+		buffer[length ++] = '-';
+	}
+	length += UIFormatDigits((unsigned long)(fixed / scale), 1, buffer + length);
+	if (decimals > 0) {
+		buffer[length ++] = '.';
+		length += UIFormatDigits((unsigned long)(fixed % scale), decimals, buffer + length);
+	}
+	if (length > c_maxNumericChars) {
+		return false;
+	}
+	buffer[length] = '\0';
+	return SetText(buffer);
+}
+
+/*!****************************************************************************
+ @Function		SetClock
+ @Input			seconds		The new value in seconds
+ @Return		bool		Could the value be displayed
+ @Description	Sets the readout to a time, formatted m:ss or h:mm:ss
+******************************************************************************/
+bool
+UINumericText::SetClock(int seconds)
+{
+	char buffer[c_maxFormatChars + 1];
+	UIFormatWrite(UIFmtClock, seconds < 0 ? 0 : seconds, buffer);
+	return SetText(buffer);
+}
+
+/*!****************************************************************************
+ @Function		SetColor
+ @Input			color		The new text color
+ @Description	Changes the text color without touching the vertex buffer
+******************************************************************************/
+void
+UINumericText::SetColor(GLuint color)
+{
+	m_color = color;
+}
+
+/*!****************************************************************************
+ @Function		SetPosition
+ @Input			x, y		The new position of the center of the readout
+ @Description	Moves the readout without touching the vertex buffer
+******************************************************************************/
+void
+UINumericText::SetPosition(float x, float y)
+{
+	m_x = x;
+	m_y = y;
+}
+
+/*!****************************************************************************
+ @Function		Measure
+ @Input			printer		UIPrinter object holding the glyph fonts
+ @Output		width		Pointer to the width of the readout
+ @Output		height		Pointer to the height of the readout
+ @Description	Measures the readout, baking the glyphs and laying out the
+				slots first if needed. Doesn't make any GL calls.
+******************************************************************************/
+void
+UINumericText::Measure(UIPrinter* printer, float* width, float* height)
+{
+	if (!m_baked || m_layoutEpoch != printer->GetLayoutEpoch()) {
+		if (!bake(printer)) {
+			*width = 0;
+			*height = 0;
+			return;
+		}
+	}
+	if (m_relayout) {
+		layoutSlots();
+	}
+	*width = m_width;
+	*height = m_height;
+}
+
+/*!****************************************************************************
+ @Function		Supports
+ @Input			text		The text being checked
+ @Return		bool		Can the text be displayed by a UINumericText
+ @Description	Checks that every character of the text has a baked glyph
+******************************************************************************/
+bool
+UINumericText::Supports(const char* text)
+{
+	if (text == NULL) {
+		return false;
+	}
+	int i = 0;
+	for ( ; text[i] != '\0'; i ++ ) {
+		if (i >= c_maxNumericChars || glyphIndex(text[i]) < 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		LoadTextures
+ @Output		pErrorStr		Pointer to the string returned on error
+ @Description	Numeric text uses the printer's font textures
+******************************************************************************/
+bool
+UINumericText::LoadTextures(CPVRTString* const pErrorStr)
+{
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		BuildVertices
+ @Description	Creates the vertex buffer with room for the longest readout
+******************************************************************************/
+void
+UINumericText::BuildVertices()
+{
+	if (m_uiVbo == 0) {
+		glGenBuffers(1, &m_uiVbo);
+		glBindBuffer(GL_ARRAY_BUFFER, m_uiVbo);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(m_vertices), NULL, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+	m_dirtySlots = 0xFFFFFFFF;
+}
+
+/*!****************************************************************************
+ @Function		Render
+ @Input			uiMVPMatrixLoc		Address of the shader's MVP matrix
+ @Input			printer				UIPrinter object used to display text
+ @Description	Uploads any slots that changed since the last frame and draws
+				the readout
+******************************************************************************/
+bool
+UINumericText::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
+{
+	if (m_hidden || m_length == 0) {
+		return true;
+	}
+
+	if (printer == NULL) {
+		fprintf(stderr, "Invalid call to UINumericText::Render\n");
+		return false;
+	}
+
+	float width, height;
+	Measure(printer, &width, &height);
+	if (!m_baked) {
+		return false;
+	}
+
+	upload();
+	printer->DrawGlyphs(m_uiVbo, m_length, m_x, m_y, m_color, m_font);
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		Update
+ @Input			updateMessage		UIMessage object containing frame info
+ @Description	Numeric text is set by its owner rather than by update messages
+******************************************************************************/
+void
+UINumericText::Update(UIMessage updateMessage)
+{
+	return;
+}
+
+/*!****************************************************************************
+ @Function		Hide
+ @Description	Makes object hidden
+******************************************************************************/
+void
+UINumericText::Hide()
+{
+	m_hidden = true;
+}
+
+/*!****************************************************************************
+ @Function		Show
+ @Description	Makes object visibile
+******************************************************************************/
+void
+UINumericText::Show()
+{
+	m_hidden = false;
+}
+
+/*!****************************************************************************
+ @Function		Delete
+ @Description	Frees the object's vertex buffer
+******************************************************************************/
+void
+UINumericText::Delete()
+{
+	if (m_uiVbo != 0) {
+		glDeleteBuffers(1, &m_uiVbo);
+		m_uiVbo = 0;
+	}
+	m_baked = false;
+	m_relayout = true;
+}
+
+/*!****************************************************************************
+ @Function		bake
+ @Input			printer		UIPrinter object holding the glyph fonts
+ @Description	HELPER - lays out a quad for each numeric glyph at the
+				readout's scale, with the pen and the line top at 0
+******************************************************************************/
+bool
+UINumericText::bake(UIPrinter* printer)
+{
+	UIGlyphFont* glyphFont = printer->GetGlyphFont(m_font);
+	if (glyphFont == NULL) {
+		fprintf(stderr, "UINumericText font not loaded\n");
+		return false;
+	}
+
+	m_digitAdvance = 0;
+	for ( int i = 0; i < c_numNumericGlyphs; i ++ ) {
+		// Characters missing from the font are baked as empty quads
+		memset(m_glyphQuads[i], 0, sizeof(m_glyphQuads[i]));
+		glyphFont->LayoutRun(0, 0, m_scale, &c_numericGlyphs[i], 1, m_glyphQuads[i], 1, &m_advances[i]);
+		if (i < 10 && m_advances[i] > m_digitAdvance) {
+			m_digitAdvance = m_advances[i];
+		}
+	}
+	m_height = glyphFont->GetLineHeight() * m_scale;
+
+	m_layoutEpoch = printer->GetLayoutEpoch();
+	m_baked = true;
+	m_relayout = true;
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		layoutSlots
+ @Description	HELPER - positions every slot so that the readout is centered
+				on the origin and rewrites all of them
+******************************************************************************/
+void
+UINumericText::layoutSlots()
+{
+	m_width = 0;
+	for ( int i = 0; i < m_length; i ++ ) {
+		int index = glyphIndex(m_chars[i]);
+		m_width += (index < 10) ? m_digitAdvance : m_advances[index];
+	}
+	m_top = m_height/2;
+
+	float penX = -m_width/2;
+	for ( int i = 0; i < m_length; i ++ ) {
+		int index = glyphIndex(m_chars[i]);
+		m_slotX[i] = penX;
+		penX += (index < 10) ? m_digitAdvance : m_advances[index];
+		writeSlot(i);
+	}
+	m_relayout = false;
+}
+
+/*!****************************************************************************
+ @Function		writeSlot
+ @Input			slot		Index of the slot
+ @Description	HELPER - copies the baked quad of the slot's character into the
+				slot and marks it for upload. Digits are centered in their slot.
+******************************************************************************/
+void
+UINumericText::writeSlot(int slot)
+{
+	int index = glyphIndex(m_chars[slot]);
+	float offsetX = m_slotX[slot];
+	if (index < 10) {
+		offsetX += (m_digitAdvance - m_advances[index])/2;
+	}
+
+	UIGlyphVertex* quad = &m_vertices[4 * slot];
+	for ( int i = 0; i < 4; i ++ ) {
+		quad[i] = m_glyphQuads[index][i];
+		quad[i].x += offsetX;
+		quad[i].y += m_top;
+	}
+	m_dirtySlots |= (1u << slot);
+}
+
+/*!****************************************************************************
+ @Function		upload
+ @Description	HELPER - uploads each run of changed slots to the vertex buffer
+				with glBufferSubData
+******************************************************************************/
+void
+UINumericText::upload()
+{
+	if (m_uiVbo == 0) {
+		BuildVertices();
+	}
+	if (m_dirtySlots == 0) {
+		return;
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_uiVbo);
+	int slot = 0;
+	while (slot < m_length) {
+		if (!(m_dirtySlots & (1u << slot))) {
+			slot ++;
+			continue;
+		}
+		int first = slot;
+		while (slot < m_length && (m_dirtySlots & (1u << slot))) {
+			slot ++;
+		}
+		glBufferSubData(GL_ARRAY_BUFFER, 4 * first * sizeof(UIGlyphVertex),
+			4 * (slot - first) * sizeof(UIGlyphVertex), &m_vertices[4 * first]);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	m_dirtySlots = 0;
+}
+
+/*!****************************************************************************
+ @Function		glyphIndex
+ @Input			c			Character
+ @Return		int			Index of the character's baked glyph, -1 if none
+ @Description	HELPER - maps a character to its baked glyph
+******************************************************************************/
+int
+UINumericText::glyphIndex(char c)
+{
+	if (c >= '0' && c <= '9') {
+		return c - '0';
+	}
+	for ( int i = 10; i < c_numNumericGlyphs; i ++ ) {
+		if (c_numericGlyphs[i] == c) {
+			return i;
+		}
+	}
+	return -1;
+}
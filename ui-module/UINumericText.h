@@ -0,0 +1,110 @@
+/******************************************************************************
+ @File          UINumericText.h
+ @Title         UINumericText Header File
+ @Author        Siddharth Hathi
+ @Description   Header file for the UINumericText class.
+******************************************************************************/
+
+#include "OGLES2Tools.h"
+#include "UIElement.h"
+#include "UIGlyphFont.h"
+#include "UIFormat.h"
+
+#ifndef _UINUMERICTEXT_H
+#define _UINUMERICTEXT_H
+
+// Characters the numeric renderer has pre-baked quads for
+const char c_numericGlyphs[] = "0123456789:./-";
+const int c_numNumericGlyphs = 14;
+
+// Longest readout a UINumericText can display
+const int c_maxNumericChars = 16;
+
+/*!****************************************************************************
+ @class UINumericText
+ Object class. A UINumericText is a UIElement used for the readouts that change
+ every second (clock, pace, heart rate, distance, energy). When its font is first
+ available it bakes a glyph quad for each of the characters 0-9 : . / - at its
+ scale. Readouts are laid out in fixed slots, with every digit given the width of
+ the widest digit, so changing a digit never moves any other character. When the
+ value changes only the slots whose characters changed are rewritten in the
+ vertex buffer, and the whole readout is only laid out again when its length or
+ the position of its punctuation changes. Values can be set as text or directly
+ as numbers, which skips formatting through a char*.
+******************************************************************************/
+class UINumericText : public UIElement
+{
+	protected:
+		// Instance variables
+
+		// Characters currently displayed
+		char m_chars[c_maxNumericChars + 1];
+		int m_length;
+
+		// The font of the text
+		UIFont m_font;
+
+		// Position of the center of the readout, scale and measured size
+		float m_x, m_y, m_scale, m_width, m_height;
+
+		// Text color
+		GLuint m_color;
+
+		// Baked glyph quads (pen at 0, line top at 0) and advances
+		UIGlyphVertex m_glyphQuads[c_numNumericGlyphs][4];
+		float m_advances[c_numNumericGlyphs];
+		float m_digitAdvance;
+
+		// Left edge of every slot relative to the center of the readout
+		float m_slotX[c_maxNumericChars];
+
+		// Top of the line relative to the center of the readout
+		float m_top;
+
+		// CPU copy of the vertex buffer
+		UIGlyphVertex m_vertices[4 * c_maxNumericChars];
+
+		// Vertex buffer holding the slots' glyph quads
+		GLuint m_uiVbo;
+
+		// Slots whose quads need to be uploaded (one bit per slot)
+		unsigned int m_dirtySlots;
+
+		// Printer layout epoch the glyphs were baked in
+		unsigned int m_layoutEpoch;
+
+		// Have the glyphs been baked, do the slots need to be laid out again
+		bool m_baked, m_relayout;
+
+		// Is the text hidden
+		bool m_hidden;
+
+		// Local functions
+		bool bake(UIPrinter* printer);
+		void layoutSlots();
+		void writeSlot(int slot);
+		void upload();
+		static int glyphIndex(char c);
+
+	public:
+		// Exported functions
+		UINumericText();
+		UINumericText(float x, float y, float scale, GLuint color, UIFont font);
+		bool SetText(const char* text);
+		bool SetInteger(int value);
+		bool SetFixed(float value, int decimals);
+		bool SetClock(int seconds);
+		void SetColor(GLuint color);
+		void SetPosition(float x, float y);
+		void Measure(UIPrinter* printer, float* width, float* height);
+		static bool Supports(const char* text);
+		virtual bool LoadTextures(CPVRTString* const pErrorStr);
+		virtual void BuildVertices();
+		virtual bool Render(GLuint uiMVPMatrixLoc, UIPrinter* printer);
+		virtual void Update(UIMessage updateMessage);
+		virtual void Hide();
+		virtual void Show();
+		virtual void Delete();
+};
+
+#endif
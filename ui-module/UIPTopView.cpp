@@ -11,6 +11,8 @@
 ******************************************************************************/
 
 #include "UIPTopView.h"
+#include "UIDispatcher.h"
+#include "UIStateTable.h"
 
 /*!****************************************************************************
  @Function		Constructor
@@ -20,6 +22,7 @@ UIPTopView::UIPTopView()
 {
 	m_state = UIMain;
 	m_hidden = true;
+	m_stateSlot = -1;
 }
 
 /*!****************************************************************************
@@ -36,36 +39,37 @@ UIPTopView::UIPTopView(UIState startingState, UIWorkoutStage startingWorkoutMode
 	m_hidden = false;
 
 	// Add UIElements
-	UIElement** mainElements = new UIElement*[c_tvPNumElementPositions];
-	UIElement** infoElements = new UIElement*[c_tvPNumElementPositions];
-	UIElement** bioElements = new UIElement*[c_tvPNumElementPositions];
-	UIElement** pauseElements = new UIElement*[c_tvPNumElementPositions];
+	m_arena.Init(c_PTVArenaSize);
+	UIElement** mainElements = m_arena.AllocArray<UIElement*>(c_tvPNumElementPositions);
+	UIElement** infoElements = m_arena.AllocArray<UIElement*>(c_tvPNumElementPositions);
+	UIElement** bioElements = m_arena.AllocArray<UIElement*>(c_tvPNumElementPositions);
+	UIElement** pauseElements = m_arena.AllocArray<UIElement*>(c_tvPNumElementPositions);
 
 	for (int i = 0 ; i < c_tvPNumElementPositions; i ++) {
 		switch(c_PTVLayoutSpecs[i].type) {
 			case PTVLeftTB:
-				mainElements[i] = new UITextBlock("0", "", UIFBold, UIFMedium, c_PTVLayoutSpecs[i].x, c_PTVLayoutSpecs[i].y, c_PTVDefaultTextColor, UIClock);
-				infoElements[i] = new UITextBlock("0", "", UIFBold, UIFMedium, c_PTVLayoutSpecs[i].x, c_PTVLayoutSpecs[i].y, c_PTVDefaultTextColor, UIClock);
-				pauseElements[i] = new UITextBlock("0", "", UIFBold, UIFMedium, c_PTVLayoutSpecs[i].x, c_PTVLayoutSpecs[i].y, c_PTVDefaultTextColor, UIRank);
-				bioElements[i] = new UITextBlock("0", "", UIFBold, UIFMedium, c_PTVLayoutSpecs[i].x, c_PTVLayoutSpecs[i].y, c_PTVDefaultTextColor, UIClock);
+				mainElements[i] = m_arena.Create<UITextBlock>((char*) "0", (char*) "", UIFBold, UIFMedium, c_PTVLayoutSpecs[i].x, c_PTVLayoutSpecs[i].y, c_PTVDefaultTextColor, UIClock);
+				infoElements[i] = m_arena.Create<UITextBlock>((char*) "0", (char*) "", UIFBold, UIFMedium, c_PTVLayoutSpecs[i].x, c_PTVLayoutSpecs[i].y, c_PTVDefaultTextColor, UIClock);
+				pauseElements[i] = m_arena.Create<UITextBlock>((char*) "0", (char*) "", UIFBold, UIFMedium, c_PTVLayoutSpecs[i].x, c_PTVLayoutSpecs[i].y, c_PTVDefaultTextColor, UIRank);
+				bioElements[i] = m_arena.Create<UITextBlock>((char*) "0", (char*) "", UIFBold, UIFMedium, c_PTVLayoutSpecs[i].x, c_PTVLayoutSpecs[i].y, c_PTVDefaultTextColor, UIClock);
 				break;
 			case PTVRightTB1:
-				mainElements[i] = new UITextBlock("0", c_PTVLayoutSpecs[i].x, c_PTVLayoutSpecs[i].y, c_PTVDefaultTextColor, UIRank);
-				infoElements[i] = new UITextBlock("0", "/mi", UIFBold, UIFMedium, c_PTVLayoutSpecs[i].x, c_PTVLayoutSpecs[i].y, c_PTVDefaultTextColor, UISpeedMPM);
-				bioElements[i] = new UITextBlock("0", "bpm", UIFBold, UIFMedium, c_PTVLayoutSpecs[i].x, c_PTVLayoutSpecs[i].y, c_PTVDefaultTextColor, UIBPM);
+				mainElements[i] = m_arena.Create<UITextBlock>((char*) "0", c_PTVLayoutSpecs[i].x, c_PTVLayoutSpecs[i].y, c_PTVDefaultTextColor, UIRank);
+				infoElements[i] = m_arena.Create<UITextBlock>((char*) "0", (char*) "/mi", UIFBold, UIFMedium, c_PTVLayoutSpecs[i].x, c_PTVLayoutSpecs[i].y, c_PTVDefaultTextColor, UISpeedMPM);
+				bioElements[i] = m_arena.Create<UITextBlock>((char*) "0", (char*) "bpm", UIFBold, UIFMedium, c_PTVLayoutSpecs[i].x, c_PTVLayoutSpecs[i].y, c_PTVDefaultTextColor, UIBPM);
 				pauseElements[i] = NULL;
 				break;
 			case PTVRightTB2:
-				mainElements[i] = new UITextBlock("0", "kJ", UIFBold, UIFMedium, c_PTVLayoutSpecs[i].x, c_PTVLayoutSpecs[i].y, c_PTVDefaultTextColor, UIEnergyKJ);
-				infoElements[i] = new UITextBlock("0", "mi", UIFBold, UIFMedium, c_PTVLayoutSpecs[i].x, c_PTVLayoutSpecs[i].y, c_PTVDefaultTextColor, UIDistanceM);
+				mainElements[i] = m_arena.Create<UITextBlock>((char*) "0", (char*) "kJ", UIFBold, UIFMedium, c_PTVLayoutSpecs[i].x, c_PTVLayoutSpecs[i].y, c_PTVDefaultTextColor, UIEnergyKJ);
+				infoElements[i] = m_arena.Create<UITextBlock>((char*) "0", (char*) "mi", UIFBold, UIFMedium, c_PTVLayoutSpecs[i].x, c_PTVLayoutSpecs[i].y, c_PTVDefaultTextColor, UIDistanceM);
 				pauseElements[i] = NULL;
 				bioElements[i] = NULL;
 				break;
 			case PTVWorkoutView:
-				mainElements[i] = new UIPWorkoutView(m_startingWorkoutMode);
-				infoElements[i] = new UIPWorkoutView(m_startingWorkoutMode);
-				pauseElements[i] = new UIPWorkoutView(m_startingWorkoutMode);
-				bioElements[i] = new UIPWorkoutView(m_startingWorkoutMode);
+				mainElements[i] = m_arena.Create<UIPWorkoutView>(m_startingWorkoutMode);
+				infoElements[i] = m_arena.Create<UIPWorkoutView>(m_startingWorkoutMode);
+				pauseElements[i] = m_arena.Create<UIPWorkoutView>(m_startingWorkoutMode);
+				bioElements[i] = m_arena.Create<UIPWorkoutView>(m_startingWorkoutMode);
 				break;
 			default:
 				mainElements[i] = NULL, infoElements[i] = NULL, pauseElements[i] = NULL;
@@ -78,6 +82,8 @@ UIPTopView::UIPTopView(UIState startingState, UIWorkoutStage startingWorkoutMode
 	m_stateMap[UIPause] = pauseElements;
 	m_stateMap[UIBPMView] = bioElements;
 	m_stateMap[UISummary] = NULL;
+	UIDispatcher::Get()->Subscribe(this, UIFieldState);
+	m_stateSlot = UIStateTable::Get()->Register(1u << UIMain | 1u << UIInfo | 1u << UIBPMView | 1u << UIPause);
 }
 
 /*!****************************************************************************
@@ -147,7 +153,7 @@ UIPTopView::BuildVertices()
 bool
 UIPTopView::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 {
-	if (m_hidden) {
+	if (m_hidden || !UIStateTable::Get()->IsVisible(m_stateSlot)) {
 		return true;
 	}
 	//fprintf(stderr, "Rendering UIPTopView\n");
@@ -179,16 +185,16 @@ UIPTopView::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 void
 UIPTopView::Update(UIMessage updateMessage)
 {
-	if (updateMessage.ReadState() > UIPause) {
-		m_hidden = true;
+	UIStateTable::Get()->SetState(updateMessage.ReadState());
+	// The UIStateTable shows the view in the states it has elements for
+	if (!UIStateTable::Get()->IsVisible(m_stateSlot)) {
 		return;
-	} else {
-		m_hidden = false;
 	}
-	m_state = updateMessage.ReadState();
+	m_state = UIStateTable::Get()->GetState();
 	UIElement** elementArray = m_stateMap[m_state];
 	UIMessage delegateMessage;
-	if (elementArray != NULL) {
+	// During a dispatch the children are updated by the UIDispatcher
+	if (elementArray != NULL && !UIDispatcher::Get()->IsDispatching()) {
 		for (int i = 0 ; i < c_tvPNumElementPositions; i ++) {
 			if (elementArray[i] == NULL) {
 				continue;
@@ -205,8 +211,13 @@ UIPTopView::Update(UIMessage updateMessage)
 void
 UIPTopView::Hide()
 {
+	m_hidden = true;
 	for (int i = 0; i < m_stateMap.GetSize(); i ++) {
 		UIElement** elementArray = *m_stateMap.GetDataAtIndex(i);
+		// UISummary has no elements, and Delete clears every entry
+		if (elementArray == NULL) {
+			continue;
+		}
 		for (int i = 0 ; i < c_tvPNumElementPositions; i ++) {
 			if (elementArray[i] != NULL) {
 				elementArray[i]->Hide();
@@ -222,8 +233,13 @@ UIPTopView::Hide()
 void
 UIPTopView::Show()
 {
+	m_hidden = false;
 	for (int i = 0; i < m_stateMap.GetSize(); i ++) {
 		UIElement** elementArray = *m_stateMap.GetDataAtIndex(i);
+		// UISummary has no elements, and Delete clears every entry
+		if (elementArray == NULL) {
+			continue;
+		}
 		for (int i = 0 ; i < c_tvPNumElementPositions; i ++) {
 			if (elementArray[i] != NULL) {
 				elementArray[i]->Show();
@@ -235,26 +251,14 @@ UIPTopView::Show()
 /*!****************************************************************************
  @Function		SetState
  @Input			state		New UI state
- @Description	Sets the m_state instance variable and sets the corresponding
-				elements to visible.
+ @Description	Sets the m_state instance variable and makes it the UI's state
+				in the UIStateTable, which shows the views of that state.
 ******************************************************************************/
 void
 UIPTopView::SetState(UIState state)
 {
-	this->m_state = state;
-	for (int i = UIMain; i != UISummary; i ++) {
-		UIState iState = static_cast<UIState>(i);
-		UIElement** elementArray = m_stateMap[iState];
-		for (int i = 0 ; i < c_tvPNumElementPositions; i ++) {
-			if (elementArray[i] != NULL) {
-				if (iState == m_state) {
-					elementArray[i]->Show();
-				} else {
-					elementArray[i]->Hide();
-				}
-			}
-		}
-	}
+	m_state = state;
+	UIStateTable::Get()->SetState(state);
 }
 
 /*!****************************************************************************
@@ -270,22 +274,28 @@ UIPTopView::GetState()
 
 /*!****************************************************************************
  @Function		Delete
- @Description	Frees any memory allocated within the object
+ @Description	Frees any memory allocated within the object. The elements free
+				their own GL objects, then the arena frees the elements and the
+				element arrays.
 ******************************************************************************/
 void
 UIPTopView::Delete()
 {
+	UIDispatcher::Get()->Unsubscribe(this);
+	UIStateTable::Get()->Unregister(m_stateSlot);
+	m_stateSlot = -1;
 	for ( int i = UIMain; i != UISummary; i++ ) {
 		UIState iState = static_cast<UIState>(i);
 		UIElement** elementArray = m_stateMap[iState];
+		if (elementArray == NULL) {
+			continue;
+		}
 		for (int i = 0 ; i < c_tvPNumElementPositions; i ++) {
 			if (elementArray[i] != NULL) {
 				elementArray[i]->Delete();
-				delete elementArray[i];
-				elementArray[i] = NULL;
 			}
 		}
-		delete elementArray;
-		elementArray = NULL;
+		m_stateMap[iState] = NULL;
 	}
+	m_arena.Delete();
 }
\ No newline at end of file
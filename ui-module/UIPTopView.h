@@ -16,6 +16,7 @@
 #include "UIProgressBar.h"
 #include "UITextBlock.h"
 #include "UIPWorkoutView.h"
+#include "UIArena.h"
 
 #ifndef _UIPTOPVIEW_H
 #define _UIPTOPVIEW_H
@@ -44,13 +45,18 @@ const PTVLayoutSpec c_PTVLayoutSpecs[] = {
 // The default color of text in the UIPTopView
 const GLuint c_PTVDefaultTextColor = 0xFFFFFFFF;
 
+// Size of the arena holding the UIPTopView's elements: an element array for
+// each of the four states, nine text blocks and a workout view per state
+const size_t c_PTVArenaSize = 4 * UIArenaArraySize<UIElement*>(c_tvPNumElementPositions)
+	+ UIArenaSize<UITextBlock>(9) + UIArenaSize<UIPWorkoutView>(4);
+
 /*!****************************************************************************
  @class UIPTopView
  Object class. The UIPTopView is the collection of UIElements that make up the
  information HUD at the top of the peloton workout's AR display. The UITB
  functions using a map of UI display states to element arrays. Depending on the
  UIState defined in the current frame, a different set of elements is displayed
- to the user.
+ to the user. The UIStateTable hides the whole view in the other states.
 ******************************************************************************/
 class UIPTopView : public UIElement
 {
@@ -63,12 +69,19 @@ class UIPTopView : public UIElement
 		// The current peloton workout stage
 		UIWorkoutStage m_startingWorkoutMode;
 
+		// Arena that owns the child elements and the element arrays
+		UIArena m_arena;
+
 		// A Map from possible UIStates to the elements that will be shown in the
 		// UITB for those states
 		CPVRTMap<UIState, UIElement**> m_stateMap;
 
 		// Is the UITB hidden?
 		bool m_hidden;
+
+		// Slot in the UIStateTable, which decides the states the UITB is
+		// shown in
+		int m_stateSlot;
 		
 	public:
 		// Exported functions
@@ -1,4 +1,5 @@
 #include "UIPWorkoutView.h"
+#include "UIDispatcher.h"
 
 UIPWorkoutView::UIPWorkoutView()
 {
@@ -9,6 +10,7 @@ UIPWorkoutView::UIPWorkoutView()
     m_y = 0;
     m_width = 0;
     m_height = 0;
+    m_elements = NULL;
 }
 
 UIPWorkoutView::UIPWorkoutView(UIWorkoutStage startingState)
@@ -16,38 +18,35 @@ UIPWorkoutView::UIPWorkoutView(UIWorkoutStage startingState)
     m_state = startingState;
     m_hidden = false;
     m_multiBars = true;
-    m_x = c_uipwvPosition.x;
-    m_y = c_uipwvPosition.y;
-    m_width = c_uipwvWidth;
-    m_height = c_uipwvHeight;
-
-    float uipwvUsableArea = c_uipwvWidth - (c_uipwvPaddingHorizontal*4);
-    float pbX = c_uipwvPosition.x - c_uipwvWidth/2 + c_uipwvPaddingHorizontal;
-    float pbWidth = uipwvUsableArea/3;
-
-    m_elements = new UIElement*[c_uipwvNumElements];
-    for ( int i = 0; i < c_uipwvNumElements; i ++ ) {
-        UIPWVElem iElem = static_cast<UIPWVElem>(i);
-        switch (iElem) {
-            case BG:
-                m_elements[i] = new UIImage("peloProgBG.pvr", 
-                    c_uipwvPosition.x, c_uipwvPosition.y, c_uipwvWidth, c_uipwvHeight);
-                break;
-            case SINGLE:
-                m_elements[i] = new UIProgressBar("peloProgUF.pvr", "peloProgFill.pvr",
-                    c_uipwvPosition.x, c_uipwvPosition.y, c_uipwvWidth-(2*c_uipwvPaddingHorizontal), 
-                    c_uipwvHeight-(2*c_uipwvPaddingVertical), 0, 0, 1);
-                m_elements[i]->Hide();
-                break;
-            default:
-                m_elements[i] = new UIProgressBar("peloProgUF.pvr", "peloProgFill.pvr", 
-                    pbX + (i-1) * (uipwvUsableArea/3) + (i-1)*c_uipwvPaddingHorizontal + pbWidth/2, c_uipwvPosition.y, pbWidth, 
-                    c_uipwvHeight - (2*c_uipwvPaddingVertical), 0, 0, 1);
-                break;
-        }
+    m_x = c_uipwvRect.x;
+    m_y = c_uipwvRect.y;
+    m_width = c_uipwvRect.width;
+    m_height = c_uipwvRect.height;
+
+    // The layout is worked out at compile time (see c_uipwvSprites)
+    m_arena.Init(c_uipwvArenaSize);
+    m_elements = m_arena.AllocArray<UIElement*>(c_uipwvNumElements);
+    const UISpriteCommand& bg = c_uipwvSprites[BG];
+    UIImage* bgImage = m_arena.Create<UIImage>("peloProgBG.pvr", bg.rect.x, bg.rect.y, bg.rect.width, bg.rect.height);
+    bgImage->SetTexCoords(bg.uv.u0, bg.uv.v0, bg.uv.u1, bg.uv.v1);
+    m_elements[BG] = bgImage;
+    // The bars are resized and refilled every frame, so their fill is
+    // clipped by the fill shader rather than rebuilt on the CPU
+    for ( int i = SINGLE; i < c_uipwvNumElements; i ++ ) {
+        const UIRect& rect = c_uipwvSprites[i].rect;
+        UIProgressBar* bar = m_arena.Create<UIProgressBar>((char*) "peloProgUF.pvr", (char*) "peloProgFill.pvr",
+            rect.x, rect.y, rect.width, rect.height, 0, 0, 1);
+        bar->SetShaderFill(true);
+        // The view lays out and fills the bars itself
+        UIDispatcher::Get()->Unsubscribe(bar);
+        m_elements[i] = bar;
     }
+    m_elements[SINGLE]->Hide();
 
-
+    UIDispatcher::Get()->Subscribe(this, UIFieldState);
+    UIDispatcher::Get()->Subscribe(this, UIFieldStage);
+    UIDispatcher::Get()->Subscribe(this, UIMultiProg);
+    UIDispatcher::Get()->Subscribe(this, UIStageProgress);
 }
 
 bool
@@ -133,12 +132,6 @@ UIPWorkoutView::Update(UIMessage updateMessage)
 
     m_multiBars = updateMessage.Read(UIMultiProg);
 
-    float bigProgWidth = 0.5 * (c_uipwvWidth - (4*c_uipwvPaddingHorizontal));
-    float smallProgWidth = 0.25 * (c_uipwvWidth - (4*c_uipwvPaddingHorizontal));
-    float progHeight = c_uipwvHeight - 2*c_uipwvPaddingVertical;
-    float selfPositionLeft = m_x - (m_width/2);
-    float usableSpace = c_uipwvWidth - (c_uipwvPaddingHorizontal*4);
-
     UIProgressBar* pb1 = (UIProgressBar*)m_elements[PB1];
     UIProgressBar* pb2 = (UIProgressBar*)m_elements[PB2];
     UIProgressBar* pb3 = (UIProgressBar*)m_elements[PB3];
@@ -158,54 +151,39 @@ UIPWorkoutView::Update(UIMessage updateMessage)
         pb3->Show();
     }
 
+    // Stages past the cooldown keep the cooldown layout
+    int stage = (m_state >= UIWarmup && m_state <= UICooldown) ? m_state : UICooldown;
+    UIProgressBar* bars[c_uipwvNumBars] = { pb1, pb2, pb3 };
+    for ( int i = 0; i < c_uipwvNumBars; i ++ ) {
+        const UIRect& rect = c_uipwvStageBars[stage][i];
+        bars[i]->SetSize(rect.width, rect.height);
+        bars[i]->SetPosition(rect.x, rect.y);
+    }
+
     switch (m_state) {
         case UIWarmup:
             m_activeBar = 0;
-            pb1->SetSize(bigProgWidth, progHeight);
-            pb1->SetPosition(selfPositionLeft + c_uipwvPaddingHorizontal + bigProgWidth/2, m_y);
-            pb1->SetCompletion(updateMessage.Read(UIFloat::UIStageProgress));
-            pb2->SetSize(smallProgWidth, progHeight);
-            pb2->SetPosition(selfPositionLeft + 2*c_uipwvPaddingHorizontal + 1*bigProgWidth + smallProgWidth/2, m_y);
-            pb2->SetCompletion(0);
-            pb3->SetSize(smallProgWidth, progHeight);
-            pb3->SetPosition(selfPositionLeft + 3*c_uipwvPaddingHorizontal + 1*bigProgWidth + 3*smallProgWidth/2, m_y);
-            pb3->SetCompletion(0);
+            pb1->AnimateCompletion(updateMessage.Read(UIFloat::UIStageProgress), c_pbAnimDuration);
+            pb2->AnimateCompletion(0, c_pbAnimDuration);
+            pb3->AnimateCompletion(0, c_pbAnimDuration);
             break;
         case UIWorkout:
             m_activeBar = 1;
-            pb1->SetSize(smallProgWidth, progHeight);
-            pb1->SetPosition(selfPositionLeft + c_uipwvPaddingHorizontal + smallProgWidth/2, m_y);
-            pb1->SetCompletion(1);
-            pb2->SetSize(bigProgWidth, progHeight);
-            pb2->SetPosition(selfPositionLeft + 2*c_uipwvPaddingHorizontal + 1*smallProgWidth + bigProgWidth/2, m_y);
-            pb2->SetCompletion(updateMessage.Read(UIStageProgress));
-            pb3->SetSize(smallProgWidth, progHeight);
-            pb3->SetPosition(selfPositionLeft + 3*c_uipwvPaddingHorizontal + 1*bigProgWidth + 3*smallProgWidth/2, m_y);
-            pb3->SetCompletion(0);
+            pb1->AnimateCompletion(1, c_pbAnimDuration);
+            pb2->AnimateCompletion(updateMessage.Read(UIStageProgress), c_pbAnimDuration);
+            pb3->AnimateCompletion(0, c_pbAnimDuration);
             break;
         case UICooldown:
             m_activeBar = 3;
-            pb1->SetSize(smallProgWidth, progHeight);
-            pb1->SetPosition(selfPositionLeft + c_uipwvPaddingHorizontal + smallProgWidth/2, m_y);
-            pb1->SetCompletion(1);
-            pb2->SetSize(smallProgWidth, progHeight);
-            pb2->SetPosition(selfPositionLeft + 2*c_uipwvPaddingHorizontal + 3*smallProgWidth/2, m_y);
-            pb2->SetCompletion(1);
-            pb3->SetSize(bigProgWidth, progHeight);
-            pb3->SetPosition(selfPositionLeft + 3*c_uipwvPaddingHorizontal + 2*smallProgWidth + bigProgWidth/2, m_y);
-            pb3->SetCompletion(updateMessage.Read(UIStageProgress));
+            pb1->AnimateCompletion(1, c_pbAnimDuration);
+            pb2->AnimateCompletion(1, c_pbAnimDuration);
+            pb3->AnimateCompletion(updateMessage.Read(UIStageProgress), c_pbAnimDuration);
             break;
         default:
             m_activeBar = 0;
-            pb1->SetSize(smallProgWidth, progHeight);
-            pb1->SetPosition(selfPositionLeft + c_uipwvPaddingHorizontal + smallProgWidth/2, m_y);
-            pb1->SetCompletion(0);
-            pb2->SetSize(smallProgWidth, progHeight);
-            pb2->SetPosition(selfPositionLeft + 2*c_uipwvPaddingHorizontal + 3*smallProgWidth/2, m_y);
-            pb2->SetCompletion(0);
-            pb3->SetSize(bigProgWidth, progHeight);
-            pb3->SetPosition(selfPositionLeft + 3*c_uipwvPaddingHorizontal + 2*smallProgWidth + bigProgWidth/2, m_y);
-            pb3->SetCompletion(0);
+            pb1->AnimateCompletion(0, c_pbAnimDuration);
+            pb2->AnimateCompletion(0, c_pbAnimDuration);
+            pb3->AnimateCompletion(0, c_pbAnimDuration);
             break;
     }
 }
@@ -225,12 +203,15 @@ UIPWorkoutView::Show()
 void 
 UIPWorkoutView::Delete()
 {
+    UIDispatcher::Get()->Unsubscribe(this);
+    if (m_elements == NULL) {
+        return;
+    }
     for ( int i = 0; i < c_uipwvNumElements; i ++ ) {
         if (m_elements[i] != NULL) {
             m_elements[i]->Delete();
-            delete m_elements[i];
-            m_elements[i] = NULL;
         }
     }
-    delete [] m_elements;
+    m_arena.Delete();
+    m_elements = NULL;
 }
\ No newline at end of file
@@ -16,22 +16,68 @@
 #include "UIMessage.h"
 #include "UIImage.h"
 #include "UIProgressBar.h"
+#include "UIArena.h"
+#include "UILayoutDSL.h"
 
 #ifndef _UIPWORKOUTVIEW_H
 #define _UIPWORKOUTVIEW_H
 
-const float c_uipwvWidth = 465;
-const float c_uipwvHeight = 50;
-const float c_uipwvPaddingHorizontal = 10;
-const float c_uipwvPaddingVertical = 10;
-const float c_uipwvActiveBarSize = 0.5;
+constexpr float c_uipwvWidth = 465;
+constexpr float c_uipwvHeight = 50;
+constexpr float c_uipwvPaddingHorizontal = 10;
+constexpr float c_uipwvPaddingVertical = 10;
+constexpr float c_uipwvActiveBarSize = 0.5;
 const int c_uipwvNumElements = 5;
-const PVRTVec2 c_uipwvPosition = {105, 450};
+
+// Size of the arena holding the UIPWorkoutView's elements
+const size_t c_uipwvArenaSize = UIArenaArraySize<UIElement*>(c_uipwvNumElements)
+    + UIArenaSize<UIImage>(1) + UIArenaSize<UIProgressBar>(c_uipwvNumElements - 1);
 
 enum UIPWVElem {
     BG, SINGLE, PB1, PB2, PB3
 };
 
+// Number of stage progress bars shown in multi bar mode
+const int c_uipwvNumBars = 3;
+
+// Background rect, and the area inside its padding that the bars fill
+constexpr UIRect c_uipwvRect = { 105, 450, c_uipwvWidth, c_uipwvHeight };
+constexpr UIRect c_uipwvContent = UIInset(c_uipwvRect, c_uipwvPaddingHorizontal, c_uipwvPaddingVertical);
+
+// Widths of the stage bars. The bars share the content area less the gaps
+// between them, and the active stage's bar is bigger than the other two.
+constexpr float c_uipwvBarArea = c_uipwvContent.width - (c_uipwvNumBars - 1) * c_uipwvPaddingHorizontal;
+constexpr float c_uipwvEvenBar = c_uipwvBarArea / c_uipwvNumBars;
+constexpr float c_uipwvBigBar = c_uipwvActiveBarSize * c_uipwvBarArea;
+constexpr float c_uipwvSmallBar = (1 - c_uipwvActiveBarSize) / 2 * c_uipwvBarArea;
+
+// Sprites of the view's elements, in UIPWVElem order
+constexpr UISpriteCommand c_uipwvSprites[c_uipwvNumElements] = {
+    UISprite(BG, c_uipwvRect),
+    UISprite(SINGLE, c_uipwvContent),
+    UISprite(PB1, UIRowSlot(c_uipwvContent, c_uipwvPaddingHorizontal, 0, c_uipwvEvenBar, c_uipwvEvenBar, c_uipwvEvenBar)),
+    UISprite(PB2, UIRowSlot(c_uipwvContent, c_uipwvPaddingHorizontal, 1, c_uipwvEvenBar, c_uipwvEvenBar, c_uipwvEvenBar)),
+    UISprite(PB3, UIRowSlot(c_uipwvContent, c_uipwvPaddingHorizontal, 2, c_uipwvEvenBar, c_uipwvEvenBar, c_uipwvEvenBar))
+};
+
+// Stage bar rects for each workout stage (UIWarmup, UIWorkout, UICooldown)
+#define UIPWV_STAGE_BARS(w0, w1, w2) { \
+    UIRowSlot(c_uipwvContent, c_uipwvPaddingHorizontal, 0, w0, w1, w2), \
+    UIRowSlot(c_uipwvContent, c_uipwvPaddingHorizontal, 1, w0, w1, w2), \
+    UIRowSlot(c_uipwvContent, c_uipwvPaddingHorizontal, 2, w0, w1, w2) }
+constexpr UIRect c_uipwvStageBars[][c_uipwvNumBars] = {
+    UIPWV_STAGE_BARS(c_uipwvBigBar, c_uipwvSmallBar, c_uipwvSmallBar),
+    UIPWV_STAGE_BARS(c_uipwvSmallBar, c_uipwvBigBar, c_uipwvSmallBar),
+    UIPWV_STAGE_BARS(c_uipwvSmallBar, c_uipwvSmallBar, c_uipwvBigBar)
+};
+#undef UIPWV_STAGE_BARS
+
+static_assert(UIRowTotal(c_uipwvPaddingHorizontal, c_uipwvEvenBar, c_uipwvEvenBar, c_uipwvEvenBar)
+    <= c_uipwvContent.width, "UIPWorkoutView bars overflow the background");
+static_assert(UIRowTotal(c_uipwvPaddingHorizontal, c_uipwvBigBar, c_uipwvSmallBar, c_uipwvSmallBar)
+    <= c_uipwvContent.width, "UIPWorkoutView stage bars overflow the background");
+static_assert(UIContains(c_uipwvRect, c_uipwvSprites[PB3].rect), "UIPWorkoutView bar outside the background");
+
 /*!****************************************************************************
  @class UIPWorkoutView
  Object class. The UIPWorkoutView is a peloton specific component of the workout
@@ -64,6 +110,9 @@ class UIPWorkoutView : public UIElement
 		// The current peloton workout stage
         UIWorkoutStage m_state;
 
+        // Arena that owns the child elements and the element array
+        UIArena m_arena;
+
         UIElement** m_elements;
 
 		// A map from each possible workout stage to the array of elements that
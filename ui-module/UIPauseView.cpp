@@ -12,6 +12,8 @@
 ******************************************************************************/
 
 #include "UIPauseView.h"
+#include "UIDispatcher.h"
+#include "UIStateTable.h"
 
 /*!****************************************************************************
  @Function		Constructor
@@ -21,30 +23,34 @@
 UIPauseView::UIPauseView()
 {
 	m_hidden = false;
-	m_elements = new UIElement*[c_numPVElements];
+	m_resume = false;
+	m_arena.Init(c_PVArenaSize);
+	m_elements = m_arena.AllocArray<UIElement*>(c_numPVElements);
 	for ( int i = 0; i < c_numPVElements; i ++ ) {
 		PVLayoutSpec layoutSpec = c_PVLayoutSpecs[i];
 		switch(layoutSpec.type) {
 			case PVIcon:
-				m_elements[i] = new UIImage("pause.pvr", layoutSpec.x, layoutSpec.y, layoutSpec.width, layoutSpec.height);
+				m_elements[i] = m_arena.Create<UIImage>((char*) "pause.pvr", layoutSpec.x, layoutSpec.y, layoutSpec.width, layoutSpec.height);
 				break;
 			case PVResumeButton:
-				m_elements[i] = new UIButton("Resume", layoutSpec.x, layoutSpec.y, 0xFFFFFFFF, 0xFFFFFFFF, UIResumeButtonActive);
+				m_elements[i] = m_arena.Create<UIButton>((char*) "Resume", layoutSpec.x, layoutSpec.y, 0xFFFFFFFF, 0xFFFFFFFF, UIResumeButtonActive);
 				break;
 			case PVVolumeButton:
-				m_elements[i] = new UIButton("Volume", layoutSpec.x, layoutSpec.y, 0xFFFFFFFF, 0xFFFFFFFF, UIVolumeButtonActive);
+				m_elements[i] = m_arena.Create<UIButton>((char*) "Volume", layoutSpec.x, layoutSpec.y, 0xFFFFFFFF, 0xFFFFFFFF, UIVolumeButtonActive);
 				break;
 			case PVBrightnessButton:
-				m_elements[i] = new UIButton("Brightness", layoutSpec.x, layoutSpec.y, 0xFFFFFFFF, 0xFFFFFFFF, UIBrightButtonActive);
+				m_elements[i] = m_arena.Create<UIButton>((char*) "Brightness", layoutSpec.x, layoutSpec.y, 0xFFFFFFFF, 0xFFFFFFFF, UIBrightButtonActive);
 				break;
 			case PVEndButton:
-				m_elements[i] = new UIButton("End", layoutSpec.x, layoutSpec.y, 0xFFFFFFFF, 0xFFFFFFFF, UIEndButtonActive);
+				m_elements[i] = m_arena.Create<UIButton>((char*) "End", layoutSpec.x, layoutSpec.y, 0xFFFFFFFF, 0xFFFFFFFF, UIEndButtonActive);
 				break;
 			default:
 				m_elements[i] = NULL;
 				break;
 		}
 	}
+	UIDispatcher::Get()->Subscribe(this, UIFieldState);
+	m_stateSlot = UIStateTable::Get()->Register(1u << UIPause);
 }
 
 /*!****************************************************************************
@@ -87,7 +93,7 @@ UIPauseView::BuildVertices()
 bool
 UIPauseView::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 {
-	if (m_hidden) {
+	if (m_hidden || !UIStateTable::Get()->IsVisible(m_stateSlot)) {
 		return true;
 	}
 	for ( int i = 0 ; i < c_numPVElements; i ++ ) {
@@ -106,12 +112,11 @@ UIPauseView::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 void
 UIPauseView::Update(UIMessage updateMessage)
 {
-	if (updateMessage.ReadState() != UIPause) {
-		// fprintf(stderr, "State: UISummary\n");
-		m_hidden = true;
+	UIStateTable::Get()->SetState(updateMessage.ReadState());
+	// Shown in UIPause only. During a dispatch the buttons are updated by
+	// the UIDispatcher.
+	if (!UIStateTable::Get()->IsVisible(m_stateSlot) || UIDispatcher::Get()->IsDispatching()) {
 		return;
-	} else {
-		m_hidden = false;
 	}
 	for ( int i = 0; i < c_numPVElements; i ++ ) {
 		m_elements[i]->Update(updateMessage);
@@ -151,15 +156,20 @@ UIPauseView::ResumeSelected()
 
 /*!****************************************************************************
  @Function		Delete
- @Description	Frees any memory allocated within the object
+ @Description	Frees any memory allocated within the object. The elements free
+				their own GL objects, then the arena frees the elements.
 ******************************************************************************/
 void
 UIPauseView::Delete()
 {
+	UIDispatcher::Get()->Unsubscribe(this);
+	UIStateTable::Get()->Unregister(m_stateSlot);
+	m_stateSlot = -1;
 	for ( int i = 0 ; i < c_numPVElements; i ++ ) {
-		if (m_elements == NULL && m_elements[i] != NULL) {
-			delete m_elements[i];
-			m_elements[i] = NULL;
+		if (m_elements != NULL && m_elements[i] != NULL) {
+			m_elements[i]->Delete();
 		}
 	}
+	m_arena.Delete();
+	m_elements = NULL;
 }
\ No newline at end of file
@@ -14,6 +14,7 @@
 #include "UIElement.h"
 #include "UIImage.h"
 #include "UIButton.h"
+#include "UIArena.h"
 
 #ifndef _UIPAUSEVIEW_H
 #define _UIPAUSEVIEW_H
@@ -39,6 +40,10 @@ const PVLayoutSpec c_PVLayoutSpecs[] = {
 	{ PVEndButton, 0, -310, 360, 40 }
 };
 
+// Size of the arena holding the UIPauseView's elements
+const size_t c_PVArenaSize = UIArenaArraySize<UIElement*>(c_numPVElements)
+	+ UIArenaSize<UIImage>(1) + UIArenaSize<UIButton>(4);
+
 /*!****************************************************************************
  @class UIElement
 Object class. The UIPauseView is container UIElement used to house and display
@@ -49,12 +54,19 @@ class UIPauseView : public UIElement
 	protected:
 		// Instance variables:
 		
+		// Arena that owns the child elements and the element array
+		UIArena m_arena;
+
 		// Child elements
 		UIElement** m_elements;
 
 		// Is the UIPV hidden?
 		bool m_hidden;
 
+		// Slot in the UIStateTable, which decides the states the UIPV is
+		// shown in
+		int m_stateSlot;
+
 		// Is the resume button selected?
 		bool m_resume;
 		
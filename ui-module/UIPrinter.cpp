@@ -6,6 +6,45 @@
 ******************************************************************************/
 
 #include "UIPrinter.h"
+#include "UISpriteStore.h"
+#include "UIFrameCache.h"
+#include "UISpriteBatch.h"
+
+// Glyph text shaders. Glyph quads are in pixel coordinates and the font
+// textures only carry coverage in their alpha channel
+static const char* c_textVertShader =
+	"attribute highp vec2 inVertex;\n"
+	"attribute mediump vec2 inTexCoord;\n"
+	"uniform highp mat4 myPMVMatrix;\n"
+	"varying mediump vec2 TexCoord;\n"
+	"void main()\n"
+	"{\n"
+	"	gl_Position = myPMVMatrix * vec4(inVertex, 0.0, 1.0);\n"
+	"	TexCoord = inTexCoord;\n"
+	"}\n";
+
+static const char* c_textFragShader =
+	"uniform sampler2D sTexture;\n"
+	"uniform lowp vec4 uColour;\n"
+	"varying mediump vec2 TexCoord;\n"
+	"void main()\n"
+	"{\n"
+	"	gl_FragColor = vec4(uColour.rgb, uColour.a * texture2D(sTexture, TexCoord).a);\n"
+	"}\n";
+
+/*!****************************************************************************
+ @Function		flushSprites
+ @Description	HELPER - draws the images a capturing UISpriteBatch has queued,
+				so text drawn straight away lands on top of them
+******************************************************************************/
+static void
+flushSprites()
+{
+	UISpriteBatch* batch = UISpriteBatch::GetCapturing();
+	if (batch != NULL) {
+		batch->Flush();
+	}
+}
 
 /*!****************************************************************************
  @Function		Constructor
@@ -17,6 +56,13 @@ UIPrinter::UIPrinter()
 		UIFont iFont = static_cast<UIFont>(i);
 		m_fontMap[iFont] = new CPVRTPrint3D();
 	}
+	m_isRotated = false;
+	SetViewport(1280, 720);
+	m_textMVPLoc = -1;
+	m_textColorLoc = -1;
+	m_uiQuadIndexVbo = 0;
+	m_layoutEpoch = 0;
+	m_batchTexture = 0;
 }
 
 /*!****************************************************************************
@@ -30,6 +76,8 @@ UIPrinter::LoadFonts(int pvrShellWidth, int pvrShellHeight, bool isRotated)
 {
 	fprintf(stderr, "Loading fonts \n");
 	m_isRotated = isRotated;
+	SetViewport(pvrShellWidth, pvrShellHeight);
+	m_measureCache.Clear();
 	for ( int i = UIFBold; i <= UIFMedium; i ++ ) {
 		UIFont iFont = static_cast<UIFont>(i);
 		CPVRTPrint3D* print3D = m_fontMap[iFont];
@@ -66,6 +114,27 @@ UIPrinter::LoadFonts(int pvrShellWidth, int pvrShellHeight, bool isRotated)
 			// 	break;
 		}
 	}
+
+	CPVRTString errorStr;
+	if (!loadGlyphFonts(&errorStr)) {
+		fprintf(stderr, "%s\n", errorStr.c_str());
+		return false;
+	}
+
+#ifdef UIKIT_SDF_TEXT
+	m_sdfFont.Delete();
+	if (!m_sdfFont.Load((const void *) _UISDFAtlas_pvr, &errorStr)) {
+		fprintf(stderr, "%s\n", errorStr.c_str());
+		return false;
+	}
+#endif
+#if defined(UIKIT_SDF_TEXT) || defined(UIKIT_BATCH_TEXT)
+	if (!m_textBatch.Init(&errorStr)) {
+		fprintf(stderr, "%s\n", errorStr.c_str());
+		return false;
+	}
+	m_batchTexture = 0;
+#endif
 	return true;
 }
 
@@ -86,6 +155,32 @@ UIPrinter::Print(float x, float y, float scale, GLuint color, UIFont font, char*
 		return;
 	}
 
+#if defined(UIKIT_SDF_TEXT)
+	// Fonts missing from the atlas fall back to the bold face
+	int face = m_sdfFont.HasFace(font) ? font : UIFBold;
+	m_batchTexture = m_sdfFont.GetTexture();
+	if (!m_textBatch.Add(&m_sdfFont, face, x, y, scale, color, text)) {
+		Flush();
+		m_textBatch.Add(&m_sdfFont, face, x, y, scale, color, text);
+	}
+#elif defined(UIKIT_BATCH_TEXT)
+	UIGlyphFont* glyphFont = GetGlyphFont(font);
+	if (glyphFont == NULL) {
+		return;
+	}
+	// Only happens if the fonts couldn't be packed into the atlas
+	if (glyphFont->GetTexture() != m_batchTexture) {
+		Flush();
+		m_batchTexture = glyphFont->GetTexture();
+	}
+	UIGlyphVertex quads[4 * c_maxTextQuads];
+	int numQuads = glyphFont->Layout(x, y, scale, text, quads, c_maxTextQuads);
+	if (!m_textBatch.AddQuads(quads, numQuads, color)) {
+		Flush();
+		m_textBatch.AddQuads(quads, numQuads, color);
+	}
+#else
+
 	// if (m_isRotated) {
 	// 	if (y > 0) {
 	// 		y += 200;
@@ -94,32 +189,24 @@ UIPrinter::Print(float x, float y, float scale, GLuint color, UIFont font, char*
 	// 	}
 	// }
 
-	// fprintf(stderr, "UIPrinter::Print called \n");
-    GLint viewport[4];
-    GLint vWidth;                           // Viewport width
-    GLint vHeight;                          // Viewport height
-	glGetIntegerv(GL_VIEWPORT, viewport);
-
-	vWidth = viewport[2];
-	vHeight = viewport[3];
-
 	CPVRTPrint3D* print3D = m_fontMap[font];
 
 	float textWidth;
 	float textHeight;
 
-	print3D->MeasureText(&textWidth, &textHeight, scale, text);
+	m_measureCache.Measure(print3D, &textWidth, &textHeight, scale, text);
+	flushSprites();
 
-	if (m_isRotated) {
-		if (print3D->Print3D((100*(x - (textWidth)/2)/vHeight)+50, -(100*(y + (textHeight)/2)/vWidth)+50, scale, color, text) != PVR_SUCCESS) {
-			fprintf(stderr, "UIPrint failed \n");
-		}	
-	} else {
-		if (print3D->Print3D((100*(x - (textWidth)/2)/vWidth)+50, -(100*(y + (textHeight)/2)/vHeight)+50, scale, color, text) != PVR_SUCCESS) {
-			fprintf(stderr, "UIPrint failed \n");
-		}	
+	// Print3D rotates its own output (see SetTextures), so text is placed
+	// as a percentage of the logical screen
+	if (print3D->Print3D((100*(x - (textWidth)/2)/m_logicalWidth)+50, -(100*(y + (textHeight)/2)/m_logicalHeight)+50, scale, color, text) != PVR_SUCCESS) {
+		fprintf(stderr, "UIPrint failed \n");
 	}
 	print3D->Flush();
+	// Print3D resets the blend function, which breaks the premultiplied
+	// alpha of a cached overlay
+	UIFrameCache::Get()->RestoreBlend();
+#endif
 }
 
 /*!****************************************************************************
@@ -129,7 +216,8 @@ UIPrinter::Print(float x, float y, float scale, GLuint color, UIFont font, char*
  @Input			scale		Text scale
  @Input			font		The text's font
  @Input			text		The actual text being measured
- @Description	Measures text
+ @Description	Measures text. Repeated measurements of the same text are
+				served from the measurement cache.
 ******************************************************************************/
 void
 UIPrinter::Measure(float* width, float* height, float scale, UIFont font, char* text)
@@ -139,8 +227,32 @@ UIPrinter::Measure(float* width, float* height, float scale, UIFont font, char*
 		return;
 	}
 
-	CPVRTPrint3D* print3D = m_fontMap[font];
-	print3D->MeasureText(width, height, scale, text);
+#if defined(UIKIT_SDF_TEXT)
+	m_sdfFont.Measure(m_sdfFont.HasFace(font) ? font : UIFBold, width, height, scale, text);
+#elif defined(UIKIT_BATCH_TEXT)
+	m_glyphFontMap[font]->Measure(width, height, scale, text);
+#else
+	m_measureCache.Measure(m_fontMap[font], width, height, scale, text);
+#endif
+}
+
+/*!****************************************************************************
+ @Function		Flush
+ @Description	Draws any text queued by Print. Only batched (UIKIT_BATCH_TEXT
+				and UIKIT_SDF_TEXT) builds queue text, so this does nothing
+				otherwise. Should be called once at the end of every frame,
+				after the UI has rendered.
+******************************************************************************/
+void
+UIPrinter::Flush()
+{
+	if (m_textBatch.GetQuadCount() == 0) {
+		return;
+	}
+	flushSprites();
+	PVRTMat4 mProjection;
+	GetPixelProjection(&mProjection);
+	m_textBatch.Flush(mProjection, m_batchTexture);
 }
 
 /*!****************************************************************************
@@ -154,6 +266,272 @@ UIPrinter::Rotated()
 	return m_isRotated;
 }
 
+/*!****************************************************************************
+ @Function		GetPrint3D
+ @Input			font			The font identifier
+ @Return		CPVRTPrint3D*	The print3D object loaded with the font
+ @Description	Returns the print3D object for a font so that legacy Print2D
+				views can share the UIPrinter's fonts
+******************************************************************************/
+CPVRTPrint3D*
+UIPrinter::GetPrint3D(UIFont font)
+{
+	if (!m_fontMap.Exists(font)) {
+		return NULL;
+	}
+	return m_fontMap[font];
+}
+
+/*!****************************************************************************
+ @Function		GetMeasureCache
+ @Return		UIMeasureCache*		The printer's measurement cache
+ @Description	Returns the measurement cache so that it can be shared with the
+				legacy Print2D path
+******************************************************************************/
+UIMeasureCache*
+UIPrinter::GetMeasureCache()
+{
+	return &m_measureCache;
+}
+
+/*!****************************************************************************
+ @Function		GetGlyphFont
+ @Input			font			The font identifier
+ @Return		UIGlyphFont*	The glyph font loaded with the font
+ @Description	Returns the glyph font used to lay out static text
+******************************************************************************/
+UIGlyphFont*
+UIPrinter::GetGlyphFont(UIFont font)
+{
+	if (!m_glyphFontMap.Exists(font)) {
+		return NULL;
+	}
+	return m_glyphFontMap[font];
+}
+
+/*!****************************************************************************
+ @Function		SetViewport
+ @Input			width		Width of the viewport in screen pixels
+ @Input			height		Height of the viewport in screen pixels
+ @Description	Builds the root transform that takes pixel coordinates (origin
+				at the center of the screen, y up) to normalized device
+				coordinates, turning them a quarter turn when the display is
+				rotated. Every UIKit draw goes through this one matrix, so
+				elements only ever work in pixel coordinates and rotated frames
+				cost the same as upright ones. The transform is shared with
+				the images through the UISpriteStore. Called by LoadFonts; call
+				it again if the viewport changes (and re-Init the UIFrameCache,
+				whose cached overlay is the size of the viewport).
+******************************************************************************/
+void
+UIPrinter::SetViewport(int width, int height)
+{
+	float vWidth = width;
+	float vHeight = height;
+
+	for ( int i = 0; i < 16; i ++ ) {
+		m_rootTransform.f[i] = 0;
+	}
+	if (m_isRotated) {
+		m_rootTransform.f[4] = -2/vWidth;
+		m_rootTransform.f[1] = 2/vHeight;
+		m_logicalWidth = vHeight;
+		m_logicalHeight = vWidth;
+	} else {
+		m_rootTransform.f[0] = 2/vWidth;
+		m_rootTransform.f[5] = 2/vHeight;
+		m_logicalWidth = vWidth;
+		m_logicalHeight = vHeight;
+	}
+	m_rootTransform.f[10] = 1;
+	m_rootTransform.f[15] = 1;
+
+	*UISpriteStore::Get()->GetProjection() = m_rootTransform;
+	UIFrameCache::Get()->MarkDirty();
+}
+
+/*!****************************************************************************
+ @Function		GetPixelProjection
+ @Output		projection		Matrix from pixel to device coordinates
+ @Description	Returns the root transform built by SetViewport
+******************************************************************************/
+void
+UIPrinter::GetPixelProjection(PVRTMat4* projection)
+{
+	*projection = m_rootTransform;
+}
+
+/*!****************************************************************************
+ @Function		DrawGlyphs
+ @Input			vbo			Vertex buffer of UIGlyphVertex quads
+ @Input			numQuads	Number of quads in the buffer
+ @Input			x, y		Pixel offset applied to the quads
+ @Input			color		Text color (Print3D ABGR format)
+ @Input			font		Font the quads were laid out with
+ @Description	Draws pre-laid-out glyph quads. The offset and color are applied
+				in the shader so that moving or recoloring text never requires
+				the quads to be rebuilt.
+******************************************************************************/
+void
+UIPrinter::DrawGlyphs(GLuint vbo, int numQuads, float x, float y, GLuint color, UIFont font)
+{
+	UIGlyphFont* glyphFont = GetGlyphFont(font);
+	if (glyphFont == NULL || vbo == 0 || numQuads <= 0) {
+		return;
+	}
+	if (numQuads > c_maxTextQuads) {
+		numQuads = c_maxTextQuads;
+	}
+	flushSprites();
+
+	PVRTMat4 mProjection, mTrans, mMVP;
+	GetPixelProjection(&mProjection);
+	PVRTMatrixTranslation(mTrans, x, y, 0);
+	mMVP = mProjection * mTrans;
+
+	m_textShader.Use();
+	glUniformMatrix4fv(m_textMVPLoc, 1, GL_FALSE, mMVP.f);
+	glUniform4f(m_textColorLoc, (color & 0xFF)/255.0f, ((color >> 8) & 0xFF)/255.0f,
+		((color >> 16) & 0xFF)/255.0f, ((color >> 24) & 0xFF)/255.0f);
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, glyphFont->GetTexture());
+
+	glEnableVertexAttribArray(c_textVertexAttrib);
+	glEnableVertexAttribArray(c_textTexCoordAttrib);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glVertexAttribPointer(c_textVertexAttrib, 2, GL_FLOAT, GL_FALSE, sizeof(UIGlyphVertex), 0);
+	glVertexAttribPointer(c_textTexCoordAttrib, 2, GL_FLOAT, GL_FALSE, sizeof(UIGlyphVertex), (GLvoid*)(2 * sizeof(float)));
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_uiQuadIndexVbo);
+	glDrawElements(GL_TRIANGLES, 6 * numQuads, GL_UNSIGNED_SHORT, 0);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	glDisableVertexAttribArray(c_textVertexAttrib);
+	glDisableVertexAttribArray(c_textTexCoordAttrib);
+	m_textShader.Restore();
+}
+
+/*!****************************************************************************
+ @Function		GetLayoutEpoch
+ @Return		unsigned int	The current layout epoch
+ @Description	Returns a counter that changes whenever the fonts are reloaded.
+				Elements that cache glyph layouts compare it against the epoch
+				they were laid out in.
+******************************************************************************/
+unsigned int
+UIPrinter::GetLayoutEpoch()
+{
+	return m_layoutEpoch;
+}
+
+/*!****************************************************************************
+ @Function		loadGlyphFonts
+ @Output		pErrorStr	Error message on failure
+ @Description	HELPER - loads a glyph font for every font identifier, packs
+				them into the glyph atlas, builds the text shader and the
+				shared quad index buffer
+******************************************************************************/
+bool
+UIPrinter::loadGlyphFonts(CPVRTString* const pErrorStr)
+{
+	deleteGlyphFonts();
+
+	const void* loadedData[UIFLight + 1];
+	for ( int i = UIFBold; i <= UIFMedium; i ++ ) {
+		UIFont iFont = static_cast<UIFont>(i);
+		const void* fontData = NULL;
+		switch(iFont) {
+			case UIFBold:
+				fontData = (const void *) _PelotareSans_200wt_pvr;
+				break;
+			case UIFMedium:
+				fontData = (const void *) _PelotareSans_200wt_pvr;
+				break;
+			default:
+				break;
+		}
+		loadedData[i] = fontData;
+
+		// Fonts that use the same texture share a glyph font
+		UIGlyphFont* glyphFont = NULL;
+		for ( int j = UIFBold; j < i; j ++ ) {
+			if (loadedData[j] == fontData) {
+				glyphFont = m_glyphFontMap[static_cast<UIFont>(j)];
+				break;
+			}
+		}
+		if (glyphFont == NULL) {
+			glyphFont = new UIGlyphFont();
+			if (!glyphFont->Load(fontData, pErrorStr)) {
+				delete glyphFont;
+				return false;
+			}
+			m_glyphFonts.Append(glyphFont);
+		}
+		m_glyphFontMap[iFont] = glyphFont;
+	}
+
+	// Fonts that can't be packed together keep their own textures
+	if (!m_glyphAtlas.Build(&m_glyphFonts[0], m_glyphFonts.GetSize(), pErrorStr)) {
+		fprintf(stderr, "%s, using separate font textures\n", pErrorStr->c_str());
+		for ( int i = 0; i < (int)m_glyphFonts.GetSize(); i ++ ) {
+			if (!m_glyphFonts[i]->LoadTexture(pErrorStr)) {
+				return false;
+			}
+		}
+	}
+
+	if (m_textShader.GetProgram() == 0) {
+		const UIShaderAttrib attribs[] = {
+			{ "inVertex", c_textVertexAttrib },
+			{ "inTexCoord", c_textTexCoordAttrib }
+		};
+		if (!m_textShader.Build(c_textVertShader, c_textFragShader, attribs, 2, pErrorStr)) {
+			return false;
+		}
+		m_textMVPLoc = m_textShader.GetUniform("myPMVMatrix");
+		m_textColorLoc = m_textShader.GetUniform("uColour");
+	}
+
+	if (m_uiQuadIndexVbo == 0) {
+		// Quads are laid out top left, top right, bottom left, bottom right
+		unsigned short indices[6 * c_maxTextQuads];
+		for ( int i = 0; i < c_maxTextQuads; i ++ ) {
+			unsigned short base = (unsigned short)(4 * i);
+			indices[6*i] = base;
+			indices[6*i + 1] = base + 2;
+			indices[6*i + 2] = base + 3;
+			indices[6*i + 3] = base;
+			indices[6*i + 4] = base + 3;
+			indices[6*i + 5] = base + 1;
+		}
+		glGenBuffers(1, &m_uiQuadIndexVbo);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_uiQuadIndexVbo);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
+
+	m_layoutEpoch ++;
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		deleteGlyphFonts
+ @Description	HELPER - frees the printer's glyph fonts
+******************************************************************************/
+void
+UIPrinter::deleteGlyphFonts()
+{
+	for ( int i = 0; i < (int)m_glyphFonts.GetSize(); i ++ ) {
+		m_glyphFonts[i]->Delete();
+		delete m_glyphFonts[i];
+	}
+	m_glyphFonts.Clear();
+	m_glyphFontMap.Clear();
+	m_glyphAtlas.Delete();
+}
+
 /*!****************************************************************************
  @Function		Delete
  @Description	Frees allocated memory within the printer
@@ -169,4 +547,17 @@ UIPrinter::Delete()
 			m_fontMap[iFont] = NULL;
 		}
 	}
+	m_measureCache.Clear();
+
+	deleteGlyphFonts();
+	m_textShader.Delete();
+	m_textBatch.Delete();
+#ifdef UIKIT_SDF_TEXT
+	m_sdfFont.Delete();
+#endif
+	if (m_uiQuadIndexVbo != 0) {
+		glDeleteBuffers(1, &m_uiQuadIndexVbo);
+		m_uiQuadIndexVbo = 0;
+	}
+	m_layoutEpoch ++;
 }
\ No newline at end of file
@@ -14,17 +14,27 @@
 // #include "Fonts/MontserratMedium.h"
 #include "UIMessage.h"
 #include "Fonts/Pelotare200.h"
+#include "UIMeasureCache.h"
+#include "UIGlyphFont.h"
+#include "UIGlyphAtlas.h"
+#include "UIShader.h"
+#include "UISDFFont.h"
+#include "UITextBatch.h"
+#ifdef UIKIT_SDF_TEXT
+#include "Fonts/UISDFAtlas.h"
+#endif
 // #include "Fonts/MontserratRegular.h"
 // #include "Fonts/MontserratThin.h"
 // #include "Fonts/MontserratLight.h"
 
-// Enum font identifiers
+// Enum font identifiers. UINumFonts counts the fonts.
 enum UIFont {
 	UIFBold,
 	UIFMedium,
 	UIFRegular,
 	UIFThin,
-	UIFLight
+	UIFLight,
+	UINumFonts
 };
 
 // struct used to store updating text 
@@ -36,13 +46,29 @@ struct UITextSpec {
 	UIFont font;
 };
 
+// Attribute indices used by the glyph text shader. These match IVERTEX_ARRAY and
+// ITEXCOORD_ARRAY in UIImage.h
+const GLuint c_textVertexAttrib = 0;
+const GLuint c_textTexCoordAttrib = 3;
+
 /*!****************************************************************************
  @class UIPrinter
  Object class. A UIPrinter is a wrapper for a map of enum identifiers to CPVRTPrint3D
  objects. Each identifier represents a font and each CPVRTPrint3D object is intended
  to be preloaded with said font's textures. The UIPrinter contains functionality
  for initializing the print3D objects, measuring text, and printing via print3D
- with a desired font.
+ with a desired font. Text measurements are memoized in a UIMeasureCache that is
+ shared with the legacy Print2D classes. Alongside the print3D objects the
+ printer loads a UIGlyphFont for each font along with a text shader and a shared
+ quad index buffer, so that static text can be laid out once into a vertex
+ buffer (see UIStaticText) and drawn with DrawGlyphs every frame. The glyph
+ fonts' glyphs are packed into a single UIGlyphAtlas texture.
+
+ When built with UIKIT_BATCH_TEXT, Print lays text out with the glyph fonts and
+ queues it into a UITextBatch. Since every font draws from the atlas, all of a
+ frame's text is drawn with a single draw call when Flush is called at the end
+ of the frame. UIKIT_SDF_TEXT does the same with a signed distance field atlas
+ (generated by tools/SDFFontGen) holding every font.
 ******************************************************************************/
 class UIPrinter
 {
@@ -52,16 +78,67 @@ class UIPrinter
 		// Is the text rotated?
 	 	bool m_isRotated;
 
+		// Transform from pixel to device coordinates applied to the whole UI,
+		// and the size of the screen in pixel coordinates (width and height
+		// are swapped when the display is rotated)
+		PVRTMat4 m_rootTransform;
+		float m_logicalWidth, m_logicalHeight;
+
 		 // Mapping from font identifiers to print3D objects
 		CPVRTMap<UIFont, CPVRTPrint3D*> m_fontMap;
 
+		// Cache of text measurements keyed by font, scale and text
+		UIMeasureCache m_measureCache;
+
+		// Mapping from font identifiers to glyph fonts. Fonts that share a
+		// texture share a glyph font
+		CPVRTMap<UIFont, UIGlyphFont*> m_glyphFontMap;
+
+		// Glyph fonts owned by the printer
+		CPVRTArray<UIGlyphFont*> m_glyphFonts;
+
+		// Shader used to draw glyph quads and its uniforms
+		UIShader m_textShader;
+		GLint m_textMVPLoc, m_textColorLoc;
+
+		// Index buffer shared by every glyph vertex buffer
+		GLuint m_uiQuadIndexVbo;
+
+		// Incremented whenever the fonts are reloaded. Cached text layouts
+		// built against an older epoch must be rebuilt
+		unsigned int m_layoutEpoch;
+
+		// Texture holding the glyphs of every glyph font
+		UIGlyphAtlas m_glyphAtlas;
+
+		// Batch that printed text is queued into, and the texture it samples
+		UITextBatch m_textBatch;
+		GLuint m_batchTexture;
+
+#ifdef UIKIT_SDF_TEXT
+		// Distance field atlas of every font
+		UISDFFont m_sdfFont;
+#endif
+
+		// Local functions
+		bool loadGlyphFonts(CPVRTString* const pErrorStr);
+		void deleteGlyphFonts();
+
 	public:
 		// Exported functions
 		UIPrinter();
 		bool LoadFonts(int pvrShellWidth, int pvrShellHeight, bool isRotated);
+		void SetViewport(int width, int height);
 		void Print(float x, float y, float scale, GLuint color, UIFont font, char* text);
 		void Measure(float* width, float* height, float scale, UIFont font, char* text);
+		void Flush();
 		bool Rotated();
+		CPVRTPrint3D* GetPrint3D(UIFont font);
+		UIMeasureCache* GetMeasureCache();
+		UIGlyphFont* GetGlyphFont(UIFont font);
+		void GetPixelProjection(PVRTMat4* projection);
+		void DrawGlyphs(GLuint vbo, int numQuads, float x, float y, GLuint color, UIFont font);
+		unsigned int GetLayoutEpoch();
 		void Delete();
 };
 
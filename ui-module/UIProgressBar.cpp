@@ -6,6 +6,38 @@
 ******************************************************************************/
 
 #include "UIProgressBar.h"
+#include "UIDispatcher.h"
+#include "UISpriteBatch.h"
+
+// Fill shader. The fill quad is drawn at full size; the vertex stage pulls
+// its right edge in to u_fill and clips the texture coordinates to match
+static const char* c_fillVertShader =
+	"attribute highp vec3 inVertex;\n"
+	"attribute mediump vec2 inTexCoord;\n"
+	"uniform highp mat4 myPMVMatrix;\n"
+	"uniform mediump float u_fill;\n"
+	"varying mediump vec2 TexCoord;\n"
+	"void main()\n"
+	"{\n"
+	"	highp float x = mix(-0.5, inVertex.x, u_fill);\n"
+	"	gl_Position = myPMVMatrix * vec4(x, inVertex.y, inVertex.z, 1.0);\n"
+	"	TexCoord = vec2(inTexCoord.x * u_fill, inTexCoord.y);\n"
+	"}\n";
+
+static const char* c_fillFragShader =
+	"uniform sampler2D sTexture;\n"
+	"varying mediump vec2 TexCoord;\n"
+	"void main()\n"
+	"{\n"
+	"	gl_FragColor = texture2D(sTexture, TexCoord);\n"
+	"}\n";
+
+// The fill shader is shared by every bar in shader fill mode, and freed when
+// the last of them is deleted
+static UIShader s_fillShader;
+static GLint s_fillMVPLoc = -1;
+static GLint s_fillLoc = -1;
+static int s_fillUsers = 0;
 
 /*!****************************************************************************
  @Function		Constructor
@@ -18,6 +50,7 @@ UIProgressBar::UIProgressBar()
     m_bg = UIImage();
     m_progress = UIImage();
     m_completion = 0;
+    m_completionTarget = 0;
     m_width = 0;
     m_height = 0;
     m_insetX = 0; 
@@ -25,6 +58,8 @@ UIProgressBar::UIProgressBar()
     m_x = 0;
     m_y = 0;
     m_hidden = false;
+    m_flashedOff = false;
+    m_shaderFill = false;
 }
 
 /*!****************************************************************************
@@ -84,8 +119,11 @@ UIProgressBar::UIProgressBar(PBType type, float x, float y, float initialComplet
     m_x = x;
     m_y = y;
     m_hidden = false;
+    m_flashedOff = false;
+    m_shaderFill = false;
     m_completion = 1;
     SetCompletion(initialCompletion);
+    UIDispatcher::Get()->Subscribe(this, updateKey());
 }
 
 /*!****************************************************************************
@@ -107,8 +145,11 @@ UIProgressBar::UIProgressBar(float x, float y, float initialCompletion)
     m_x = x;
     m_y = y;
     m_hidden = false;
+    m_flashedOff = false;
+    m_shaderFill = false;
     m_completion = 1;
     SetCompletion(initialCompletion);
+    UIDispatcher::Get()->Subscribe(this, updateKey());
 }
 
 /*!****************************************************************************
@@ -134,8 +175,11 @@ UIProgressBar::UIProgressBar(float x, float y, float width, float height, float
     m_x = x;
     m_y = y;
     m_hidden = false;
+    m_flashedOff = false;
+    m_shaderFill = false;
     m_completion = 1;
     SetCompletion(initialCompletion);
+    UIDispatcher::Get()->Subscribe(this, updateKey());
 }
 
 /*!****************************************************************************
@@ -161,8 +205,11 @@ UIProgressBar::UIProgressBar(char* bgTex, char* progTex, float x, float y, float
     m_x = x;
     m_y = y;
     m_hidden = false;
+    m_flashedOff = false;
+    m_shaderFill = false;
     m_completion = 1;
     SetCompletion(initialCompletion);
+    UIDispatcher::Get()->Subscribe(this, updateKey());
 }
 
 /*!****************************************************************************
@@ -188,6 +235,9 @@ UIProgressBar::BuildVertices()
 {
     m_bg.BuildVertices();
     m_progress.BuildVertices();
+    if (m_shaderFill) {
+        buildFillShader();
+    }
 }
 
 /*!****************************************************************************
@@ -200,7 +250,11 @@ UIProgressBar::Render(GLuint uiMVPMatrixLoc)
 {
 
     m_bg.Render(uiMVPMatrixLoc);
-    m_progress.Render(uiMVPMatrixLoc);
+    if (m_shaderFill) {
+        drawFill();
+    } else {
+        m_progress.Render(uiMVPMatrixLoc);
+    }
 
 	return true;
 }
@@ -214,13 +268,17 @@ UIProgressBar::Render(GLuint uiMVPMatrixLoc)
 bool
 UIProgressBar::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 {
-    if (m_hidden) {
+    if (m_hidden || m_flashedOff) {
         //fprintf(stderr, "Progress bar hidden\n");
         return true;
     }
 
     m_bg.Render(uiMVPMatrixLoc, printer);
-    m_progress.Render(uiMVPMatrixLoc, printer);
+    if (m_shaderFill) {
+        drawFill();
+    } else {
+        m_progress.Render(uiMVPMatrixLoc, printer);
+    }
 
 	return true;
 }
@@ -228,11 +286,20 @@ UIProgressBar::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 /*!****************************************************************************
  @Function		SetCompletion
  @Input         newCompletion   The new completion value for the bar
- @Description	Sets the extent to which the progress bar is filled
+ @Description	Sets the extent to which the progress bar is filled, stopping
+                any completion animation. In shader fill mode this only stores
+                the value, which is passed to the fill shader when the bar is
+                drawn.
 ******************************************************************************/
 void
 UIProgressBar::SetCompletion(float newCompletion)
 {
+    UIAnimator::Get()->Cancel(&m_completion);
+    m_completionTarget = newCompletion;
+    if (m_shaderFill) {
+        m_completion = newCompletion;
+        return;
+    }
     //fprintf(stderr, "new completion : %f, old completion %f\n", newCompletion, m_completion);
     //fprintf(stderr, "Effective width : %f", (m_width-(m_insetX)));
     //fprintf(stderr, "%d, %d\n", m_progress.GetPosition().x, m_progress.GetPosition().y);
@@ -243,6 +310,31 @@ UIProgressBar::SetCompletion(float newCompletion)
     m_completion = newCompletion;
 }
 
+/*!****************************************************************************
+ @Function		AnimateCompletion
+ @Input         newCompletion   The completion the bar ends at
+ @Input         duration        Length of the animation in seconds
+ @Description	Fills or empties the bar smoothly. In shader fill mode the
+                UIAnimator writes the completion each frame and the fill shader
+                picks it up, so animating costs no CPU transform work. Other
+                bars jump straight to the new completion. Asking again for the
+                completion the bar is already heading to doesn't restart the
+                animation, so this can be called every frame.
+******************************************************************************/
+void
+UIProgressBar::AnimateCompletion(float newCompletion, float duration)
+{
+    if (!m_shaderFill) {
+        SetCompletion(newCompletion);
+        return;
+    }
+    if (newCompletion == m_completionTarget) {
+        return;
+    }
+    m_completionTarget = newCompletion;
+    UIAnimator::Get()->Tween(&m_completion, newCompletion, duration, UIEEaseOut);
+}
+
 /*!****************************************************************************
  @Function		GetCompletion
  @Return        float   The progress bar's completion
@@ -262,20 +354,7 @@ UIProgressBar::GetCompletion()
 void
 UIProgressBar::Update(UIMessage updateMessage)
 {
-    UIFloat updateKey;
-    if (m_type == BrightnessSelected || m_type == BrightnessUnselected) {
-        //fprintf(stderr, "Brightness bar received message\n");
-        if (updateMessage.Read(UIFlash)) {
-            //fprintf(stderr, "Brightness bar flashed\n");
-            m_hidden = true;
-        } else {
-            m_hidden = false;
-        }
-        updateKey = UIBrightnessProg;
-    } else {
-        updateKey = UIStageProgress;
-    }
-	float messageContents = updateMessage.Read(updateKey);
+	float messageContents = updateMessage.Read(updateKey());
 	// fprintf(stderr, "Message received to UIProgressBar, contents: %f\n", messageContents);
 	if (messageContents >= 0 && messageContents <= 1) {
 		SetCompletion(messageContents);
@@ -305,6 +384,10 @@ UIProgressBar::SetPosition(float newX, float newY)
     m_y = newY;
 
     m_bg.SetPosition(newX, newY);
+    if (m_shaderFill) {
+        m_progress.SetPosition(newX, newY);
+        return;
+    }
     float completion = m_completion;
     SetCompletion(1);
     m_progress.SetPosition(newX, newY);
@@ -330,6 +413,23 @@ UIProgressBar::Show()
 {
     m_hidden = false;
 }
+/*!****************************************************************************
+ @Function		SetBlink
+ @Input			blink		Should the bar blink?
+ @Description	Starts or stops the bar blinking. The UIBlinkScheduler flashes
+                it off and on from the frame clock, so the app layer doesn't
+                have to send a flash flag every frame.
+******************************************************************************/
+void
+UIProgressBar::SetBlink(bool blink)
+{
+    if (blink) {
+        UIBlinkScheduler::Get()->Start(&m_flashedOff, c_defaultBlinkPeriod, 0);
+    } else {
+        UIBlinkScheduler::Get()->Stop(&m_flashedOff);
+    }
+}
+
 /*!****************************************************************************
  @Function		Delete
  @Description	Frees any memory allocated within the object
@@ -338,5 +438,117 @@ UIProgressBar::Show()
 void
 UIProgressBar::Delete()
 {
-	return;
-}
\ No newline at end of file
+    UIDispatcher::Get()->Unsubscribe(this);
+    UIAnimator::Get()->Cancel(&m_completion);
+    SetBlink(false);
+    SetShaderFill(false);
+    m_bg.Delete();
+    m_progress.Delete();
+}
+
+/*!****************************************************************************
+ @Function		SetShaderFill
+ @Input			shaderFill		Should the fill be clipped by a shader?
+ @Description	Switches the bar between its rendering modes. By default the
+                fill image is scaled and moved on the CPU every time the
+                completion changes. In shader fill mode the fill image stays
+                at full size and the fill shader clips it to the completion
+                in the vertex stage, so animating the bar costs no CPU
+                transform work. The fill image must show its whole texture.
+******************************************************************************/
+void
+UIProgressBar::SetShaderFill(bool shaderFill)
+{
+    if (shaderFill == m_shaderFill) {
+        return;
+    }
+    float completion = m_completion;
+    m_progress.Scale(1, 1, 1);
+    m_progress.SetPosition(m_x, m_y);
+    m_completion = 1;
+    m_shaderFill = shaderFill;
+
+    if (shaderFill) {
+        s_fillUsers ++;
+    } else if (-- s_fillUsers == 0) {
+        s_fillShader.Delete();
+    }
+    SetCompletion(completion);
+}
+
+/*!****************************************************************************
+ @Function		buildFillShader
+ @Return		bool		Was the shader built?
+ @Description	HELPER - builds the shared fill shader if it hasn't been built.
+                Bars fall back to CPU filling if it can't be.
+******************************************************************************/
+bool
+UIProgressBar::buildFillShader()
+{
+    if (s_fillShader.GetProgram() != 0) {
+        return true;
+    }
+    const UIShaderAttrib attribs[] = {
+        { "inVertex", IVERTEX_ARRAY },
+        { "inTexCoord", ITEXCOORD_ARRAY }
+    };
+    CPVRTString errorStr;
+    if (!s_fillShader.Build(c_fillVertShader, c_fillFragShader, attribs, 2, &errorStr)) {
+        fprintf(stderr, "%s\n", errorStr.c_str());
+        SetShaderFill(false);
+        return false;
+    }
+    s_fillMVPLoc = s_fillShader.GetUniform("myPMVMatrix");
+    s_fillLoc = s_fillShader.GetUniform("u_fill");
+    return true;
+}
+
+/*!****************************************************************************
+ @Function		drawFill
+ @Description	HELPER - draws the fill image with the fill shader
+******************************************************************************/
+void
+UIProgressBar::drawFill()
+{
+    PVRTMat4 mMVP;
+    if (!buildFillShader() || !m_progress.GetMVP(&mMVP)) {
+        return;
+    }
+    float fill = m_completion < 0 ? 0 : (m_completion > 1 ? 1 : m_completion);
+
+    // Images queued in a capturing batch go under the fill
+    UISpriteBatch* batch = UISpriteBatch::GetCapturing();
+    if (batch != NULL) {
+        batch->Flush();
+    }
+
+    s_fillShader.Use();
+    glUniformMatrix4fv(s_fillMVPLoc, 1, GL_FALSE, mMVP.f);
+    glUniform1f(s_fillLoc, fill);
+    glBindTexture(GL_TEXTURE_2D, m_progress.GetTexture());
+
+    glEnableVertexAttribArray(IVERTEX_ARRAY);
+    glEnableVertexAttribArray(ITEXCOORD_ARRAY);
+    m_progress.DrawMesh();
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glDisableVertexAttribArray(IVERTEX_ARRAY);
+    glDisableVertexAttribArray(ITEXCOORD_ARRAY);
+    s_fillShader.Restore();
+}
+
+/*!****************************************************************************
+ @Function		updateKey
+ @Return		UIFloat		Key the bar's completion is read from
+ @Description	HELPER - brightness bars show the brightness and the others the
+                stage progress
+******************************************************************************/
+UIFloat
+UIProgressBar::updateKey()
+{
+    if (m_type == BrightnessSelected || m_type == BrightnessUnselected) {
+        return UIBrightnessProg;
+    }
+    return UIStageProgress;
+}
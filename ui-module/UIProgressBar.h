@@ -8,6 +8,8 @@
 #include "OGLES2Tools.h"
 #include "UIElement.h"
 #include "UIImage.h"
+#include "UIShader.h"
+#include "UIBlinkScheduler.h"
 
 #ifndef _UIPROGRESSBAR_H
 #define _UIPROGRESSBAR_H
@@ -33,6 +35,9 @@ const float c_defaultBrightWidth = 200;
 const float c_defaultPBInsetX = 12;
 const float c_defaultPBInsetY = 12;
 
+// Length in seconds of a completion animation
+const float c_pbAnimDuration = 0.25f;
+
 // Enum identifiers for progress bar colors
 enum PBType { PBR, PBG, PBB, BrightnessSelected, BrightnessUnselected };
 
@@ -59,11 +64,25 @@ class UIProgressBar : public UIElement
         // Completion from 0-1 and positional/layout details
         float m_completion, m_width, m_height, m_insetX, m_insetY, m_x, m_y;
 
+        // Completion the bar is animating towards (or showing)
+        float m_completionTarget;
+
         // Is the bar hidden?
         bool m_hidden;
 
+        // Is the bar blinking and currently flashed off?
+        bool m_flashedOff;
+
         // Is the bar rotated?
         bool m_rotated;
+
+        // Is the fill clipped by the fill shader rather than scaled?
+        bool m_shaderFill;
+
+        // Local functions
+        bool buildFillShader();
+        void drawFill();
+        UIFloat updateKey();
     public:
         // Exported functions
         UIProgressBar();
@@ -77,6 +96,7 @@ class UIProgressBar : public UIElement
 		virtual bool Render(GLuint uiMVPMatrixLoc);
         virtual bool Render(GLuint uiMVPMatrixLoc, UIPrinter* printer);
         void SetCompletion(float newCompletion);
+        void AnimateCompletion(float newCompletion, float duration);
         float GetCompletion();
 		virtual void Update(UIMessage updateMessage);
         void SetSize(float newWidth, float newHeight);
@@ -84,6 +104,8 @@ class UIProgressBar : public UIElement
         PVRTVec2 GetSize();
 		virtual void Hide();
 		virtual void Show();
+        void SetShaderFill(bool shaderFill);
+        void SetBlink(bool blink);
 		void Delete();
 };
 
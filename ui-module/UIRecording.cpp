@@ -0,0 +1,710 @@
+/******************************************************************************
+ @File          UIRecording.cpp
+ @Title         UIRecording
+ @Author        Siddharth Hathi
+ @Description   Implements the UIRecorder and UIReplay object classes defined
+				in UIRecording.h
+******************************************************************************/
+
+#include "UIRecording.h"
+#include "UIFrameCache.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+
+/*!****************************************************************************
+ @Function		captureState
+ @Input			message		Message being recorded
+ @Output		state		Everything the message carries
+ @Description	HELPER - copies a message's keys into a record state. Text is
+				referenced, not copied, so it is only valid as long as the
+				message is.
+******************************************************************************/
+static void
+captureState(UIMessage& message, UIRecordState* state)
+{
+	memset(state, 0, sizeof(UIRecordState));
+	for ( int i = 0; i < UINumFloats; i ++ ) {
+		if (message.Has((UIFloat) i)) {
+			state->floatMask |= 1u << i;
+			state->floats[i] = message.Read((UIFloat) i);
+		}
+	}
+	for ( int i = 0; i < UIMNone; i ++ ) {
+		if (message.Has((UIMetric) i)) {
+			state->metricMask |= 1u << i;
+			state->metrics[i] = message.Read((UIMetric) i);
+		}
+	}
+	for ( int i = 0; i < UINone; i ++ ) {
+		if (message.Has((UITextType) i)) {
+			state->textMask |= 1u << i;
+			state->texts[i] = message.Read((UITextType) i);
+		}
+	}
+	for ( int i = 0; i < UINumBools; i ++ ) {
+		if (message.Has((UIBool) i)) {
+			state->boolMask |= 1u << i;
+			if (message.Read((UIBool) i)) {
+				state->boolValues |= 1u << i;
+			}
+		}
+	}
+	state->state = message.ReadState();
+	state->action = message.ReadAction();
+	state->stage = message.ReadWorkoutStage();
+	state->totalRacers = message.GetTotalRacers();
+}
+
+/*!****************************************************************************
+ @Function		changedValues
+ @Input			mask		Keys present in the new frame
+ @Input			oldMask		Keys present in the last frame
+ @Input			values		The new frame's values
+ @Input			oldValues	The last frame's values
+ @Input			count		Number of keys
+ @Return		uint32_t	Bit per key whose value has to be recorded
+ @Description	HELPER - finds the numeric values that are new or changed.
+				Values are compared bit for bit, so a NaN that stays NaN
+				isn't recorded again.
+******************************************************************************/
+static uint32_t
+changedValues(uint32_t mask, uint32_t oldMask, const float* values, const float* oldValues, int count)
+{
+	uint32_t changed = 0;
+	for ( int i = 0; i < count; i ++ ) {
+		uint32_t bit = 1u << i;
+		if ((mask & bit) != 0 && ((oldMask & bit) == 0 || memcmp(&values[i], &oldValues[i], sizeof(float)) != 0)) {
+			changed |= bit;
+		}
+	}
+	return changed;
+}
+
+/*!****************************************************************************
+ @Function		readWord
+ @Modified		data		Read position, advanced past the word
+ @Input			end			End of the record
+ @Output		value		The 4 byte word read
+ @Return		bool		Was there a word left in the record?
+ @Description	HELPER - reads one mask, enum or value from a record
+******************************************************************************/
+static bool
+readWord(const char** data, const char* end, void* value)
+{
+	if (end - *data < 4) {
+		return false;
+	}
+	memcpy(value, *data, 4);
+	*data += 4;
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		monotonicNow
+ @Return		double		Seconds on the monotonic clock
+ @Description	HELPER - reads the clock replay is paced against
+******************************************************************************/
+static double
+monotonicNow()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes a recorder with no file
+******************************************************************************/
+UIRecorder::UIRecorder()
+{
+	m_file = NULL;
+	memset(&m_last, 0, sizeof(UIRecordState));
+	m_startTime = 0;
+	m_started = false;
+	m_numFrames = 0;
+	m_durationUs = 0;
+	m_recordSize = 0;
+	m_overflow = false;
+}
+
+/*!****************************************************************************
+ @Function		Open
+ @Input			path			Path of the recording to create
+ @Output		pErrorStr		Error message on failure
+ @Return		bool			Was the file created?
+ @Description	Starts a new recording, replacing any file at path. A
+				recording that is open is closed first.
+******************************************************************************/
+bool
+UIRecorder::Open(const char* path, CPVRTString* const pErrorStr)
+{
+	Close();
+
+	m_file = fopen(path, "wb");
+	if (m_file == NULL) {
+		*pErrorStr = "ERROR: UIRecorder could not create recording";
+		fprintf(stderr, "UIRecorder could not create %s\n", path);
+		return false;
+	}
+	memset(&m_last, 0, sizeof(UIRecordState));
+	for ( int i = 0; i < UINone; i ++ ) {
+		m_lastTexts[i] = "";
+	}
+	m_startTime = 0;
+	m_started = false;
+	m_numFrames = 0;
+	m_durationUs = 0;
+
+	// The header is written again with the totals when the file is closed
+	if (!writeHeader()) {
+		*pErrorStr = "ERROR: UIRecorder could not write recording";
+		fprintf(stderr, "UIRecorder could not write %s\n", path);
+		fclose(m_file);
+		m_file = NULL;
+		return false;
+	}
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		Record
+ @Input			message		The frame's message
+ @Input			time		Time of the frame in seconds
+ @Return		bool		Was the frame recorded?
+ @Description	Appends a frame to the recording: the sections and values
+				that differ from the last frame, and the time since it.
+				Times only have to increase; the first frame is at 0.
+******************************************************************************/
+bool
+UIRecorder::Record(UIMessage& message, double time)
+{
+	if (m_file == NULL) {
+		return false;
+	}
+	UIRecordState now;
+	captureState(message, &now);
+
+	uint32_t floatChanged = changedValues(now.floatMask, m_last.floatMask, now.floats, m_last.floats, UINumFloats);
+	uint32_t metricChanged = changedValues(now.metricMask, m_last.metricMask, now.metrics, m_last.metrics, UIMNone);
+	uint32_t textChanged = 0;
+	for ( int i = 0; i < UINone; i ++ ) {
+		uint32_t bit = 1u << i;
+		if ((now.textMask & bit) != 0 && ((m_last.textMask & bit) == 0 || strcmp(now.texts[i], m_lastTexts[i].c_str()) != 0)) {
+			textChanged |= bit;
+		}
+	}
+
+	uint16_t flags = 0;
+	flags |= now.floatMask != m_last.floatMask ? UIRSFloatMask : 0;
+	flags |= now.textMask != m_last.textMask ? UIRSTextMask : 0;
+	flags |= now.metricMask != m_last.metricMask ? UIRSMetricMask : 0;
+	flags |= now.boolMask != m_last.boolMask ? UIRSBoolMask : 0;
+	flags |= now.boolValues != m_last.boolValues ? UIRSBoolValues : 0;
+	flags |= now.state != m_last.state ? UIRSState : 0;
+	flags |= now.action != m_last.action ? UIRSAction : 0;
+	flags |= now.stage != m_last.stage ? UIRSStage : 0;
+	flags |= now.totalRacers != m_last.totalRacers ? UIRSRacers : 0;
+	flags |= floatChanged != 0 ? UIRSFloats : 0;
+	flags |= metricChanged != 0 ? UIRSMetrics : 0;
+	flags |= textChanged != 0 ? UIRSTexts : 0;
+
+	// Deltas are taken from the total so rounding doesn't drift
+	if (!m_started) {
+		m_startTime = time;
+	}
+	double elapsedUs = (time - m_startTime) * 1e6 + 0.5;
+	uint32_t deltaUs = 0;
+	if (elapsedUs > (double) m_durationUs) {
+		double delta = (double) (uint64_t) elapsedUs - (double) m_durationUs;
+		deltaUs = delta > 4294967295.0 ? 0xffffffffu : (uint32_t) delta;
+	}
+
+	UIRecordHeader header;
+	header.size = 0;
+	header.flags = flags;
+	header.deltaUs = deltaUs;
+	m_recordSize = 0;
+	m_overflow = false;
+	append(&header, sizeof(UIRecordHeader));
+
+	// Sections in the order of their flags
+	const uint32_t* words[] = {
+		&now.floatMask, &now.textMask, &now.metricMask, &now.boolMask, &now.boolValues,
+		(const uint32_t*) &now.state, (const uint32_t*) &now.action, (const uint32_t*) &now.stage,
+		(const uint32_t*) &now.totalRacers
+	};
+	for ( int i = 0; i < (int) (sizeof(words) / sizeof(words[0])); i ++ ) {
+		if ((flags & (1 << i)) != 0) {
+			append(words[i], sizeof(uint32_t));
+		}
+	}
+	if (floatChanged != 0) {
+		append(&floatChanged, sizeof(uint32_t));
+		for ( int i = 0; i < UINumFloats; i ++ ) {
+			if ((floatChanged & (1u << i)) != 0) {
+				append(&now.floats[i], sizeof(float));
+			}
+		}
+	}
+	if (metricChanged != 0) {
+		append(&metricChanged, sizeof(uint32_t));
+		for ( int i = 0; i < UIMNone; i ++ ) {
+			if ((metricChanged & (1u << i)) != 0) {
+				append(&now.metrics[i], sizeof(float));
+			}
+		}
+	}
+	if (textChanged != 0) {
+		append(&textChanged, sizeof(uint32_t));
+		for ( int i = 0; i < UINone; i ++ ) {
+			if ((textChanged & (1u << i)) != 0) {
+				append(now.texts[i], strlen(now.texts[i]) + 1);
+			}
+		}
+	}
+	static const char padding[4] = { 0, 0, 0, 0 };
+	append(padding, (4 - m_recordSize % 4) % 4);
+
+	if (m_overflow) {
+		fprintf(stderr, "UIRecorder: frame %u is larger than %d bytes\n", m_numFrames, c_maxRecordSize);
+		return false;
+	}
+	header.size = (uint16_t) m_recordSize;
+	memcpy(m_record, &header, sizeof(UIRecordHeader));
+	if (fwrite(m_record, 1, m_recordSize, m_file) != m_recordSize) {
+		fprintf(stderr, "UIRecorder: could not write frame %u\n", m_numFrames);
+		return false;
+	}
+
+	for ( int i = 0; i < UINone; i ++ ) {
+		if ((textChanged & (1u << i)) != 0) {
+			m_lastTexts[i] = now.texts[i];
+		}
+		now.texts[i] = NULL;
+	}
+	m_last = now;
+	m_started = true;
+	m_numFrames ++;
+	m_durationUs += deltaUs;
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		GetFrameCount
+ @Return		int			Number of frames recorded
+ @Description	Returns the number of frames in the recording so far
+******************************************************************************/
+int
+UIRecorder::GetFrameCount()
+{
+	return m_numFrames;
+}
+
+/*!****************************************************************************
+ @Function		Close
+ @Return		bool		Was the recording finished?
+ @Description	Writes the frame count and length into the header and closes
+				the file. A recording that was never closed still replays;
+				it just has no totals in its header.
+******************************************************************************/
+bool
+UIRecorder::Close()
+{
+	if (m_file == NULL) {
+		return false;
+	}
+	bool ok = fflush(m_file) == 0 && fseek(m_file, 0, SEEK_SET) == 0 && writeHeader();
+	if (fclose(m_file) != 0) {
+		ok = false;
+	}
+	m_file = NULL;
+	if (!ok) {
+		fprintf(stderr, "UIRecorder: could not finish the recording\n");
+	}
+	return ok;
+}
+
+/*!****************************************************************************
+ @Function		append
+ @Input			data		Bytes to add
+ @Input			size		Number of bytes
+ @Description	HELPER - adds bytes to the record being built, flagging the
+				record if they don't fit
+******************************************************************************/
+void
+UIRecorder::append(const void* data, size_t size)
+{
+	if (m_recordSize + size > (size_t) c_maxRecordSize) {
+		m_overflow = true;
+		return;
+	}
+	memcpy(m_record + m_recordSize, data, size);
+	m_recordSize += size;
+}
+
+/*!****************************************************************************
+ @Function		writeHeader
+ @Return		bool		Was the header written?
+ @Description	HELPER - writes the recording header with the current totals
+				at the file position
+******************************************************************************/
+bool
+UIRecorder::writeHeader()
+{
+	UIRecordingHeader header;
+	memset(&header, 0, sizeof(UIRecordingHeader));
+	header.magic = c_recordingMagic;
+	header.version = c_recordingVersion;
+	header.schema = UIFrameSchema();
+	header.numFrames = m_numFrames;
+	header.durationUs = m_durationUs;
+	return fwrite(&header, sizeof(UIRecordingHeader), 1, m_file) == 1;
+}
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes a replay with no recording
+******************************************************************************/
+UIReplay::UIReplay()
+{
+	m_mapping = NULL;
+	m_mappingSize = 0;
+	m_end = 0;
+	m_numFrames = 0;
+	m_durationUs = 0;
+	Rewind();
+}
+
+/*!****************************************************************************
+ @Function		Open
+ @Input			path			Path of the recording
+ @Output		pErrorStr		Error message on failure
+ @Return		bool			Was the recording opened?
+ @Description	Maps a recording and counts its frames. A recording whose
+				last record was cut short (the app stopped while writing it)
+				replays up to that record.
+******************************************************************************/
+bool
+UIReplay::Open(const char* path, CPVRTString* const pErrorStr)
+{
+	Delete();
+
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		*pErrorStr = "ERROR: UIReplay could not open recording";
+		fprintf(stderr, "UIReplay could not open %s\n", path);
+		return false;
+	}
+	struct stat fileStat;
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size < (off_t) sizeof(UIRecordingHeader)) {
+		close(fd);
+		*pErrorStr = "ERROR: UIReplay recording too small";
+		fprintf(stderr, "UIReplay recording %s too small\n", path);
+		return false;
+	}
+	m_mappingSize = fileStat.st_size;
+	m_mapping = mmap(NULL, m_mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (m_mapping == MAP_FAILED) {
+		m_mapping = NULL;
+		*pErrorStr = "ERROR: UIReplay could not map recording";
+		fprintf(stderr, "UIReplay could not map %s\n", path);
+		return false;
+	}
+
+	const UIRecordingHeader* header = (const UIRecordingHeader*) m_mapping;
+	if (header->magic != c_recordingMagic || header->version != c_recordingVersion) {
+		*pErrorStr = "ERROR: UIReplay invalid recording";
+		fprintf(stderr, "UIReplay invalid recording %s\n", path);
+		Delete();
+		return false;
+	}
+	if (header->schema != UIFrameSchema()) {
+		*pErrorStr = "ERROR: UIReplay recording was made with different message keys";
+		fprintf(stderr, "UIReplay recording %s was made with different message keys\n", path);
+		Delete();
+		return false;
+	}
+
+	// Walk the record sizes once for the totals and the end of the last
+	// whole record. The contents are checked as they are read.
+	const char* data = (const char*) m_mapping;
+	size_t offset = sizeof(UIRecordingHeader);
+	while (m_mappingSize - offset >= sizeof(UIRecordHeader)) {
+		UIRecordHeader record;
+		memcpy(&record, data + offset, sizeof(UIRecordHeader));
+		if (record.size < sizeof(UIRecordHeader) || record.size % 4 != 0 || record.size > m_mappingSize - offset) {
+			break;
+		}
+		offset += record.size;
+		m_numFrames ++;
+		m_durationUs += record.deltaUs;
+	}
+	m_end = offset;
+	if (m_end != m_mappingSize) {
+		fprintf(stderr, "UIReplay: %s is cut short after %d frames\n", path, m_numFrames);
+	}
+	Rewind();
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		Next
+ @Output		message		The next frame's message (may be NULL)
+ @Output		time		Time of the frame in seconds (may be NULL)
+ @Return		bool		Was there another frame?
+ @Description	Reads the next frame and rebuilds its message. The message
+				is recycled and every key of the frame is written into it,
+				so one message can be reused for the whole replay. Returns
+				false at the end of the recording or at a damaged record.
+******************************************************************************/
+bool
+UIReplay::Next(UIMessage* message, double* time)
+{
+	if (m_mapping == NULL || m_cursor >= m_end) {
+		return false;
+	}
+	if (m_cursor == sizeof(UIRecordingHeader)) {
+		m_wallStart = monotonicNow();
+	}
+	if (!readRecord()) {
+		m_cursor = m_end;
+		return false;
+	}
+	if (message != NULL) {
+		fillMessage(message);
+	}
+	if (time != NULL) {
+		*time = m_timeUs * 1e-6;
+	}
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		Rewind
+ @Description	Goes back to the first frame
+******************************************************************************/
+void
+UIReplay::Rewind()
+{
+	m_cursor = sizeof(UIRecordingHeader);
+	m_timeUs = 0;
+	m_wallStart = monotonicNow();
+	memset(&m_state, 0, sizeof(UIRecordState));
+}
+
+/*!****************************************************************************
+ @Function		Pace
+ @Input			time		Time of the frame just read, in seconds
+ @Input			speed		Multiple of real time (0 for no pacing)
+ @Description	Sleeps until a frame is due: time / speed seconds after the
+				first frame was read. A replay that falls behind isn't slowed
+				further, so it catches up.
+******************************************************************************/
+void
+UIReplay::Pace(double time, float speed)
+{
+	if (speed <= 0) {
+		return;
+	}
+	double due = m_wallStart + time / speed;
+	if (due <= monotonicNow()) {
+		return;
+	}
+	struct timespec wake;
+	wake.tv_sec = (time_t) due;
+	wake.tv_nsec = (long) ((due - wake.tv_sec) * 1e9);
+	// clock_nanosleep returns the error rather than setting errno. Only
+	// an interrupted sleep is retried; any other error replays unpaced.
+	int result;
+	while ((result = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL)) == EINTR) {
+	}
+	if (result != 0) {
+		fprintf(stderr, "UIReplay can't sleep (%s), not pacing the frame\n", strerror(result));
+	}
+}
+
+/*!****************************************************************************
+ @Function		Play
+ @Input			root		Root of the UI tree
+ @Input			speed		Multiple of real time (0 for as fast as possible)
+ @Return		int			Number of frames played
+ @Description	Replays the whole recording into a UI tree from the start,
+				passing each frame's message through the UIFrameCache. Drawing
+				is left to the caller; with the GL stubbed out this measures
+				the cost of updating the tree.
+******************************************************************************/
+int
+UIReplay::Play(UIElement* root, float speed)
+{
+	Rewind();
+	UIMessage message;
+	double time;
+	int numFrames = 0;
+	while (Next(&message, &time)) {
+		Pace(time, speed);
+		UIFrameCache::Get()->Update(root, message);
+		numFrames ++;
+	}
+	return numFrames;
+}
+
+/*!****************************************************************************
+ @Function		GetFrameCount
+ @Return		int			Number of frames
+ @Description	Returns the number of frames in the recording
+******************************************************************************/
+int
+UIReplay::GetFrameCount()
+{
+	return m_numFrames;
+}
+
+/*!****************************************************************************
+ @Function		GetDuration
+ @Return		double		Length in seconds
+ @Description	Returns the time of the recording's last frame
+******************************************************************************/
+double
+UIReplay::GetDuration()
+{
+	return m_durationUs * 1e-6;
+}
+
+/*!****************************************************************************
+ @Function		Delete
+ @Description	Unmaps the recording
+******************************************************************************/
+void
+UIReplay::Delete()
+{
+	if (m_mapping != NULL) {
+		munmap(m_mapping, m_mappingSize);
+		m_mapping = NULL;
+		m_mappingSize = 0;
+	}
+	m_end = 0;
+	m_numFrames = 0;
+	m_durationUs = 0;
+	Rewind();
+}
+
+/*!****************************************************************************
+ @Function		readRecord
+ @Return		bool		Was the record valid?
+ @Description	HELPER - applies the record at the cursor to the replay
+				state. Text is left pointing into the mapping.
+******************************************************************************/
+bool
+UIReplay::readRecord()
+{
+	const char* record = (const char*) m_mapping + m_cursor;
+	UIRecordHeader header;
+	memcpy(&header, record, sizeof(UIRecordHeader));
+	const char* data = record + sizeof(UIRecordHeader);
+	const char* end = record + header.size;
+	UIRecordState next = m_state;
+	bool ok = true;
+
+	uint32_t* words[] = {
+		&next.floatMask, &next.textMask, &next.metricMask, &next.boolMask, &next.boolValues,
+		(uint32_t*) &next.state, (uint32_t*) &next.action, (uint32_t*) &next.stage,
+		(uint32_t*) &next.totalRacers
+	};
+	for ( int i = 0; i < (int) (sizeof(words) / sizeof(words[0])); i ++ ) {
+		if ((header.flags & (1 << i)) != 0) {
+			ok = ok && readWord(&data, end, words[i]);
+		}
+	}
+	uint32_t changed = 0;
+	if ((header.flags & UIRSFloats) != 0) {
+		ok = ok && readWord(&data, end, &changed) && (changed >> UINumFloats) == 0;
+		for ( int i = 0; ok && i < UINumFloats; i ++ ) {
+			if ((changed & (1u << i)) != 0) {
+				ok = readWord(&data, end, &next.floats[i]);
+			}
+		}
+	}
+	if ((header.flags & UIRSMetrics) != 0) {
+		ok = ok && readWord(&data, end, &changed) && (changed >> UIMNone) == 0;
+		for ( int i = 0; ok && i < UIMNone; i ++ ) {
+			if ((changed & (1u << i)) != 0) {
+				ok = readWord(&data, end, &next.metrics[i]);
+			}
+		}
+	}
+	if ((header.flags & UIRSTexts) != 0) {
+		ok = ok && readWord(&data, end, &changed) && (changed >> UINone) == 0;
+		for ( int i = 0; ok && i < UINone; i ++ ) {
+			if ((changed & (1u << i)) != 0) {
+				const char* terminator = (const char*) memchr(data, '\0', end - data);
+				if (terminator == NULL) {
+					ok = false;
+				} else {
+					next.texts[i] = data;
+					data = terminator + 1;
+				}
+			}
+		}
+	}
+	if (!ok || (next.floatMask >> UINumFloats) != 0 || (next.textMask >> UINone) != 0
+		|| (next.metricMask >> UIMNone) != 0 || (next.boolMask >> UINumBools) != 0
+		|| next.state < 0 || next.state >= UINumStates || next.action < 0 || next.action >= UINumActions
+		|| next.stage < 0 || next.stage >= UINumWorkoutStages) {
+		fprintf(stderr, "UIReplay: record at offset %u is damaged\n", (unsigned int) m_cursor);
+		return false;
+	}
+	for ( int i = 0; i < UINone; i ++ ) {
+		if ((next.textMask & (1u << i)) != 0 && next.texts[i] == NULL) {
+			fprintf(stderr, "UIReplay: record at offset %u has no text for a key\n", (unsigned int) m_cursor);
+			return false;
+		}
+	}
+
+	m_state = next;
+	m_cursor += header.size;
+	m_timeUs += header.deltaUs;
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		fillMessage
+ @Output		message		Message to rebuild
+ @Description	HELPER - recycles a message and writes the current frame
+				into it
+******************************************************************************/
+void
+UIReplay::fillMessage(UIMessage* message)
+{
+	message->Recycle();
+	for ( int i = 0; i < UINumFloats; i ++ ) {
+		if ((m_state.floatMask & (1u << i)) != 0) {
+			message->Write((UIFloat) i, m_state.floats[i]);
+		}
+	}
+	for ( int i = 0; i < UIMNone; i ++ ) {
+		if ((m_state.metricMask & (1u << i)) != 0) {
+			message->Write((UIMetric) i, m_state.metrics[i]);
+		}
+	}
+	for ( int i = 0; i < UINone; i ++ ) {
+		if ((m_state.textMask & (1u << i)) != 0) {
+			message->Write((UITextType) i, m_state.texts[i]);
+		}
+	}
+	for ( int i = 0; i < UINumBools; i ++ ) {
+		if ((m_state.boolMask & (1u << i)) != 0) {
+			message->Write((UIBool) i, (m_state.boolValues & (1u << i)) != 0);
+		}
+	}
+	message->Write((UIState) m_state.state);
+	message->Write((UIAction) m_state.action);
+	message->Write((UIWorkoutStage) m_state.stage);
+	message->SetTotalRacers(m_state.totalRacers);
+}
@@ -0,0 +1,177 @@
+/******************************************************************************
+ @File          UIRecording.h
+ @Title         UIRecording Header File
+ @Author        Siddharth Hathi
+ @Description   Header file for the UIRecorder and UIReplay classes.
+******************************************************************************/
+
+#include "OGLES2Tools.h"
+#include "UIElement.h"
+#include "UIFrame.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#ifndef _UIRECORDING_H
+#define _UIRECORDING_H
+
+// Identifies a recording file ("UIRC" in memory) and the version of its format
+const uint32_t c_recordingMagic = 0x43524955;
+const uint16_t c_recordingVersion = 1;
+
+// Header at the start of a recording file
+struct UIRecordingHeader {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t reserved;
+
+	// UIFrameSchema() of the recorder. Recordings are keyed the same way as
+	// frames, so they only replay in a build with the same keys
+	uint32_t schema;
+
+	// Number of frames and their total length in microseconds
+	uint32_t numFrames;
+	uint64_t durationUs;
+};
+
+// Header of each frame's record. flags says which sections follow it, in the
+// order of the bits below. Masks are full presence bitmaps; the value
+// sections hold a bitmap of the keys that changed followed by their values
+// (text NUL terminated). Records are padded to 4 bytes.
+struct UIRecordHeader {
+	uint16_t size;
+	uint16_t flags;
+	uint32_t deltaUs;
+};
+
+// Record sections
+enum UIRecordSection {
+	UIRSFloatMask = 1 << 0,
+	UIRSTextMask = 1 << 1,
+	UIRSMetricMask = 1 << 2,
+	UIRSBoolMask = 1 << 3,
+	UIRSBoolValues = 1 << 4,
+	UIRSState = 1 << 5,
+	UIRSAction = 1 << 6,
+	UIRSStage = 1 << 7,
+	UIRSRacers = 1 << 8,
+	UIRSFloats = 1 << 9,
+	UIRSMetrics = 1 << 10,
+	UIRSTexts = 1 << 11
+};
+
+// Largest record (a record can't hold more than 64KB of text)
+const int c_maxRecordSize = 0xffff;
+
+// Everything a UIMessage carries, as the recorder and replay track it
+struct UIRecordState {
+	uint32_t floatMask, textMask, metricMask, boolMask, boolValues;
+	int32_t state, action, stage, totalRacers;
+	float floats[UINumFloats];
+	float metrics[UIMNone];
+	const char* texts[UINone];
+};
+
+/*!****************************************************************************
+ @class UIRecorder
+ Object class. A UIRecorder captures the UIMessages a UI tree is updated with
+ so the workout can be replayed later by a UIReplay. Each frame is stored as
+ a delta against the frame before: the time since it, and only the sections
+ and values that changed, so a frame where only a few readouts moved costs a
+ few dozen bytes.
+
+	recorder.Open("workout.uir", &error);
+	... every frame:
+	recorder.Record(message, UIAnimator::Get()->Now());
+	...
+	recorder.Close();
+******************************************************************************/
+class UIRecorder
+{
+	protected:
+		// Instance variables
+
+		// File being written
+		FILE* m_file;
+
+		// The last frame recorded, with copies of its text
+		UIRecordState m_last;
+		CPVRTString m_lastTexts[UINone];
+
+		// Time of the first frame, and has a frame been recorded?
+		double m_startTime;
+		bool m_started;
+
+		// Frames recorded and their total length
+		uint32_t m_numFrames;
+		uint64_t m_durationUs;
+
+		// Record being built, its size, and did it outgrow c_maxRecordSize?
+		char m_record[c_maxRecordSize];
+		size_t m_recordSize;
+		bool m_overflow;
+
+		// Local functions
+		void append(const void* data, size_t size);
+		bool writeHeader();
+
+	public:
+		// Exported functions
+		UIRecorder();
+		bool Open(const char* path, CPVRTString* const pErrorStr);
+		bool Record(UIMessage& message, double time);
+		int GetFrameCount();
+		bool Close();
+};
+
+/*!****************************************************************************
+ @class UIReplay
+ Object class. A UIReplay plays back a recording made by a UIRecorder. The
+ file is mapped rather than read, and text is referenced in the mapping until
+ it is written into the output message. Next rebuilds each frame's UIMessage
+ from the deltas. Play feeds a whole recording to a UI tree in real time, at
+ a multiple of real time, or as fast as possible (speed 0). With the GL
+ stubbed out (tools/UIGLStub.cpp), that replays an hour long workout in
+ seconds; see tools/ReplayBench.cpp.
+******************************************************************************/
+class UIReplay
+{
+	protected:
+		// Instance variables
+
+		// The mapped file, and the end of its last whole record
+		void* m_mapping;
+		size_t m_mappingSize;
+		size_t m_end;
+
+		// Number of frames in the file and their total length
+		int m_numFrames;
+		uint64_t m_durationUs;
+
+		// Offset of the next record, and the time of the last frame read
+		size_t m_cursor;
+		uint64_t m_timeUs;
+
+		// Monotonic clock time Pace measures playback from
+		double m_wallStart;
+
+		// The last frame read
+		UIRecordState m_state;
+
+		// Local functions
+		bool readRecord();
+		void fillMessage(UIMessage* message);
+
+	public:
+		// Exported functions
+		UIReplay();
+		bool Open(const char* path, CPVRTString* const pErrorStr);
+		bool Next(UIMessage* message, double* time);
+		void Rewind();
+		void Pace(double time, float speed);
+		int Play(UIElement* root, float speed);
+		int GetFrameCount();
+		double GetDuration();
+		void Delete();
+};
+
+#endif
@@ -0,0 +1,260 @@
+/******************************************************************************
+ @File          UISDFFont.cpp
+ @Title         UISDFFont
+ @Author        Siddharth Hathi
+ @Description   Implements the UISDFFont object class defined in UISDFFont.h
+******************************************************************************/
+
+#include "UISDFFont.h"
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes an empty atlas
+******************************************************************************/
+UISDFFont::UISDFFont()
+{
+	for ( int f = 0; f < c_maxSDFFaces; f ++ ) {
+		m_faces[f].loaded = false;
+		for ( int i = 0; i < c_numGlyphCodes; i ++ ) {
+			m_faces[f].glyphs[i].valid = false;
+		}
+	}
+	m_numFaces = 0;
+	m_size = 0;
+	m_spread = 0;
+	m_texWidth = 0;
+	m_texHeight = 0;
+	m_uiTexture = 0;
+}
+
+/*!****************************************************************************
+ @Function		Load
+ @Input			pvrData		Pointer to the SDF atlas (PVR v3) in memory
+ @Output		pErrorStr	Error message on failure
+ @Description	Reads the faces' metrics out of the atlas' meta data and loads
+				the atlas into graphics memory
+******************************************************************************/
+bool
+UISDFFont::Load(const void* pvrData, CPVRTString* const pErrorStr)
+{
+	const PVRTuint32* header = (const PVRTuint32*)pvrData;
+	if (header == NULL || header[0] != c_pvrV3Identifier) {
+		*pErrorStr = "ERROR: UISDFFont expects a PVR v3 atlas";
+		return false;
+	}
+
+	if (!parseMetaData(header, pErrorStr)) {
+		return false;
+	}
+
+	if (PVRTTextureLoadFromPointer(pvrData, &m_uiTexture, NULL, true, 0, NULL, NULL) != PVR_SUCCESS) {
+		*pErrorStr = "ERROR: UISDFFont failed to load atlas texture";
+		return false;
+	}
+	// Distance fields need bilinear filtering to reconstruct the edges
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		HasFace
+ @Input			face		Face index (UIFont)
+ @Return		bool		Does the atlas contain the face
+ @Description	Checks whether a face was generated into the atlas
+******************************************************************************/
+bool
+UISDFFont::HasFace(int face)
+{
+	return face >= 0 && face < m_numFaces && m_faces[face].loaded;
+}
+
+/*!****************************************************************************
+ @Function		Measure
+ @Input			face		Face index (UIFont)
+ @Output		width		Pointer to the width of the text
+ @Output		height		Pointer to the height of the text
+ @Input			scale		Text scale
+ @Input			text		The text being measured
+ @Description	Measures a single line of text
+******************************************************************************/
+void
+UISDFFont::Measure(int face, float* width, float* height, float scale, const char* text)
+{
+	*width = 0;
+	*height = 0;
+	if (!HasFace(face) || text == NULL) {
+		return;
+	}
+	float length = 0;
+	for ( int i = 0; text[i] != '\0'; i ++ ) {
+		const UIGlyph* glyph = GetGlyph(face, text[i]);
+		length += (glyph == NULL) ? m_faces[face].spaceAdvance : glyph->advance;
+	}
+	*width = length * scale;
+	*height = m_faces[face].lineHeight * scale;
+}
+
+/*!****************************************************************************
+ @Function		GetGlyph
+ @Input			face		Face index (UIFont)
+ @Input			c			Character code
+ @Return		UIGlyph*	The glyph's metrics, NULL if the face doesn't have it
+ @Description	Looks up a glyph. Characters without glyphs render as spaces
+******************************************************************************/
+const UIGlyph*
+UISDFFont::GetGlyph(int face, char c)
+{
+	unsigned char code = (unsigned char)c;
+	if (!HasFace(face) || code >= c_numGlyphCodes || !m_faces[face].glyphs[code].valid) {
+		return NULL;
+	}
+	return &m_faces[face].glyphs[code];
+}
+
+/*!****************************************************************************
+ @Function		GetLineHeight
+ @Input			face		Face index (UIFont)
+ @Return		float		Unscaled height of a line of text
+ @Description	Returns a face's line height
+******************************************************************************/
+float
+UISDFFont::GetLineHeight(int face)
+{
+	return HasFace(face) ? m_faces[face].lineHeight : 0;
+}
+
+/*!****************************************************************************
+ @Function		GetSpaceAdvance
+ @Input			face		Face index (UIFont)
+ @Return		float		Unscaled width of a space
+ @Description	Returns the width of a space in a face
+******************************************************************************/
+float
+UISDFFont::GetSpaceAdvance(int face)
+{
+	return HasFace(face) ? m_faces[face].spaceAdvance : 0;
+}
+
+/*!****************************************************************************
+ @Function		GetSpread
+ @Return		float		Distance (in atlas pixels) covered by the field
+ @Description	Returns the distance field's spread, used to pick the edge
+				smoothing width
+******************************************************************************/
+float
+UISDFFont::GetSpread()
+{
+	return m_spread;
+}
+
+/*!****************************************************************************
+ @Function		GetTexture
+ @Return		GLuint		The atlas texture
+ @Description	Returns the atlas' GL texture
+******************************************************************************/
+GLuint
+UISDFFont::GetTexture()
+{
+	return m_uiTexture;
+}
+
+/*!****************************************************************************
+ @Function		Delete
+ @Description	Frees the atlas texture
+******************************************************************************/
+void
+UISDFFont::Delete()
+{
+	if (m_uiTexture != 0) {
+		glDeleteTextures(1, &m_uiTexture);
+		m_uiTexture = 0;
+	}
+	m_numFaces = 0;
+}
+
+/*!****************************************************************************
+ @Function		parseMetaData
+ @Input			header		Pointer to the PVR v3 header of the atlas
+ @Output		pErrorStr	Error message on failure
+ @Description	HELPER - reads the atlas header and the per face metric tables
+				written by tools/SDFFontGen
+******************************************************************************/
+bool
+UISDFFont::parseMetaData(const PVRTuint32* header, CPVRTString* const pErrorStr)
+{
+	m_texHeight = header[6];
+	m_texWidth = header[7];
+	PVRTuint32 metaDataSize = header[12];
+
+	const PVRTuint8* block = (const PVRTuint8*)(header + c_pvrV3HeaderWords);
+	const PVRTuint8* end = block + metaDataSize;
+	const PVRTuint32* sdfHeader = NULL;
+	const PVRTuint32* metrics = NULL;
+	const PVRTuint32* metricsEnd = NULL;
+
+	while (block + 3 * sizeof(PVRTuint32) <= end) {
+		const PVRTuint32* blockHeader = (const PVRTuint32*)block;
+		PVRTuint32 dataSize = blockHeader[2];
+		const PVRTuint8* data = block + 3 * sizeof(PVRTuint32);
+		if (blockHeader[1] == c_sdfFontHeader) {
+			sdfHeader = (const PVRTuint32*)data;
+		} else if (blockHeader[1] == c_sdfFontMetrics) {
+			metrics = (const PVRTuint32*)data;
+			metricsEnd = (const PVRTuint32*)(data + dataSize);
+		}
+		block = data + dataSize;
+	}
+
+	if (sdfHeader == NULL || metrics == NULL) {
+		*pErrorStr = "ERROR: UISDFFont atlas is missing SDF meta data";
+		return false;
+	}
+
+	m_numFaces = sdfHeader[0];
+	if (m_numFaces > c_maxSDFFaces) {
+		m_numFaces = c_maxSDFFaces;
+	}
+	memcpy(&m_size, &sdfHeader[1], sizeof(float));
+	memcpy(&m_spread, &sdfHeader[2], sizeof(float));
+
+	// Each face: line height, ascent, space advance, glyph count, then
+	// (code, x, y, w, h, x offset, y offset, advance) per glyph
+	const PVRTuint32* word = metrics;
+	for ( int f = 0; f < m_numFaces; f ++ ) {
+		if (word + 4 > metricsEnd) {
+			*pErrorStr = "ERROR: UISDFFont metrics are truncated";
+			return false;
+		}
+		UISDFFace* face = &m_faces[f];
+		memcpy(&face->lineHeight, &word[0], sizeof(float));
+		memcpy(&face->ascent, &word[1], sizeof(float));
+		memcpy(&face->spaceAdvance, &word[2], sizeof(float));
+		PVRTuint32 numGlyphs = word[3];
+		word += 4;
+		if (word + 8 * numGlyphs > metricsEnd) {
+			*pErrorStr = "ERROR: UISDFFont metrics are truncated";
+			return false;
+		}
+
+		for ( PVRTuint32 i = 0; i < numGlyphs; i ++, word += 8 ) {
+			if (word[0] >= (PVRTuint32)c_numGlyphCodes) {
+				continue;
+			}
+			UIGlyph* glyph = &face->glyphs[word[0]];
+			PVRTint32 x = word[1], y = word[2], w = word[3], h = word[4];
+			glyph->u0 = (float)x / m_texWidth;
+			glyph->v0 = (float)y / m_texHeight;
+			glyph->u1 = (float)(x + w) / m_texWidth;
+			glyph->v1 = (float)(y + h) / m_texHeight;
+			glyph->width = w;
+			glyph->height = h;
+			memcpy(&glyph->xOffset, &word[5], sizeof(float));
+			memcpy(&glyph->yOffset, &word[6], sizeof(float));
+			memcpy(&glyph->advance, &word[7], sizeof(float));
+			glyph->valid = true;
+		}
+		face->loaded = numGlyphs > 0;
+	}
+	return true;
+}
@@ -0,0 +1,70 @@
+/******************************************************************************
+ @File          UISDFFont.h
+ @Title         UISDFFont Header File
+ @Author        Siddharth Hathi
+ @Description   Header file for the UISDFFont class.
+******************************************************************************/
+
+#include "OGLES2Tools.h"
+#include "UIGlyphFont.h"
+
+#ifndef _UISDFFONT_H
+#define _UISDFFONT_H
+
+// Meta data keys written into SDF atlases by tools/SDFFontGen
+const PVRTuint32 c_sdfFontHeader = 0xFCFC0060;
+const PVRTuint32 c_sdfFontMetrics = 0xFCFC0061;
+
+// Maximum number of faces (one per UIFont) in an atlas
+const int c_maxSDFFaces = 5;
+
+// Metrics of every glyph of one face in the atlas
+struct UISDFFace {
+	UIGlyph glyphs[c_numGlyphCodes];
+	float lineHeight, ascent, spaceAdvance;
+	bool loaded;
+};
+
+/*!****************************************************************************
+ @class UISDFFont
+ Object class. A UISDFFont is a signed distance field font atlas generated by
+ tools/SDFFontGen. Every UIFont weight is stored as a face in the same texture,
+ so text of any weight and size can be drawn from one texture binding. Glyph
+ metrics are in pixels at the size the atlas was generated at, which should be
+ the size the bitmap fonts were generated at so that UIPrinter text scales mean
+ the same thing in both modes.
+******************************************************************************/
+class UISDFFont
+{
+	protected:
+		// Instance variables
+
+		// Glyph tables of every face in the atlas
+		UISDFFace m_faces[c_maxSDFFaces];
+		int m_numFaces;
+
+		// Size the glyphs were rendered at and the distance field's spread
+		float m_size, m_spread;
+
+		// Atlas dimensions and GL texture
+		int m_texWidth, m_texHeight;
+		GLuint m_uiTexture;
+
+		// Local functions
+		bool parseMetaData(const PVRTuint32* header, CPVRTString* const pErrorStr);
+
+	public:
+		// Exported functions
+		UISDFFont();
+		bool Load(const void* pvrData, CPVRTString* const pErrorStr);
+		bool HasFace(int face);
+		void Measure(int face, float* width, float* height, float scale, const char* text);
+		const UIGlyph* GetGlyph(int face, char c);
+		float GetLineHeight(int face);
+		float GetSpaceAdvance(int face);
+		float GetSpread();
+		GLuint GetTexture();
+		void Delete();
+};
+
+#endif
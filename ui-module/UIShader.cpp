@@ -0,0 +1,133 @@
+/******************************************************************************
+ @File          UIShader.cpp
+ @Title         UIShader
+ @Author        Siddharth Hathi
+ @Description   Implements the UIShader object class defined in UIShader.h
+******************************************************************************/
+
+#include "UIShader.h"
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes an empty shader
+******************************************************************************/
+UIShader::UIShader()
+{
+	m_program = 0;
+	m_vertShader = 0;
+	m_fragShader = 0;
+	m_prevProgram = 0;
+}
+
+/*!****************************************************************************
+ @Function		Build
+ @Input			vertSrc			Vertex shader source
+ @Input			fragSrc			Fragment shader source
+ @Input			attribs			Attribute names and the indices they bind to
+ @Input			numAttribs		Number of attributes
+ @Output		pErrorStr		Error message on failure
+ @Description	Compiles both shaders and links them into a program with the
+				attributes bound to the requested indices
+******************************************************************************/
+bool
+UIShader::Build(const char* vertSrc, const char* fragSrc, const UIShaderAttrib* attribs,
+	int numAttribs, CPVRTString* const pErrorStr)
+{
+	if (PVRTShaderLoadSourceFromMemory(vertSrc, GL_VERTEX_SHADER, &m_vertShader, pErrorStr) != PVR_SUCCESS) {
+		fprintf(stderr, "UIShader vertex shader failed to compile\n");
+		return false;
+	}
+	if (PVRTShaderLoadSourceFromMemory(fragSrc, GL_FRAGMENT_SHADER, &m_fragShader, pErrorStr) != PVR_SUCCESS) {
+		fprintf(stderr, "UIShader fragment shader failed to compile\n");
+		return false;
+	}
+
+	m_program = glCreateProgram();
+	glAttachShader(m_program, m_vertShader);
+	glAttachShader(m_program, m_fragShader);
+	for ( int i = 0; i < numAttribs; i ++ ) {
+		glBindAttribLocation(m_program, attribs[i].index, attribs[i].name);
+	}
+	glLinkProgram(m_program);
+
+	GLint linked;
+	glGetProgramiv(m_program, GL_LINK_STATUS, &linked);
+	if (!linked) {
+		*pErrorStr = "ERROR: UIShader failed to link";
+		fprintf(stderr, "UIShader failed to link\n");
+		return false;
+	}
+
+	// Samplers always read from texture unit 0
+	GLint prevProgram;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &prevProgram);
+	glUseProgram(m_program);
+	glUniform1i(glGetUniformLocation(m_program, "sTexture"), 0);
+	glUseProgram(prevProgram);
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		GetUniform
+ @Input			name		Name of the uniform
+ @Return		GLint		Location of the uniform in the program
+ @Description	Looks up a uniform location
+******************************************************************************/
+GLint
+UIShader::GetUniform(const char* name)
+{
+	return glGetUniformLocation(m_program, name);
+}
+
+/*!****************************************************************************
+ @Function		GetProgram
+ @Return		GLuint		The GL program handle
+ @Description	Returns the GL program handle
+******************************************************************************/
+GLuint
+UIShader::GetProgram()
+{
+	return m_program;
+}
+
+/*!****************************************************************************
+ @Function		Use
+ @Description	Binds the program, remembering the program it replaced
+******************************************************************************/
+void
+UIShader::Use()
+{
+	glGetIntegerv(GL_CURRENT_PROGRAM, &m_prevProgram);
+	glUseProgram(m_program);
+}
+
+/*!****************************************************************************
+ @Function		Restore
+ @Description	Rebinds the program that was bound before Use was called
+******************************************************************************/
+void
+UIShader::Restore()
+{
+	glUseProgram(m_prevProgram);
+}
+
+/*!****************************************************************************
+ @Function		Delete
+ @Description	Frees the GL objects owned by the shader
+******************************************************************************/
+void
+UIShader::Delete()
+{
+	if (m_program != 0) {
+		glDeleteProgram(m_program);
+		m_program = 0;
+	}
+	if (m_vertShader != 0) {
+		glDeleteShader(m_vertShader);
+		m_vertShader = 0;
+	}
+	if (m_fragShader != 0) {
+		glDeleteShader(m_fragShader);
+		m_fragShader = 0;
+	}
+}
@@ -0,0 +1,51 @@
+/******************************************************************************
+ @File          UIShader.h
+ @Title         UIShader Header File
+ @Author        Siddharth Hathi
+ @Description   Header file for the UIShader class.
+******************************************************************************/
+
+#include "OGLES2Tools.h"
+
+#ifndef _UISHADER_H
+#define _UISHADER_H
+
+// struct used to bind a shader attribute name to a fixed attribute index
+struct UIShaderAttrib {
+	const char* name;
+	GLuint index;
+};
+
+/*!****************************************************************************
+ @class UIShader
+ Object class. A UIShader is a small wrapper around a GL ES 2.0 program object
+ used by the UIKit for the draws that can't go through the UILayer's image
+ shader (text, batched sprites, shader driven progress bars). Attributes are
+ bound to explicit indices so that the UIKit's attribute constants can be shared
+ between programs. Use() remembers the program that was bound beforehand so that
+ Restore() can hand the pipeline back to the UILayer.
+******************************************************************************/
+class UIShader
+{
+	protected:
+		// Instance variables
+
+		// GL handles of the program and its shaders
+		GLuint m_program, m_vertShader, m_fragShader;
+
+		// Program that was bound when Use was called
+		GLint m_prevProgram;
+
+	public:
+		// Exported functions
+		UIShader();
+		bool Build(const char* vertSrc, const char* fragSrc, const UIShaderAttrib* attribs,
+			int numAttribs, CPVRTString* const pErrorStr);
+		GLint GetUniform(const char* name);
+		GLuint GetProgram();
+		void Use();
+		void Restore();
+		void Delete();
+};
+
+#endif
@@ -0,0 +1,575 @@
+/******************************************************************************
+ @File          UIShmTransport.cpp
+ @Title         UIShmTransport
+ @Author        Siddharth Hathi
+ @Description   Implements the UIShmProducer and UIShmConsumer object classes
+				defined in UIShmTransport.h
+******************************************************************************/
+
+#include "UIShmTransport.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static_assert(sizeof(UIShmHeader) <= c_shmHeaderBytes, "UIShmHeader must fit before the first slot");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex words must be plain 32 bit words");
+
+/*!****************************************************************************
+ @Function		slotAt
+ @Input			mapping		The mapped ring
+ @Input			numSlots	Number of slots in the ring
+ @Input			stride		Distance between slots
+ @Input			number		A frame number
+ @Return		UIShmSlot*	The slot the frame goes in
+ @Description	HELPER - finds a frame's slot
+******************************************************************************/
+static UIShmSlot*
+slotAt(void* mapping, uint32_t numSlots, uint32_t stride, uint32_t number)
+{
+	return (UIShmSlot*) ((char*) mapping + c_shmHeaderBytes + (size_t) ((number - 1) % numSlots) * stride);
+}
+
+/*!****************************************************************************
+ @Function		futexWake
+ @Input			word		The futex
+ @Description	HELPER - wakes every process sleeping on a shared futex
+******************************************************************************/
+static void
+futexWake(std::atomic<uint32_t>* word)
+{
+	syscall(SYS_futex, (uint32_t*) word, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+/*!****************************************************************************
+ @Function		futexWait
+ @Input			word		The futex
+ @Input			expected	Value to sleep while the futex holds
+ @Input			timeout		Longest time to sleep
+ @Description	HELPER - sleeps on a shared futex until it is woken, the word
+				no longer holds expected, a signal arrives or the timeout
+				passes
+******************************************************************************/
+static void
+futexWait(std::atomic<uint32_t>* word, uint32_t expected, const struct timespec* timeout)
+{
+	syscall(SYS_futex, (uint32_t*) word, FUTEX_WAIT, expected, timeout, NULL, 0);
+}
+
+/*!****************************************************************************
+ @Function		UIShmNow
+ @Return		uint64_t	Nanoseconds on the monotonic clock
+ @Description	Reads the clock frames are stamped with
+******************************************************************************/
+uint64_t
+UIShmNow()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * 1000000000ull + now.tv_nsec;
+}
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes a producer with no ring
+******************************************************************************/
+UIShmProducer::UIShmProducer()
+{
+	m_mapping = NULL;
+	m_mappingSize = 0;
+	m_header = NULL;
+	m_published = 0;
+	m_writing = false;
+}
+
+/*!****************************************************************************
+ @Function		Create
+ @Input			name		Name of the shared memory object ("/name")
+ @Input			numSlots	Number of frames the ring holds (at least 2)
+ @Input			slotSize	Largest frame in bytes
+ @Output		pErrorStr	Pointer to the string returned on error
+ @Return		bool		Is the ring ready to publish to?
+ @Description	Creates the ring, or maps it again if it already exists with
+				the same layout, in which case frame numbers carry on from
+				the last one published. A ring with a different layout is
+				laid out afresh.
+******************************************************************************/
+bool
+UIShmProducer::Create(const char* name, int numSlots, size_t slotSize, CPVRTString* const pErrorStr)
+{
+	Close();
+	if (numSlots < 2 || slotSize < sizeof(UIFrame) || slotSize > (size_t) c_maxFrameText + sizeof(UIFrame)) {
+		fprintf(stderr, "UIShmProducer needs at least 2 slots of %u to %u bytes\n",
+			(unsigned int) sizeof(UIFrame), (unsigned int) (c_maxFrameText + sizeof(UIFrame)));
+		*pErrorStr = "ERROR: Invalid frame ring layout";
+		return false;
+	}
+	slotSize = (slotSize + 3) & ~(size_t) 3;
+	size_t stride = (sizeof(UIShmSlot) + slotSize + c_shmSlotAlign - 1) / c_shmSlotAlign * c_shmSlotAlign;
+	size_t size = c_shmHeaderBytes + numSlots * stride;
+
+	int fd = shm_open(name, O_RDWR | O_CREAT, 0600);
+	if (fd < 0) {
+		fprintf(stderr, "Can't open shared memory %s: %s\n", name, strerror(errno));
+		*pErrorStr = "ERROR: Can't create frame ring";
+		return false;
+	}
+	struct stat info;
+	bool sameSize = fstat(fd, &info) == 0 && (size_t) info.st_size == size;
+	if (!sameSize && ftruncate(fd, size) != 0) {
+		fprintf(stderr, "Can't size shared memory %s: %s\n", name, strerror(errno));
+		close(fd);
+		*pErrorStr = "ERROR: Can't create frame ring";
+		return false;
+	}
+	void* mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (mapping == MAP_FAILED) {
+		fprintf(stderr, "Can't map shared memory %s: %s\n", name, strerror(errno));
+		*pErrorStr = "ERROR: Can't create frame ring";
+		return false;
+	}
+
+	UIShmHeader* header = (UIShmHeader*) mapping;
+	bool sameLayout = sameSize && __atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) == c_shmMagic
+		&& header->version == c_shmVersion && header->headerSize == sizeof(UIShmHeader)
+		&& header->schema == UIFrameSchema() && header->numSlots == (uint32_t) numSlots
+		&& header->slotSize == slotSize && header->slotStride == stride;
+	if (!sameLayout) {
+		// Consumers check the magic number last, so they never see a ring
+		// that is half laid out
+		memset(mapping, 0, size);
+		header->version = c_shmVersion;
+		header->headerSize = sizeof(UIShmHeader);
+		header->schema = UIFrameSchema();
+		header->numSlots = numSlots;
+		header->slotSize = slotSize;
+		header->slotStride = stride;
+		__atomic_store_n(&header->magic, c_shmMagic, __ATOMIC_RELEASE);
+	}
+
+	m_mapping = mapping;
+	m_mappingSize = size;
+	m_header = header;
+	m_published = header->published.load();
+	m_writing = false;
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		Begin
+ @Return		UIFrameWriter*	Writer of the next frame (NULL if there is no
+								ring)
+ @Description	Starts the next frame in its slot. Consumers that were
+				reading the frame the slot held before will see that it has
+				been written over and skip it.
+******************************************************************************/
+UIFrameWriter*
+UIShmProducer::Begin()
+{
+	if (m_header == NULL) {
+		return NULL;
+	}
+	uint32_t number = m_published + 1;
+	UIShmSlot* slot = slotAt(m_mapping, m_header->numSlots, m_header->slotStride, number);
+	slot->sequence.store(number * 2 - 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	m_writing = m_writer.Begin(slot + 1, m_header->slotSize, number);
+	return m_writing ? &m_writer : NULL;
+}
+
+/*!****************************************************************************
+ @Function		Publish
+ @Return		bool		Was the frame published?
+ @Description	Finishes the frame started by Begin and publishes it
+******************************************************************************/
+bool
+UIShmProducer::Publish()
+{
+	return m_writing && publishSlot(m_writer.Finish());
+}
+
+/*!****************************************************************************
+ @Function		Publish
+ @Input			frame		A frame written by a UIFrameWriter
+ @Input			size		Size of the frame
+ @Return		bool		Was the frame published?
+ @Description	Copies a frame built elsewhere into the next slot and
+				publishes it
+******************************************************************************/
+bool
+UIShmProducer::Publish(const void* frame, size_t size)
+{
+	if (m_header == NULL || frame == NULL || size < sizeof(UIFrame) || size > m_header->slotSize) {
+		fprintf(stderr, "UIShmProducer can't publish a %u byte frame\n", (unsigned int) size);
+		return false;
+	}
+	if (Begin() == NULL) {
+		return false;
+	}
+	// The payload follows the slot header (which holds an atomic, so it is
+	// addressed as bytes rather than copied into as a UIShmSlot)
+	UIShmSlot* slot = slotAt(m_mapping, m_header->numSlots, m_header->slotStride, m_published + 1);
+	memcpy((char*) (slot + 1), frame, size);
+	return publishSlot(size);
+}
+
+/*!****************************************************************************
+ @Function		GetFrameCount
+ @Return		uint32_t	Number of the last frame published
+ @Description	Getter for m_published
+******************************************************************************/
+uint32_t
+UIShmProducer::GetFrameCount()
+{
+	return m_published;
+}
+
+/*!****************************************************************************
+ @Function		Close
+ @Description	Unmaps the ring. The shared memory object stays, so consumers
+				keep the last frame and a restarted producer carries on.
+******************************************************************************/
+void
+UIShmProducer::Close()
+{
+	if (m_mapping != NULL) {
+		munmap(m_mapping, m_mappingSize);
+	}
+	m_mapping = NULL;
+	m_mappingSize = 0;
+	m_header = NULL;
+	m_writing = false;
+}
+
+/*!****************************************************************************
+ @Function		Remove
+ @Input			name		Name of the shared memory object
+ @Description	Removes a ring's shared memory object. Processes that have it
+				mapped keep their mapping.
+******************************************************************************/
+void
+UIShmProducer::Remove(const char* name)
+{
+	shm_unlink(name);
+}
+
+/*!****************************************************************************
+ @Function		publishSlot
+ @Input			size		Size of the frame in the next slot (0 if it
+							couldn't be written)
+ @Return		bool		Was the frame published?
+ @Description	HELPER - stamps the frame, marks its slot as written and
+				bumps the published frame number, waking any consumer asleep
+				on it. A frame that couldn't be written leaves its slot
+				marked as being written, and the next Begin reuses it.
+******************************************************************************/
+bool
+UIShmProducer::publishSlot(size_t size)
+{
+	m_writing = false;
+	if (size == 0) {
+		return false;
+	}
+	uint32_t number = m_published + 1;
+	UIShmSlot* slot = slotAt(m_mapping, m_header->numSlots, m_header->slotStride, number);
+	slot->size = size;
+	slot->publishNs = UIShmNow();
+	slot->sequence.store(number * 2, std::memory_order_release);
+
+	// Sequentially consistent with the consumer's waiters count, so either
+	// the consumer sees the new frame before sleeping or this sees it asleep
+	m_header->published.store(number);
+	m_published = number;
+	if (m_header->waiters.load() != 0) {
+		futexWake(&m_header->published);
+	}
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes a consumer with no ring
+******************************************************************************/
+UIShmConsumer::UIShmConsumer()
+{
+	m_mapping = NULL;
+	m_mappingSize = 0;
+	m_header = NULL;
+	m_numSlots = 0;
+	m_slotSize = 0;
+	m_slotStride = 0;
+	m_buffer = NULL;
+	m_read = 0;
+	m_publishNs = 0;
+	m_dropped = 0;
+}
+
+/*!****************************************************************************
+ @Function		Open
+ @Input			name		Name of the shared memory object ("/name")
+ @Output		pErrorStr	Pointer to the string returned on error
+ @Return		bool		Was the ring opened?
+ @Description	Maps a ring created by a UIShmProducer and checks its layout.
+				Reading starts from the newest frame published.
+******************************************************************************/
+bool
+UIShmConsumer::Open(const char* name, CPVRTString* const pErrorStr)
+{
+	Delete();
+	int fd = shm_open(name, O_RDWR, 0);
+	if (fd < 0) {
+		fprintf(stderr, "Can't open shared memory %s: %s\n", name, strerror(errno));
+		*pErrorStr = "ERROR: Can't open frame ring";
+		return false;
+	}
+	struct stat info;
+	if (fstat(fd, &info) != 0 || (size_t) info.st_size < c_shmHeaderBytes) {
+		close(fd);
+		*pErrorStr = "ERROR: Frame ring isn't laid out";
+		return false;
+	}
+	size_t size = info.st_size;
+	void* mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (mapping == MAP_FAILED) {
+		fprintf(stderr, "Can't map shared memory %s: %s\n", name, strerror(errno));
+		*pErrorStr = "ERROR: Can't open frame ring";
+		return false;
+	}
+
+	UIShmHeader* header = (UIShmHeader*) mapping;
+	if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != c_shmMagic || header->version != c_shmVersion
+		|| header->headerSize != sizeof(UIShmHeader)) {
+		munmap(mapping, size);
+		*pErrorStr = "ERROR: Not a frame ring of this version";
+		return false;
+	}
+	if (header->schema != UIFrameSchema()) {
+		munmap(mapping, size);
+		*pErrorStr = "ERROR: Frame ring was created with different message keys";
+		return false;
+	}
+	uint32_t numSlots = header->numSlots;
+	uint32_t slotSize = header->slotSize;
+	uint32_t stride = header->slotStride;
+	if (numSlots < 2 || slotSize < sizeof(UIFrame) || (slotSize & 3) != 0 || stride < sizeof(UIShmSlot) + slotSize
+		|| (stride % c_shmSlotAlign) != 0 || c_shmHeaderBytes + (size_t) numSlots * stride > size) {
+		munmap(mapping, size);
+		*pErrorStr = "ERROR: Frame ring layout is invalid";
+		return false;
+	}
+	m_buffer = (uint32_t*) malloc(slotSize);
+	if (m_buffer == NULL) {
+		munmap(mapping, size);
+		*pErrorStr = "ERROR: Can't allocate frame buffer";
+		return false;
+	}
+
+	m_mapping = mapping;
+	m_mappingSize = size;
+	m_header = header;
+	m_numSlots = numSlots;
+	m_slotSize = slotSize;
+	m_slotStride = stride;
+	uint32_t published = header->published.load();
+	m_read = published > 0 ? published - 1 : 0;
+	m_publishNs = 0;
+	m_dropped = 0;
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		Wait
+ @Input			timeoutMs	Longest time to wait (0 to only check)
+ @Return		bool		Is there a frame that hasn't been read?
+ @Description	Sleeps until the producer publishes a frame that hasn't been
+				read, or the timeout passes
+******************************************************************************/
+bool
+UIShmConsumer::Wait(int timeoutMs)
+{
+	if (m_header == NULL) {
+		return false;
+	}
+	uint32_t published = m_header->published.load();
+	if (published != m_read || timeoutMs <= 0) {
+		return published != m_read;
+	}
+
+	uint64_t deadline = UIShmNow() + timeoutMs * 1000000ull;
+	m_header->waiters.fetch_add(1);
+	while ((published = m_header->published.load()) == m_read) {
+		uint64_t now = UIShmNow();
+		if (now >= deadline) {
+			break;
+		}
+		struct timespec timeout;
+		timeout.tv_sec = (deadline - now) / 1000000000ull;
+		timeout.tv_nsec = (deadline - now) % 1000000000ull;
+		futexWait(&m_header->published, published, &timeout);
+	}
+	m_header->waiters.fetch_sub(1);
+	return published != m_read;
+}
+
+/*!****************************************************************************
+ @Function		Next
+ @Output		message		The message to load the frame into
+ @Return		bool		Was a frame read?
+ @Description	Reads the oldest frame that hasn't been read and is still in
+				the ring. Frames the producer wrote over before they were
+				read are skipped and counted as dropped. Doesn't wait.
+******************************************************************************/
+bool
+UIShmConsumer::Next(UIMessage* message)
+{
+	if (m_header == NULL) {
+		return false;
+	}
+	uint32_t published = m_header->published.load(std::memory_order_acquire);
+	if ((int32_t) (published - m_read) < 0) {
+		// The producer laid the ring out again and started over
+		m_read = published > 0 ? published - 1 : 0;
+	}
+	while (m_read != published) {
+		uint32_t number = m_read + 1;
+		if (published - number >= m_numSlots) {
+			m_dropped += published - number - m_numSlots + 1;
+			number = published - m_numSlots + 1;
+		}
+		m_read = number;
+		if (readFrame(number, message)) {
+			return true;
+		}
+		m_dropped ++;
+		published = m_header->published.load(std::memory_order_acquire);
+	}
+	return false;
+}
+
+/*!****************************************************************************
+ @Function		Latest
+ @Output		message		The message to load the frame into
+ @Return		bool		Was a frame read?
+ @Description	Reads the newest frame if it hasn't been read, skipping any
+				older ones (counted as dropped). Doesn't wait.
+******************************************************************************/
+bool
+UIShmConsumer::Latest(UIMessage* message)
+{
+	if (m_header == NULL) {
+		return false;
+	}
+	uint32_t published = m_header->published.load(std::memory_order_acquire);
+	if ((int32_t) (published - m_read) < 0) {
+		m_read = published > 0 ? published - 1 : 0;
+	}
+	while (m_read != published) {
+		m_dropped += published - m_read - 1;
+		m_read = published;
+		if (readFrame(published, message)) {
+			return true;
+		}
+		m_dropped ++;
+		published = m_header->published.load(std::memory_order_acquire);
+	}
+	return false;
+}
+
+/*!****************************************************************************
+ @Function		GetSequence
+ @Return		uint32_t	Number of the last frame read
+ @Description	Getter for m_read
+******************************************************************************/
+uint32_t
+UIShmConsumer::GetSequence()
+{
+	return m_read;
+}
+
+/*!****************************************************************************
+ @Function		GetPublishTime
+ @Return		uint64_t	UIShmNow() when the last frame read was
+							published
+ @Description	Getter for m_publishNs. Subtracting it from UIShmNow() gives
+				the frame's latency.
+******************************************************************************/
+uint64_t
+UIShmConsumer::GetPublishTime()
+{
+	return m_publishNs;
+}
+
+/*!****************************************************************************
+ @Function		GetDroppedCount
+ @Return		uint32_t	Frames skipped or rejected
+ @Description	Getter for m_dropped
+******************************************************************************/
+uint32_t
+UIShmConsumer::GetDroppedCount()
+{
+	return m_dropped;
+}
+
+/*!****************************************************************************
+ @Function		Delete
+ @Description	Unmaps the ring and frees the frame buffer
+******************************************************************************/
+void
+UIShmConsumer::Delete()
+{
+	if (m_mapping != NULL) {
+		munmap(m_mapping, m_mappingSize);
+	}
+	free(m_buffer);
+	m_mapping = NULL;
+	m_mappingSize = 0;
+	m_header = NULL;
+	m_buffer = NULL;
+	m_read = 0;
+}
+
+/*!****************************************************************************
+ @Function		readFrame
+ @Input			number		A frame number that has been published
+ @Output		message		The message to load the frame into
+ @Return		bool		Was the frame read?
+ @Description	HELPER - copies a frame out of its slot, checks that the
+				producer didn't start writing over it during the copy, and
+				loads the copy into the message. The message isn't touched
+				if the frame was written over or is invalid.
+******************************************************************************/
+bool
+UIShmConsumer::readFrame(uint32_t number, UIMessage* message)
+{
+	UIShmSlot* slot = slotAt(m_mapping, m_numSlots, m_slotStride, number);
+	uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+	if (sequence != number * 2) {
+		return false;
+	}
+	size_t size = slot->size;
+	uint64_t publishNs = slot->publishNs;
+	if (size > m_slotSize) {
+		size = m_slotSize;
+	}
+	memcpy(m_buffer, slot + 1, size);
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (slot->sequence.load(std::memory_order_relaxed) != sequence) {
+		return false;
+	}
+
+	CPVRTString error;
+	if (!message->Load(m_buffer, size, &error)) {
+		return false;
+	}
+	m_publishNs = publishNs;
+	return true;
+}
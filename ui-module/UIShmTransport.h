@@ -0,0 +1,183 @@
+/******************************************************************************
+ @File          UIShmTransport.h
+ @Title         UIShmTransport Header File
+ @Author        Siddharth Hathi
+ @Description   Header file for the UIShmProducer and UIShmConsumer classes.
+******************************************************************************/
+
+#include "OGLES2Tools.h"
+#include "UIElement.h"
+#include "UIFrame.h"
+#include <stdint.h>
+#include <atomic>
+
+#ifndef _UISHMTRANSPORT_H
+#define _UISHMTRANSPORT_H
+
+// Identifies a frame ring ("UISM" in memory) and the version of its layout
+const uint32_t c_shmMagic = 0x4d534955;
+const uint16_t c_shmVersion = 1;
+
+// Default name of the shared memory object, frames in the ring and bytes
+// per frame
+const char* const c_defaultShmName = "/uikit-frames";
+const int c_defaultShmSlots = 8;
+const size_t c_defaultShmSlotSize = 4096;
+
+// Bytes the ring header takes up before the first slot, and the alignment
+// of the slots (a cache line, so the producer and consumer don't share one
+// between slots)
+const size_t c_shmHeaderBytes = 64;
+const size_t c_shmSlotAlign = 64;
+
+// Header at the start of the shared memory object
+struct UIShmHeader {
+	// Magic number, layout version, sizeof(UIShmHeader) and UIFrameSchema()
+	// of the producer
+	uint32_t magic;
+	uint16_t version;
+	uint16_t headerSize;
+	uint32_t schema;
+
+	// Number of slots, the bytes of frame each holds, and the distance
+	// between slots
+	uint32_t numSlots;
+	uint32_t slotSize;
+	uint32_t slotStride;
+
+	// Number of the last frame published (frames are numbered from 1). This
+	// is the futex consumers sleep on
+	std::atomic<uint32_t> published;
+
+	// Consumers sleeping in Wait, so the producer only wakes when someone is
+	// asleep
+	std::atomic<uint32_t> waiters;
+};
+
+// Header of each slot, followed by the frame. Frame n goes in slot
+// (n - 1) % numSlots, and sequence is 2n - 1 while it is being written and
+// 2n once it is published, so a consumer can tell when the producer wrote
+// over a frame it was copying.
+struct UIShmSlot {
+	std::atomic<uint32_t> sequence;
+	uint32_t size;
+
+	// UIShmNow() when the frame was published
+	uint64_t publishNs;
+};
+
+// Monotonic clock time in nanoseconds, the same in every process. Frames are
+// stamped with it when they are published.
+uint64_t UIShmNow();
+
+/*!****************************************************************************
+ @class UIShmProducer
+ Object class. A UIShmProducer is the app process's side of the frame ring:
+ it writes UIFrames into a POSIX shared memory object that the UILayer's
+ process reads with a UIShmConsumer. Frames are written straight into the
+ ring's slots and publishing never waits for the consumer, so a stalled or
+ crashed renderer can't hold up the workout logic; if the consumer falls
+ more than a ring behind, it skips the frames that were written over.
+
+	producer.Create(c_defaultShmName, c_defaultShmSlots, c_defaultShmSlotSize, &error);
+	... every frame:
+	UIFrameWriter* writer = producer.Begin();
+	writer->Write(UIMTimeS, elapsed);
+	...
+	producer.Publish();
+
+ There can be one producer per ring. A producer that restarts with the same
+ name and layout carries on from the last frame number, so consumers keep
+ reading without reopening.
+******************************************************************************/
+class UIShmProducer
+{
+	protected:
+		// Instance variables
+
+		// The mapped ring and its size
+		void* m_mapping;
+		size_t m_mappingSize;
+		UIShmHeader* m_header;
+
+		// Number of the last frame published, and is the next one being
+		// written?
+		uint32_t m_published;
+		bool m_writing;
+
+		// Writer of the frame being built in its slot
+		UIFrameWriter m_writer;
+
+		// Local functions
+		bool publishSlot(size_t size);
+
+	public:
+		// Exported functions
+		UIShmProducer();
+		bool Create(const char* name, int numSlots, size_t slotSize, CPVRTString* const pErrorStr);
+		UIFrameWriter* Begin();
+		bool Publish();
+		bool Publish(const void* frame, size_t size);
+		uint32_t GetFrameCount();
+		void Close();
+		static void Remove(const char* name);
+};
+
+/*!****************************************************************************
+ @class UIShmConsumer
+ Object class. A UIShmConsumer is the UILayer's side of the frame ring. Each
+ frame is copied out of its slot, checked against the slot's sequence number
+ in case the producer wrote over it, and loaded into a UIMessage. Latest
+ takes the newest frame, which suits a render loop that updates the tree
+ once per frame; Next takes the frames in order. Wait sleeps on a futex
+ until a frame is published, for a consumer with a thread to spare.
+
+	consumer.Open(c_defaultShmName, &error);
+	... every frame:
+	if (consumer.Latest(&message)) {
+		UIFrameCache::Get()->Update(root, message);
+	}
+******************************************************************************/
+class UIShmConsumer
+{
+	protected:
+		// Instance variables
+
+		// The mapped ring and its size
+		void* m_mapping;
+		size_t m_mappingSize;
+		UIShmHeader* m_header;
+
+		// The ring's layout when it was opened, so a producer that lays it
+		// out again can't send reads outside the mapping
+		uint32_t m_numSlots;
+		uint32_t m_slotSize;
+		uint32_t m_slotStride;
+
+		// Frame copied out of its slot, so it can be checked and loaded
+		// without the producer changing it
+		uint32_t* m_buffer;
+
+		// Number of the last frame read, its publish time, and the frames
+		// skipped or rejected
+		uint32_t m_read;
+		uint64_t m_publishNs;
+		uint32_t m_dropped;
+
+		// Local functions
+		bool readFrame(uint32_t number, UIMessage* message);
+
+	public:
+		// Exported functions
+		UIShmConsumer();
+		bool Open(const char* name, CPVRTString* const pErrorStr);
+		bool Wait(int timeoutMs);
+		bool Next(UIMessage* message);
+		bool Latest(UIMessage* message);
+		uint32_t GetSequence();
+		uint64_t GetPublishTime();
+		uint32_t GetDroppedCount();
+		void Delete();
+};
+
+#endif
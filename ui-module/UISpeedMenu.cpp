@@ -6,6 +6,8 @@
 ******************************************************************************/
 
 #include "UISpeedMenu.h"
+#include "UIDispatcher.h"
+#include "UIStateTable.h"
 
 /*!****************************************************************************
  @Function		Constructor
@@ -20,6 +22,17 @@ UISpeedMenu::UISpeedMenu()
 	UISMSpec imgSpec = c_UISMSpecs[Arrows];
 	m_arrowsActive = new UIImage("updown.pvr", imgSpec.x, imgSpec.y, imgSpec.width, imgSpec.height);
 	m_arrowsInactive = new UIImage("updownGray.pvr", imgSpec.x, imgSpec.y, imgSpec.width, imgSpec.height);
+	UISMSpec titleSpec = c_UISMSpecs[Title];
+	m_title = UIStaticText(titleSpec.text, titleSpec.x, titleSpec.y, titleSpec.scale, 0xdddddddd, UIFBold);
+	UISMSpec backSpec = c_UISMSpecs[Back];
+	m_back = UIStaticText(backSpec.text, backSpec.x, backSpec.y, backSpec.scale, 0xdddddddd, UIFBold);
+	UISMSpec valueSpec = c_UISMSpecs[Value];
+	m_value = UINumericText(valueSpec.x, valueSpec.y, valueSpec.scale, 0xdddddddd, UIFBold);
+	m_valueValid = m_value.SetText(m_currentSpeed);
+	UIDispatcher::Get()->Subscribe(this, UIFieldState);
+	UIDispatcher::Get()->Subscribe(this, UISpeedSelected);
+	UIDispatcher::Get()->Subscribe(this, UISpeedMPM);
+	m_stateSlot = UIStateTable::Get()->Register(1u << UIMenuSpeed);
 }
 
 /*!****************************************************************************
@@ -47,6 +60,9 @@ UISpeedMenu::BuildVertices()
 		m_arrowsActive->BuildVertices();
 		m_arrowsInactive->BuildVertices();
 	}
+	m_title.BuildVertices();
+	m_back.BuildVertices();
+	m_value.BuildVertices();
 }
 
 /*!****************************************************************************
@@ -58,7 +74,7 @@ UISpeedMenu::BuildVertices()
 bool
 UISpeedMenu::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 {
-	if (m_hidden) {
+	if (m_hidden || !UIStateTable::Get()->IsVisible(m_stateSlot)) {
 		return true;
 	}
 	GLuint selectedColor = 0xFFFF0000;
@@ -67,18 +83,17 @@ UISpeedMenu::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 		UISMSpec spec = c_UISMSpecs[i];
 		switch (spec.type) {
 			case Title:
-					if (m_selected) {
-						printer->Print(spec.x, spec.y, spec.scale, selectedColor, UIFBold, spec.text);
-					} else {
-						printer->Print(spec.x, spec.y, spec.scale, deselectedColor, UIFBold, spec.text);
-					}
+				m_title.SetColor(m_selected ? selectedColor : deselectedColor);
+				m_title.Render(uiMVPMatrixLoc, printer);
 				break;
 			case Value:
 				if (!m_flash) {
-					if (m_selected) {
-						printer->Print(spec.x, spec.y, spec.scale, selectedColor, UIFBold, m_currentSpeed);
+					GLuint valueColor = m_selected ? selectedColor : deselectedColor;
+					if (m_valueValid) {
+						m_value.SetColor(valueColor);
+						m_value.Render(uiMVPMatrixLoc, printer);
 					} else {
-						printer->Print(spec.x, spec.y, spec.scale, deselectedColor, UIFBold, m_currentSpeed);
+						printer->Print(spec.x, spec.y, spec.scale, valueColor, UIFBold, m_currentSpeed);
 					}
 				}
 				break;
@@ -94,11 +109,8 @@ UISpeedMenu::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 				}
 				break;
 			case Back:
-				if (m_selected) {
-					printer->Print(spec.x, spec.y, spec.scale, deselectedColor, UIFBold, spec.text);
-				} else {
-					printer->Print(spec.x, spec.y, spec.scale, selectedColor, UIFBold, spec.text);
-				}
+				m_back.SetColor(m_selected ? deselectedColor : selectedColor);
+				m_back.Render(uiMVPMatrixLoc, printer);
 				break;
 			default:
 				break;
@@ -115,20 +127,22 @@ UISpeedMenu::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 void
 UISpeedMenu::Update(UIMessage updateMessage)
 {
-	if (updateMessage.ReadState() != UIMenuSpeed) {
-		m_hidden = true;
+	UIStateTable::Get()->SetState(updateMessage.ReadState());
+	if (!UIStateTable::Get()->IsVisible(m_stateSlot)) {
+		UIBlinkScheduler::Get()->Stop(&m_flash);
 		return;
 	}
-	m_hidden = false;
 	m_selected = updateMessage.Read(UISpeedSelected);
-	m_flash = updateMessage.Read(UIFlash);
-	if (updateMessage.Read(UISpeedMPM) != NULL) {
-		char* prevSpeed = m_currentSpeed;
-		m_currentSpeed = new char[strlen(updateMessage.Read(UISpeedMPM)) + 1];
-		strcpy(m_currentSpeed, updateMessage.Read(UISpeedMPM));
-		if (strcmp(prevSpeed, "0") != 0) {
-			delete prevSpeed;
-		}
+	if (m_selected) {
+		UIBlinkScheduler::Get()->Start(&m_flash, c_defaultBlinkPeriod, 0);
+	} else {
+		UIBlinkScheduler::Get()->Stop(&m_flash);
+	}
+	UIStringRef speed = updateMessage.ReadRef(UISpeedMPM);
+	if (!speed.IsNull()) {
+		m_speedRef = speed;
+		m_currentSpeed = m_speedRef.Get();
+		m_valueValid = m_value.SetText(m_currentSpeed);
 	}
 	return;
 }
@@ -160,6 +174,13 @@ UISpeedMenu::Show()
 void
 UISpeedMenu::Delete()
 {
+	UIDispatcher::Get()->Unsubscribe(this);
+	UIStateTable::Get()->Unregister(m_stateSlot);
+	m_stateSlot = -1;
+	UIBlinkScheduler::Get()->Stop(&m_flash);
+	m_speedRef.Release();
+	m_currentSpeed = (char*) "0";
+
 	if (m_arrowsInactive != NULL) {
 		m_arrowsInactive->Delete();
 		delete m_arrowsInactive;
@@ -171,4 +192,8 @@ UISpeedMenu::Delete()
 		delete m_arrowsActive;
 		m_arrowsActive = NULL;
 	}
+
+	m_title.Delete();
+	m_back.Delete();
+	m_value.Delete();
 }
@@ -10,6 +10,9 @@
 #include "UIImage.h"
 #include "UIProgressBar.h"
 #include "UICompositeView.h"
+#include "UIStaticText.h"
+#include "UINumericText.h"
+#include "UIBlinkScheduler.h"
 
 #ifndef _UISPEEDMENU_H
 #define _UISPEEDMENU_H
@@ -43,8 +46,8 @@ const int c_numUISMElems = 4;
 /*!****************************************************************************
  @class UISpeedMenu
  Object class. The UISpeedMenu is the collection of UIElements that make up the
- menu section used to modify the running speed. It supports the app layer's
- flashing element functionality, and highlight toggling between the two elements
+ menu section used to modify the running speed. Its value blinks while the
+ menu is selected, and it toggles highlighting between the two elements
 ******************************************************************************/
 class UISpeedMenu : public UIElement
 {
@@ -54,20 +57,34 @@ class UISpeedMenu : public UIElement
 		// Is the speed toggling section currently selected
 		bool m_selected;
 
-		// Is the speed currently flashed off
+		// Is the speed currently flashed off? Set by the UIBlinkScheduler
 		bool m_flash;
 
 		// Is the menu hidden?
 		bool m_hidden;
 
-		// The current speed string displayed to the user
+		// Slot in the UIStateTable, which decides the states the menu is
+		// shown in
+		int m_stateSlot;
+
+		// The current speed string displayed to the user, and the reference
+		// keeping it alive once it has come from a UIMessage
 		char* m_currentSpeed;
+		UIStringRef m_speedRef;
 
 		// The UIImage object used to display the toggling arrows (white)
 		UIImage* m_arrowsActive;
 
 		// The UIImage object used to display the toggling arrows (gray)
 		UIImage* m_arrowsInactive;
+
+		// Pre-laid-out title and back labels
+		UIStaticText m_title;
+		UIStaticText m_back;
+
+		// Numeric renderer for the speed and whether it can display it
+		UINumericText m_value;
+		bool m_valueValid;
 	public:
 		// Publicly exported functions
 		UISpeedMenu();
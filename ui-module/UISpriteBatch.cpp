@@ -0,0 +1,302 @@
+/******************************************************************************
+ @File          UISpriteBatch.cpp
+ @Title         UISpriteBatch
+ @Author        Siddharth Hathi
+ @Description   Implements the UISpriteBatch object class defined in
+				UISpriteBatch.h
+******************************************************************************/
+
+#include "UISpriteBatch.h"
+
+// Attribute indices of the sprite shader, shared with UIImage's
+const GLuint c_spriteVertexAttrib = 0;
+const GLuint c_spriteTexCoordAttrib = 3;
+
+// Sprite shaders
+static const char* c_spriteVertShader =
+	"attribute highp vec2 inVertex;\n"
+	"attribute mediump vec2 inTexCoord;\n"
+	"uniform highp mat4 myPMVMatrix;\n"
+	"varying mediump vec2 TexCoord;\n"
+	"void main()\n"
+	"{\n"
+	"	gl_Position = myPMVMatrix * vec4(inVertex, 0.0, 1.0);\n"
+	"	TexCoord = inTexCoord;\n"
+	"}\n";
+
+static const char* c_spriteFragShader =
+	"uniform sampler2D sTexture;\n"
+	"varying mediump vec2 TexCoord;\n"
+	"void main()\n"
+	"{\n"
+	"	gl_FragColor = texture2D(sTexture, TexCoord);\n"
+	"}\n";
+
+/*!****************************************************************************
+ @Function		capturing
+ @Return		UISpriteBatch*&		The batch that is capturing
+ @Description	HELPER - holds the batch between its Begin and Draw (NULL
+				when no batch is capturing)
+******************************************************************************/
+static UISpriteBatch*&
+capturing()
+{
+	static UISpriteBatch* batch = NULL;
+	return batch;
+}
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes an empty batch
+******************************************************************************/
+UISpriteBatch::UISpriteBatch()
+{
+	m_vertices = NULL;
+	m_queue = NULL;
+	m_indices = NULL;
+	m_numQueued = 0;
+	m_expanded = false;
+	m_uiVbo = 0;
+	m_uiIndexVbo = 0;
+	m_mvpLoc = -1;
+	m_numDraws = 0;
+}
+
+/*!****************************************************************************
+ @Function		Init
+ @Output		pErrorStr	Error message on failure
+ @Description	Builds the sprite shader and the batch's buffers
+******************************************************************************/
+bool
+UISpriteBatch::Init(CPVRTString* const pErrorStr)
+{
+	if (m_shader.GetProgram() == 0) {
+		const UIShaderAttrib attribs[] = {
+			{ "inVertex", c_spriteVertexAttrib },
+			{ "inTexCoord", c_spriteTexCoordAttrib }
+		};
+		if (!m_shader.Build(c_spriteVertShader, c_spriteFragShader, attribs, 2, pErrorStr)) {
+			return false;
+		}
+		m_mvpLoc = m_shader.GetUniform("myPMVMatrix");
+	}
+
+	if (m_uiVbo == 0) {
+		glGenBuffers(1, &m_uiVbo);
+	}
+	if (m_uiIndexVbo == 0) {
+		glGenBuffers(1, &m_uiIndexVbo);
+	}
+	if (m_vertices == NULL) {
+		m_vertices = new UISpriteVertex[4 * c_maxSprites];
+		m_queue = new int[c_maxSprites];
+		m_indices = new unsigned short[6 * c_maxSprites];
+	}
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		Begin
+ @Description	Starts capturing the frame's images. Call before the tree is
+				rendered.
+******************************************************************************/
+void
+UISpriteBatch::Begin()
+{
+	m_numQueued = 0;
+	m_numDraws = 0;
+	m_expanded = false;
+	capturing() = m_vertices != NULL ? this : NULL;
+}
+
+/*!****************************************************************************
+ @Function		Queue
+ @Input			sprite		A visible sprite
+ @Return		bool		Was the sprite queued?
+ @Description	Queues a sprite to be drawn by the next Flush. Called by
+				UIImage::Render while the batch is capturing.
+******************************************************************************/
+bool
+UISpriteBatch::Queue(int sprite)
+{
+	if (m_numQueued == c_maxSprites) {
+		Flush();
+	}
+	if (m_queue == NULL || sprite < 0 || sprite >= c_maxSprites) {
+		return false;
+	}
+	m_queue[m_numQueued ++] = sprite;
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		Flush
+ @Description	Draws the queued sprites in the order they were queued and
+				empties the queue. The batch keeps capturing.
+******************************************************************************/
+void
+UISpriteBatch::Flush()
+{
+	if (m_numQueued == 0) {
+		return;
+	}
+	UISpriteStore* store = UISpriteStore::Get();
+	m_shader.Use();
+	glUniformMatrix4fv(m_mvpLoc, 1, GL_FALSE, store->GetProjection()->f);
+	glActiveTexture(GL_TEXTURE0);
+	glBindBuffer(GL_ARRAY_BUFFER, m_uiVbo);
+	if (!m_expanded) {
+		expand();
+	}
+
+	// Quads are laid out top left, top right, bottom left, bottom right
+	for ( int i = 0; i < m_numQueued; i ++ ) {
+		unsigned short base = (unsigned short)(4 * m_queue[i]);
+		unsigned short* indices = m_indices + 6 * i;
+		indices[0] = base;
+		indices[1] = base + 2;
+		indices[2] = base + 3;
+		indices[3] = base;
+		indices[4] = base + 3;
+		indices[5] = base + 1;
+	}
+	// Orphan the previous flush's storage rather than waiting on it
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_uiIndexVbo);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, 6 * c_maxSprites * sizeof(unsigned short), NULL, GL_STREAM_DRAW);
+	glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, 6 * m_numQueued * sizeof(unsigned short), m_indices);
+
+	GLsizei stride = sizeof(UISpriteVertex);
+	glEnableVertexAttribArray(c_spriteVertexAttrib);
+	glEnableVertexAttribArray(c_spriteTexCoordAttrib);
+	glVertexAttribPointer(c_spriteVertexAttrib, 2, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offsetof(UISpriteVertex, x));
+	glVertexAttribPointer(c_spriteTexCoordAttrib, 2, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offsetof(UISpriteVertex, u));
+
+	// A run ends where the queued sprites change texture
+	const GLuint* textures = store->GetTextures();
+	GLuint runTexture = textures[m_queue[0]];
+	int runStart = 0;
+	for ( int i = 1; i < m_numQueued; i ++ ) {
+		if (textures[m_queue[i]] == runTexture) {
+			continue;
+		}
+		drawRun(runTexture, runStart, i);
+		runTexture = textures[m_queue[i]];
+		runStart = i;
+	}
+	drawRun(runTexture, runStart, m_numQueued);
+	m_numQueued = 0;
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	glDisableVertexAttribArray(c_spriteVertexAttrib);
+	glDisableVertexAttribArray(c_spriteTexCoordAttrib);
+	m_shader.Restore();
+}
+
+/*!****************************************************************************
+ @Function		Draw
+ @Description	Draws the images queued since the last flush and stops
+				capturing. Call after the tree is rendered and before
+				UIPrinter::Flush, so batched text is drawn over the images.
+******************************************************************************/
+void
+UISpriteBatch::Draw()
+{
+	Flush();
+	if (capturing() == this) {
+		capturing() = NULL;
+	}
+}
+
+/*!****************************************************************************
+ @Function		GetDrawCount
+ @Return		int		Number of draw calls
+ @Description	Returns the number of draw calls issued since the last Begin
+******************************************************************************/
+int
+UISpriteBatch::GetDrawCount()
+{
+	return m_numDraws;
+}
+
+/*!****************************************************************************
+ @Function		Delete
+ @Description	Frees the batch's GL objects
+******************************************************************************/
+void
+UISpriteBatch::Delete()
+{
+	if (capturing() == this) {
+		capturing() = NULL;
+	}
+	if (m_uiVbo != 0) {
+		glDeleteBuffers(1, &m_uiVbo);
+		m_uiVbo = 0;
+	}
+	if (m_uiIndexVbo != 0) {
+		glDeleteBuffers(1, &m_uiIndexVbo);
+		m_uiIndexVbo = 0;
+	}
+	m_shader.Delete();
+	if (m_vertices != NULL) {
+		delete[] m_vertices;
+		delete[] m_queue;
+		delete[] m_indices;
+		m_vertices = NULL;
+		m_queue = NULL;
+		m_indices = NULL;
+	}
+	m_numQueued = 0;
+}
+
+/*!****************************************************************************
+ @Function		GetCapturing
+ @Return		UISpriteBatch*		The capturing batch (NULL if none)
+ @Description	Returns the batch images should queue their sprites in
+******************************************************************************/
+UISpriteBatch*
+UISpriteBatch::GetCapturing()
+{
+	return capturing();
+}
+
+/*!****************************************************************************
+ @Function		expand
+ @Description	HELPER - expands the whole store into quads and uploads them
+				to the bound vertex buffer. Done once a frame, on the first
+				flush, since the sprites don't move while the tree renders.
+******************************************************************************/
+void
+UISpriteBatch::expand()
+{
+	UISpriteStore* store = UISpriteStore::Get();
+	int count = store->GetHighWater();
+	UISpriteArrays arrays;
+	store->GetArrays(&arrays);
+	UIExpandSprites(arrays, count, m_vertices);
+
+	// Orphan the previous frame's storage rather than waiting on it
+	glBufferData(GL_ARRAY_BUFFER, 4 * c_maxSprites * sizeof(UISpriteVertex), NULL, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, 4 * count * sizeof(UISpriteVertex), m_vertices);
+	m_expanded = true;
+}
+
+/*!****************************************************************************
+ @Function		drawRun
+ @Input			texture		Texture shared by the run's sprites
+ @Input			first		Queue index of the run's first sprite
+ @Input			end			One past the queue index of the run's last sprite
+ @Description	HELPER - draws a run of queued sprites. Sprites without a
+				texture (not loaded yet) are skipped.
+******************************************************************************/
+void
+UISpriteBatch::drawRun(GLuint texture, int first, int end)
+{
+	if (texture == 0 || end <= first) {
+		return;
+	}
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glDrawElements(GL_TRIANGLES, 6 * (end - first), GL_UNSIGNED_SHORT,
+		(GLvoid*)(6 * first * sizeof(unsigned short)));
+	m_numDraws ++;
+}
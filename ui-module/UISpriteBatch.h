@@ -0,0 +1,78 @@
+/******************************************************************************
+ @File          UISpriteBatch.h
+ @Title         UISpriteBatch Header File
+ @Author        Siddharth Hathi
+ @Description   Header file for the UISpriteBatch class.
+******************************************************************************/
+
+#include "OGLES2Tools.h"
+#include "UISpriteStore.h"
+#include "UISpriteKernels.h"
+#include "UIShader.h"
+
+#include <stddef.h>
+
+#ifndef _UISPRITEBATCH_H
+#define _UISPRITEBATCH_H
+
+/*!****************************************************************************
+ @class UISpriteBatch
+ Object class. A UISpriteBatch draws the frame's images without going through
+ each UIImage's Draw. Between Begin and Draw the batch is capturing: a
+ UIImage's Render queues its sprite instead of drawing it, so only the images
+ the tree actually renders are drawn (hidden views and the element arrays of
+ other states never reach their images), in the order they were rendered.
+
+ The store is expanded into quads with UIExpandSprites and uploaded once per
+ frame, and the queue is drawn with one draw call per run of queued sprites
+ sharing a texture. Anything that draws straight to GL while the batch is
+ capturing (UIPrinter's text, UIProgressBar's fill shader) calls Flush first,
+ so the images queued before it stay underneath it. The quads are in pixel
+ coordinates and drawn through the root transform shared with UIImage, which
+ handles display rotation. Only one batch captures at a time.
+******************************************************************************/
+class UISpriteBatch
+{
+	protected:
+		// Instance variables
+
+		// Expanded vertices (4 * c_maxSprites, allocated in Init)
+		UISpriteVertex* m_vertices;
+
+		// Sprites queued since the last flush, in render order, and the
+		// indices they are drawn with (allocated in Init)
+		int* m_queue;
+		unsigned short* m_indices;
+		int m_numQueued;
+
+		// Has the store been expanded and uploaded this frame?
+		bool m_expanded;
+
+		// Streaming vertex and index buffers
+		GLuint m_uiVbo, m_uiIndexVbo;
+
+		// Sprite shader and its MVP uniform
+		UIShader m_shader;
+		GLint m_mvpLoc;
+
+		// Number of draw calls issued since Begin
+		int m_numDraws;
+
+		// Local functions
+		void expand();
+		void drawRun(GLuint texture, int first, int end);
+
+	public:
+		// Exported functions
+		UISpriteBatch();
+		bool Init(CPVRTString* const pErrorStr);
+		void Begin();
+		bool Queue(int sprite);
+		void Flush();
+		void Draw();
+		int GetDrawCount();
+		void Delete();
+		static UISpriteBatch* GetCapturing();
+};
+
+#endif
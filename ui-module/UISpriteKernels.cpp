@@ -0,0 +1,215 @@
+/******************************************************************************
+ @File          UISpriteKernels.cpp
+ @Title         UISpriteKernels
+ @Author        Siddharth Hathi
+ @Description   Implements the sprite expansion kernels declared in
+				UISpriteKernels.h
+******************************************************************************/
+
+#include "UISpriteKernels.h"
+
+#if !defined(UIKIT_SCALAR_SPRITES) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define UIKIT_NEON_SPRITES
+#include <arm_neon.h>
+#elif !defined(UIKIT_SCALAR_SPRITES) && (defined(__SSE2__) || defined(_M_X64))
+#define UIKIT_SSE_SPRITES
+#include <emmintrin.h>
+#endif
+
+/*
+ * Every kernel works out a sprite's center (x, y) and half extents (hx, hy),
+ * which are zero for hidden sprites. The corners are then
+ *		top left (x - hx, y + hy)		top right (x + hx, y + hy)
+ *		bottom left (x - hx, y - hy)	bottom right (x + hx, y - hy)
+ */
+
+/*!****************************************************************************
+ @Function		UIExpandSpritesScalar
+ @Input			sprites			The store's arrays
+ @Input			first			Index of the first sprite to expand
+ @Input			count			Number of sprites to expand
+ @Output		out				Vertices of every sprite; sprite i's are written
+								to out[4*i] to out[4*i + 3]
+ @Description	Expands sprites into quads one at a time
+******************************************************************************/
+void
+UIExpandSpritesScalar(const UISpriteArrays& sprites, int first, int count, UISpriteVertex* out)
+{
+	for ( int i = first; i < first + count; i ++ ) {
+		float visible = sprites.visible[i] ? 0.5f : 0.0f;
+		float hx = sprites.width[i] * sprites.scaleX[i] * visible;
+		float hy = sprites.height[i] * sprites.scaleY[i] * visible;
+		float x = sprites.x[i];
+		float y = sprites.y[i];
+
+		UISpriteVertex* quad = &out[4 * i];
+		quad[0].x = x - hx;	quad[0].y = y + hy;
+		quad[1].x = x + hx;	quad[1].y = y + hy;
+		quad[2].x = x - hx;	quad[2].y = y - hy;
+		quad[3].x = x + hx;	quad[3].y = y - hy;
+
+		quad[0].u = sprites.u0[i];	quad[0].v = sprites.v1[i];
+		quad[1].u = sprites.u1[i];	quad[1].v = sprites.v1[i];
+		quad[2].u = sprites.u0[i];	quad[2].v = sprites.v0[i];
+		quad[3].u = sprites.u1[i];	quad[3].v = sprites.v0[i];
+	}
+}
+
+#if defined(UIKIT_NEON_SPRITES)
+
+/*!****************************************************************************
+ @Function		storeCorner
+ @Input			x, y, u, v		One corner of 4 consecutive sprites
+ @Output		out				Vertices of the first of the 4 sprites
+ @Input			corner			Which corner (0 to 3)
+ @Description	HELPER - transposes one corner of 4 sprites into 4 vertices
+******************************************************************************/
+static inline void
+storeCorner(float32x4_t x, float32x4_t y, float32x4_t u, float32x4_t v, UISpriteVertex* out, int corner)
+{
+	float32x4x2_t xy = vtrnq_f32(x, y);
+	float32x4x2_t uv = vtrnq_f32(u, v);
+	vst1q_f32(&out[corner].x, vcombine_f32(vget_low_f32(xy.val[0]), vget_low_f32(uv.val[0])));
+	vst1q_f32(&out[4 + corner].x, vcombine_f32(vget_low_f32(xy.val[1]), vget_low_f32(uv.val[1])));
+	vst1q_f32(&out[8 + corner].x, vcombine_f32(vget_high_f32(xy.val[0]), vget_high_f32(uv.val[0])));
+	vst1q_f32(&out[12 + corner].x, vcombine_f32(vget_high_f32(xy.val[1]), vget_high_f32(uv.val[1])));
+}
+
+/*!****************************************************************************
+ @Function		UIExpandSprites
+ @Description	NEON kernel, see UISpriteKernels.h
+******************************************************************************/
+void
+UIExpandSprites(const UISpriteArrays& sprites, int count, UISpriteVertex* out)
+{
+	int vectorCount = count - count % c_spriteKernelWidth;
+
+	for ( int i = 0; i < vectorCount; i += c_spriteKernelWidth ) {
+		float visibleHalf[4];
+		for ( int j = 0; j < 4; j ++ ) {
+			visibleHalf[j] = sprites.visible[i + j] ? 0.5f : 0.0f;
+		}
+		float32x4_t visible = vld1q_f32(visibleHalf);
+		float32x4_t hx = vmulq_f32(vmulq_f32(vld1q_f32(sprites.width + i), vld1q_f32(sprites.scaleX + i)), visible);
+		float32x4_t hy = vmulq_f32(vmulq_f32(vld1q_f32(sprites.height + i), vld1q_f32(sprites.scaleY + i)), visible);
+		float32x4_t x = vld1q_f32(sprites.x + i);
+		float32x4_t y = vld1q_f32(sprites.y + i);
+		float32x4_t left = vsubq_f32(x, hx);
+		float32x4_t right = vaddq_f32(x, hx);
+		float32x4_t top = vaddq_f32(y, hy);
+		float32x4_t bottom = vsubq_f32(y, hy);
+
+		float32x4_t u0 = vld1q_f32(sprites.u0 + i);
+		float32x4_t v0 = vld1q_f32(sprites.v0 + i);
+		float32x4_t u1 = vld1q_f32(sprites.u1 + i);
+		float32x4_t v1 = vld1q_f32(sprites.v1 + i);
+
+		UISpriteVertex* quads = &out[4 * i];
+		storeCorner(left, top, u0, v1, quads, 0);
+		storeCorner(right, top, u1, v1, quads, 1);
+		storeCorner(left, bottom, u0, v0, quads, 2);
+		storeCorner(right, bottom, u1, v0, quads, 3);
+	}
+	UIExpandSpritesScalar(sprites, vectorCount, count - vectorCount, out);
+}
+
+/*!****************************************************************************
+ @Function		UISpriteKernelName
+ @Return		const char*		The kernel's name
+ @Description	Returns the name of the kernel UIExpandSprites was built with
+******************************************************************************/
+const char*
+UISpriteKernelName()
+{
+	return "NEON";
+}
+
+#elif defined(UIKIT_SSE_SPRITES)
+
+/*!****************************************************************************
+ @Function		storeCorner
+ @Input			x, y, u, v		One corner of 4 consecutive sprites
+ @Output		out				Vertices of the first of the 4 sprites
+ @Input			corner			Which corner (0 to 3)
+ @Description	HELPER - transposes one corner of 4 sprites into 4 vertices
+******************************************************************************/
+static inline void
+storeCorner(__m128 x, __m128 y, __m128 u, __m128 v, UISpriteVertex* out, int corner)
+{
+	_MM_TRANSPOSE4_PS(x, y, u, v);
+	_mm_storeu_ps(&out[corner].x, x);
+	_mm_storeu_ps(&out[4 + corner].x, y);
+	_mm_storeu_ps(&out[8 + corner].x, u);
+	_mm_storeu_ps(&out[12 + corner].x, v);
+}
+
+/*!****************************************************************************
+ @Function		UIExpandSprites
+ @Description	SSE2 kernel, see UISpriteKernels.h
+******************************************************************************/
+void
+UIExpandSprites(const UISpriteArrays& sprites, int count, UISpriteVertex* out)
+{
+	int vectorCount = count - count % c_spriteKernelWidth;
+
+	for ( int i = 0; i < vectorCount; i += c_spriteKernelWidth ) {
+		__m128 visible = _mm_set_ps(sprites.visible[i + 3] ? 0.5f : 0.0f, sprites.visible[i + 2] ? 0.5f : 0.0f,
+			sprites.visible[i + 1] ? 0.5f : 0.0f, sprites.visible[i] ? 0.5f : 0.0f);
+		__m128 hx = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(sprites.width + i), _mm_loadu_ps(sprites.scaleX + i)), visible);
+		__m128 hy = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(sprites.height + i), _mm_loadu_ps(sprites.scaleY + i)), visible);
+		__m128 x = _mm_loadu_ps(sprites.x + i);
+		__m128 y = _mm_loadu_ps(sprites.y + i);
+		__m128 left = _mm_sub_ps(x, hx);
+		__m128 right = _mm_add_ps(x, hx);
+		__m128 top = _mm_add_ps(y, hy);
+		__m128 bottom = _mm_sub_ps(y, hy);
+
+		__m128 u0 = _mm_loadu_ps(sprites.u0 + i);
+		__m128 v0 = _mm_loadu_ps(sprites.v0 + i);
+		__m128 u1 = _mm_loadu_ps(sprites.u1 + i);
+		__m128 v1 = _mm_loadu_ps(sprites.v1 + i);
+
+		UISpriteVertex* quads = &out[4 * i];
+		storeCorner(left, top, u0, v1, quads, 0);
+		storeCorner(right, top, u1, v1, quads, 1);
+		storeCorner(left, bottom, u0, v0, quads, 2);
+		storeCorner(right, bottom, u1, v0, quads, 3);
+	}
+	UIExpandSpritesScalar(sprites, vectorCount, count - vectorCount, out);
+}
+
+/*!****************************************************************************
+ @Function		UISpriteKernelName
+ @Return		const char*		The kernel's name
+ @Description	Returns the name of the kernel UIExpandSprites was built with
+******************************************************************************/
+const char*
+UISpriteKernelName()
+{
+	return "SSE2";
+}
+
+#else
+
+/*!****************************************************************************
+ @Function		UIExpandSprites
+ @Description	Scalar build, see UISpriteKernels.h
+******************************************************************************/
+void
+UIExpandSprites(const UISpriteArrays& sprites, int count, UISpriteVertex* out)
+{
+	UIExpandSpritesScalar(sprites, 0, count, out);
+}
+
+/*!****************************************************************************
+ @Function		UISpriteKernelName
+ @Return		const char*		The kernel's name
+ @Description	Returns the name of the kernel UIExpandSprites was built with
+******************************************************************************/
+const char*
+UISpriteKernelName()
+{
+	return "scalar";
+}
+
+#endif
@@ -0,0 +1,70 @@
+/******************************************************************************
+ @File          UISpriteKernels.h
+ @Title         UISpriteKernels Header File
+ @Author        Siddharth Hathi
+ @Description   Kernels that expand UISpriteStore data into batched sprite
+				vertices.
+******************************************************************************/
+
+#include <stdint.h>
+
+#ifndef _UISPRITEKERNELS_H
+#define _UISPRITEKERNELS_H
+
+/*
+ * The kernels turn the store's per sprite arrays into four corners per sprite,
+ * in pixel coordinates, ready to be uploaded by the UISpriteBatch. Display
+ * rotation is left to the root transform the batch draws with. The vector
+ * kernel is picked at build time: NEON on ARM, SSE2 on x86 and a scalar loop
+ * elsewhere (or when UIKIT_SCALAR_SPRITES is defined). Each iteration of the
+ * vector kernels expands c_spriteKernelWidth sprites.
+ *
+ * The kernels use no GL, so they can be built and benchmarked on their own
+ * (see tools/SpriteKernelBench.cpp).
+ */
+
+// Number of sprites each iteration of the vector kernels expands
+const int c_spriteKernelWidth = 4;
+
+// Vertex format of batched sprites. A sprite's corners are written top left,
+// top right, bottom left, bottom right
+struct UISpriteVertex {
+	float x, y;
+	float u, v;
+};
+
+// The UISpriteStore arrays read by the kernels
+struct UISpriteArrays {
+	const float *x, *y, *width, *height, *scaleX, *scaleY;
+	const float *u0, *v0, *u1, *v1;
+	const uint8_t* visible;
+};
+
+/*!****************************************************************************
+ @Function		UIExpandSprites
+ @Input			sprites			The store's arrays
+ @Input			count			Number of sprites to expand (from index 0)
+ @Output		out				4 * count vertices
+ @Description	Expands sprites into quads with the build's vector kernel.
+				Hidden sprites are collapsed onto their center so that they
+				draw nothing without breaking up the batch.
+******************************************************************************/
+void UIExpandSprites(const UISpriteArrays& sprites, int count, UISpriteVertex* out);
+
+/*!****************************************************************************
+ @Function		UIExpandSpritesScalar
+ @Description	Scalar version of UIExpandSprites, used for the sprites left
+				over after the vector loop and as the reference implementation.
+				Takes the same arguments, plus the index of the first sprite.
+******************************************************************************/
+void UIExpandSpritesScalar(const UISpriteArrays& sprites, int first, int count,
+	UISpriteVertex* out);
+
+/*!****************************************************************************
+ @Function		UISpriteKernelName
+ @Return		const char*		"NEON", "SSE2" or "scalar"
+ @Description	Returns the name of the kernel UIExpandSprites was built with
+******************************************************************************/
+const char* UISpriteKernelName();
+
+#endif
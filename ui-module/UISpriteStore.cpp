@@ -0,0 +1,428 @@
+/******************************************************************************
+ @File          UISpriteStore.cpp
+ @Title         UISpriteStore
+ @Author        Siddharth Hathi
+ @Description   Implements the UISpriteStore object class defined in
+				UISpriteStore.h
+******************************************************************************/
+
+#include "UISpriteStore.h"
+#include "UIImage.h"
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes an empty store. Only used by Get.
+******************************************************************************/
+UISpriteStore::UISpriteStore()
+{
+	memset(m_live, 0, sizeof(m_live));
+	memset(m_visible, 0, sizeof(m_visible));
+	memset(m_generation, 0, sizeof(m_generation));
+	memset(m_texture, 0, sizeof(m_texture));
+	memset(m_vbo, 0, sizeof(m_vbo));
+	m_numFree = 0;
+	m_highWater = 0;
+	m_quadVbo = 0;
+	m_quadIndexVbo = 0;
+}
+
+/*!****************************************************************************
+ @Function		Get
+ @Return		UISpriteStore*		The sprite store
+ @Description	Returns the store shared by every UIImage
+******************************************************************************/
+UISpriteStore*
+UISpriteStore::Get()
+{
+	static UISpriteStore store;
+	return &store;
+}
+
+/*!****************************************************************************
+ @Function		Allocate
+ @Return		int			Index of the new sprite (c_noSprite if full)
+ @Description	Allocates a visible sprite showing its whole texture, reusing
+				released slots first so the arrays stay dense
+******************************************************************************/
+int
+UISpriteStore::Allocate()
+{
+	int sprite;
+	if (m_numFree > 0) {
+		sprite = m_freeList[-- m_numFree];
+	} else if (m_highWater < c_maxSprites) {
+		sprite = m_highWater ++;
+	} else {
+		fprintf(stderr, "UISpriteStore is full (%d sprites)\n", c_maxSprites);
+		return c_noSprite;
+	}
+	m_live[sprite] = 1;
+	m_visible[sprite] = 1;
+	m_x[sprite] = m_y[sprite] = 0;
+	m_width[sprite] = m_height[sprite] = 0;
+	m_scaleX[sprite] = m_scaleY[sprite] = 1;
+	m_u0[sprite] = m_v0[sprite] = 0;
+	m_u1[sprite] = m_v1[sprite] = 1;
+	m_texture[sprite] = 0;
+	m_vbo[sprite] = 0;
+	return sprite;
+}
+
+/*!****************************************************************************
+ @Function		Release
+ @Input			sprite		Index of the sprite
+ @Description	Frees a sprite's texture and quad and returns its slot to the
+				free list
+******************************************************************************/
+void
+UISpriteStore::Release(int sprite)
+{
+	if (sprite < 0 || sprite >= m_highWater || !m_live[sprite]) {
+		return;
+	}
+	if (m_texture[sprite] != 0) {
+		glDeleteTextures(1, &m_texture[sprite]);
+		m_texture[sprite] = 0;
+	}
+	if (m_vbo[sprite] != 0) {
+		glDeleteBuffers(1, &m_vbo[sprite]);
+		m_vbo[sprite] = 0;
+	}
+	m_live[sprite] = 0;
+	m_visible[sprite] = 0;
+	m_generation[sprite] ++;
+	m_freeList[m_numFree ++] = sprite;
+}
+
+/*!****************************************************************************
+ @Function		IsValid
+ @Input			sprite			Index of the sprite
+ @Input			generation		Generation the handle was created with
+ @Return		bool			Does the handle still refer to a live sprite?
+ @Description	Checks a UIImage's handle
+******************************************************************************/
+bool
+UISpriteStore::IsValid(int sprite, PVRTuint16 generation)
+{
+	return sprite >= 0 && sprite < m_highWater && m_live[sprite] && m_generation[sprite] == generation;
+}
+
+/*!****************************************************************************
+ @Function		GetGeneration
+ @Input			sprite			Index of the sprite
+ @Return		PVRTuint16		The slot's current generation
+ @Description	Returns the generation a new handle to the sprite should store
+******************************************************************************/
+PVRTuint16
+UISpriteStore::GetGeneration(int sprite)
+{
+	return m_generation[sprite];
+}
+
+/*!****************************************************************************
+ @Function		GetHighWater
+ @Return		int			One past the highest slot ever used
+ @Description	Returns the number of entries passes over the arrays need to
+				cover. Released slots below it are not visible.
+******************************************************************************/
+int
+UISpriteStore::GetHighWater()
+{
+	return m_highWater;
+}
+
+/*!****************************************************************************
+ @Function		SetRect
+ @Input			sprite			Index of the sprite
+ @Input			x, y			Pixel coordinates of the sprite's center
+ @Input			width, height	Dimensions of the sprite
+ @Description	Sets a sprite's position and size
+******************************************************************************/
+void
+UISpriteStore::SetRect(int sprite, float x, float y, float width, float height)
+{
+	m_x[sprite] = x;
+	m_y[sprite] = y;
+	m_width[sprite] = width;
+	m_height[sprite] = height;
+}
+
+/*!****************************************************************************
+ @Function		SetPosition
+ @Input			sprite			Index of the sprite
+ @Input			x, y			Pixel coordinates of the sprite's center
+ @Description	Sets a sprite's position
+******************************************************************************/
+void
+UISpriteStore::SetPosition(int sprite, float x, float y)
+{
+	m_x[sprite] = x;
+	m_y[sprite] = y;
+}
+
+/*!****************************************************************************
+ @Function		SetSize
+ @Input			sprite			Index of the sprite
+ @Input			width, height	Dimensions of the sprite
+ @Description	Sets a sprite's size
+******************************************************************************/
+void
+UISpriteStore::SetSize(int sprite, float width, float height)
+{
+	m_width[sprite] = width;
+	m_height[sprite] = height;
+}
+
+/*!****************************************************************************
+ @Function		SetScale
+ @Input			sprite			Index of the sprite
+ @Input			scaleX, scaleY	Scale applied on top of the sprite's size
+ @Description	Sets a sprite's scale
+******************************************************************************/
+void
+UISpriteStore::SetScale(int sprite, float scaleX, float scaleY)
+{
+	m_scaleX[sprite] = scaleX;
+	m_scaleY[sprite] = scaleY;
+}
+
+/*!****************************************************************************
+ @Function		SetTexCoords
+ @Input			sprite			Index of the sprite
+ @Input			u0, v0			Texture coordinates of the bottom left
+ @Input			u1, v1			Texture coordinates of the top right
+ @Description	Sets the part of its texture a sprite shows. Takes effect when
+				the sprite's quad is built.
+******************************************************************************/
+void
+UISpriteStore::SetTexCoords(int sprite, float u0, float v0, float u1, float v1)
+{
+	m_u0[sprite] = u0;
+	m_v0[sprite] = v0;
+	m_u1[sprite] = u1;
+	m_v1[sprite] = v1;
+}
+
+/*!****************************************************************************
+ @Function		SetTexture
+ @Input			sprite			Index of the sprite
+ @Input			texture			GL texture the sprite now owns
+ @Description	Sets a sprite's texture, freeing the one it had
+******************************************************************************/
+void
+UISpriteStore::SetTexture(int sprite, GLuint texture)
+{
+	if (m_texture[sprite] != 0 && m_texture[sprite] != texture) {
+		glDeleteTextures(1, &m_texture[sprite]);
+	}
+	m_texture[sprite] = texture;
+}
+
+/*!****************************************************************************
+ @Function		SetVisible
+ @Input			sprite			Index of the sprite
+ @Input			visible			Should the sprite be drawn?
+ @Description	Shows or hides a sprite
+******************************************************************************/
+void
+UISpriteStore::SetVisible(int sprite, bool visible)
+{
+	m_visible[sprite] = visible ? 1 : 0;
+}
+
+/*!****************************************************************************
+ @Function		GetX, GetY, GetWidth, GetHeight, GetScaleX, GetScaleY,
+				GetTextures, GetVisible
+ @Return		The store's dense array of that property
+ @Description	Give passes over every sprite direct access to the arrays
+******************************************************************************/
+float*
+UISpriteStore::GetX()
+{
+	return m_x;
+}
+
+float*
+UISpriteStore::GetY()
+{
+	return m_y;
+}
+
+float*
+UISpriteStore::GetWidth()
+{
+	return m_width;
+}
+
+float*
+UISpriteStore::GetHeight()
+{
+	return m_height;
+}
+
+float*
+UISpriteStore::GetScaleX()
+{
+	return m_scaleX;
+}
+
+float*
+UISpriteStore::GetScaleY()
+{
+	return m_scaleY;
+}
+
+GLuint*
+UISpriteStore::GetTextures()
+{
+	return m_texture;
+}
+
+PVRTuint8*
+UISpriteStore::GetVisible()
+{
+	return m_visible;
+}
+
+/*!****************************************************************************
+ @Function		GetArrays
+ @Output		arrays		The arrays read by the sprite kernels
+ @Description	Points a UISpriteArrays at the store's arrays, so that the
+				store's sprites can be expanded with UIExpandSprites
+******************************************************************************/
+void
+UISpriteStore::GetArrays(UISpriteArrays* arrays)
+{
+	arrays->x = m_x;
+	arrays->y = m_y;
+	arrays->width = m_width;
+	arrays->height = m_height;
+	arrays->scaleX = m_scaleX;
+	arrays->scaleY = m_scaleY;
+	arrays->u0 = m_u0;
+	arrays->v0 = m_v0;
+	arrays->u1 = m_u1;
+	arrays->v1 = m_v1;
+	arrays->visible = m_visible;
+}
+
+/*!****************************************************************************
+ @Function		BuildQuad
+ @Input			sprite			Index of the sprite
+ @Description	Makes sure the geometry a sprite draws with exists: the shared
+				unit quad, or a quad of its own if it shows part of its texture
+******************************************************************************/
+void
+UISpriteStore::BuildQuad(int sprite)
+{
+	if (m_quadVbo == 0) {
+		m_quadVbo = buildQuad(0, 0, 1, 1);
+
+		// Two counter clockwise triangles (the UILayer culls back faces)
+		unsigned short indices[6] = { 1, 0, 2, 1, 2, 3 };
+		glGenBuffers(1, &m_quadIndexVbo);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_quadIndexVbo);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	}
+	bool fullTexture = m_u0[sprite] == 0 && m_v0[sprite] == 0 && m_u1[sprite] == 1 && m_v1[sprite] == 1;
+	if (!fullTexture && m_vbo[sprite] == 0) {
+		m_vbo[sprite] = buildQuad(m_u0[sprite], m_v0[sprite], m_u1[sprite], m_v1[sprite]);
+	}
+}
+
+/*!****************************************************************************
+ @Function		GetQuadVbo
+ @Input			sprite			Index of the sprite
+ @Return		GLuint			Vertex buffer the sprite draws with
+ @Description	Returns the sprite's own quad, or the shared unit quad
+******************************************************************************/
+GLuint
+UISpriteStore::GetQuadVbo(int sprite)
+{
+	return m_vbo[sprite] != 0 ? m_vbo[sprite] : m_quadVbo;
+}
+
+/*!****************************************************************************
+ @Function		GetQuadIndexVbo
+ @Return		GLuint			The quad index buffer
+ @Description	Returns the index buffer shared by every quad (6 indices)
+******************************************************************************/
+GLuint
+UISpriteStore::GetQuadIndexVbo()
+{
+	return m_quadIndexVbo;
+}
+
+/*!****************************************************************************
+ @Function		GetProjection
+ @Return		PVRTMat4*		The shared projection matrix
+ @Description	Returns the projection matrix shared by every image
+******************************************************************************/
+PVRTMat4*
+UISpriteStore::GetProjection()
+{
+	return &m_mProjection;
+}
+
+/*!****************************************************************************
+ @Function		GetView
+ @Return		PVRTMat4*		The shared view matrix
+ @Description	Returns the view matrix shared by every image
+******************************************************************************/
+PVRTMat4*
+UISpriteStore::GetView()
+{
+	return &m_mView;
+}
+
+/*!****************************************************************************
+ @Function		Delete
+ @Description	Frees the shared geometry and every sprite's GL objects. Should
+				be called when the GL context is torn down.
+******************************************************************************/
+void
+UISpriteStore::Delete()
+{
+	for ( int i = 0; i < m_highWater; i ++ ) {
+		Release(i);
+	}
+	if (m_quadVbo != 0) {
+		glDeleteBuffers(1, &m_quadVbo);
+		m_quadVbo = 0;
+	}
+	if (m_quadIndexVbo != 0) {
+		glDeleteBuffers(1, &m_quadIndexVbo);
+		m_quadIndexVbo = 0;
+	}
+}
+
+/*!****************************************************************************
+ @Function		buildQuad
+ @Input			u0, v0, u1, v1	Texture coordinates of the quad's corners
+ @Return		GLuint			The new vertex buffer
+ @Description	HELPER - builds a unit quad (centered on the origin) vertex
+				buffer in UIImage's vertex format. The vertices are ordered top
+				left, top right, bottom left, bottom right.
+******************************************************************************/
+GLuint
+UISpriteStore::buildQuad(float u0, float v0, float u1, float v1)
+{
+	SVertex vertices[4];
+	for ( int i = 0; i < 4; i ++ ) {
+		float x = (i % 2 == 0) ? -0.5f : 0.5f;
+		float y = (i < 2) ? 0.5f : -0.5f;
+		vertices[i].p = PVRTVec3(x, y, 0);
+		vertices[i].n = PVRTVec3(0.0f, 1.0f, 0.0f);
+		vertices[i].c = PVRTVec4(1.0f, 1.0f, 1.0f, 1.0f);
+		vertices[i].t.x = u0 + (x + 0.5f) * (u1 - u0);
+		vertices[i].t.y = v0 + (y + 0.5f) * (v1 - v0);
+	}
+
+	GLuint vbo;
+	glGenBuffers(1, &vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	return vbo;
+}
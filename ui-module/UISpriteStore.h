@@ -0,0 +1,106 @@
+/******************************************************************************
+ @File          UISpriteStore.h
+ @Title         UISpriteStore Header File
+ @Author        Siddharth Hathi
+ @Description   Header file for the UISpriteStore class.
+******************************************************************************/
+
+#include "OGLES2Tools.h"
+#include "UISpriteKernels.h"
+
+#ifndef _UISPRITESTORE_H
+#define _UISPRITESTORE_H
+
+// Maximum number of sprites (live UIImages) in the store
+const int c_maxSprites = 512;
+
+// Returned by Allocate when the store is full
+const int c_noSprite = -1;
+
+/*!****************************************************************************
+ @class UISpriteStore
+ Object class. The UISpriteStore holds the per image data of every UIImage in
+ structure of arrays form: position, size, scale, texture coordinates, texture
+ and visibility each live in their own dense array indexed by sprite, and a
+ UIImage is just a handle (index and generation) into them. Passes over every
+ sprite (transforms, visibility) walk a few small contiguous arrays instead of
+ striding across several KB per image, and can be vectorised.
+
+ The store also owns the geometry shared by every image: a unit quad vertex
+ buffer and its index buffer, built the first time an image builds its
+ vertices. Images showing part of their texture get a quad of their own.
+ There is one store, returned by UISpriteStore::Get.
+******************************************************************************/
+class UISpriteStore
+{
+	protected:
+		// Instance variables
+
+		// Transform data
+		float m_x[c_maxSprites], m_y[c_maxSprites];
+		float m_width[c_maxSprites], m_height[c_maxSprites];
+		float m_scaleX[c_maxSprites], m_scaleY[c_maxSprites];
+
+		// Texture coordinates of the part of the texture each sprite shows
+		float m_u0[c_maxSprites], m_v0[c_maxSprites], m_u1[c_maxSprites], m_v1[c_maxSprites];
+
+		// GL texture, and vertex buffer (0 for the shared unit quad)
+		GLuint m_texture[c_maxSprites], m_vbo[c_maxSprites];
+
+		// Is the sprite visible? Is the slot in use?
+		PVRTuint8 m_visible[c_maxSprites], m_live[c_maxSprites];
+
+		// Bumped every time a slot is released so stale handles can be detected
+		PVRTuint16 m_generation[c_maxSprites];
+
+		// Released slots, and the number of slots ever used
+		int m_freeList[c_maxSprites];
+		int m_numFree, m_highWater;
+
+		// Shared unit quad
+		GLuint m_quadVbo, m_quadIndexVbo;
+
+		// Projection and view matrices shared by every image
+		PVRTMat4 m_mProjection, m_mView;
+
+		// Local functions
+		UISpriteStore();
+		GLuint buildQuad(float u0, float v0, float u1, float v1);
+
+	public:
+		// Exported functions
+		static UISpriteStore* Get();
+		int Allocate();
+		void Release(int sprite);
+		bool IsValid(int sprite, PVRTuint16 generation);
+		PVRTuint16 GetGeneration(int sprite);
+		int GetHighWater();
+
+		void SetRect(int sprite, float x, float y, float width, float height);
+		void SetPosition(int sprite, float x, float y);
+		void SetSize(int sprite, float width, float height);
+		void SetScale(int sprite, float scaleX, float scaleY);
+		void SetTexCoords(int sprite, float u0, float v0, float u1, float v1);
+		void SetTexture(int sprite, GLuint texture);
+		void SetVisible(int sprite, bool visible);
+
+		// Dense arrays, valid for indices below GetHighWater
+		float* GetX();
+		float* GetY();
+		float* GetWidth();
+		float* GetHeight();
+		float* GetScaleX();
+		float* GetScaleY();
+		GLuint* GetTextures();
+		PVRTuint8* GetVisible();
+		void GetArrays(UISpriteArrays* arrays);
+
+		void BuildQuad(int sprite);
+		GLuint GetQuadVbo(int sprite);
+		GLuint GetQuadIndexVbo();
+		PVRTMat4* GetProjection();
+		PVRTMat4* GetView();
+		void Delete();
+};
+
+#endif
@@ -0,0 +1,135 @@
+/******************************************************************************
+ @File          UIStateTable.cpp
+ @Title         UIStateTable
+ @Author        Siddharth Hathi
+ @Description   Implements the UIStateTable object class defined in
+				UIStateTable.h
+******************************************************************************/
+
+#include "UIStateTable.h"
+#include <string.h>
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes an empty table in the UIMain state. Only used by
+				Get.
+******************************************************************************/
+UIStateTable::UIStateTable()
+{
+	memset(m_masks, 0, sizeof(m_masks));
+	m_used = 0;
+	m_state = UIMain;
+	m_visible = 0;
+}
+
+/*!****************************************************************************
+ @Function		Get
+ @Return		UIStateTable*		The table
+ @Description	Returns the state table shared by the whole UI
+******************************************************************************/
+UIStateTable*
+UIStateTable::Get()
+{
+	static UIStateTable table;
+	return &table;
+}
+
+/*!****************************************************************************
+ @Function		Register
+ @Input			stateMask	Bit per UIState the view is shown in
+							(1u << state)
+ @Return		int			The view's slot (-1 if the table is full)
+ @Description	Adds a view to the table. The view is visible whenever the
+				state is one of those in its mask.
+******************************************************************************/
+int
+UIStateTable::Register(uint32_t stateMask)
+{
+	if (m_used == ~(uint64_t) 0) {
+		fprintf(stderr, "UIStateTable is full (%d views), view will stay hidden\n", c_maxStateViews);
+		return -1;
+	}
+	int slot = __builtin_ctzll(~m_used);
+	uint64_t bit = (uint64_t) 1 << slot;
+	m_used |= bit;
+	for ( int i = 0; i < UINumStates; i ++ ) {
+		if ((stateMask & (1u << i)) != 0) {
+			m_masks[i] |= bit;
+		}
+	}
+	m_visible = m_masks[m_state];
+	return slot;
+}
+
+/*!****************************************************************************
+ @Function		Unregister
+ @Input			slot		A view's slot
+ @Description	Removes a view from the table. Views call this from Delete.
+******************************************************************************/
+void
+UIStateTable::Unregister(int slot)
+{
+	if (slot < 0 || slot >= c_maxStateViews) {
+		return;
+	}
+	uint64_t keep = ~((uint64_t) 1 << slot);
+	for ( int i = 0; i < UINumStates; i ++ ) {
+		m_masks[i] &= keep;
+	}
+	m_used &= keep;
+	m_visible = m_masks[m_state];
+}
+
+/*!****************************************************************************
+ @Function		SetState
+ @Input			state		New UI state
+ @Return		bool		Did the state change?
+ @Description	Makes the views of a state the visible ones
+******************************************************************************/
+bool
+UIStateTable::SetState(UIState state)
+{
+	if (state < 0 || state >= UINumStates || state == m_state) {
+		return false;
+	}
+	m_state = state;
+	m_visible = m_masks[state];
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		GetState
+ @Return		UIState		The current state
+ @Description	Getter for m_state
+******************************************************************************/
+UIState
+UIStateTable::GetState()
+{
+	return m_state;
+}
+
+/*!****************************************************************************
+ @Function		IsVisible
+ @Input			slot		A view's slot
+ @Return		bool		Is the view shown in the current state?
+ @Description	Tests a view's bit in the current state's mask
+******************************************************************************/
+bool
+UIStateTable::IsVisible(int slot)
+{
+	return slot >= 0 && slot < c_maxStateViews && (m_visible & ((uint64_t) 1 << slot)) != 0;
+}
+
+/*!****************************************************************************
+ @Function		IsEmpty
+ @Return		bool		Is the UI turned off?
+ @Description	Checks whether the UI is in the noUI state with no view
+				registered for it. Elements that aren't in the table (text
+				and images added straight to a UICompositeView, say) are
+				shown in every state, so other states never count as empty.
+******************************************************************************/
+bool
+UIStateTable::IsEmpty()
+{
+	return m_state == noUI && m_visible == 0;
+}
@@ -0,0 +1,61 @@
+/******************************************************************************
+ @File          UIStateTable.h
+ @Title         UIStateTable Header File
+ @Author        Siddharth Hathi
+ @Description   Header file for the UIStateTable class.
+******************************************************************************/
+
+#include "UIMessageKeys.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#ifndef _UISTATETABLE_H
+#define _UISTATETABLE_H
+
+// Most views the table can hold, one bit each in a visibility mask
+const int c_maxStateViews = 64;
+
+/*!****************************************************************************
+ @class UIStateTable
+ Object class. The UIStateTable decides which of the top level views are
+ visible in each UIState. A view registers the states it is shown in when it
+ is constructed and gets a slot; the table keeps, for every state, a mask of
+ the slots visible in it. Changing the state swaps in that state's mask, and
+ a view's Render and Update only test its bit, so no view has to be shown,
+ hidden or told about the state one element at a time.
+
+ UIFrameCache::Update sets the state of every message before the tree sees
+ it, and each top level view sets it again from the message its Update is
+ given, so a layer that calls the root's Update directly still changes state.
+ In noUI, unless a view registered for it, the message goes no further than
+ UIFrameCache and the frame renders nothing. There is one table, returned by
+ UIStateTable::Get.
+******************************************************************************/
+class UIStateTable
+{
+	protected:
+		// Instance variables
+
+		// Slots visible in each state, and slots that are taken
+		uint64_t m_masks[UINumStates];
+		uint64_t m_used;
+
+		// The current state and its mask
+		UIState m_state;
+		uint64_t m_visible;
+
+		// Local functions
+		UIStateTable();
+
+	public:
+		// Exported functions
+		static UIStateTable* Get();
+		int Register(uint32_t stateMask);
+		void Unregister(int slot);
+		bool SetState(UIState state);
+		UIState GetState();
+		bool IsVisible(int slot);
+		bool IsEmpty();
+};
+
+#endif
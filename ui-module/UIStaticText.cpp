@@ -0,0 +1,261 @@
+/******************************************************************************
+ @File          UIStaticText.cpp
+ @Title         UIStaticText
+ @Author        Siddharth Hathi
+ @Description   Implements the UIStaticText object class defined in
+				UIStaticText.h
+******************************************************************************/
+
+#include "UIStaticText.h"
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes some default values
+******************************************************************************/
+UIStaticText::UIStaticText()
+{
+	m_text = NULL;
+	m_font = UIFBold;
+	m_x = 0;
+	m_y = 0;
+	m_scale = 0;
+	m_width = 0;
+	m_height = 0;
+	m_color = 0;
+	m_uiVbo = 0;
+	m_numQuads = 0;
+	m_layoutEpoch = 0;
+	m_dirty = true;
+	m_hidden = false;
+}
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Input			text		The text to display
+ @Input			x, y		Position of the center of the text
+ @Input			scale		Text scale
+ @Input			color		Text color
+ @Input			font		Text font
+ @Description	Initializes a piece of static text. The text isn't copied and
+				must outlive the object.
+******************************************************************************/
+UIStaticText::UIStaticText(char* text, float x, float y, float scale, GLuint color, UIFont font)
+{
+	m_text = text;
+	m_font = font;
+	m_x = x;
+	m_y = y;
+	m_scale = scale;
+	m_width = 0;
+	m_height = 0;
+	m_color = color;
+	m_uiVbo = 0;
+	m_numQuads = 0;
+	m_layoutEpoch = 0;
+	m_dirty = true;
+	m_hidden = false;
+}
+
+/*!****************************************************************************
+ @Function		SetText
+ @Input			text		The new text
+ @Description	Replaces the text. The quads are rebuilt on the next render.
+******************************************************************************/
+void
+UIStaticText::SetText(char* text)
+{
+	if (text == m_text) {
+		return;
+	}
+	m_text = text;
+	m_dirty = true;
+}
+
+/*!****************************************************************************
+ @Function		SetColor
+ @Input			color		The new text color
+ @Description	Changes the text color without rebuilding the quads
+******************************************************************************/
+void
+UIStaticText::SetColor(GLuint color)
+{
+	m_color = color;
+}
+
+/*!****************************************************************************
+ @Function		SetPosition
+ @Input			x, y		The new position of the center of the text
+ @Description	Moves the text without rebuilding the quads
+******************************************************************************/
+void
+UIStaticText::SetPosition(float x, float y)
+{
+	m_x = x;
+	m_y = y;
+}
+
+/*!****************************************************************************
+ @Function		GetSize
+ @Return		PVRTVec2	Width and height of the text
+ @Description	Returns the size of the text as of its last layout
+******************************************************************************/
+PVRTVec2
+UIStaticText::GetSize()
+{
+	return PVRTVec2(m_width, m_height);
+}
+
+/*!****************************************************************************
+ @Function		Measure
+ @Input			printer		UIPrinter object holding the glyph fonts
+ @Output		width		Pointer to the width of the text
+ @Output		height		Pointer to the height of the text
+ @Description	Measures the text with the glyph font it is drawn with, before
+				it has been laid out if need be. Doesn't make any GL calls.
+******************************************************************************/
+void
+UIStaticText::Measure(UIPrinter* printer, float* width, float* height)
+{
+	UIGlyphFont* glyphFont = printer->GetGlyphFont(m_font);
+	if (m_text == NULL || glyphFont == NULL) {
+		*width = 0;
+		*height = 0;
+		return;
+	}
+	if (m_dirty || m_layoutEpoch != printer->GetLayoutEpoch()) {
+		glyphFont->Measure(&m_width, &m_height, m_scale, m_text);
+	}
+	*width = m_width;
+	*height = m_height;
+}
+
+/*!****************************************************************************
+ @Function		LoadTextures
+ @Output		pErrorStr		Pointer to the string returned on error
+ @Description	Static text uses the printer's font textures
+******************************************************************************/
+bool
+UIStaticText::LoadTextures(CPVRTString* const pErrorStr)
+{
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		BuildVertices
+ @Description	Creates the vertex buffer. The glyph quads themselves are laid
+				out on the first render, once the printer's fonts are loaded.
+******************************************************************************/
+void
+UIStaticText::BuildVertices()
+{
+	if (m_uiVbo == 0) {
+		glGenBuffers(1, &m_uiVbo);
+	}
+	m_dirty = true;
+}
+
+/*!****************************************************************************
+ @Function		Render
+ @Input			uiMVPMatrixLoc		Address of the shader's MVP matrix
+ @Input			printer				UIPrinter object used to display text
+ @Description	Draws the cached glyph quads, laying them out first if the
+				text or the printer's fonts have changed
+******************************************************************************/
+bool
+UIStaticText::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
+{
+	if (m_hidden || m_text == NULL) {
+		return true;
+	}
+
+	if (printer == NULL) {
+		fprintf(stderr, "Invalid call to UIStaticText::Render\n");
+		return false;
+	}
+
+	if (m_dirty || m_layoutEpoch != printer->GetLayoutEpoch()) {
+		if (!layout(printer)) {
+			return false;
+		}
+	}
+
+	printer->DrawGlyphs(m_uiVbo, m_numQuads, m_x, m_y, m_color, m_font);
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		Update
+ @Input			updateMessage		UIMessage object containing frame info
+ @Description	Static text doesn't respond to update messages
+******************************************************************************/
+void
+UIStaticText::Update(UIMessage updateMessage)
+{
+	return;
+}
+
+/*!****************************************************************************
+ @Function		Hide
+ @Description	Makes object hidden
+******************************************************************************/
+void
+UIStaticText::Hide()
+{
+	m_hidden = true;
+}
+
+/*!****************************************************************************
+ @Function		Show
+ @Description	Makes object visibile
+******************************************************************************/
+void
+UIStaticText::Show()
+{
+	m_hidden = false;
+}
+
+/*!****************************************************************************
+ @Function		Delete
+ @Description	Frees the object's vertex buffer
+******************************************************************************/
+void
+UIStaticText::Delete()
+{
+	if (m_uiVbo != 0) {
+		glDeleteBuffers(1, &m_uiVbo);
+		m_uiVbo = 0;
+	}
+	m_numQuads = 0;
+	m_dirty = true;
+}
+
+/*!****************************************************************************
+ @Function		layout
+ @Input			printer		UIPrinter object holding the glyph fonts
+ @Description	HELPER - lays the text out around the origin and uploads the
+				quads to the vertex buffer
+******************************************************************************/
+bool
+UIStaticText::layout(UIPrinter* printer)
+{
+	UIGlyphFont* glyphFont = printer->GetGlyphFont(m_font);
+	if (glyphFont == NULL) {
+		fprintf(stderr, "UIStaticText font not loaded\n");
+		return false;
+	}
+
+	UIGlyphVertex vertices[4 * c_maxTextQuads];
+	glyphFont->Measure(&m_width, &m_height, m_scale, m_text);
+	m_numQuads = glyphFont->Layout(0, 0, m_scale, m_text, vertices, c_maxTextQuads);
+
+	if (m_uiVbo == 0) {
+		glGenBuffers(1, &m_uiVbo);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, m_uiVbo);
+	glBufferData(GL_ARRAY_BUFFER, 4 * m_numQuads * sizeof(UIGlyphVertex), vertices, GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	m_layoutEpoch = printer->GetLayoutEpoch();
+	m_dirty = false;
+	return true;
+}
@@ -0,0 +1,79 @@
+/******************************************************************************
+ @File          UIStaticText.h
+ @Title         UIStaticText Header File
+ @Author        Siddharth Hathi
+ @Description   Header file for the UIStaticText class.
+******************************************************************************/
+
+#include "OGLES2Tools.h"
+#include "UIElement.h"
+#include "UIGlyphFont.h"
+
+#ifndef _UISTATICTEXT_H
+#define _UISTATICTEXT_H
+
+/*!****************************************************************************
+ @class UIStaticText
+ Object class. A UIStaticText is a UIElement for text that never changes, such
+ as menu titles and button labels. The first time it is rendered the text is laid
+ out with the printer's UIGlyphFont into glyph quads centered on the origin and
+ stored in a vertex buffer. After that, rendering is a single draw call: the
+ text's position and color are applied by the printer's text shader, so moving
+ or recoloring the text doesn't touch the cached quads. The quads are only rebuilt
+ when the text changes or when the printer reloads its fonts (which happens when
+ the viewport or rotation changes).
+******************************************************************************/
+class UIStaticText : public UIElement
+{
+	protected:
+		// Instance variables
+
+		// The text being displayed
+		char* m_text;
+
+		// The font of the text
+		UIFont m_font;
+
+		// Position of the center of the text, scale and measured size
+		float m_x, m_y, m_scale, m_width, m_height;
+
+		// Text color
+		GLuint m_color;
+
+		// Vertex buffer holding the laid out glyph quads
+		GLuint m_uiVbo;
+
+		// Number of quads in the vertex buffer
+		int m_numQuads;
+
+		// Printer layout epoch the quads were built in
+		unsigned int m_layoutEpoch;
+
+		// Does the text need to be laid out again
+		bool m_dirty;
+
+		// Is the text hidden
+		bool m_hidden;
+
+		// Local functions
+		bool layout(UIPrinter* printer);
+
+	public:
+		// Exported functions
+		UIStaticText();
+		UIStaticText(char* text, float x, float y, float scale, GLuint color, UIFont font);
+		void SetText(char* text);
+		void SetColor(GLuint color);
+		void SetPosition(float x, float y);
+		PVRTVec2 GetSize();
+		void Measure(UIPrinter* printer, float* width, float* height);
+		virtual bool LoadTextures(CPVRTString* const pErrorStr);
+		virtual void BuildVertices();
+		virtual bool Render(GLuint uiMVPMatrixLoc, UIPrinter* printer);
+		virtual void Update(UIMessage updateMessage);
+		virtual void Hide();
+		virtual void Show();
+		virtual void Delete();
+};
+
+#endif
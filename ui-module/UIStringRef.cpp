@@ -0,0 +1,385 @@
+/******************************************************************************
+ @File          UIStringRef.cpp
+ @Title         UIStringRef
+ @Author        Siddharth Hathi
+ @Description   Implements the UIStringRef and UIStringWriter object classes
+				defined in UIStringRef.h
+******************************************************************************/
+
+#include "UIStringRef.h"
+
+/*!****************************************************************************
+ @Function		blockText
+ @Input			block		A string block
+ @Return		char*		Start of the block's text
+ @Description	HELPER - returns the memory after a block's header
+******************************************************************************/
+static inline char*
+blockText(UIStringBlock* block)
+{
+	return (char*) block + sizeof(UIStringBlock);
+}
+
+/*!****************************************************************************
+ @Function		isIdle
+ @Input			block		A block owned by the writer
+ @Return		bool		Is the writer the block's only reference?
+ @Description	HELPER - checks whether a block can be written again. The
+				acquire pairs with the release in UIStringBlockRelease, so
+				readers are done with the text before it is overwritten.
+******************************************************************************/
+static inline bool
+isIdle(UIStringBlock* block)
+{
+	return block->refs.load(std::memory_order_acquire) == 1;
+}
+
+/*!****************************************************************************
+ @Function		UIStringBlockRetain
+ @Input			block		A string block
+ @Description	Adds a reference to a block
+******************************************************************************/
+void
+UIStringBlockRetain(UIStringBlock* block)
+{
+	block->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+/*!****************************************************************************
+ @Function		UIStringBlockRelease
+ @Input			block		A string block
+ @Description	Drops a reference to a block, freeing it if it was the last
+******************************************************************************/
+void
+UIStringBlockRelease(UIStringBlock* block)
+{
+	if (block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		block->~UIStringBlock();
+		free(block);
+	}
+}
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes a null reference
+******************************************************************************/
+UIStringRef::UIStringRef()
+{
+	m_block = NULL;
+	m_text = NULL;
+}
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Input			block		Block holding the text
+ @Input			text		The text
+ @Description	Initializes a reference to text in a block
+******************************************************************************/
+UIStringRef::UIStringRef(UIStringBlock* block, char* text)
+{
+	m_block = block;
+	m_text = text;
+	if (m_block != NULL) {
+		UIStringBlockRetain(m_block);
+	}
+}
+
+/*!****************************************************************************
+ @Function		Copy Constructor
+ @Input			other		Reference being copied
+ @Description	Initializes another reference to the same text
+******************************************************************************/
+UIStringRef::UIStringRef(const UIStringRef& other)
+{
+	m_block = other.m_block;
+	m_text = other.m_text;
+	if (m_block != NULL) {
+		UIStringBlockRetain(m_block);
+	}
+}
+
+/*!****************************************************************************
+ @Function		operator=
+ @Input			other		Reference being copied
+ @Return		UIStringRef&	This reference
+ @Description	Releases the current text and references other's
+******************************************************************************/
+UIStringRef&
+UIStringRef::operator=(const UIStringRef& other)
+{
+	if (other.m_block != NULL) {
+		UIStringBlockRetain(other.m_block);
+	}
+	Release();
+	m_block = other.m_block;
+	m_text = other.m_text;
+	return *this;
+}
+
+/*!****************************************************************************
+ @Function		Destructor
+ @Description	Releases the text
+******************************************************************************/
+UIStringRef::~UIStringRef()
+{
+	Release();
+}
+
+/*!****************************************************************************
+ @Function		Get
+ @Return		char*		The text (NULL for a null reference). Must not be
+							modified.
+ @Description	Returns the referenced text
+******************************************************************************/
+char*
+UIStringRef::Get() const
+{
+	return m_text;
+}
+
+/*!****************************************************************************
+ @Function		At
+ @Input			offset		Offset into the referenced text
+ @Return		UIStringRef		Reference to the text at offset
+ @Description	References other text in the same block, such as another
+				string in a copied string table
+******************************************************************************/
+UIStringRef
+UIStringRef::At(size_t offset) const
+{
+	if (m_text == NULL) {
+		return UIStringRef();
+	}
+	return UIStringRef(m_block, m_text + offset);
+}
+
+/*!****************************************************************************
+ @Function		IsNull
+ @Return		bool		Is the reference empty?
+ @Description	Checks whether the reference has any text
+******************************************************************************/
+bool
+UIStringRef::IsNull() const
+{
+	return m_text == NULL;
+}
+
+/*!****************************************************************************
+ @Function		Release
+ @Description	Drops the reference, leaving it null
+******************************************************************************/
+void
+UIStringRef::Release()
+{
+	if (m_block != NULL) {
+		UIStringBlockRelease(m_block);
+	}
+	m_block = NULL;
+	m_text = NULL;
+}
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes a writer with no blocks
+******************************************************************************/
+UIStringWriter::UIStringWriter()
+{
+	m_current = NULL;
+	m_retired = NULL;
+	m_numBlocks = 0;
+}
+
+/*!****************************************************************************
+ @Function		Copy Constructor
+ @Description	Initializes a writer with no blocks. Copies of a UIMessage
+				start with an empty writer, and the references handed out by
+				the writer being copied are unaffected.
+******************************************************************************/
+UIStringWriter::UIStringWriter(const UIStringWriter&)
+{
+	m_current = NULL;
+	m_retired = NULL;
+	m_numBlocks = 0;
+}
+
+/*!****************************************************************************
+ @Function		operator=
+ @Input			other		Writer being copied
+ @Return		UIStringWriter&		This writer
+ @Description	Gives up this writer's blocks, leaving it empty
+******************************************************************************/
+UIStringWriter&
+UIStringWriter::operator=(const UIStringWriter& other)
+{
+	if (this != &other) {
+		Delete();
+	}
+	return *this;
+}
+
+/*!****************************************************************************
+ @Function		Destructor
+ @Description	Gives up the writer's blocks
+******************************************************************************/
+UIStringWriter::~UIStringWriter()
+{
+	Delete();
+}
+
+/*!****************************************************************************
+ @Function		Copy
+ @Input			text		Text to copy
+ @Return		UIStringRef		Reference to the copy (null if text is NULL
+								or on failure)
+ @Description	Copies text into the current block, moving on to another
+				block if it doesn't fit
+******************************************************************************/
+UIStringRef
+UIStringWriter::Copy(const char* text)
+{
+	if (text == NULL) {
+		return UIStringRef();
+	}
+	return Copy(text, strlen(text) + 1);
+}
+
+/*!****************************************************************************
+ @Function		Copy
+ @Input			data		Bytes to copy
+ @Input			size		Number of bytes
+ @Return		UIStringRef		Reference to the copy (null on failure)
+ @Description	Copies a run of bytes, such as a table of terminated strings,
+				into one block
+******************************************************************************/
+UIStringRef
+UIStringWriter::Copy(const char* data, size_t size)
+{
+	if (data == NULL || size == 0) {
+		return UIStringRef();
+	}
+	if (m_current == NULL || m_current->size - m_current->used < size) {
+		if (m_current != NULL) {
+			retire(m_current);
+		}
+		m_current = takeBlock(size);
+		if (m_current == NULL) {
+			return UIStringRef();
+		}
+	}
+	char* copy = blockText(m_current) + m_current->used;
+	memcpy(copy, data, size);
+	m_current->used += size;
+	return UIStringRef(m_current, copy);
+}
+
+/*!****************************************************************************
+ @Function		Recycle
+ @Description	Starts the next frame's text. The current block is rewound if
+				nothing else references it and retired otherwise, and idle
+				blocks beyond c_maxIdleStringBlocks are freed.
+******************************************************************************/
+void
+UIStringWriter::Recycle()
+{
+	if (m_current != NULL) {
+		if (isIdle(m_current)) {
+			m_current->used = 0;
+		} else {
+			retire(m_current);
+			m_current = NULL;
+		}
+	}
+
+	int numIdle = 0;
+	UIStringBlock** link = &m_retired;
+	while (*link != NULL) {
+		UIStringBlock* block = *link;
+		if (isIdle(block) && ++ numIdle > c_maxIdleStringBlocks) {
+			*link = block->next;
+			UIStringBlockRelease(block);
+			m_numBlocks --;
+		} else {
+			link = &block->next;
+		}
+	}
+}
+
+/*!****************************************************************************
+ @Function		GetBlockCount
+ @Return		int			Number of blocks
+ @Description	Returns the number of blocks the writer owns. It stops growing
+				once readers let go of text as fast as it is written.
+******************************************************************************/
+int
+UIStringWriter::GetBlockCount()
+{
+	return m_numBlocks;
+}
+
+/*!****************************************************************************
+ @Function		Delete
+ @Description	Gives up the writer's blocks. Blocks still referenced are
+				freed when their last reference is released.
+******************************************************************************/
+void
+UIStringWriter::Delete()
+{
+	if (m_current != NULL) {
+		UIStringBlockRelease(m_current);
+		m_current = NULL;
+	}
+	while (m_retired != NULL) {
+		UIStringBlock* next = m_retired->next;
+		UIStringBlockRelease(m_retired);
+		m_retired = next;
+	}
+	m_numBlocks = 0;
+}
+
+/*!****************************************************************************
+ @Function		takeBlock
+ @Input			minSize		Bytes the block must hold
+ @Return		UIStringBlock*		An empty block (NULL on failure)
+ @Description	HELPER - takes an idle retired block that is large enough, or
+				allocates a new one
+******************************************************************************/
+UIStringBlock*
+UIStringWriter::takeBlock(size_t minSize)
+{
+	for ( UIStringBlock** link = &m_retired; *link != NULL; link = &(*link)->next ) {
+		UIStringBlock* block = *link;
+		if (block->size >= minSize && isIdle(block)) {
+			*link = block->next;
+			block->next = NULL;
+			block->used = 0;
+			return block;
+		}
+	}
+
+	size_t size = minSize > c_stringBlockSize ? minSize : c_stringBlockSize;
+	void* memory = malloc(sizeof(UIStringBlock) + size);
+	if (memory == NULL) {
+		fprintf(stderr, "UIStringWriter failed to allocate %u bytes\n", (unsigned int) size);
+		return NULL;
+	}
+	UIStringBlock* block = new (memory) UIStringBlock();
+	block->refs.store(1, std::memory_order_relaxed);
+	block->next = NULL;
+	block->size = size;
+	block->used = 0;
+	m_numBlocks ++;
+	return block;
+}
+
+/*!****************************************************************************
+ @Function		retire
+ @Input			block		A block owned by the writer
+ @Description	HELPER - puts a block on the retired list, keeping the
+				writer's reference to it
+******************************************************************************/
+void
+UIStringWriter::retire(UIStringBlock* block)
+{
+	block->next = m_retired;
+	m_retired = block;
+}
@@ -0,0 +1,110 @@
+/******************************************************************************
+ @File          UIStringRef.h
+ @Title         UIStringRef Header File
+ @Author        Siddharth Hathi
+ @Description   Header file for the UIStringRef and UIStringWriter classes.
+				Makes no GL calls.
+******************************************************************************/
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+
+#ifndef _UISTRINGREF_H
+#define _UISTRINGREF_H
+
+// Usable size of the blocks a UIStringWriter copies text into
+const size_t c_stringBlockSize = 512;
+
+// Most unreferenced blocks a UIStringWriter keeps for reuse
+const int c_maxIdleStringBlocks = 4;
+
+// Header at the start of every block of shared strings. The text follows it.
+// refs counts the writer that owns the block plus every UIStringRef into it
+struct UIStringBlock {
+	std::atomic<int> refs;
+	UIStringBlock* next;
+	size_t size, used;
+};
+
+// Adds and drops a reference to a block. The last reference frees it
+void UIStringBlockRetain(UIStringBlock* block);
+void UIStringBlockRelease(UIStringBlock* block);
+
+/*!****************************************************************************
+ @class UIStringRef
+ Object class. A UIStringRef is a counted reference to immutable text in a
+ UIStringWriter's block. Elements keep the references they read from a
+ UIMessage instead of copying the text, and the block stays alive until the
+ last reference to it is released or replaced, on whichever thread that
+ happens. Copying a reference only bumps the block's count.
+******************************************************************************/
+class UIStringRef
+{
+	protected:
+		// Instance variables
+
+		// Block holding the text (NULL for a null reference) and the text
+		UIStringBlock* m_block;
+		char* m_text;
+
+	public:
+		// Exported functions
+		UIStringRef();
+		UIStringRef(UIStringBlock* block, char* text);
+		UIStringRef(const UIStringRef& other);
+		UIStringRef& operator=(const UIStringRef& other);
+		~UIStringRef();
+		char* Get() const;
+		UIStringRef At(size_t offset) const;
+		bool IsNull() const;
+		void Release();
+};
+
+/*!****************************************************************************
+ @class UIStringWriter
+ Object class. A UIStringWriter is the producer side of the shared strings:
+ it copies text into blocks it owns and hands out UIStringRefs to it. Recycle
+ starts the next frame. A block that nothing outside the writer still
+ references is rewound and written again, and one that is still referenced
+ is retired, to be reused once its count drops back to the writer's own.
+ Nothing is locked: readers only decrement counts, and only the writer
+ reuses blocks, so once enough blocks are in circulation the writer stops
+ allocating.
+
+ Copies of a writer start out empty, so a copied UIMessage never writes into
+ or recycles its original's blocks.
+******************************************************************************/
+class UIStringWriter
+{
+	protected:
+		// Instance variables
+
+		// Block being written, and retired blocks (chained through next)
+		UIStringBlock* m_current;
+		UIStringBlock* m_retired;
+
+		// Number of blocks the writer owns
+		int m_numBlocks;
+
+		// Local functions
+		UIStringBlock* takeBlock(size_t minSize);
+		void retire(UIStringBlock* block);
+
+	public:
+		// Exported functions
+		UIStringWriter();
+		UIStringWriter(const UIStringWriter&);
+		UIStringWriter& operator=(const UIStringWriter& other);
+		~UIStringWriter();
+		UIStringRef Copy(const char* text);
+		UIStringRef Copy(const char* data, size_t size);
+		void Recycle();
+		int GetBlockCount();
+		void Delete();
+};
+
+#endif
@@ -11,6 +11,8 @@
 ******************************************************************************/
 
 #include "UISummaryView.h"
+#include "UIDispatcher.h"
+#include "UIStateTable.h"
 
 /*!****************************************************************************
  @Function		Constructor
@@ -19,36 +21,41 @@
 ******************************************************************************/
 UISummaryView::UISummaryView()
 {
-	m_elements = new UIElement*[c_numSUMElements];
+	m_hidden = false;
+	m_arena.Init(c_SUMArenaSize);
+	m_elements = m_arena.AllocArray<UIElement*>(c_numSUMElements);
 	for ( int i = 0; i < c_numSUMElements; i ++ ) {
 		SUMLayoutSpec spec = c_SUMLayouSpecs[i];
-		UICompositeView* completeIcon = new UICompositeView("textContainer.pvr", spec.x, spec.y, spec.width, spec.height);
+		UICompositeView* completeIcon;
 		switch(spec.type) {
 			case SVComplete:
+				completeIcon = m_arena.Create<UICompositeView>((char*) "textContainer.pvr", spec.x, spec.y, spec.width, spec.height);
 				completeIcon->AddText("Workout Complete", 0xFF0000FF, 40, 0, 0.3, UINone, UIFBold);
 				completeIcon->AddImage("checkmark.pvr", -120, 0, 40, 42);
 				m_elements[i] = completeIcon;
 				break;
 			case SVDistance:
-				m_elements[i] = new UITextBlock("0", "mi", UIFBold, UIFMedium, spec.x, spec.y, 0xFFFFFFFF, UIDistanceM);
+				m_elements[i] = m_arena.Create<UITextBlock>((char*) "0", (char*) "mi", UIFBold, UIFMedium, spec.x, spec.y, 0xFFFFFFFF, UIDistanceM);
 				break;
 			case SVEnergy:
-				m_elements[i] = new UITextBlock("0", "kJ", UIFBold, UIFMedium, spec.x, spec.y, 0xFFFFFFFF, UIEnergyKJ);
+				m_elements[i] = m_arena.Create<UITextBlock>((char*) "0", (char*) "kJ", UIFBold, UIFMedium, spec.x, spec.y, 0xFFFFFFFF, UIEnergyKJ);
 				break;
 			case SVPace:
-				m_elements[i] = new UITextBlock("0", "/mi", UIFBold, UIFMedium, spec.x, spec.y, 0xFFFFFFFF, UISpeedMPM);
+				m_elements[i] = m_arena.Create<UITextBlock>((char*) "0", (char*) "/mi", UIFBold, UIFMedium, spec.x, spec.y, 0xFFFFFFFF, UISpeedMPM);
 				break;
 			case SVCalories:
-				m_elements[i] = new UITextBlock("0", "cal", UIFBold, UIFMedium, spec.x, spec.y, 0xFFFFFFFF, UICalories);
+				m_elements[i] = m_arena.Create<UITextBlock>((char*) "0", (char*) "cal", UIFBold, UIFMedium, spec.x, spec.y, 0xFFFFFFFF, UICalories);
 				break;
 			case SVBadges:
-				m_elements[i] = new UIBadges(spec.x, spec.y);
+				m_elements[i] = m_arena.Create<UIBadges>(spec.x, spec.y);
 				break;
 			default:
 				m_elements[i] = NULL;
 				break;
 		}
 	}
+	UIDispatcher::Get()->Subscribe(this, UIFieldState);
+	m_stateSlot = UIStateTable::Get()->Register(1u << UISummary);
 }
 
 /*!****************************************************************************
@@ -96,7 +103,7 @@ UISummaryView::BuildVertices()
 bool
 UISummaryView::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 {
-	if (m_hidden) {
+	if (m_hidden || !UIStateTable::Get()->IsVisible(m_stateSlot)) {
 		return true;
 	}
 	for ( int i = 0; i < c_numSUMElements; i ++ ) {
@@ -117,9 +124,11 @@ UISummaryView::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 void
 UISummaryView::Update(UIMessage updateMessage)
 {
+	UIStateTable::Get()->SetState(updateMessage.ReadState());
 	//UIMessage delegateMessage;
-	m_hidden = !(updateMessage.ReadState() == UISummary);
-	if (m_hidden) {
+	// Shown in UISummary only. During a dispatch the elements are updated by
+	// the UIDispatcher.
+	if (!UIStateTable::Get()->IsVisible(m_stateSlot) || UIDispatcher::Get()->IsDispatching()) {
 		return;
 	}
 	for (int i = 0 ; i < c_numSUMElements; i ++) {
@@ -152,15 +161,20 @@ UISummaryView::Show()
 
 /*!****************************************************************************
  @Function		Delete
- @Description	Frees any memory allocated within the object
+ @Description	Frees any memory allocated within the object. The elements free
+				their own GL objects, then the arena frees the elements.
 ******************************************************************************/
 void
 UISummaryView::Delete()
 {
+	UIDispatcher::Get()->Unsubscribe(this);
+	UIStateTable::Get()->Unregister(m_stateSlot);
+	m_stateSlot = -1;
 	for ( int i = 0; i < c_numSUMElements; i ++ ) {
-		if (m_elements != NULL && m_elements[i] != NULL)
-		m_elements[i]->Delete();
-		delete m_elements[i];
-		m_elements[i] = NULL;
+		if (m_elements != NULL && m_elements[i] != NULL) {
+			m_elements[i]->Delete();
+		}
 	}
+	m_arena.Delete();
+	m_elements = NULL;
 }
\ No newline at end of file
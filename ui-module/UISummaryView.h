@@ -15,6 +15,7 @@
 #include "UITextBlock.h"
 #include "UICompositeView.h"
 #include "UIBadges.h"
+#include "UIArena.h"
 
 #ifndef _UISUMMARYVIEW_H
 #define _UISUMMARYVIEW_H
@@ -42,6 +43,10 @@ const SUMLayoutSpec c_SUMLayouSpecs[] = {
 	{ SVBadges, 0, 80, 0, 0 }
 };
 
+// Size of the arena holding the UISummaryView's elements
+const size_t c_SUMArenaSize = UIArenaArraySize<UIElement*>(c_numSUMElements)
+	+ UIArenaSize<UICompositeView>(1) + UIArenaSize<UITextBlock>(4) + UIArenaSize<UIBadges>(1);
+
 /*!****************************************************************************
  @class UISummaryView
  Object class. A UIButton is a peice of text with a background that can dynamically
@@ -53,12 +58,19 @@ class UISummaryView : public UIElement
 	protected:
 		// Instance variables
 
+		// Arena that owns the child elements and the element array
+		UIArena m_arena;
+
 		// Child element array
 		UIElement** m_elements;
 
 		// Is the view hidden?
 		bool m_hidden;
 
+		// Slot in the UIStateTable, which decides the states the view is
+		// shown in
+		int m_stateSlot;
+
 	public:
 		// Exported functions
 		UISummaryView();
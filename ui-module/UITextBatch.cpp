@@ -0,0 +1,298 @@
+/******************************************************************************
+ @File          UITextBatch.cpp
+ @Title         UITextBatch
+ @Author        Siddharth Hathi
+ @Description   Implements the UITextBatch object class defined in
+				UITextBatch.h
+******************************************************************************/
+
+#include "UITextBatch.h"
+
+// Attribute indices of the SDF text shader
+const GLuint c_sdfVertexAttrib = 0;
+const GLuint c_sdfColorAttrib = 2;
+const GLuint c_sdfTexCoordAttrib = 3;
+const GLuint c_sdfSmoothingAttrib = 4;
+
+// Batched text shaders. SDF atlases store 0.5 + distance/(2*spread) in alpha
+// and are drawn with a smoothed edge, bitmap glyphs (zero smoothing) store
+// coverage and are drawn as is
+static const char* c_sdfVertShader =
+	"attribute highp vec2 inVertex;\n"
+	"attribute mediump vec2 inTexCoord;\n"
+	"attribute lowp vec4 inColour;\n"
+	"attribute mediump float inSmoothing;\n"
+	"uniform highp mat4 myPMVMatrix;\n"
+	"varying mediump vec2 TexCoord;\n"
+	"varying lowp vec4 Colour;\n"
+	"varying mediump float Smoothing;\n"
+	"void main()\n"
+	"{\n"
+	"	gl_Position = myPMVMatrix * vec4(inVertex, 0.0, 1.0);\n"
+	"	TexCoord = inTexCoord;\n"
+	"	Colour = inColour;\n"
+	"	Smoothing = inSmoothing;\n"
+	"}\n";
+
+static const char* c_sdfFragShader =
+	"uniform sampler2D sTexture;\n"
+	"varying mediump vec2 TexCoord;\n"
+	"varying lowp vec4 Colour;\n"
+	"varying mediump float Smoothing;\n"
+	"void main()\n"
+	"{\n"
+	"	mediump float dist = texture2D(sTexture, TexCoord).a;\n"
+	"	mediump float edge = smoothstep(0.5 - Smoothing, 0.5 + Smoothing, dist);\n"
+	"	mediump float coverage = mix(dist, edge, step(0.0001, Smoothing));\n"
+	"	gl_FragColor = vec4(Colour.rgb, Colour.a * coverage);\n"
+	"}\n";
+
+/*!****************************************************************************
+ @Function		Constructor
+ @Description	Initializes an empty batch
+******************************************************************************/
+UITextBatch::UITextBatch()
+{
+	m_vertices = NULL;
+	m_numQuads = 0;
+	m_uiVbo = 0;
+	m_uiIndexVbo = 0;
+	m_mvpLoc = -1;
+}
+
+/*!****************************************************************************
+ @Function		Init
+ @Output		pErrorStr	Error message on failure
+ @Description	Builds the SDF shader and the batch's buffers
+******************************************************************************/
+bool
+UITextBatch::Init(CPVRTString* const pErrorStr)
+{
+	if (m_shader.GetProgram() == 0) {
+		const UIShaderAttrib attribs[] = {
+			{ "inVertex", c_sdfVertexAttrib },
+			{ "inColour", c_sdfColorAttrib },
+			{ "inTexCoord", c_sdfTexCoordAttrib },
+			{ "inSmoothing", c_sdfSmoothingAttrib }
+		};
+		if (!m_shader.Build(c_sdfVertShader, c_sdfFragShader, attribs, 4, pErrorStr)) {
+			return false;
+		}
+		m_mvpLoc = m_shader.GetUniform("myPMVMatrix");
+	}
+
+	if (m_uiIndexVbo == 0) {
+		// Quads are laid out top left, top right, bottom left, bottom right
+		unsigned short* indices = new unsigned short[6 * c_maxBatchQuads];
+		for ( int i = 0; i < c_maxBatchQuads; i ++ ) {
+			unsigned short base = (unsigned short)(4 * i);
+			indices[6*i] = base;
+			indices[6*i + 1] = base + 2;
+			indices[6*i + 2] = base + 3;
+			indices[6*i + 3] = base;
+			indices[6*i + 4] = base + 3;
+			indices[6*i + 5] = base + 1;
+		}
+		glGenBuffers(1, &m_uiIndexVbo);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_uiIndexVbo);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, 6 * c_maxBatchQuads * sizeof(unsigned short), indices, GL_STATIC_DRAW);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		delete[] indices;
+	}
+
+	if (m_uiVbo == 0) {
+		glGenBuffers(1, &m_uiVbo);
+	}
+	if (m_vertices == NULL) {
+		m_vertices = new UISDFVertex[4 * c_maxBatchQuads];
+	}
+	m_numQuads = 0;
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		Add
+ @Input			font		The SDF atlas
+ @Input			face		Face index (UIFont) of the text
+ @Input			x, y		Position of the center of the text
+ @Input			scale		Text scale
+ @Input			color		Text color (Print3D ABGR format)
+ @Input			text		The text being queued
+ @Return		bool		False if the batch is too full to hold the text
+ @Description	Lays a line of text out centered on (x, y) and queues its quads
+******************************************************************************/
+bool
+UITextBatch::Add(UISDFFont* font, int face, float x, float y, float scale, GLuint color, const char* text)
+{
+	if (m_vertices == NULL || font == NULL || text == NULL || !font->HasFace(face)) {
+		return true;
+	}
+
+	int length = strlen(text);
+	if (m_numQuads + length > c_maxBatchQuads) {
+		return false;
+	}
+
+	float width, height;
+	font->Measure(face, &width, &height, scale, text);
+	float penX = x - width/2;
+	float top = y + height/2;
+
+	// Half a screen pixel in distance field units
+	float smoothing = 0.25f / (font->GetSpread() * scale);
+	GLubyte r = color & 0xFF;
+	GLubyte g = (color >> 8) & 0xFF;
+	GLubyte b = (color >> 16) & 0xFF;
+	GLubyte a = (color >> 24) & 0xFF;
+
+	for ( int i = 0; i < length; i ++ ) {
+		const UIGlyph* glyph = font->GetGlyph(face, text[i]);
+		if (glyph == NULL) {
+			penX += font->GetSpaceAdvance(face) * scale;
+			continue;
+		}
+
+		float left = penX + glyph->xOffset * scale;
+		float right = left + glyph->width * scale;
+		float glyphTop = top - glyph->yOffset * scale;
+		float bottom = glyphTop - glyph->height * scale;
+
+		UISDFVertex* quad = &m_vertices[4 * m_numQuads];
+		quad[0].x = left;	quad[0].y = glyphTop;	quad[0].u = glyph->u0;	quad[0].v = glyph->v0;
+		quad[1].x = right;	quad[1].y = glyphTop;	quad[1].u = glyph->u1;	quad[1].v = glyph->v0;
+		quad[2].x = left;	quad[2].y = bottom;		quad[2].u = glyph->u0;	quad[2].v = glyph->v1;
+		quad[3].x = right;	quad[3].y = bottom;		quad[3].u = glyph->u1;	quad[3].v = glyph->v1;
+		for ( int j = 0; j < 4; j ++ ) {
+			quad[j].smoothing = smoothing;
+			quad[j].r = r;
+			quad[j].g = g;
+			quad[j].b = b;
+			quad[j].a = a;
+		}
+		m_numQuads ++;
+		penX += glyph->advance * scale;
+	}
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		AddQuads
+ @Input			quads		Glyph quads laid out by a UIGlyphFont
+ @Input			numQuads	Number of quads
+ @Input			color		Text color (Print3D ABGR format)
+ @Return		bool		False if the batch is too full to hold the quads
+ @Description	Queues bitmap glyph quads. The font must draw from the same
+				texture as everything else in the batch (a UIGlyphAtlas).
+******************************************************************************/
+bool
+UITextBatch::AddQuads(const UIGlyphVertex* quads, int numQuads, GLuint color)
+{
+	if (m_vertices == NULL || quads == NULL) {
+		return true;
+	}
+	if (m_numQuads + numQuads > c_maxBatchQuads) {
+		return false;
+	}
+
+	GLubyte r = color & 0xFF;
+	GLubyte g = (color >> 8) & 0xFF;
+	GLubyte b = (color >> 16) & 0xFF;
+	GLubyte a = (color >> 24) & 0xFF;
+
+	UISDFVertex* vertex = &m_vertices[4 * m_numQuads];
+	for ( int i = 0; i < 4 * numQuads; i ++, vertex ++ ) {
+		vertex->x = quads[i].x;
+		vertex->y = quads[i].y;
+		vertex->u = quads[i].u;
+		vertex->v = quads[i].v;
+		vertex->smoothing = 0;
+		vertex->r = r;
+		vertex->g = g;
+		vertex->b = b;
+		vertex->a = a;
+	}
+	m_numQuads += numQuads;
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		Flush
+ @Input			projection	Matrix from pixel to device coordinates
+ @Input			texture		The atlas every queued quad samples
+ @Description	Draws every queued quad with a single draw call and empties
+				the batch
+******************************************************************************/
+void
+UITextBatch::Flush(const PVRTMat4& projection, GLuint texture)
+{
+	if (m_numQuads == 0 || m_uiVbo == 0) {
+		return;
+	}
+
+	m_shader.Use();
+	glUniformMatrix4fv(m_mvpLoc, 1, GL_FALSE, projection.f);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, texture);
+
+	// Orphan the previous frame's storage rather than waiting on it
+	glBindBuffer(GL_ARRAY_BUFFER, m_uiVbo);
+	glBufferData(GL_ARRAY_BUFFER, 4 * c_maxBatchQuads * sizeof(UISDFVertex), NULL, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, 4 * m_numQuads * sizeof(UISDFVertex), m_vertices);
+
+	GLsizei stride = sizeof(UISDFVertex);
+	glEnableVertexAttribArray(c_sdfVertexAttrib);
+	glEnableVertexAttribArray(c_sdfTexCoordAttrib);
+	glEnableVertexAttribArray(c_sdfSmoothingAttrib);
+	glEnableVertexAttribArray(c_sdfColorAttrib);
+	glVertexAttribPointer(c_sdfVertexAttrib, 2, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offsetof(UISDFVertex, x));
+	glVertexAttribPointer(c_sdfTexCoordAttrib, 2, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offsetof(UISDFVertex, u));
+	glVertexAttribPointer(c_sdfSmoothingAttrib, 1, GL_FLOAT, GL_FALSE, stride, (GLvoid*)offsetof(UISDFVertex, smoothing));
+	glVertexAttribPointer(c_sdfColorAttrib, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (GLvoid*)offsetof(UISDFVertex, r));
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_uiIndexVbo);
+	glDrawElements(GL_TRIANGLES, 6 * m_numQuads, GL_UNSIGNED_SHORT, 0);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	glDisableVertexAttribArray(c_sdfVertexAttrib);
+	glDisableVertexAttribArray(c_sdfTexCoordAttrib);
+	glDisableVertexAttribArray(c_sdfSmoothingAttrib);
+	glDisableVertexAttribArray(c_sdfColorAttrib);
+	m_shader.Restore();
+
+	m_numQuads = 0;
+}
+
+/*!****************************************************************************
+ @Function		GetQuadCount
+ @Return		int		Number of queued quads
+ @Description	Returns the number of quads waiting to be flushed
+******************************************************************************/
+int
+UITextBatch::GetQuadCount()
+{
+	return m_numQuads;
+}
+
+/*!****************************************************************************
+ @Function		Delete
+ @Description	Frees the batch's GL objects
+******************************************************************************/
+void
+UITextBatch::Delete()
+{
+	if (m_uiVbo != 0) {
+		glDeleteBuffers(1, &m_uiVbo);
+		m_uiVbo = 0;
+	}
+	if (m_uiIndexVbo != 0) {
+		glDeleteBuffers(1, &m_uiIndexVbo);
+		m_uiIndexVbo = 0;
+	}
+	m_shader.Delete();
+	if (m_vertices != NULL) {
+		delete[] m_vertices;
+		m_vertices = NULL;
+	}
+	m_numQuads = 0;
+}
@@ -0,0 +1,65 @@
+/******************************************************************************
+ @File          UITextBatch.h
+ @Title         UITextBatch Header File
+ @Author        Siddharth Hathi
+ @Description   Header file for the UITextBatch class.
+******************************************************************************/
+
+#include "OGLES2Tools.h"
+#include "UISDFFont.h"
+#include "UIShader.h"
+
+#include <stddef.h>
+
+#ifndef _UITEXTBATCH_H
+#define _UITEXTBATCH_H
+
+// Maximum number of glyph quads queued between flushes
+const int c_maxBatchQuads = 1024;
+
+// Vertex format of batched SDF text. Color and edge smoothing are per vertex
+// so that text of any color and size can share a draw
+struct UISDFVertex {
+	float x, y;
+	float u, v;
+	float smoothing;
+	GLubyte r, g, b, a;
+};
+
+/*!****************************************************************************
+ @class UITextBatch
+ Object class. A UITextBatch queues text laid out from a UISDFFont into a single
+ vertex array and draws all of it with one draw call when it is flushed. Because
+ every face lives in the same atlas and color and size are vertex attributes,
+ text of any font, size and color can share the batch. Bitmap glyph quads laid
+ out by UIGlyphFonts packed into a UIGlyphAtlas can be queued with AddQuads;
+ they are given no edge smoothing, which the shader treats as plain coverage.
+******************************************************************************/
+class UITextBatch
+{
+	protected:
+		// Instance variables
+
+		// Queued vertices (4 * c_maxBatchQuads, allocated in Init)
+		UISDFVertex* m_vertices;
+		int m_numQuads;
+
+		// Streaming vertex buffer and static quad index buffer
+		GLuint m_uiVbo, m_uiIndexVbo;
+
+		// SDF text shader and its MVP uniform
+		UIShader m_shader;
+		GLint m_mvpLoc;
+
+	public:
+		// Exported functions
+		UITextBatch();
+		bool Init(CPVRTString* const pErrorStr);
+		bool Add(UISDFFont* font, int face, float x, float y, float scale, GLuint color, const char* text);
+		bool AddQuads(const UIGlyphVertex* quads, int numQuads, GLuint color);
+		void Flush(const PVRTMat4& projection, GLuint texture);
+		int GetQuadCount();
+		void Delete();
+};
+
+#endif
@@ -11,6 +11,7 @@
 ******************************************************************************/
 
 #include "UITextBlock.h"
+#include "UIDispatcher.h"
 
 /*!****************************************************************************
  @Function		Constructor
@@ -27,6 +28,10 @@ UITextBlock::UITextBlock()
     m_insetX = 0;
     m_insetY = 0;
 	m_hidden = false;
+	m_numericMode = false;
+	m_numericValid = false;
+	m_metricKey = UIMNone;
+	m_showMetric = false;
 }
 
 
@@ -53,6 +58,7 @@ UITextBlock::UITextBlock(char* text, float x, float y, GLuint color, UITextType
 	m_textSecondary = NULL;
 	m_fontMain = c_UITBDefaults.font;
 	m_hidden = false;
+	initNumeric();
 }
 
 
@@ -84,6 +90,8 @@ UITextBlock::UITextBlock(char* text, char* textSecondary, UIFont fontMain, UIFon
 	m_color = color;
 	m_updateKey = updateKey;
 	m_hidden = false;
+	m_secondaryLabel = UIStaticText(textSecondary, x, y, m_textScale/2, color, fontSec);
+	initNumeric();
 }
 
 /*!****************************************************************************
@@ -115,6 +123,8 @@ UITextBlock::UITextBlock(char* bg, char* text, char* textSecondary, UIFont fontM
 	m_color = color;
 	m_updateKey = updateKey;
 	m_hidden = false;
+	m_secondaryLabel = UIStaticText(textSecondary, x, y, m_textScale/2, color, fontSec);
+	initNumeric();
 }
 
 /*!****************************************************************************
@@ -129,6 +139,87 @@ UITextBlock::AddSecondaryText(char* text, UIFont fontSecondary)
 {
 	m_textSecondary = text;
 	m_fontSecondary = fontSecondary;
+	// The old label's vertex buffer is released before it is replaced
+	m_secondaryLabel.Delete();
+	m_secondaryLabel = UIStaticText(text, m_x, m_y, m_textScale/2, m_color, fontSecondary);
+}
+
+/*!****************************************************************************
+ @Function		SetValue
+ @Input			value		The new value of the main text
+ @Input			decimals	Number of digits after the decimal point
+ @Description	Sets a numeric text block's main text straight from a number,
+				without formatting it into a string first
+******************************************************************************/
+void
+UITextBlock::SetValue(float value, int decimals)
+{
+	if (m_numericMode) {
+		m_numericValid = m_numeric.SetFixed(value, decimals);
+	}
+}
+
+/*!****************************************************************************
+ @Function		SetClock
+ @Input			seconds		The new time of the main text
+ @Description	Sets a numeric text block's main text to a time (m:ss)
+******************************************************************************/
+void
+UITextBlock::SetClock(int seconds)
+{
+	if (m_numericMode) {
+		m_numericValid = m_numeric.SetClock(seconds);
+	}
+}
+
+/*!****************************************************************************
+ @Function		BindMetric
+ @Input			key			The numeric metric shown as the main text
+ @Input			format		How the metric is formatted
+ @Description	Binds the main text to a numeric metric in the UIMessage. The
+				text block keeps the formatted text in its own buffer and only
+				formats it again when the value crosses a display precision
+				boundary. Text blocks are bound to their text key's metric by
+				default; this overrides it.
+******************************************************************************/
+void
+UITextBlock::BindMetric(UIMetric key, UIFormatter format)
+{
+	m_metricKey = key;
+	m_formatted = UIFormattedValue(format);
+	m_showMetric = false;
+	UIDispatcher::Get()->Subscribe(this, key);
+}
+
+/*!****************************************************************************
+ @Function		AnimateColor
+ @Input			color		Colour the text ends at (Print3D ABGR format)
+ @Input			duration	Length of the animation in seconds
+ @Input			easing		Easing curve
+ @Description	Blends the text from its current colour to a new one. The
+				UIAnimator moves each channel, alpha included, a step each
+				frame.
+******************************************************************************/
+void
+UITextBlock::AnimateColor(GLuint color, float duration, UIEasing easing)
+{
+	UIAnimator::Get()->TweenColor(&m_color, color, duration, easing);
+}
+
+/*!****************************************************************************
+ @Function		FadeTo
+ @Input			alpha		Opacity the text ends at (0 to 1)
+ @Input			duration	Length of the animation in seconds
+ @Input			easing		Easing curve
+ @Description	Fades the text in or out by animating the alpha channel of
+				its colour
+******************************************************************************/
+void
+UITextBlock::FadeTo(float alpha, float duration, UIEasing easing)
+{
+	alpha = alpha < 0 ? 0 : (alpha > 1 ? 1 : alpha);
+	GLuint color = (m_color & 0x00FFFFFF) | ((GLuint)(alpha*255 + 0.5f) << 24);
+	AnimateColor(color, duration, easing);
 }
 
 /*!****************************************************************************
@@ -150,6 +241,10 @@ void
 UITextBlock::BuildVertices()
 {
     m_bg.BuildVertices();
+	m_secondaryLabel.BuildVertices();
+	if (m_numericMode) {
+		m_numeric.BuildVertices();
+	}
 }
 
 /*!****************************************************************************
@@ -170,17 +265,39 @@ UITextBlock::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 		return false;
 	}
 
+	// The colour may be animating, so the pre-laid-out text picks it up
+	// every frame
+	m_numeric.SetColor(m_color);
+	m_secondaryLabel.SetColor(m_color);
+
 	m_bg.Render(uiMVPMatrixLoc, printer);
+	bool numeric = m_numericMode && m_numericValid;
 	if (m_textSecondary == NULL) {
-		printer->Print(m_x, m_y, m_textScale, m_color, UIFBold, m_text);
+		if (numeric) {
+			m_numeric.SetPosition(m_x, m_y);
+			m_numeric.Render(uiMVPMatrixLoc, printer);
+		} else {
+			printer->Print(m_x, m_y, m_textScale, m_color, UIFBold, mainText());
+		}
 	} else {
 		float mainTextWidth, mainTextHeight, secTextWidth, secTextHeight;
-		printer->Measure(&mainTextWidth, &mainTextHeight, m_textScale, m_fontMain, m_text);
-		printer->Measure(&secTextWidth, &secTextHeight, m_textScale/2, m_fontSecondary, m_textSecondary);
+		if (numeric) {
+			m_numeric.Measure(printer, &mainTextWidth, &mainTextHeight);
+		} else {
+			printer->Measure(&mainTextWidth, &mainTextHeight, m_textScale, m_fontMain, mainText());
+		}
+		// Measured with the glyph font the label is drawn with
+		m_secondaryLabel.Measure(printer, &secTextWidth, &secTextHeight);
 		float mainOffset = (-secTextWidth/2);
 		float secondaryOffset = (mainTextWidth/2) + 10;
-		printer->Print(m_x+mainOffset, m_y, m_textScale, m_color, m_fontMain, m_text);
-		printer->Print(m_x+secondaryOffset, m_y, m_textScale/2, m_color, m_fontSecondary, m_textSecondary);
+		if (numeric) {
+			m_numeric.SetPosition(m_x+mainOffset, m_y);
+			m_numeric.Render(uiMVPMatrixLoc, printer);
+		} else {
+			printer->Print(m_x+mainOffset, m_y, m_textScale, m_color, m_fontMain, mainText());
+		}
+		m_secondaryLabel.SetPosition(m_x+secondaryOffset, m_y);
+		m_secondaryLabel.Render(uiMVPMatrixLoc, printer);
 	}
 
     return true;
@@ -195,20 +312,24 @@ void
 UITextBlock::Update(UIMessage updateMessage)
 {
 	//fprintf(stderr, "Message\n");
-	char* oldText = m_text;
-	if ((updateMessage.Read(m_updateKey)) != NULL) {
-		m_text = new char[strlen(updateMessage.Read(m_updateKey)) + 1];
-		strcpy(m_text, updateMessage.Read(m_updateKey));
-		/*
-		 * NOTE: By convention, it's assumed that the UITB's main text
-		 * is initialized to a const string "0" that isn't stored in allocated
-		 * memory. After this initialization, all updates to the main
-		 * text should replace with an allocated string in memory.
-		 * Any string not equal to "0" will be treated as allocated memory
-		 * and freed to maximize performance
-		 */
-		if (strcmp("0", oldText) != 0) {
-			delete oldText;
+	if (m_metricKey != UIMNone && updateMessage.Has(m_metricKey)) {
+		// Numbers are formatted into the text block's own buffer, and only
+		// when the displayed text changes
+		bool changed = m_formatted.Set(updateMessage.Read(m_metricKey)) || !m_showMetric;
+		m_showMetric = true;
+		if (changed && m_numericMode) {
+			m_numericValid = m_numeric.SetText(m_formatted.GetText());
+		}
+		return;
+	}
+	UIStringRef text = updateMessage.ReadRef(m_updateKey);
+	if (!text.IsNull()) {
+		// Holds on to the message's text rather than copying it
+		m_textRef = text;
+		m_text = m_textRef.Get();
+		m_showMetric = false;
+		if (m_numericMode) {
+			m_numericValid = m_numeric.SetText(m_text);
 		}
 	}
 }
@@ -242,16 +363,74 @@ UITextBlock::Show()
 void
 UITextBlock::Delete()
 {
-	/*
-	 * NOTE: By convention, it's assumed that the UITB's main text
-	 * is initialized to a const string "0" that isn't stored in allocated
-	 * memory. After this initialization, all updates to the main
-	 * text should replace with an allocated string in memory.
-	 * Any string not equal to "0" will be treated as allocated memory
-	 * and freed to maximize performance
-	 */
-	if (strcmp(m_text, "0") != 0) {
-		delete m_text;
-		m_text = NULL;
+	UIDispatcher::Get()->Unsubscribe(this);
+	UIAnimator::Get()->Cancel(&m_color);
+	m_textRef.Release();
+	m_text = NULL;
+	m_secondaryLabel.Delete();
+	m_numeric.Delete();
+	m_bg.Delete();
+}
+
+/*!****************************************************************************
+ @Function		initNumeric
+ @Description	HELPER - binds the text block to its text key's numeric metric,
+				subscribes it to both keys, and sets up the numeric renderer
+				if the text block is bound to a numeric readout
+******************************************************************************/
+void
+UITextBlock::initNumeric()
+{
+	UIFormatter format;
+	m_showMetric = false;
+	if (UIMessage::MetricForText(m_updateKey, &m_metricKey, &format)) {
+		m_formatted = UIFormattedValue(format);
+	} else {
+		m_metricKey = UIMNone;
+	}
+	UIDispatcher::Get()->Subscribe(this, m_updateKey);
+	if (m_metricKey != UIMNone) {
+		UIDispatcher::Get()->Subscribe(this, m_metricKey);
+	}
+
+	m_numericMode = numericKey(m_updateKey);
+	m_numericValid = false;
+	if (m_numericMode) {
+		m_numeric = UINumericText(m_x, m_y, m_textScale, m_color, m_fontMain);
+		m_numericValid = m_numeric.SetText(m_text);
+	}
+}
+
+/*!****************************************************************************
+ @Function		mainText
+ @Return		char*		The main text to display
+ @Description	HELPER - returns the formatted metric if the main text was last
+				set from it, otherwise the text from the UIMessage
+******************************************************************************/
+char*
+UITextBlock::mainText()
+{
+	return m_showMetric ? m_formatted.GetText() : m_text;
+}
+
+/*!****************************************************************************
+ @Function		numericKey
+ @Input			key			UIMessage text key
+ @Return		bool		Is the key a numeric readout
+ @Description	HELPER - returns true for the keys whose text only contains
+				digits and : . / -
+******************************************************************************/
+bool
+UITextBlock::numericKey(UITextType key)
+{
+	switch (key) {
+		case UIClock:
+		case UISpeedMPM:
+		case UIBPM:
+		case UIDistanceM:
+		case UIEnergyKJ:
+			return true;
+		default:
+			return false;
 	}
 }
\ No newline at end of file
@@ -13,6 +13,8 @@
 #include "OGLES2Tools.h"
 #include "UIElement.h"
 #include "UIImage.h"
+#include "UIStaticText.h"
+#include "UINumericText.h"
 
 #ifndef _UITEXTBLOCK_H
 #define _UITEXTBLOCK_H
@@ -35,7 +37,13 @@ const TextblockData c_UITBDefaults = {
  centered peice of text over a UIImage background. Additional functionality added
  in this version to support two text objects within the UITextBlock - a main peice
  of text that updates through the UIElement update functionality and a secondary
- fixed subtext that displays to the right of the main text. 
+ fixed subtext that displays to the right of the main text. Text blocks bound to
+ numeric readouts (clock, pace, heart rate, distance, energy) draw their main
+ text with a UINumericText, falling back to the printer for any text it can't
+ display. Their values can also be set directly as numbers. Text blocks whose
+ key has a numeric metric (c_metricBindings), or that are bound to one with
+ BindMetric, also accept the metric's value from the UIMessage and format it
+ into their own buffer, only when it crosses a display precision boundary.
 ******************************************************************************/
 class UITextBlock : public UIElement
 {
@@ -48,8 +56,10 @@ class UITextBlock : public UIElement
 		// The background image for the UITB
         UIImage m_bg;
 
-		// The main text in the UITB
+		// The main text in the UITB, and the reference keeping it alive once
+		// it has come from a UIMessage
         char* m_text;
+		UIStringRef m_textRef;
 
 		// The font of the main text element
         UIFont m_fontMain;
@@ -60,6 +70,9 @@ class UITextBlock : public UIElement
 		// The font of the secondary text element
         UIFont m_fontSecondary;
 
+		// Pre-laid-out secondary text. It only moves with the main text
+		UIStaticText m_secondaryLabel;
+
 		// The color of the text
         GLuint m_color;
 
@@ -69,6 +82,25 @@ class UITextBlock : public UIElement
 		// Is it hidden?
 		bool m_hidden;
 
+		// Numeric renderer for the main text
+		UINumericText m_numeric;
+
+		// Is the main text a numeric readout, can m_numeric display it
+		bool m_numericMode, m_numericValid;
+
+		// Numeric metric the main text is bound to (UIMNone if none), and
+		// its formatted value
+		UIMetric m_metricKey;
+		UIFormattedValue m_formatted;
+
+		// Was the main text last set from the metric rather than as text?
+		bool m_showMetric;
+
+		// Local functions
+		void initNumeric();
+		char* mainText();
+		static bool numericKey(UITextType key);
+
     public:
 		// Exported functions
         UITextBlock();
@@ -78,6 +110,11 @@ class UITextBlock : public UIElement
 		UITextBlock(char* bg, char* text, char* textSecondary, UIFont fontMain, UIFont fontSec,
              float x, float y, float width, float height, GLuint color, UITextType updateKey);
 		void AddSecondaryText(char* textSecondary, UIFont fontSecondary);
+		void SetValue(float value, int decimals);
+		void SetClock(int seconds);
+		void BindMetric(UIMetric key, UIFormatter format);
+		void AnimateColor(GLuint color, float duration, UIEasing easing);
+		void FadeTo(float alpha, float duration, UIEasing easing);
         virtual bool LoadTextures(CPVRTString* const pErrorStr);
         virtual void BuildVertices();
         virtual bool Render(GLuint uiMVPMatrixLoc, UIPrinter* printer);
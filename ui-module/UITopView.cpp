@@ -11,6 +11,8 @@
 ******************************************************************************/
 
 #include "UITopView.h"
+#include "UIDispatcher.h"
+#include "UIStateTable.h"
 
 /*!****************************************************************************
  @Function		Constructor
@@ -20,6 +22,7 @@ UITopView::UITopView()
 {
 	m_state = UIMain;
 	m_hidden = true;
+	m_stateSlot = -1;
 }
 
 /*!****************************************************************************
@@ -36,26 +39,27 @@ UITopView::UITopView(UIState startingState, UIWorkoutStage startingWorkoutMode)
 	m_hidden = false;
 
 	// Add UIElements
-	UIElement** mainElements = new UIElement*[c_tvNumElementPositions];
-	UIElement** infoElements = new UIElement*[c_tvNumElementPositions];
-	UIElement** pauseElements = new UIElement*[c_tvNumElementPositions];
+	m_arena.Init(c_TVArenaSize);
+	UIElement** mainElements = m_arena.AllocArray<UIElement*>(c_tvNumElementPositions);
+	UIElement** infoElements = m_arena.AllocArray<UIElement*>(c_tvNumElementPositions);
+	UIElement** pauseElements = m_arena.AllocArray<UIElement*>(c_tvNumElementPositions);
 
 	for (int i = 0 ; i < c_tvNumElementPositions; i ++) {
 		switch(c_TVLayoutSpecs[i].type) {
 			case TVLeftTB:
-				mainElements[i] = new UITextBlock("0", c_TVLayoutSpecs[i].x, c_TVLayoutSpecs[i].y, c_TVDefaultTextColor, UIRank);
-				infoElements[i] = new UITextBlock("0", "/mi", UIFBold, UIFMedium, c_TVLayoutSpecs[i].x, c_TVLayoutSpecs[i].y, c_TVDefaultTextColor, UISpeedMPM);
-				pauseElements[i] = new UITextBlock("0", c_TVLayoutSpecs[i].x, c_TVLayoutSpecs[i].y, c_TVDefaultTextColor, UIRank);
+				mainElements[i] = m_arena.Create<UITextBlock>((char*) "0", c_TVLayoutSpecs[i].x, c_TVLayoutSpecs[i].y, c_TVDefaultTextColor, UIRank);
+				infoElements[i] = m_arena.Create<UITextBlock>((char*) "0", (char*) "/mi", UIFBold, UIFMedium, c_TVLayoutSpecs[i].x, c_TVLayoutSpecs[i].y, c_TVDefaultTextColor, UISpeedMPM);
+				pauseElements[i] = m_arena.Create<UITextBlock>((char*) "0", c_TVLayoutSpecs[i].x, c_TVLayoutSpecs[i].y, c_TVDefaultTextColor, UIRank);
 				break;
 			case TVRightTB:
-				mainElements[i] = new UITextBlock("0", "kJ", UIFBold, UIFMedium, c_TVLayoutSpecs[i].x, c_TVLayoutSpecs[i].y, c_TVDefaultTextColor, UIEnergyKJ);
-				infoElements[i] = new UITextBlock("0", "mi", UIFBold, UIFMedium, c_TVLayoutSpecs[i].x, c_TVLayoutSpecs[i].y, c_TVDefaultTextColor, UIDistanceM);
+				mainElements[i] = m_arena.Create<UITextBlock>((char*) "0", (char*) "kJ", UIFBold, UIFMedium, c_TVLayoutSpecs[i].x, c_TVLayoutSpecs[i].y, c_TVDefaultTextColor, UIEnergyKJ);
+				infoElements[i] = m_arena.Create<UITextBlock>((char*) "0", (char*) "mi", UIFBold, UIFMedium, c_TVLayoutSpecs[i].x, c_TVLayoutSpecs[i].y, c_TVDefaultTextColor, UIDistanceM);
 				pauseElements[i] = NULL;
 				break;
 			case TVWorkoutView:
-				mainElements[i] = new UIWorkoutView(m_startingWorkoutMode);
-				infoElements[i] = new UIWorkoutView(m_startingWorkoutMode);
-				pauseElements[i] = new UIWorkoutView(m_startingWorkoutMode);
+				mainElements[i] = m_arena.Create<UIWorkoutView>(m_startingWorkoutMode);
+				infoElements[i] = m_arena.Create<UIWorkoutView>(m_startingWorkoutMode);
+				pauseElements[i] = m_arena.Create<UIWorkoutView>(m_startingWorkoutMode);
 				break;
 			default:
 				mainElements[i] = NULL, infoElements[i] = NULL, pauseElements[i] = NULL;
@@ -67,6 +71,8 @@ UITopView::UITopView(UIState startingState, UIWorkoutStage startingWorkoutMode)
 	m_stateMap[UIInfo] = infoElements;
 	m_stateMap[UIPause] = pauseElements;
 	m_stateMap[UISummary] = NULL;
+	UIDispatcher::Get()->Subscribe(this, UIFieldState);
+	m_stateSlot = UIStateTable::Get()->Register(1u << UIMain | 1u << UIInfo | 1u << UIPause);
 }
 
 /*!****************************************************************************
@@ -136,7 +142,7 @@ UITopView::BuildVertices()
 bool
 UITopView::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 {
-	if (m_hidden) {
+	if (m_hidden || !UIStateTable::Get()->IsVisible(m_stateSlot)) {
 		return true;
 	}
 	//fprintf(stderr, "Rendering UITopView\n");
@@ -168,16 +174,16 @@ UITopView::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 void
 UITopView::Update(UIMessage updateMessage)
 {
-	if (updateMessage.ReadState() != UIMain && updateMessage.ReadState() != UIInfo && updateMessage.ReadState() != UIPause) {
-		m_hidden = true;
+	UIStateTable::Get()->SetState(updateMessage.ReadState());
+	// The UIStateTable shows the view in the states it has elements for
+	if (!UIStateTable::Get()->IsVisible(m_stateSlot)) {
 		return;
-	} else {
-		m_hidden = false;
 	}
-	m_state = updateMessage.ReadState();
+	m_state = UIStateTable::Get()->GetState();
 	UIElement** elementArray = m_stateMap[m_state];
 	UIMessage delegateMessage;
-	if (elementArray != NULL) {
+	// During a dispatch the children are updated by the UIDispatcher
+	if (elementArray != NULL && !UIDispatcher::Get()->IsDispatching()) {
 		for (int i = 0 ; i < c_tvNumElementPositions; i ++) {
 			if (elementArray[i] == NULL) {
 				continue;
@@ -194,8 +200,13 @@ UITopView::Update(UIMessage updateMessage)
 void
 UITopView::Hide()
 {
+	m_hidden = true;
 	for (int i = 0; i < m_stateMap.GetSize(); i ++) {
 		UIElement** elementArray = *m_stateMap.GetDataAtIndex(i);
+		// UISummary has no elements, and Delete clears every entry
+		if (elementArray == NULL) {
+			continue;
+		}
 		for (int i = 0 ; i < c_tvNumElementPositions; i ++) {
 			if (elementArray[i] != NULL) {
 				elementArray[i]->Hide();
@@ -211,8 +222,13 @@ UITopView::Hide()
 void
 UITopView::Show()
 {
+	m_hidden = false;
 	for (int i = 0; i < m_stateMap.GetSize(); i ++) {
 		UIElement** elementArray = *m_stateMap.GetDataAtIndex(i);
+		// UISummary has no elements, and Delete clears every entry
+		if (elementArray == NULL) {
+			continue;
+		}
 		for (int i = 0 ; i < c_tvNumElementPositions; i ++) {
 			if (elementArray[i] != NULL) {
 				elementArray[i]->Show();
@@ -224,26 +240,14 @@ UITopView::Show()
 /*!****************************************************************************
  @Function		SetState
  @Input			state		New UI state
- @Description	Sets the m_state instance variable and sets the corresponding
-				elements to visible.
+ @Description	Sets the m_state instance variable and makes it the UI's state
+				in the UIStateTable, which shows the views of that state.
 ******************************************************************************/
 void
 UITopView::SetState(UIState state)
 {
-	this->m_state = state;
-	for (int i = UIMain; i != UISummary; i ++) {
-		UIState iState = static_cast<UIState>(i);
-		UIElement** elementArray = m_stateMap[iState];
-		for (int i = 0 ; i < c_tvNumElementPositions; i ++) {
-			if (elementArray[i] != NULL) {
-				if (iState == m_state) {
-					elementArray[i]->Show();
-				} else {
-					elementArray[i]->Hide();
-				}
-			}
-		}
-	}
+	m_state = state;
+	UIStateTable::Get()->SetState(state);
 }
 
 /*!****************************************************************************
@@ -259,22 +263,28 @@ UITopView::GetState()
 
 /*!****************************************************************************
  @Function		Delete
- @Description	Frees any memory allocated within the object
+ @Description	Frees any memory allocated within the object. The elements free
+				their own GL objects, then the arena frees the elements and the
+				element arrays.
 ******************************************************************************/
 void
 UITopView::Delete()
 {
+	UIDispatcher::Get()->Unsubscribe(this);
+	UIStateTable::Get()->Unregister(m_stateSlot);
+	m_stateSlot = -1;
 	for ( int i = UIMain; i != UISummary; i++ ) {
 		UIState iState = static_cast<UIState>(i);
 		UIElement** elementArray = m_stateMap[iState];
+		if (elementArray == NULL) {
+			continue;
+		}
 		for (int i = 0 ; i < c_tvNumElementPositions; i ++) {
 			if (elementArray[i] != NULL) {
 				elementArray[i]->Delete();
-				delete elementArray[i];
-				elementArray[i] = NULL;
 			}
 		}
-		delete elementArray;
-		elementArray = NULL;
+		m_stateMap[iState] = NULL;
 	}
+	m_arena.Delete();
 }
\ No newline at end of file
@@ -16,6 +16,8 @@
 #include "UIProgressBar.h"
 #include "UITextBlock.h"
 #include "UIWorkoutView.h"
+#include "UILayoutDSL.h"
+#include "UIArena.h"
 
 #ifndef _UITOPVIEW_
 #define _UITOPVIEW_
@@ -32,24 +34,41 @@ struct TVLayoutSpec {
 // Class constant that stores the number of fixed elements in the UITopView
 const int c_tvNumElementPositions = 3;
 
+// Row holding the two text blocks, and the workout view underneath it. The
+// text blocks split the row in two, and their centers anchor their text.
+constexpr float c_TVTextBlockWidth = 220;
+constexpr float c_TVTextBlockGap = 10;
+constexpr UIRect c_TVTextRow = { 0, 300, 450, 70 };
+constexpr UIRect c_TVLeftRect = UIRowSlot(c_TVTextRow, c_TVTextBlockGap, 0, c_TVTextBlockWidth, c_TVTextBlockWidth);
+constexpr UIRect c_TVRightRect = UIRowSlot(c_TVTextRow, c_TVTextBlockGap, 1, c_TVTextBlockWidth, c_TVTextBlockWidth);
+constexpr UIRect c_TVWorkoutRect = UIOffset(c_TVTextRow, 0, -65, c_TVTextRow.width, 30);
+
+static_assert(UIRowTotal(c_TVTextBlockGap, c_TVTextBlockWidth, c_TVTextBlockWidth) == c_TVTextRow.width,
+	"UITopView text blocks don't fill their row");
+
 // Class const reference array that defines the position and sizing of the fixed
 // UITopView elements
-const TVLayoutSpec c_TVLayoutSpecs[] = {
-	{ TVLeftTB, -115, 300, 220, 70 },
-	{ TVRightTB, 115, 300, 220, 70 },
-	{ TVWorkoutView, 0, 235, 450, 30 }
+constexpr TVLayoutSpec c_TVLayoutSpecs[] = {
+	{ TVLeftTB, c_TVLeftRect.x, c_TVLeftRect.y, c_TVLeftRect.width, c_TVLeftRect.height },
+	{ TVRightTB, c_TVRightRect.x, c_TVRightRect.y, c_TVRightRect.width, c_TVRightRect.height },
+	{ TVWorkoutView, c_TVWorkoutRect.x, c_TVWorkoutRect.y, c_TVWorkoutRect.width, c_TVWorkoutRect.height }
 };
 
 // The default color of text in the UITopView
 const GLuint c_TVDefaultTextColor = 0xFF0000FF;
 
+// Size of the arena holding the UITopView's elements: an element array for
+// each of the three states, five text blocks and a workout view per state
+const size_t c_TVArenaSize = 3 * UIArenaArraySize<UIElement*>(c_tvNumElementPositions)
+	+ UIArenaSize<UITextBlock>(5) + UIArenaSize<UIWorkoutView>(3);
+
 /*!****************************************************************************
  @class UITopView
  Object class. The UITopView is the collection of UIElements that make up the
  information HUD at the top of the peloton workout's AR display. The UITB
  functions using a map of UI display states to element arrays. Depending on the
  UIState defined in the current frame, a different set of elements is displayed
- to the user.
+ to the user. The UIStateTable hides the whole view in the other states.
 ******************************************************************************/
 class UITopView : public UIElement
 {
@@ -62,12 +81,19 @@ class UITopView : public UIElement
 		// The current peloton workout stage
 		UIWorkoutStage m_startingWorkoutMode;
 
+		// Arena that owns the child elements and the element arrays
+		UIArena m_arena;
+
 		// A Map from possible UIStates to the elements that will be shown in the
 		// UITB for those states
 		CPVRTMap<UIState, UIElement**> m_stateMap;
 
 		// Is the UITB hidden?
 		bool m_hidden;
+
+		// Slot in the UIStateTable, which decides the states the UITB is
+		// shown in
+		int m_stateSlot;
 		
 	public:
 		// Exported functions
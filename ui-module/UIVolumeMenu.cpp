@@ -6,6 +6,8 @@
 ******************************************************************************/
 
 #include "UIVolumeMenu.h"
+#include "UIDispatcher.h"
+#include "UIStateTable.h"
 
 /*!****************************************************************************
  @Function		Constructor
@@ -13,7 +15,7 @@
 ******************************************************************************/
 UIVolumeMenu::UIVolumeMenu()
 {
-	m_hidden = true;
+	m_hidden = false;
 	m_volumeSelected = false;
 	m_selected = new UICompositeView("brightnessBG.pvr", 0, 100, 300, 300);
 	m_deselected = new UICompositeView("brightnessBG.pvr", 0, 100, 300, 300);
@@ -21,8 +23,13 @@ UIVolumeMenu::UIVolumeMenu()
 	m_deselected->AddImage("volumeImgGray.pvr", 0, 25, 150, 100);
 	UIProgressBar* progBlue = new UIProgressBar(PBType::BrightnessSelected, 0, 10, 0.75);
 	m_selected->AddElement(progBlue);
+	m_selectedBar = progBlue;
 	UIProgressBar* progRed = new UIProgressBar(PBType::BrightnessUnselected, 0, 10, 0.75);
 	m_deselected->AddElement(progRed);
+	m_back = UIStaticText("Back", 0, -200, 0.5, 0xdddddddd, UIFBold);
+	UIDispatcher::Get()->Subscribe(this, UIFieldState);
+	UIDispatcher::Get()->Subscribe(this, UIVolumeSelected);
+	m_stateSlot = UIStateTable::Get()->Register(1u << UIMenuVolume);
 }
 
 /*!****************************************************************************
@@ -34,9 +41,7 @@ bool
 UIVolumeMenu::LoadTextures(CPVRTString* const pErrorStr)
 {
 	if (m_selected != NULL && m_deselected != NULL) {
-		m_selected->LoadTextures(pErrorStr);
-		m_deselected->LoadTextures(pErrorStr);
-		return true;
+		return m_selected->LoadTextures(pErrorStr) && m_deselected->LoadTextures(pErrorStr);
 	} else {
 		return false;
 	}
@@ -53,6 +58,7 @@ UIVolumeMenu::BuildVertices()
 		m_selected->BuildVertices();
 		m_deselected->BuildVertices();
 	}
+	m_back.BuildVertices();
 }
 
 /*!****************************************************************************
@@ -64,7 +70,7 @@ UIVolumeMenu::BuildVertices()
 bool
 UIVolumeMenu::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 {
-	if (m_hidden) {
+	if (m_hidden || !UIStateTable::Get()->IsVisible(m_stateSlot)) {
 		//fprintf(stderr, "UIBM hidden\n");
 		return true;
 	}
@@ -84,7 +90,8 @@ UIVolumeMenu::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 	} else {
 		color = 0xdddddddd;
 	}
-	printer->Print(0, -200, 0.5, color, UIFBold, "Back");
+	m_back.SetColor(color);
+	m_back.Render(uiMVPMatrixLoc, printer);
 	return true;
 }
 
@@ -96,19 +103,19 @@ UIVolumeMenu::Render(GLuint uiMVPMatrixLoc, UIPrinter* printer)
 void
 UIVolumeMenu::Update(UIMessage updateMessage)
 {
+	UIStateTable::Get()->SetState(updateMessage.ReadState());
 	if (m_selected == NULL || m_deselected == NULL) {
 		return;
 	}
 
-	if (updateMessage.ReadState() == UIMenuVolume) {
+	if (UIStateTable::Get()->IsVisible(m_stateSlot)) {
 		//fprintf(stderr, "UIBM message received\n");
-		m_hidden = false;
-		m_flash = updateMessage.Read(UIFlash);
 		m_volumeSelected = updateMessage.Read(UIVolumeSelected);
 		m_selected->Update(updateMessage);
 		m_deselected->Update(updateMessage);
+		m_selectedBar->SetBlink(m_volumeSelected);
 	} else {
-		m_hidden = true;
+		m_selectedBar->SetBlink(false);
 	}
 }
 
@@ -141,6 +148,9 @@ UIVolumeMenu::Show()
 void
 UIVolumeMenu::Delete()
 {
+	UIDispatcher::Get()->Unsubscribe(this);
+	UIStateTable::Get()->Unregister(m_stateSlot);
+	m_stateSlot = -1;
 	if (m_deselected != NULL) {
 		m_deselected->Delete();
 		delete m_deselected;
@@ -150,6 +160,8 @@ UIVolumeMenu::Delete()
 		m_selected->Delete();
 		delete m_selected;
 		m_selected = NULL;
+		m_selectedBar = NULL;
 	}
+	m_back.Delete();
 	return;
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "UIImage.h"
 #include "UIProgressBar.h"
 #include "UICompositeView.h"
+#include "UIStaticText.h"
 
 #ifndef _UIVOLUMEMENU_H
 #define _UIVOLUMEMENU_H
@@ -17,8 +18,8 @@
 /*!****************************************************************************
  @class UIVolumeMenu
  Object class. The UIVolumeMenu is the collection of UIElements that make up the
- menu section used to modify the display's brightness. It supports the app layers
- flashing element functionality, and highlight toggling between the two elements
+ menu section used to modify the display's brightness. Its bar blinks while the
+ menu is selected, and it toggles highlighting between the two elements
 ******************************************************************************/
 class UIVolumeMenu : public UIElement
 {
@@ -28,8 +29,9 @@ class UIVolumeMenu : public UIElement
 		// Is the menu hidden?
 		bool m_hidden;
 
-		// Is the menu currently flashed off?
-		bool m_flash;
+		// Slot in the UIStateTable, which decides the states the menu is
+		// shown in
+		int m_stateSlot;
 
 		// Is the brightness element selected?
 		bool m_volumeSelected;
@@ -39,6 +41,12 @@ class UIVolumeMenu : public UIElement
 
 		// Red brightness elements
 		UICompositeView* m_deselected;
+
+		// Bar of the blue elements, which blinks while the menu is selected
+		UIProgressBar* m_selectedBar;
+
+		// "Back" label
+		UIStaticText m_back;
 	public:
 		// Publicly exported functions
 		UIVolumeMenu();
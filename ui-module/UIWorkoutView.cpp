@@ -11,6 +11,7 @@
 ******************************************************************************/
 
 #include "UIWorkoutView.h"
+#include "UIDispatcher.h"
 
 
 /*!****************************************************************************
@@ -24,60 +25,64 @@ UIWorkoutView::UIWorkoutView(UIWorkoutStage startingState)
     m_state = startingState;
     m_hidden = false;
 
-    UIElement** warmupElements = new UIElement*[c_numWVLayoutSpecs];
-    UIElement** workoutElements = new UIElement*[c_numWVLayoutSpecs];
-    UIElement** cooldownElements = new UIElement*[c_numWVLayoutSpecs];
+    m_arena.Init(c_wvArenaSize);
+    UIElement** warmupElements = m_arena.AllocArray<UIElement*>(c_numWVLayoutSpecs);
+    UIElement** workoutElements = m_arena.AllocArray<UIElement*>(c_numWVLayoutSpecs);
+    UIElement** cooldownElements = m_arena.AllocArray<UIElement*>(c_numWVLayoutSpecs);
 
     for (int i = 0 ; i < c_numWVLayoutSpecs; i ++ ) {
         WVLayoutSpec spec = c_wvLayoutSpecs[i];
         switch(spec.type) {
             case wvBG:
-                warmupElements[i] = new UIImage("progContainer.pvr", spec.x, spec.y, spec.width, spec.height);
-                workoutElements[i] = new UIImage("progContainer.pvr", spec.x, spec.y, spec.width, spec.height);
-                cooldownElements[i] = new UIImage("progContainer.pvr", spec.x, spec.y, spec.width, spec.height);
+                warmupElements[i] = m_arena.Create<UIImage>("progContainer.pvr", spec.x, spec.y, spec.width, spec.height);
+                workoutElements[i] = m_arena.Create<UIImage>("progContainer.pvr", spec.x, spec.y, spec.width, spec.height);
+                cooldownElements[i] = m_arena.Create<UIImage>("progContainer.pvr", spec.x, spec.y, spec.width, spec.height);
                 break;
             case wvWarmupIconActive:
-                warmupElements[i] = new UIImage("warmupActive.pvr", spec.x, spec.y, spec.width, spec.height);
+                warmupElements[i] = m_arena.Create<UIImage>("warmupActive.pvr", spec.x, spec.y, spec.width, spec.height);
                 workoutElements[i] = NULL;
                 cooldownElements[i] = NULL;
                 break;
             case wvWarmupIconInactive:
                 warmupElements[i] = NULL;
-                workoutElements[i] = new UIImage("warmupInactive.pvr", spec.x, spec.y, spec.width, spec.height);
-                cooldownElements[i] =  new UIImage("warmupInactive.pvr", spec.x, spec.y, spec.width, spec.height);
+                workoutElements[i] = m_arena.Create<UIImage>("warmupInactive.pvr", spec.x, spec.y, spec.width, spec.height);
+                cooldownElements[i] =  m_arena.Create<UIImage>("warmupInactive.pvr", spec.x, spec.y, spec.width, spec.height);
                 break;
             case wvWorkoutIconActive:
-                workoutElements[i] = new UIImage("workoutActive.pvr", spec.x, spec.y, spec.width, spec.height);
+                workoutElements[i] = m_arena.Create<UIImage>("workoutActive.pvr", spec.x, spec.y, spec.width, spec.height);
                 warmupElements[i] = NULL;
                 cooldownElements[i] = NULL;
                 break;
             case wvWorkoutIconInactive:
                 workoutElements[i] = NULL;
-                warmupElements[i] = new UIImage("workoutInactive.pvr", spec.x, spec.y, spec.width, spec.height);
-                cooldownElements[i] =  new UIImage("workoutInactive.pvr", spec.x, spec.y, spec.width, spec.height);
+                warmupElements[i] = m_arena.Create<UIImage>("workoutInactive.pvr", spec.x, spec.y, spec.width, spec.height);
+                cooldownElements[i] =  m_arena.Create<UIImage>("workoutInactive.pvr", spec.x, spec.y, spec.width, spec.height);
                 break;
             case wvCooldownIconActive:
-                cooldownElements[i] = new UIImage("cooldownActive.pvr", spec.x, spec.y, spec.width, spec.height);
+                cooldownElements[i] = m_arena.Create<UIImage>("cooldownActive.pvr", spec.x, spec.y, spec.width, spec.height);
                 workoutElements[i] = NULL;
                 warmupElements[i] = NULL;
                 break;
             case wvCooldownIconInactive:
                 cooldownElements[i] = NULL;
-                workoutElements[i] = new UIImage("cooldownInactive.pvr", spec.x, spec.y, spec.width, spec.height);
-                warmupElements[i] =  new UIImage("cooldownInactive.pvr", spec.x, spec.y, spec.width, spec.height);
+                workoutElements[i] = m_arena.Create<UIImage>("cooldownInactive.pvr", spec.x, spec.y, spec.width, spec.height);
+                warmupElements[i] =  m_arena.Create<UIImage>("cooldownInactive.pvr", spec.x, spec.y, spec.width, spec.height);
                 break;
             case wvProgressBarGreen:
-                warmupElements[i] = new UIProgressBar(PBType::PBG, spec.x, spec.y, 1.f);
+                warmupElements[i] = m_arena.Create<UIProgressBar>(PBType::PBG, spec.x, spec.y, 1.f);
+                UIDispatcher::Get()->Unsubscribe(warmupElements[i]);
                 workoutElements[i] = NULL;
                 cooldownElements[i] = NULL;
                 break;
             case wvProgressBarRed:
-                workoutElements[i] = new UIProgressBar(PBType::PBR, spec.x, spec.y, 1.f);
+                workoutElements[i] = m_arena.Create<UIProgressBar>(PBType::PBR, spec.x, spec.y, 1.f);
+                UIDispatcher::Get()->Unsubscribe(workoutElements[i]);
                 warmupElements[i] = NULL;
                 cooldownElements[i] = NULL;
                 break;
             case wvProgressBarBlue:
-                cooldownElements[i] = new UIProgressBar(PBType::PBB, spec.x, spec.y, 1.f);
+                cooldownElements[i] = m_arena.Create<UIProgressBar>(PBType::PBB, spec.x, spec.y, 1.f);
+                UIDispatcher::Get()->Unsubscribe(cooldownElements[i]);
                 workoutElements[i] = NULL;
                 warmupElements[i] = NULL;
                 break;
@@ -91,6 +96,11 @@ UIWorkoutView::UIWorkoutView(UIWorkoutStage startingState)
     m_stateMap[UIWarmup] = warmupElements;
     m_stateMap[UIWorkout] = workoutElements;
     m_stateMap[UICooldown] = cooldownElements;
+
+    // Only the current stage's bar follows the stage progress, so the view
+    // updates its bars itself rather than subscribing them
+    UIDispatcher::Get()->Subscribe(this, UIFieldStage);
+    UIDispatcher::Get()->Subscribe(this, UIStageProgress);
 }
 
 /*!****************************************************************************
@@ -236,6 +246,7 @@ UIWorkoutView::Show()
 void
 UIWorkoutView::Delete()
 {
+	UIDispatcher::Get()->Unsubscribe(this);
 	for ( int i = UIWarmup; i <= UICooldown; i ++ ) {
         UIWorkoutStage iState = static_cast<UIWorkoutStage>(i);
         if (!m_stateMap.Exists(iState)) {
@@ -250,10 +261,8 @@ UIWorkoutView::Delete()
                 continue;
             }
             elementArray[i]->Delete();
-			delete elementArray[i];
-			elementArray[i] = NULL;
         }
-		delete elementArray;
-		elementArray = NULL;
+        m_stateMap[iState] = NULL;
     }
+    m_arena.Delete();
 }
\ No newline at end of file
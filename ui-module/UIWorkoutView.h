@@ -16,6 +16,7 @@
 #include "UIMessage.h"
 #include "UIImage.h"
 #include "UIProgressBar.h"
+#include "UIArena.h"
 
 #ifndef _UIWORKOUTVIEW_H
 #define _UIWORKOUTVIEW_H
@@ -49,6 +50,11 @@ const WVLayoutSpec c_wvLayoutSpecs[] = {
     { wvProgressBarBlue, 40, 235, 450, 30 }
 };
 
+// Size of the arena holding the UIWorkoutView's elements: an element array for
+// each of the three stages, twelve images and a progress bar per stage
+const size_t c_wvArenaSize = 3 * UIArenaArraySize<UIElement*>(c_numWVLayoutSpecs)
+    + UIArenaSize<UIImage>(12) + UIArenaSize<UIProgressBar>(3);
+
 /*!****************************************************************************
  @class UIWorkoutView
  Object class. The UIWorkoutView is a peloton specific component of the workout
@@ -67,6 +73,9 @@ class UIWorkoutView : public UIElement
 		// The current peloton workout stage
         UIWorkoutStage m_state;
 
+		// Arena that owns the child elements and the element arrays
+        UIArena m_arena;
+
 		// A map from each possible workout stage to the array of elements that
 		// should be displayed in that workout stage
         CPVRTMap<UIWorkoutStage, UIElement**> m_stateMap;
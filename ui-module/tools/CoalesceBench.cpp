@@ -0,0 +1,245 @@
+/******************************************************************************
+ @File          CoalesceBench.cpp
+ @Title         CoalesceBench
+ @Author        Siddharth Hathi
+ @Description   Offline benchmark of the UICoalescer under a high rate sensor
+				trace. The trace is a UIRecording with one record per sensor
+				reading, each a whole UIMessage as the app layer writes them
+				today. It is replayed into the Peloton tree twice: once with
+				an Update per reading, and once through a UICoalescer flushed
+				at 60 frames a second with per key display rates. Reports the
+				tree updates and CPU time of each. GL is stubbed out by
+				UIGLStub.cpp.
+
+				Build:	g++ -O2 -I$(SDK)/Builds/Include -I$(SDK)/Tools -I$(SDK)/Tools/OGLES2
+						-o CoalesceBench CoalesceBench.cpp UIGLStub.cpp ../UI*.cpp
+						$(SDK)/Tools/OGLES2/Build/Linux/libogles2tools.a
+				Usage:	CoalesceBench trace.uir
+						CoalesceBench -synth trace.uir [minutes]
+						Run from the ui-module directory so the views find
+						their textures.
+******************************************************************************/
+
+#include "../UICoalescer.h"
+#include "../UIRecording.h"
+#include "../UIFrameCache.h"
+#include "../UICompositeView.h"
+#include "../UIPTopView.h"
+#include "../UIPauseView.h"
+#include "../UISummaryView.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+// Default length of the synthetic trace
+const int c_defaultMinutes = 10;
+
+// Sensors in the synthetic trace: a footpod reporting speed and distance at
+// about 100 Hz with jitter, and a heart rate strap whose notifications arrive
+// in bursts of up to 4 about once a second
+const double c_footpodInterval = 0.01;
+const double c_strapInterval = 1.0;
+const int c_strapBurst = 4;
+const int c_traceRacers = 24;
+
+// Frame rate the coalescer is flushed at
+const int c_benchFrameRate = 60;
+
+/*!****************************************************************************
+ @Function		jitter
+ @Input			interval	Nominal time between readings
+ @Return		double		Time to the next reading
+ @Description	HELPER - spreads a sensor's readings by up to half their
+				interval either way
+******************************************************************************/
+static double
+jitter(double interval)
+{
+	return interval * (0.5 + rand() / (double) RAND_MAX);
+}
+
+/*!****************************************************************************
+ @Function		writeTrace
+ @Input			path		Path of the trace to write
+ @Input			minutes		Length of the workout
+ @Return		bool		Was the trace written?
+ @Description	HELPER - records a synthetic sensor trace. Each reading
+				updates its sensor's values and records the whole message, as
+				the app layer does when a reading arrives.
+******************************************************************************/
+static bool
+writeTrace(const char* path, int minutes)
+{
+	UIRecorder recorder;
+	CPVRTString error;
+	if (!recorder.Open(path, &error)) {
+		fprintf(stderr, "%s\n", error.c_str());
+		return false;
+	}
+
+	double length = minutes * 60.0;
+	double footpod = 0, strap = 0, time = 0;
+	int burst = 0;
+	float speed = 3.0f, distance = 0, bpm = 95;
+	int rank = c_traceRacers;
+	char clock[16];
+	UIMessage message;
+	while (time < length) {
+		// The next reading is whichever sensor reports first
+		if (footpod <= strap) {
+			double step = footpod - time;
+			time = footpod;
+			speed += 0.05f * (rand() / (float) RAND_MAX - 0.5f);
+			distance += speed * step;
+			footpod += jitter(c_footpodInterval);
+		} else {
+			time = strap;
+			bpm += rand() % 3 - 1;
+			if (++ burst < c_strapBurst && rand() % 2 == 0) {
+				strap += 0.002;
+			} else {
+				burst = 0;
+				strap += jitter(c_strapInterval);
+				rank += rand() % 3 - 1;
+				rank = rank < 1 ? 1 : (rank > c_traceRacers ? c_traceRacers : rank);
+			}
+		}
+		float progress = (float) (time / length);
+		int hour = 19 + (int) (time / 3600), minute = ((int) (time / 60) + 30) % 60;
+		snprintf(clock, sizeof(clock), "%d:%02d PM", hour > 12 ? hour - 12 : hour, minute);
+
+		message.Recycle();
+		message.Write(UIMain);
+		message.Write(progress < 0.1f ? UIWarmup : (progress < 0.9f ? UIWorkout : UICooldown));
+		message.SetTotalRacers(c_traceRacers);
+		message.Write(UIMTimeS, (float) time);
+		message.Write(UIMDistanceM, distance);
+		message.Write(UIMSpeedMPS, speed);
+		message.Write(UIMEnergyKJ, distance * 0.11f);
+		message.Write(UIMCalories, distance * 0.026f);
+		message.Write(UIMBPM, bpm);
+		message.Write(UIMRank, (float) rank);
+		message.Write(UIStageProgress, progress);
+		message.Write(UIClock, clock);
+		if (!recorder.Record(message, time)) {
+			recorder.Close();
+			return false;
+		}
+	}
+	printf("wrote %d readings (%d minutes) to %s\n", recorder.GetFrameCount(), minutes, path);
+	return recorder.Close();
+}
+
+/*!****************************************************************************
+ @Function		setRates
+ @Modified		coalescer	The coalescer
+ @Description	HELPER - sets the display rate of each readout: the clock and
+				the slow moving totals once a second, the heart rate twice,
+				speed and distance four times and the progress bar at 30
+				frames a second
+******************************************************************************/
+static void
+setRates(UICoalescer* coalescer)
+{
+	coalescer->SetRate(UIMTimeS, 1);
+	coalescer->SetRate(UIClock, 1);
+	coalescer->SetRate(UIMEnergyKJ, 1);
+	coalescer->SetRate(UIMCalories, 1);
+	coalescer->SetRate(UIMRank, 1);
+	coalescer->SetRate(UIMBPM, 2);
+	coalescer->SetRate(UIMSpeedMPS, 4);
+	coalescer->SetRate(UIMDistanceM, 4);
+	coalescer->SetRate(UIStageProgress, 30);
+}
+
+/*!****************************************************************************
+ @Function		flushFrame
+ @Modified		coalescer	The coalescer
+ @Input			root		Root of the tree
+ @Modified		shown		Message the coalescer fills
+ @Input			frame		Frame number
+ @Return		int			Number of tree updates (0 or 1)
+ @Description	HELPER - flushes the coalescer for a frame and updates the tree
+				if anything shown changed
+******************************************************************************/
+static int
+flushFrame(UICoalescer* coalescer, UIElement* root, UIMessage* shown, int frame)
+{
+	if (!coalescer->Flush(shown, frame / (double) c_benchFrameRate)) {
+		return 0;
+	}
+	UIFrameCache::Get()->Update(root, *shown);
+	return 1;
+}
+
+int
+main(int argc, char** argv)
+{
+	if (argc >= 3 && strcmp(argv[1], "-synth") == 0) {
+		int minutes = argc > 3 ? atoi(argv[3]) : c_defaultMinutes;
+		return writeTrace(argv[2], minutes > 0 ? minutes : c_defaultMinutes) ? 0 : 1;
+	}
+	if (argc < 2) {
+		fprintf(stderr, "Usage: %s trace.uir\n       %s -synth trace.uir [minutes]\n", argv[0], argv[0]);
+		return 1;
+	}
+
+	UIReplay replay;
+	CPVRTString error;
+	if (!replay.Open(argv[1], &error)) {
+		fprintf(stderr, "%s\n", error.c_str());
+		return 1;
+	}
+
+	// Missing textures only leave the stubbed draws with nothing to bind
+	UICompositeView root(0, 0);
+	root.AddElement(new UIPTopView(UIMain, UIWarmup));
+	root.AddElement(new UIPauseView());
+	root.AddElement(new UISummaryView());
+	if (!root.LoadTextures(&error)) {
+		fprintf(stderr, "%s (continuing without textures)\n", error.c_str());
+	}
+	root.BuildVertices();
+
+	// An Update per reading
+	UIMessage message;
+	double time;
+	int numReadings = 0;
+	auto start = std::chrono::steady_clock::now();
+	while (replay.Next(&message, &time)) {
+		UIFrameCache::Get()->Update(&root, message);
+		numReadings ++;
+	}
+	double direct = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	// Readings merged into the coalescer, flushed once a frame
+	UICoalescer coalescer;
+	setRates(&coalescer);
+	UIMessage shown;
+	int numFrames = 0, numUpdates = 0;
+	replay.Rewind();
+	start = std::chrono::steady_clock::now();
+	while (replay.Next(&message, &time)) {
+		// The frames due before the reading arrived are flushed first
+		while (numFrames / (double) c_benchFrameRate <= time) {
+			numUpdates += flushFrame(&coalescer, &root, &shown, numFrames ++);
+		}
+		coalescer.Merge(message);
+	}
+	numUpdates += flushFrame(&coalescer, &root, &shown, numFrames ++);
+	double coalesced = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	printf("%d readings over %.1f s (%.0f a second)\n", numReadings, replay.GetDuration(),
+		replay.GetDuration() > 0 ? numReadings / replay.GetDuration() : 0.0);
+	printf("update per reading: %d updates in %.3f s\n", numReadings, direct);
+	printf("coalesced:          %d updates over %d frames in %.3f s\n", numUpdates, numFrames, coalesced);
+	if (numUpdates > 0 && coalesced > 0) {
+		printf("%.1fx fewer updates, %.1fx less time\n", numReadings / (double) numUpdates, direct / coalesced);
+	}
+
+	root.Delete();
+	replay.Delete();
+	return numReadings > 0 ? 0 : 1;
+}
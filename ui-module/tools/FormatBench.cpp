@@ -0,0 +1,163 @@
+/******************************************************************************
+ @File          FormatBench.cpp
+ @Title         FormatBench
+ @Author        Siddharth Hathi
+ @Description   Offline benchmark of the readout formatters. Times UIFormatWrite
+				against snprintf with the equivalent format strings over a
+				spread of telemetry ticks for each formatter, and checks that
+				they write the same text. The formatters make no GL calls, so
+				no GPU or GL stubs are needed.
+
+				Build:	g++ -O2 -o FormatBench FormatBench.cpp ../UIFormat.cpp
+				Usage:	FormatBench [values] [iterations]
+******************************************************************************/
+
+#include "../UIFormat.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+
+// Defaults: a workout's worth of distinct readouts, formatted a few times over
+const int c_defaultValues = 4096;
+const int c_defaultIterations = 500;
+
+// Names of the formatters, in UIFormatter order
+const char* c_formatterNames[UIFmtNumFormatters] = { "integer", "fixed1", "fixed2", "clock", "miles", "pace" };
+
+/*!****************************************************************************
+ @Function		randomValue
+ @Input			format		The formatter
+ @Return		float		A typical value for the formatter's readouts
+ @Description	HELPER - returns a random telemetry value
+******************************************************************************/
+static float
+randomValue(UIFormatter format)
+{
+	float unit = rand() / (float)RAND_MAX;
+	switch (format) {
+		case UIFmtClock:
+			return unit * 3 * 3600;
+		case UIFmtMiles:
+			return unit * 50000;
+		case UIFmtPace:
+			// Mostly running speeds, with some stopped
+			return unit * 6;
+		case UIFmtFixed1:
+		case UIFmtFixed2:
+			return (unit - 0.1f) * 500;
+		case UIFmtInteger:
+		default:
+			return (unit - 0.1f) * 5000;
+	}
+}
+
+/*!****************************************************************************
+ @Function		writeSnprintf
+ @Input			format		How the value is displayed
+ @Input			ticks		The value's display tick
+ @Output		out			The display text
+ @Return		int			Length of the text
+ @Description	HELPER - the snprintf equivalent of UIFormatWrite
+******************************************************************************/
+static int
+writeSnprintf(UIFormatter format, long ticks, char* out)
+{
+	const char* sign = ticks < 0 ? "-" : "";
+	long magnitude = ticks < 0 ? -ticks : ticks;
+	switch (format) {
+		case UIFmtFixed1:
+			return snprintf(out, c_maxFormatChars + 1, "%s%ld.%ld", sign, magnitude / 10, magnitude % 10);
+		case UIFmtFixed2:
+		case UIFmtMiles:
+			return snprintf(out, c_maxFormatChars + 1, "%s%ld.%02ld", sign, magnitude / 100, magnitude % 100);
+		case UIFmtClock:
+		case UIFmtPace:
+			if (ticks < 0) {
+				return snprintf(out, c_maxFormatChars + 1, "-:--");
+			} else if (ticks >= 3600) {
+				return snprintf(out, c_maxFormatChars + 1, "%ld:%02ld:%02ld", ticks / 3600, ticks / 60 % 60, ticks % 60);
+			}
+			return snprintf(out, c_maxFormatChars + 1, "%ld:%02ld", ticks / 60, ticks % 60);
+		case UIFmtInteger:
+		default:
+			return snprintf(out, c_maxFormatChars + 1, "%ld", ticks);
+	}
+}
+
+/*!****************************************************************************
+ @Function		timeWriter
+ @Input			format		The formatter
+ @Input			ticks		Ticks to format
+ @Input			iterations	Number of times to format them
+ @Input			table		Time UIFormatWrite (or snprintf)?
+ @Return		double		Nanoseconds per readout
+ @Description	HELPER - times one writer
+******************************************************************************/
+static double
+timeWriter(UIFormatter format, const std::vector<long>& ticks, int iterations, bool table)
+{
+	char out[c_maxFormatChars + 1];
+	unsigned int checksum = 0;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for ( int i = 0; i < iterations; i ++ ) {
+		for ( size_t j = 0; j < ticks.size(); j ++ ) {
+			int length = table ? UIFormatWrite(format, ticks[j], out) : writeSnprintf(format, ticks[j], out);
+			checksum += length + out[0];
+		}
+	}
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+	// Keeps the loop from being optimised away
+	if (checksum == 1) {
+		printf(" ");
+	}
+	double ns = std::chrono::duration<double, std::nano>(end - start).count();
+	return ns / ((double)iterations * ticks.size());
+}
+
+int
+main(int argc, char** argv)
+{
+	int count = argc > 1 ? atoi(argv[1]) : c_defaultValues;
+	int iterations = argc > 2 ? atoi(argv[2]) : c_defaultIterations;
+	if (count <= 0 || iterations <= 0) {
+		fprintf(stderr, "Usage: FormatBench [values] [iterations]\n");
+		return 1;
+	}
+
+	printf("%d values, %d iterations\n", count, iterations);
+	srand(1);
+	int mismatches = 0;
+	for ( int f = 0; f < UIFmtNumFormatters; f ++ ) {
+		UIFormatter format = (UIFormatter)f;
+		std::vector<long> ticks(count);
+		for ( int i = 0; i < count; i ++ ) {
+			ticks[i] = UIFormatTicks(format, randomValue(format));
+		}
+
+		for ( int i = 0; i < count; i ++ ) {
+			char expected[c_maxFormatChars + 1], actual[c_maxFormatChars + 1];
+			int expectedLength = writeSnprintf(format, ticks[i], expected);
+			int actualLength = UIFormatWrite(format, ticks[i], actual);
+			if (expectedLength != actualLength || strcmp(expected, actual) != 0) {
+				if (mismatches ++ < 10) {
+					fprintf(stderr, "%s %ld: expected \"%s\", got \"%s\"\n", c_formatterNames[f], ticks[i], expected, actual);
+				}
+			}
+		}
+
+		double snprintfNs = timeWriter(format, ticks, iterations, false);
+		double tableNs = timeWriter(format, ticks, iterations, true);
+		printf("%-8s snprintf %6.2f ns   table %6.2f ns   speedup %.2fx\n",
+			c_formatterNames[f], snprintfNs, tableNs, snprintfNs / tableNs);
+	}
+
+	if (mismatches > 0) {
+		fprintf(stderr, "ERROR: %d readouts differ from snprintf\n", mismatches);
+		return 1;
+	}
+	return 0;
+}
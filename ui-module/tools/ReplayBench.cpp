@@ -0,0 +1,165 @@
+/******************************************************************************
+ @File          ReplayBench.cpp
+ @Title         ReplayBench
+ @Author        Siddharth Hathi
+ @Description   Offline benchmark of the UI tree under a recorded workout.
+				Builds the Peloton element tree, replays a UIRecording into
+				it through the UIFrameCache and reports the time per frame.
+				GL is stubbed out by UIGLStub.cpp, so the numbers are the CPU
+				cost of updating the tree and are reproducible run to run.
+				Can also write a synthetic workout recording to replay.
+
+				Build:	g++ -O2 -I$(SDK)/Builds/Include -I$(SDK)/Tools -I$(SDK)/Tools/OGLES2
+						-o ReplayBench ReplayBench.cpp UIGLStub.cpp ../UI*.cpp
+						$(SDK)/Tools/OGLES2/Build/Linux/libogles2tools.a
+						(UIGLStub.cpp takes the place of -lGLESv2 -lEGL)
+				Usage:	ReplayBench recording.uir [speed] [-dispatch]
+						ReplayBench -synth recording.uir [minutes]
+						Run from the ui-module directory so the views find
+						their textures. -dispatch updates the tree through
+						the UIDispatcher rather than passing every message
+						down the whole tree.
+******************************************************************************/
+
+#include "../UIRecording.h"
+#include "../UIDispatcher.h"
+#include "../UICompositeView.h"
+#include "../UIPTopView.h"
+#include "../UIPauseView.h"
+#include "../UISummaryView.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+// Defaults: an hour long workout, replayed as fast as possible
+const int c_defaultMinutes = 60;
+const float c_defaultSpeed = 0;
+
+// Frame rate of the synthetic workout and the racers in it
+const int c_synthFrameRate = 60;
+const int c_synthRacers = 24;
+
+/*!****************************************************************************
+ @Function		writeSynthetic
+ @Input			path		Path of the recording to write
+ @Input			minutes		Length of the workout
+ @Return		bool		Was the recording written?
+ @Description	HELPER - records a synthetic workout: a warmup, the workout
+				with a pause in the middle, a cooldown and the summary. The
+				readouts move every frame and the rank and heart rate drift,
+				like the telemetry of a real workout.
+******************************************************************************/
+static bool
+writeSynthetic(const char* path, int minutes)
+{
+	UIRecorder recorder;
+	CPVRTString error;
+	if (!recorder.Open(path, &error)) {
+		fprintf(stderr, "%s\n", error.c_str());
+		return false;
+	}
+
+	int numFrames = minutes * 60 * c_synthFrameRate;
+	int pauseStart = numFrames / 2;
+	int pauseEnd = pauseStart + 30 * c_synthFrameRate;
+	float distance = 0, energy = 0, elapsed = 0;
+	float bpm = 90;
+	int rank = c_synthRacers;
+	int lastMile = 0;
+	UIMessage message;
+	for ( int i = 0; i < numFrames; i ++ ) {
+		float progress = i / (float) numFrames;
+		bool paused = i >= pauseStart && i < pauseEnd;
+		bool summary = i >= numFrames - 10 * c_synthFrameRate;
+		UIWorkoutStage stage = progress < 0.1f ? UIWarmup : (progress < 0.9f ? UIWorkout : UICooldown);
+		float speed = paused || summary ? 0 : (stage == UIWorkout ? 3.2f : 2.2f) + 0.3f * (rand() / (float) RAND_MAX);
+		if (!paused && !summary) {
+			elapsed += 1.0f / c_synthFrameRate;
+			distance += speed / c_synthFrameRate;
+			energy += speed * 0.35f / c_synthFrameRate;
+		}
+		if (i % c_synthFrameRate == 0) {
+			bpm += (stage == UIWorkout ? 0.2f : -0.1f) + (rand() % 3 - 1);
+			rank += rand() % 3 - 1;
+			rank = rank < 1 ? 1 : (rank > c_synthRacers ? c_synthRacers : rank);
+		}
+		int mile = (int) (distance / c_metresPerMile);
+
+		message.Recycle();
+		message.Write(summary ? UISummary : (paused ? UIPause : UIMain));
+		message.Write(stage);
+		message.SetTotalRacers(c_synthRacers);
+		message.Write(UIMTimeS, elapsed);
+		message.Write(UIMDistanceM, distance);
+		message.Write(UIMSpeedMPS, speed);
+		message.Write(UIMEnergyKJ, energy);
+		message.Write(UIMCalories, energy * 0.239f);
+		message.Write(UIMBPM, bpm);
+		message.Write(UIMRank, (float) rank);
+		message.Write(UIStageProgress, progress);
+		message.Write(UIMileMarker, mile != lastMile);
+		message.Write(UIBadge1, mile >= 1);
+		message.Write(UIBadge2, mile >= 3);
+		message.Write(UIBadge3, mile >= 5);
+		message.Write(UIResumeButtonActive, paused);
+		lastMile = mile;
+		if (!recorder.Record(message, i / (double) c_synthFrameRate)) {
+			recorder.Close();
+			return false;
+		}
+	}
+	printf("wrote %d frames (%d minutes) to %s\n", recorder.GetFrameCount(), minutes, path);
+	return recorder.Close();
+}
+
+int
+main(int argc, char** argv)
+{
+	if (argc >= 3 && strcmp(argv[1], "-synth") == 0) {
+		int minutes = argc > 3 ? atoi(argv[3]) : c_defaultMinutes;
+		return writeSynthetic(argv[2], minutes > 0 ? minutes : c_defaultMinutes) ? 0 : 1;
+	}
+	if (argc < 2) {
+		fprintf(stderr, "Usage: %s recording.uir [speed] [-dispatch]\n       %s -synth recording.uir [minutes]\n", argv[0], argv[0]);
+		return 1;
+	}
+	float speed = argc > 2 && argv[2][0] != '-' ? (float) atof(argv[2]) : c_defaultSpeed;
+	bool dispatch = strcmp(argv[argc - 1], "-dispatch") == 0;
+
+	UIReplay replay;
+	CPVRTString error;
+	if (!replay.Open(argv[1], &error)) {
+		fprintf(stderr, "%s\n", error.c_str());
+		return 1;
+	}
+
+	// The Peloton tree. Missing textures only leave the stubbed draws with
+	// nothing to bind, so the replay goes ahead without them.
+	UICompositeView root(0, 0);
+	root.AddElement(new UIPTopView(UIMain, UIWarmup));
+	root.AddElement(new UIPauseView());
+	root.AddElement(new UISummaryView());
+	if (!root.LoadTextures(&error)) {
+		fprintf(stderr, "%s (continuing without textures)\n", error.c_str());
+	}
+	root.BuildVertices();
+	UIDispatcher::Get()->SetEnabled(dispatch);
+
+	auto start = std::chrono::steady_clock::now();
+	int numFrames = replay.Play(&root, speed);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	printf("replayed %d frames (%.1f s of workout) in %.3f s", numFrames, replay.GetDuration(), seconds);
+	if (seconds > 0) {
+		printf(", %.0fx real time", replay.GetDuration() / seconds);
+	}
+	printf("\n%.0f ns per frame (%s)\n", numFrames > 0 ? seconds * 1e9 / numFrames : 0.0,
+		dispatch ? "dispatched" : "whole tree");
+
+	bool complete = numFrames == replay.GetFrameCount();
+	root.Delete();
+	replay.Delete();
+	return complete ? 0 : 1;
+}
@@ -0,0 +1,408 @@
+/******************************************************************************
+ @File          SDFFontGen.cpp
+ @Title         SDFFontGen
+ @Author        Siddharth Hathi
+ @Description   Offline tool that renders the UIKit's fonts into a single
+				signed distance field atlas. The atlas is written as a PVR v3
+				A8 texture with the glyph metrics of every font stored in its
+				meta data, so it can be wrapped with Filewrap and loaded by
+				UISDFFont like the other font textures.
+
+				Build:	g++ -O2 -o SDFFontGen SDFFontGen.cpp `pkg-config --cflags --libs freetype2`
+				Usage:	SDFFontGen [-size px] [-spread px] [-width px] [-oversample n]
+							output.pvr font0 [font1 ...]
+
+				Fonts are stored in the order given, which should match the
+				UIFont enum (Bold, Medium, Regular, Thin, Light). Pass - in
+				place of a font file to leave a face empty.
+******************************************************************************/
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+// PVR v3 identifiers and the meta data keys read by UISDFFont
+const unsigned int c_pvrV3Identifier = 0x03525650;
+const unsigned int c_sdfFontHeader = 0xFCFC0060;
+const unsigned int c_sdfFontMetrics = 0xFCFC0061;
+
+// Printable ASCII range rendered for every font
+const int c_firstChar = 33;
+const int c_lastChar = 126;
+
+// Settings that can be changed from the command line
+struct GenSettings {
+	int size, spread, width, oversample;
+};
+
+// A glyph's distance field and metrics before packing
+struct GenGlyph {
+	unsigned int code;
+	int face;
+	int x, y, w, h;
+	float xOffset, yOffset, advance;
+	std::vector<unsigned char> field;
+};
+
+// Face wide metrics
+struct GenFace {
+	float lineHeight, ascent, spaceAdvance;
+	unsigned int numGlyphs;
+};
+
+// Offset to the nearest pixel of the other state, used by the distance transform
+struct GenPoint {
+	int dx, dy;
+	int dist2() const { return dx*dx + dy*dy; }
+};
+
+/*!****************************************************************************
+ @Function		compare
+ @Description	HELPER - 8SSEDT step, takes the offset stored at a neighbour
+				if it leads to a closer pixel
+******************************************************************************/
+static void
+compare(std::vector<GenPoint>& grid, int w, int h, int x, int y, int offX, int offY)
+{
+	int nx = x + offX;
+	int ny = y + offY;
+	if (nx < 0 || ny < 0 || nx >= w || ny >= h) {
+		return;
+	}
+	GenPoint other = grid[ny*w + nx];
+	other.dx += offX;
+	other.dy += offY;
+	if (other.dist2() < grid[y*w + x].dist2()) {
+		grid[y*w + x] = other;
+	}
+}
+
+/*!****************************************************************************
+ @Function		distanceTransform
+ @Description	HELPER - two pass 8-point sequential euclidean distance
+				transform. Pixels set in the grid with offset (0, 0) are the
+				seeds; every other pixel ends up with the offset to its nearest
+				seed.
+******************************************************************************/
+static void
+distanceTransform(std::vector<GenPoint>& grid, int w, int h)
+{
+	for ( int y = 0; y < h; y ++ ) {
+		for ( int x = 0; x < w; x ++ ) {
+			compare(grid, w, h, x, y, -1, 0);
+			compare(grid, w, h, x, y, 0, -1);
+			compare(grid, w, h, x, y, -1, -1);
+			compare(grid, w, h, x, y, 1, -1);
+		}
+		for ( int x = w - 1; x >= 0; x -- ) {
+			compare(grid, w, h, x, y, 1, 0);
+		}
+	}
+	for ( int y = h - 1; y >= 0; y -- ) {
+		for ( int x = w - 1; x >= 0; x -- ) {
+			compare(grid, w, h, x, y, 1, 0);
+			compare(grid, w, h, x, y, 0, 1);
+			compare(grid, w, h, x, y, -1, 1);
+			compare(grid, w, h, x, y, 1, 1);
+		}
+		for ( int x = 0; x < w; x ++ ) {
+			compare(grid, w, h, x, y, -1, 0);
+		}
+	}
+}
+
+/*!****************************************************************************
+ @Function		buildField
+ @Description	HELPER - converts a high resolution coverage bitmap into a
+				signed distance field at the output resolution. Distances are
+				stored as 0.5 + d/(2*spread), positive inside the glyph.
+******************************************************************************/
+static void
+buildField(const FT_Bitmap& bitmap, const GenSettings& settings, GenGlyph* glyph)
+{
+	int os = settings.oversample;
+	int pad = settings.spread * os;
+	int hiW = bitmap.width + 2*pad;
+	int hiH = bitmap.rows + 2*pad;
+	const GenPoint far = { 1 << 14, 1 << 14 };
+	const GenPoint zero = { 0, 0 };
+
+	std::vector<bool> inside(hiW * hiH, false);
+	for ( unsigned int y = 0; y < bitmap.rows; y ++ ) {
+		for ( unsigned int x = 0; x < bitmap.width; x ++ ) {
+			inside[(y + pad)*hiW + x + pad] = bitmap.buffer[y*bitmap.pitch + x] >= 128;
+		}
+	}
+
+	std::vector<GenPoint> toInside(hiW * hiH), toOutside(hiW * hiH);
+	for ( int i = 0; i < hiW * hiH; i ++ ) {
+		toInside[i] = inside[i] ? zero : far;
+		toOutside[i] = inside[i] ? far : zero;
+	}
+	distanceTransform(toInside, hiW, hiH);
+	distanceTransform(toOutside, hiW, hiH);
+
+	glyph->w = (hiW + os - 1) / os;
+	glyph->h = (hiH + os - 1) / os;
+	glyph->field.assign(glyph->w * glyph->h, 0);
+	for ( int y = 0; y < glyph->h; y ++ ) {
+		for ( int x = 0; x < glyph->w; x ++ ) {
+			// Sample the center of the output pixel
+			int hx = std::min(x*os + os/2, hiW - 1);
+			int hy = std::min(y*os + os/2, hiH - 1);
+			int i = hy*hiW + hx;
+			float dist = (sqrtf((float)toInside[i].dist2()) - sqrtf((float)toOutside[i].dist2())) / os;
+			float value = 0.5f - dist / (2.0f * settings.spread);
+			value = std::max(0.0f, std::min(1.0f, value));
+			glyph->field[y*glyph->w + x] = (unsigned char)(value * 255.0f + 0.5f);
+		}
+	}
+}
+
+/*!****************************************************************************
+ @Function		renderFace
+ @Description	HELPER - renders the printable characters of one font
+******************************************************************************/
+static bool
+renderFace(FT_Library library, const char* path, int faceIndex, const GenSettings& settings,
+	GenFace* face, std::vector<GenGlyph>* glyphs)
+{
+	face->lineHeight = 0;
+	face->ascent = 0;
+	face->spaceAdvance = 0;
+	face->numGlyphs = 0;
+	if (strcmp(path, "-") == 0) {
+		return true;
+	}
+
+	FT_Face ftFace;
+	if (FT_New_Face(library, path, 0, &ftFace) != 0) {
+		fprintf(stderr, "Couldn't open font %s\n", path);
+		return false;
+	}
+	int os = settings.oversample;
+	FT_Set_Pixel_Sizes(ftFace, 0, settings.size * os);
+
+	face->lineHeight = (ftFace->size->metrics.height / 64.0f) / os;
+	face->ascent = (ftFace->size->metrics.ascender / 64.0f) / os;
+	if (FT_Load_Char(ftFace, ' ', FT_LOAD_DEFAULT) == 0) {
+		face->spaceAdvance = (ftFace->glyph->advance.x / 64.0f) / os;
+	}
+
+	for ( int c = c_firstChar; c <= c_lastChar; c ++ ) {
+		if (FT_Get_Char_Index(ftFace, c) == 0) {
+			continue;
+		}
+		if (FT_Load_Char(ftFace, c, FT_LOAD_RENDER) != 0) {
+			continue;
+		}
+		FT_GlyphSlot slot = ftFace->glyph;
+
+		GenGlyph glyph;
+		glyph.code = c;
+		glyph.face = faceIndex;
+		glyph.x = 0;
+		glyph.y = 0;
+		buildField(slot->bitmap, settings, &glyph);
+		glyph.xOffset = (float)slot->bitmap_left / os - settings.spread;
+		glyph.yOffset = face->ascent - (float)slot->bitmap_top / os - settings.spread;
+		glyph.advance = (slot->advance.x / 64.0f) / os;
+		glyphs->push_back(glyph);
+		face->numGlyphs ++;
+	}
+
+	FT_Done_Face(ftFace);
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		pack
+ @Return		int		Height of the atlas
+ @Description	HELPER - packs the glyphs into rows, tallest first, and returns
+				the power of two atlas height that holds them
+******************************************************************************/
+static int
+pack(std::vector<GenGlyph*>& order, int width)
+{
+	std::sort(order.begin(), order.end(), [](const GenGlyph* a, const GenGlyph* b) {
+		return a->h > b->h;
+	});
+	int x = 1, y = 1, rowHeight = 0;
+	for ( size_t i = 0; i < order.size(); i ++ ) {
+		GenGlyph* glyph = order[i];
+		if (x + glyph->w + 1 > width) {
+			x = 1;
+			y += rowHeight + 1;
+			rowHeight = 0;
+		}
+		glyph->x = x;
+		glyph->y = y;
+		x += glyph->w + 1;
+		rowHeight = std::max(rowHeight, glyph->h);
+	}
+	int height = 1;
+	while (height < y + rowHeight + 1) {
+		height *= 2;
+	}
+	return height;
+}
+
+/*!****************************************************************************
+ @Function		writeBlockHeader
+ @Description	HELPER - writes a PVR v3 meta data block header
+******************************************************************************/
+static void
+writeBlockHeader(std::vector<unsigned int>* out, unsigned int key, unsigned int size)
+{
+	out->push_back(c_pvrV3Identifier);
+	out->push_back(key);
+	out->push_back(size);
+}
+
+/*!****************************************************************************
+ @Function		pushFloat
+ @Description	HELPER - appends a float's bits to a word buffer
+******************************************************************************/
+static void
+pushFloat(std::vector<unsigned int>* out, float value)
+{
+	unsigned int bits;
+	memcpy(&bits, &value, sizeof(bits));
+	out->push_back(bits);
+}
+
+/*!****************************************************************************
+ @Function		writeAtlas
+ @Description	HELPER - writes the atlas as a PVR v3 A8 texture. Meta data:
+				0xFCFC0060	u32 faces, f32 size, f32 spread, u32 reserved
+				0xFCFC0061	per face: f32 line height, f32 ascent, f32 space
+							advance, u32 glyph count, followed by one record
+							per glyph: u32 code, i32 x, y, w, h, f32 x offset,
+							y offset, advance
+******************************************************************************/
+static bool
+writeAtlas(const char* path, const GenSettings& settings, const std::vector<GenFace>& faces,
+	const std::vector<GenGlyph>& glyphs, int width, int height)
+{
+	std::vector<unsigned int> meta;
+	writeBlockHeader(&meta, c_sdfFontHeader, 16);
+	meta.push_back((unsigned int)faces.size());
+	pushFloat(&meta, (float)settings.size);
+	pushFloat(&meta, (float)settings.spread);
+	meta.push_back(0);
+
+	std::vector<unsigned int> metrics;
+	for ( size_t f = 0; f < faces.size(); f ++ ) {
+		pushFloat(&metrics, faces[f].lineHeight);
+		pushFloat(&metrics, faces[f].ascent);
+		pushFloat(&metrics, faces[f].spaceAdvance);
+		metrics.push_back(faces[f].numGlyphs);
+		for ( size_t i = 0; i < glyphs.size(); i ++ ) {
+			const GenGlyph& glyph = glyphs[i];
+			if (glyph.face != (int)f) {
+				continue;
+			}
+			metrics.push_back(glyph.code);
+			metrics.push_back(glyph.x);
+			metrics.push_back(glyph.y);
+			metrics.push_back(glyph.w);
+			metrics.push_back(glyph.h);
+			pushFloat(&metrics, glyph.xOffset);
+			pushFloat(&metrics, glyph.yOffset);
+			pushFloat(&metrics, glyph.advance);
+		}
+	}
+	writeBlockHeader(&meta, c_sdfFontMetrics, metrics.size() * 4);
+	meta.insert(meta.end(), metrics.begin(), metrics.end());
+
+	// Version, flags, pixel format ('a' 8 bit), colour space, channel type,
+	// height, width, depth, surfaces, faces, mip maps, meta data size
+	unsigned int header[13] = {
+		c_pvrV3Identifier, 0, 0x61, 0x8, 0, 0,
+		(unsigned int)height, (unsigned int)width, 1, 1, 1, 1,
+		(unsigned int)(meta.size() * 4)
+	};
+
+	std::vector<unsigned char> pixels(width * height, 0);
+	for ( size_t i = 0; i < glyphs.size(); i ++ ) {
+		const GenGlyph& glyph = glyphs[i];
+		for ( int y = 0; y < glyph.h; y ++ ) {
+			memcpy(&pixels[(glyph.y + y)*width + glyph.x], &glyph.field[y*glyph.w], glyph.w);
+		}
+	}
+
+	FILE* file = fopen(path, "wb");
+	if (file == NULL) {
+		fprintf(stderr, "Couldn't open %s for writing\n", path);
+		return false;
+	}
+	fwrite(header, sizeof(header), 1, file);
+	fwrite(&meta[0], 4, meta.size(), file);
+	fwrite(&pixels[0], 1, pixels.size(), file);
+	fclose(file);
+	return true;
+}
+
+int
+main(int argc, char** argv)
+{
+	GenSettings settings = { 48, 6, 1024, 4 };
+	int arg = 1;
+	for ( ; arg + 1 < argc && argv[arg][0] == '-' && argv[arg][1] != '\0'; arg += 2 ) {
+		int value = atoi(argv[arg + 1]);
+		if (strcmp(argv[arg], "-size") == 0) {
+			settings.size = value;
+		} else if (strcmp(argv[arg], "-spread") == 0) {
+			settings.spread = value;
+		} else if (strcmp(argv[arg], "-width") == 0) {
+			settings.width = value;
+		} else if (strcmp(argv[arg], "-oversample") == 0) {
+			settings.oversample = value;
+		} else {
+			fprintf(stderr, "Unknown option %s\n", argv[arg]);
+			return 1;
+		}
+	}
+	if (argc - arg < 2 || settings.size <= 0 || settings.spread <= 0 || settings.oversample <= 0) {
+		fprintf(stderr, "Usage: SDFFontGen [-size px] [-spread px] [-width px] [-oversample n] output.pvr font0 [font1 ...]\n");
+		return 1;
+	}
+	const char* outPath = argv[arg ++];
+
+	FT_Library library;
+	if (FT_Init_FreeType(&library) != 0) {
+		fprintf(stderr, "Couldn't initialize FreeType\n");
+		return 1;
+	}
+
+	std::vector<GenFace> faces;
+	std::vector<GenGlyph> glyphs;
+	for ( int f = 0; arg < argc; f ++, arg ++ ) {
+		GenFace face;
+		if (!renderFace(library, argv[arg], f, settings, &face, &glyphs)) {
+			FT_Done_FreeType(library);
+			return 1;
+		}
+		faces.push_back(face);
+	}
+	FT_Done_FreeType(library);
+
+	std::vector<GenGlyph*> order;
+	for ( size_t i = 0; i < glyphs.size(); i ++ ) {
+		order.push_back(&glyphs[i]);
+	}
+	int height = pack(order, settings.width);
+
+	if (!writeAtlas(outPath, settings, faces, glyphs, settings.width, height)) {
+		return 1;
+	}
+	fprintf(stderr, "Wrote %d glyphs from %d fonts into a %dx%d atlas\n",
+		(int)glyphs.size(), (int)faces.size(), settings.width, height);
+	return 0;
+}
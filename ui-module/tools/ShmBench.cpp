@@ -0,0 +1,220 @@
+/******************************************************************************
+ @File          ShmBench.cpp
+ @Title         ShmBench
+ @Author        Siddharth Hathi
+ @Description   Benchmark of the shared memory frame ring between two local
+				processes. The parent publishes synthetic workout frames with
+				a UIShmProducer; a forked child reads them with a
+				UIShmConsumer and updates the Peloton element tree through
+				the UIFrameCache, as the UILayer would. Reports the publish
+				to visible latency (until the tree has been updated with the
+				frame; GL is stubbed out by UIGLStub.cpp, so drawing isn't
+				included) and the throughput of the ring.
+
+				Build:	g++ -O2 -I$(SDK)/Builds/Include -I$(SDK)/Tools -I$(SDK)/Tools/OGLES2
+						-o ShmBench ShmBench.cpp UIGLStub.cpp ../UI*.cpp
+						$(SDK)/Tools/OGLES2/Build/Linux/libogles2tools.a -lrt
+				Usage:	ShmBench [frames] [rate]
+						rate is frames per second (0 publishes as fast as
+						possible). Run from the ui-module directory so the
+						views find their textures.
+******************************************************************************/
+
+#include "../UIShmTransport.h"
+#include "../UIFrameCache.h"
+#include "../UICompositeView.h"
+#include "../UIPTopView.h"
+#include "../UIPauseView.h"
+#include "../UISummaryView.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <algorithm>
+#include <vector>
+
+// Defaults: a minute of frames at 60 frames a second
+const int c_defaultFrames = 3600;
+const int c_defaultRate = 60;
+
+// Name of the bench's ring, so it doesn't disturb a running app's
+const char* const c_benchShmName = "/uikit-shmbench";
+
+// How long the consumer waits for a frame before deciding the producer is done
+const int c_consumerTimeoutMs = 1000;
+
+// Racers in the synthetic workout
+const int c_benchRacers = 24;
+
+/*!****************************************************************************
+ @Function		writeFrame
+ @Input			writer		Writer of the frame
+ @Input			index		Frame index
+ @Input			numFrames	Frames in the run
+ @Description	HELPER - fills a frame with moving readouts, a rank, the
+				stage progress and the clock text
+******************************************************************************/
+static void
+writeFrame(UIFrameWriter* writer, int index, int numFrames)
+{
+	float progress = index / (float) numFrames;
+	float elapsed = index / 60.0f;
+	writer->Write(UIMain);
+	writer->Write(progress < 0.1f ? UIWarmup : (progress < 0.9f ? UIWorkout : UICooldown));
+	writer->SetTotalRacers(c_benchRacers);
+	writer->Write(UIMTimeS, elapsed);
+	writer->Write(UIMDistanceM, elapsed * 3.1f);
+	writer->Write(UIMSpeedMPS, 3.0f + 0.3f * (rand() / (float) RAND_MAX));
+	writer->Write(UIMEnergyKJ, elapsed * 1.1f);
+	writer->Write(UIMCalories, elapsed * 0.26f);
+	writer->Write(UIMBPM, 120.0f + (index / 60) % 30);
+	writer->Write(UIMRank, (float) (1 + (index / 600) % c_benchRacers));
+	writer->Write(UIStageProgress, progress);
+	writer->Write(UIBadge1, progress > 0.25f);
+	writer->Write(UIClock, index % 120 < 60 ? "7:45 PM" : "7:46 PM");
+}
+
+/*!****************************************************************************
+ @Function		runConsumer
+ @Input			numFrames	Frames the producer publishes
+ @Input			ready		Pipe to tell the producer the consumer is ready
+ @Return		int			Exit status of the consumer process
+ @Description	HELPER - the child process: opens the ring, builds the tree,
+				then reads every frame, updates the tree with it and records
+				its latency
+******************************************************************************/
+static int
+runConsumer(int numFrames, int ready)
+{
+	UIShmConsumer consumer;
+	CPVRTString error;
+	if (!consumer.Open(c_benchShmName, &error)) {
+		fprintf(stderr, "%s\n", error.c_str());
+		return 1;
+	}
+
+	// Missing textures only leave the stubbed draws with nothing to bind
+	UICompositeView root(0, 0);
+	root.AddElement(new UIPTopView(UIMain, UIWarmup));
+	root.AddElement(new UIPauseView());
+	root.AddElement(new UISummaryView());
+	if (!root.LoadTextures(&error)) {
+		fprintf(stderr, "%s (continuing without textures)\n", error.c_str());
+	}
+	root.BuildVertices();
+
+	std::vector<uint64_t> latencies;
+	latencies.reserve(numFrames);
+	UIMessage message;
+	char byte = 1;
+	if (write(ready, &byte, 1) != 1) {
+		return 1;
+	}
+	close(ready);
+
+	uint64_t start = 0, end = 0;
+	while (consumer.GetSequence() < (uint32_t) numFrames && consumer.Wait(c_consumerTimeoutMs)) {
+		while (consumer.Next(&message)) {
+			UIFrameCache::Get()->Update(&root, message);
+			end = UIShmNow();
+			latencies.push_back(end - consumer.GetPublishTime());
+			if (start == 0) {
+				start = consumer.GetPublishTime();
+			}
+		}
+	}
+
+	int received = latencies.size();
+	printf("consumer: %d frames received, %u dropped", received, consumer.GetDroppedCount());
+	if (end > start) {
+		printf(", %.0f frames/s", received * 1e9 / (end - start));
+	}
+	printf("\n");
+	if (received > 0) {
+		std::sort(latencies.begin(), latencies.end());
+		printf("publish to visible: p50 %.1f us, p99 %.1f us, max %.1f us\n",
+			latencies[received / 2] * 1e-3, latencies[received * 99 / 100] * 1e-3, latencies[received - 1] * 1e-3);
+	}
+
+	root.Delete();
+	consumer.Delete();
+	return received > 0 ? 0 : 1;
+}
+
+int
+main(int argc, char** argv)
+{
+	int numFrames = argc > 1 ? atoi(argv[1]) : c_defaultFrames;
+	int rate = argc > 2 ? atoi(argv[2]) : c_defaultRate;
+	if (numFrames <= 0 || rate < 0) {
+		fprintf(stderr, "Usage: %s [frames] [rate]\n", argv[0]);
+		return 1;
+	}
+
+	UIShmProducer::Remove(c_benchShmName);
+	UIShmProducer producer;
+	CPVRTString error;
+	if (!producer.Create(c_benchShmName, c_defaultShmSlots, c_defaultShmSlotSize, &error)) {
+		fprintf(stderr, "%s\n", error.c_str());
+		return 1;
+	}
+
+	int ready[2];
+	if (pipe(ready) != 0) {
+		perror("pipe");
+		return 1;
+	}
+	pid_t child = fork();
+	if (child < 0) {
+		perror("fork");
+		return 1;
+	}
+	if (child == 0) {
+		close(ready[0]);
+		int status = runConsumer(numFrames, ready[1]);
+		fflush(stdout);
+		_exit(status);
+	}
+	close(ready[1]);
+	char byte;
+	if (read(ready[0], &byte, 1) != 1) {
+		fprintf(stderr, "consumer didn't start\n");
+		waitpid(child, NULL, 0);
+		UIShmProducer::Remove(c_benchShmName);
+		return 1;
+	}
+	close(ready[0]);
+
+	// Frames are paced against absolute deadlines so sleeping late doesn't
+	// drift
+	struct timespec next;
+	clock_gettime(CLOCK_MONOTONIC, &next);
+	long interval = rate > 0 ? 1000000000L / rate : 0;
+	uint64_t start = UIShmNow();
+	for ( int i = 0; i < numFrames; i ++ ) {
+		if (interval > 0) {
+			next.tv_nsec += interval;
+			next.tv_sec += next.tv_nsec / 1000000000L;
+			next.tv_nsec %= 1000000000L;
+			clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+		}
+		UIFrameWriter* writer = producer.Begin();
+		if (writer == NULL) {
+			break;
+		}
+		writeFrame(writer, i, numFrames);
+		producer.Publish();
+	}
+	uint64_t elapsed = UIShmNow() - start;
+	printf("producer: %u frames published in %.3f s, %.0f frames/s\n", producer.GetFrameCount(), elapsed * 1e-9,
+		elapsed > 0 ? producer.GetFrameCount() * 1e9 / elapsed : 0.0);
+	fflush(stdout);
+
+	int status = 1;
+	waitpid(child, &status, 0);
+	producer.Close();
+	UIShmProducer::Remove(c_benchShmName);
+	return WIFEXITED(status) && WEXITSTATUS(status) == 0 ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+/******************************************************************************
+ @File          SpriteKernelBench.cpp
+ @Title         SpriteKernelBench
+ @Author        Siddharth Hathi
+ @Description   Offline benchmark of the sprite expansion kernels. Times the
+				build's vector kernel against the scalar one over a full sprite
+				store and checks that they agree. The kernels make no GL calls,
+				so no GPU or GL stubs are needed.
+
+				Build:	g++ -O2 -o SpriteKernelBench SpriteKernelBench.cpp ../UISpriteKernels.cpp
+						(add -DUIKIT_SCALAR_SPRITES to time the scalar build,
+						or cross compile with -mfpu=neon for the NEON kernel)
+				Usage:	SpriteKernelBench [sprites] [iterations]
+******************************************************************************/
+
+#include "../UISpriteKernels.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+
+// Defaults: a full UISpriteStore, expanded once per frame for a while
+const int c_defaultSprites = 512;
+const int c_defaultIterations = 20000;
+
+// Viewport of the display
+const float c_halfWidth = 640;
+const float c_halfHeight = 360;
+
+// Largest difference allowed between the kernels' vertices
+const float c_tolerance = 1e-5f;
+
+// The arrays a UISpriteStore would hold
+struct BenchSprites {
+	std::vector<float> x, y, width, height, scaleX, scaleY, u0, v0, u1, v1;
+	std::vector<uint8_t> visible;
+};
+
+/*!****************************************************************************
+ @Function		randomFloat
+ @Input			lo, hi		Range
+ @Return		float		A random number in the range
+ @Description	HELPER - returns a random float
+******************************************************************************/
+static float
+randomFloat(float lo, float hi)
+{
+	return lo + (hi - lo) * (rand() / (float)RAND_MAX);
+}
+
+/*!****************************************************************************
+ @Function		buildSprites
+ @Input			count		Number of sprites
+ @Output		sprites		Randomly placed sprites
+ @Output		arrays		The kernels' view of the sprites
+ @Description	HELPER - fills a store's worth of sprites
+******************************************************************************/
+static void
+buildSprites(int count, BenchSprites* sprites, UISpriteArrays* arrays)
+{
+	std::vector<float>* fields[] = { &sprites->x, &sprites->y, &sprites->width, &sprites->height,
+		&sprites->scaleX, &sprites->scaleY, &sprites->u0, &sprites->v0, &sprites->u1, &sprites->v1 };
+	for ( int i = 0; i < 10; i ++ ) {
+		fields[i]->resize(count);
+	}
+	sprites->visible.resize(count);
+
+	for ( int i = 0; i < count; i ++ ) {
+		sprites->x[i] = randomFloat(-c_halfWidth, c_halfWidth);
+		sprites->y[i] = randomFloat(-c_halfHeight, c_halfHeight);
+		sprites->width[i] = randomFloat(10, 400);
+		sprites->height[i] = randomFloat(10, 200);
+		sprites->scaleX[i] = randomFloat(0, 1);
+		sprites->scaleY[i] = 1;
+		sprites->u0[i] = randomFloat(0, 0.5f);
+		sprites->v0[i] = randomFloat(0, 0.5f);
+		sprites->u1[i] = randomFloat(0.5f, 1);
+		sprites->v1[i] = randomFloat(0.5f, 1);
+		sprites->visible[i] = (rand() % 8) != 0;
+	}
+
+	arrays->x = sprites->x.data();
+	arrays->y = sprites->y.data();
+	arrays->width = sprites->width.data();
+	arrays->height = sprites->height.data();
+	arrays->scaleX = sprites->scaleX.data();
+	arrays->scaleY = sprites->scaleY.data();
+	arrays->u0 = sprites->u0.data();
+	arrays->v0 = sprites->v0.data();
+	arrays->u1 = sprites->u1.data();
+	arrays->v1 = sprites->v1.data();
+	arrays->visible = sprites->visible.data();
+}
+
+/*!****************************************************************************
+ @Function		timeKernel
+ @Input			arrays		The sprites
+ @Input			count		Number of sprites
+ @Input			iterations	Number of times to expand them
+ @Input			vector		Time the vector kernel (or the scalar one)?
+ @Output		out			The expanded vertices
+ @Return		double		Nanoseconds per sprite
+ @Description	HELPER - times one kernel
+******************************************************************************/
+static double
+timeKernel(const UISpriteArrays& arrays, int count, int iterations, bool vector, UISpriteVertex* out)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for ( int i = 0; i < iterations; i ++ ) {
+		if (vector) {
+			UIExpandSprites(arrays, count, out);
+		} else {
+			UIExpandSpritesScalar(arrays, 0, count, out);
+		}
+	}
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	double ns = std::chrono::duration<double, std::nano>(end - start).count();
+	return ns / ((double)iterations * count);
+}
+
+int
+main(int argc, char** argv)
+{
+	int count = argc > 1 ? atoi(argv[1]) : c_defaultSprites;
+	int iterations = argc > 2 ? atoi(argv[2]) : c_defaultIterations;
+	if (count <= 0 || iterations <= 0) {
+		fprintf(stderr, "Usage: SpriteKernelBench [sprites] [iterations]\n");
+		return 1;
+	}
+
+	BenchSprites sprites;
+	UISpriteArrays arrays;
+	srand(1);
+	buildSprites(count, &sprites, &arrays);
+
+	std::vector<UISpriteVertex> scalarOut(4 * count), vectorOut(4 * count);
+	printf("%d sprites, %d iterations, %s kernel\n", count, iterations, UISpriteKernelName());
+
+	double scalarNs = timeKernel(arrays, count, iterations, false, scalarOut.data());
+	double vectorNs = timeKernel(arrays, count, iterations, true, vectorOut.data());
+
+	float maxError = 0;
+	for ( int i = 0; i < 4 * count; i ++ ) {
+		maxError = fmaxf(maxError, fabsf(scalarOut[i].x - vectorOut[i].x));
+		maxError = fmaxf(maxError, fabsf(scalarOut[i].y - vectorOut[i].y));
+		maxError = fmaxf(maxError, fabsf(scalarOut[i].u - vectorOut[i].u));
+		maxError = fmaxf(maxError, fabsf(scalarOut[i].v - vectorOut[i].v));
+	}
+
+	printf("scalar %6.2f ns/sprite   %-6s %6.2f ns/sprite   speedup %.2fx   max error %g\n",
+		scalarNs, UISpriteKernelName(), vectorNs, scalarNs / vectorNs, maxError);
+
+	if (maxError > c_tolerance) {
+		fprintf(stderr, "ERROR: vector and scalar kernels disagree\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,845 @@
+/******************************************************************************
+ @File          UIGLStub.cpp
+ @Title         UIGLStub
+ @Author        Siddharth Hathi
+ @Description   Do-nothing definitions of every OpenGL ES 2.0 entry point, for
+				running the UIKit without a GPU or EGL context. Linked in place
+				of libGLESv2, it lets offline tools such as ReplayBench build
+				and update real element trees and measure the CPU side of the
+				UI. Object names are handed out from a counter, shaders always
+				compile and link, framebuffers are always complete and queries
+				return zeros. Nothing is drawn.
+
+				Build:	add UIGLStub.cpp to a tool's sources and leave out
+						-lGLESv2 -lEGL
+******************************************************************************/
+
+#include <GLES2/gl2.h>
+#include <string.h>
+
+// Last object name handed out
+static GLuint s_lastName = 0;
+
+/*!****************************************************************************
+ @Function		nextName
+ @Return		GLuint		A new object name
+ @Description	HELPER - returns the next object name
+******************************************************************************/
+static GLuint
+nextName()
+{
+	return ++ s_lastName;
+}
+
+/*!****************************************************************************
+ @Function		genNames
+ @Input			n			Number of names
+ @Output		names		New object names
+ @Description	HELPER - fills the output of a glGen* call
+******************************************************************************/
+static void
+genNames(GLsizei n, GLuint* names)
+{
+	for ( GLsizei i = 0; i < n; i ++ ) {
+		names[i] = nextName();
+	}
+}
+
+/*!****************************************************************************
+ @Function		paramCount
+ @Input			pname		A glGet* query
+ @Return		int			Number of values the query writes
+ @Description	HELPER - returns how many values a state query writes, so the
+				caller's array isn't overrun
+******************************************************************************/
+static int
+paramCount(GLenum pname)
+{
+	switch (pname) {
+		case GL_VIEWPORT:
+		case GL_SCISSOR_BOX:
+		case GL_COLOR_CLEAR_VALUE:
+		case GL_BLEND_COLOR:
+		case GL_COLOR_WRITEMASK:
+			return 4;
+		case GL_DEPTH_RANGE:
+		case GL_MAX_VIEWPORT_DIMS:
+		case GL_ALIASED_POINT_SIZE_RANGE:
+		case GL_ALIASED_LINE_WIDTH_RANGE:
+			return 2;
+		default:
+			return 1;
+	}
+}
+
+/*!****************************************************************************
+ @Function		fillParams
+ @Input			pname		A glGet* query
+ @Output		data		The query's values
+ @Input			value		Value every output is set to
+ @Description	HELPER - answers a state query
+******************************************************************************/
+template <typename T>
+static void
+fillParams(GLenum pname, T* data, T value)
+{
+	for ( int i = 0; i < paramCount(pname); i ++ ) {
+		data[i] = value;
+	}
+}
+
+/*!****************************************************************************
+ @Function		emptyLog
+ @Input			bufSize		Size of the caller's buffer
+ @Output		length		Length of the log
+ @Output		log			The log
+ @Description	HELPER - answers an info log or source query with ""
+******************************************************************************/
+static void
+emptyLog(GLsizei bufSize, GLsizei* length, GLchar* log)
+{
+	if (length != NULL) {
+		*length = 0;
+	}
+	if (log != NULL && bufSize > 0) {
+		log[0] = '\0';
+	}
+}
+
+// The OpenGL ES 2.0 entry points, in gl2.h order
+
+GL_APICALL void GL_APIENTRY
+glActiveTexture(GLenum texture)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glAttachShader(GLuint program, GLuint shader)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glBindAttribLocation(GLuint program, GLuint index, const GLchar *name)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glBindBuffer(GLenum target, GLuint buffer)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glBindFramebuffer(GLenum target, GLuint framebuffer)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glBindRenderbuffer(GLenum target, GLuint renderbuffer)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glBindTexture(GLenum target, GLuint texture)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glBlendColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glBlendEquation(GLenum mode)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glBlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glBlendFunc(GLenum sfactor, GLenum dfactor)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glBlendFuncSeparate(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data)
+{
+}
+
+GL_APICALL GLenum GL_APIENTRY
+glCheckFramebufferStatus(GLenum target)
+{
+	return GL_FRAMEBUFFER_COMPLETE;
+}
+
+GL_APICALL void GL_APIENTRY
+glClear(GLbitfield mask)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glClearDepthf(GLfloat d)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glClearStencil(GLint s)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glCompileShader(GLuint shader)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void *data)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glCompressedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void *data)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glCopyTexImage2D(GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glCopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height)
+{
+}
+
+GL_APICALL GLuint GL_APIENTRY
+glCreateProgram(void)
+{
+	return nextName();
+}
+
+GL_APICALL GLuint GL_APIENTRY
+glCreateShader(GLenum type)
+{
+	return nextName();
+}
+
+GL_APICALL void GL_APIENTRY
+glCullFace(GLenum mode)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glDeleteBuffers(GLsizei n, const GLuint *buffers)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glDeleteFramebuffers(GLsizei n, const GLuint *framebuffers)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glDeleteProgram(GLuint program)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glDeleteRenderbuffers(GLsizei n, const GLuint *renderbuffers)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glDeleteShader(GLuint shader)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glDeleteTextures(GLsizei n, const GLuint *textures)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glDepthFunc(GLenum func)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glDepthMask(GLboolean flag)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glDepthRangef(GLfloat n, GLfloat f)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glDetachShader(GLuint program, GLuint shader)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glDisable(GLenum cap)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glDisableVertexAttribArray(GLuint index)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glDrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glEnable(GLenum cap)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glEnableVertexAttribArray(GLuint index)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glFinish(void)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glFlush(void)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glFrontFace(GLenum mode)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glGenBuffers(GLsizei n, GLuint *buffers)
+{
+	genNames(n, buffers);
+}
+
+GL_APICALL void GL_APIENTRY
+glGenerateMipmap(GLenum target)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glGenFramebuffers(GLsizei n, GLuint *framebuffers)
+{
+	genNames(n, framebuffers);
+}
+
+GL_APICALL void GL_APIENTRY
+glGenRenderbuffers(GLsizei n, GLuint *renderbuffers)
+{
+	genNames(n, renderbuffers);
+}
+
+GL_APICALL void GL_APIENTRY
+glGenTextures(GLsizei n, GLuint *textures)
+{
+	genNames(n, textures);
+}
+
+GL_APICALL void GL_APIENTRY
+glGetActiveAttrib(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glGetAttachedShaders(GLuint program, GLsizei maxCount, GLsizei *count, GLuint *shaders)
+{
+}
+
+GL_APICALL GLint GL_APIENTRY
+glGetAttribLocation(GLuint program, const GLchar *name)
+{
+	return 0;
+}
+
+GL_APICALL void GL_APIENTRY
+glGetBooleanv(GLenum pname, GLboolean *data)
+{
+	fillParams(pname, data, (GLboolean) GL_FALSE);
+}
+
+GL_APICALL void GL_APIENTRY
+glGetBufferParameteriv(GLenum target, GLenum pname, GLint *params)
+{
+}
+
+GL_APICALL GLenum GL_APIENTRY
+glGetError(void)
+{
+	return GL_NO_ERROR;
+}
+
+GL_APICALL void GL_APIENTRY
+glGetFloatv(GLenum pname, GLfloat *data)
+{
+	fillParams(pname, data, 0.0f);
+}
+
+GL_APICALL void GL_APIENTRY
+glGetFramebufferAttachmentParameteriv(GLenum target, GLenum attachment, GLenum pname, GLint *params)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glGetIntegerv(GLenum pname, GLint *data)
+{
+	fillParams(pname, data, (GLint) 0);
+}
+
+GL_APICALL void GL_APIENTRY
+glGetProgramiv(GLuint program, GLenum pname, GLint *params)
+{
+	*params = (pname == GL_LINK_STATUS || pname == GL_VALIDATE_STATUS) ? GL_TRUE : 0;
+}
+
+GL_APICALL void GL_APIENTRY
+glGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog)
+{
+	emptyLog(bufSize, length, infoLog);
+}
+
+GL_APICALL void GL_APIENTRY
+glGetRenderbufferParameteriv(GLenum target, GLenum pname, GLint *params)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glGetShaderiv(GLuint shader, GLenum pname, GLint *params)
+{
+	*params = (pname == GL_COMPILE_STATUS) ? GL_TRUE : 0;
+}
+
+GL_APICALL void GL_APIENTRY
+glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog)
+{
+	emptyLog(bufSize, length, infoLog);
+}
+
+GL_APICALL void GL_APIENTRY
+glGetShaderPrecisionFormat(GLenum shadertype, GLenum precisiontype, GLint *range, GLint *precision)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glGetShaderSource(GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *source)
+{
+	emptyLog(bufSize, length, source);
+}
+
+GL_APICALL const GLubyte * GL_APIENTRY
+glGetString(GLenum name)
+{
+	return (const GLubyte*) "UIGLStub";
+}
+
+GL_APICALL void GL_APIENTRY
+glGetTexParameterfv(GLenum target, GLenum pname, GLfloat *params)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glGetTexParameteriv(GLenum target, GLenum pname, GLint *params)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glGetUniformfv(GLuint program, GLint location, GLfloat *params)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glGetUniformiv(GLuint program, GLint location, GLint *params)
+{
+}
+
+GL_APICALL GLint GL_APIENTRY
+glGetUniformLocation(GLuint program, const GLchar *name)
+{
+	return 0;
+}
+
+GL_APICALL void GL_APIENTRY
+glGetVertexAttribfv(GLuint index, GLenum pname, GLfloat *params)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glGetVertexAttribiv(GLuint index, GLenum pname, GLint *params)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glGetVertexAttribPointerv(GLuint index, GLenum pname, void **pointer)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glHint(GLenum target, GLenum mode)
+{
+}
+
+GL_APICALL GLboolean GL_APIENTRY
+glIsBuffer(GLuint buffer)
+{
+	return 0;
+}
+
+GL_APICALL GLboolean GL_APIENTRY
+glIsEnabled(GLenum cap)
+{
+	return GL_FALSE;
+}
+
+GL_APICALL GLboolean GL_APIENTRY
+glIsFramebuffer(GLuint framebuffer)
+{
+	return 0;
+}
+
+GL_APICALL GLboolean GL_APIENTRY
+glIsProgram(GLuint program)
+{
+	return 0;
+}
+
+GL_APICALL GLboolean GL_APIENTRY
+glIsRenderbuffer(GLuint renderbuffer)
+{
+	return 0;
+}
+
+GL_APICALL GLboolean GL_APIENTRY
+glIsShader(GLuint shader)
+{
+	return 0;
+}
+
+GL_APICALL GLboolean GL_APIENTRY
+glIsTexture(GLuint texture)
+{
+	return 0;
+}
+
+GL_APICALL void GL_APIENTRY
+glLineWidth(GLfloat width)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glLinkProgram(GLuint program)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glPixelStorei(GLenum pname, GLint param)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glPolygonOffset(GLfloat factor, GLfloat units)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void *pixels)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glReleaseShaderCompiler(void)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glSampleCoverage(GLfloat value, GLboolean invert)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glScissor(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glShaderBinary(GLsizei count, const GLuint *shaders, GLenum binaryFormat, const void *binary, GLsizei length)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glShaderSource(GLuint shader, GLsizei count, const GLchar *const*string, const GLint *length)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glStencilFunc(GLenum func, GLint ref, GLuint mask)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glStencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glStencilMask(GLuint mask)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glStencilMaskSeparate(GLenum face, GLuint mask)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glStencilOp(GLenum fail, GLenum zfail, GLenum zpass)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glStencilOpSeparate(GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glTexParameterf(GLenum target, GLenum pname, GLfloat param)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glTexParameterfv(GLenum target, GLenum pname, const GLfloat *params)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glTexParameteri(GLenum target, GLenum pname, GLint param)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glTexParameteriv(GLenum target, GLenum pname, const GLint *params)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glUniform1f(GLint location, GLfloat v0)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glUniform1fv(GLint location, GLsizei count, const GLfloat *value)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glUniform1i(GLint location, GLint v0)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glUniform1iv(GLint location, GLsizei count, const GLint *value)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glUniform2f(GLint location, GLfloat v0, GLfloat v1)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glUniform2fv(GLint location, GLsizei count, const GLfloat *value)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glUniform2i(GLint location, GLint v0, GLint v1)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glUniform2iv(GLint location, GLsizei count, const GLint *value)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glUniform3fv(GLint location, GLsizei count, const GLfloat *value)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glUniform3i(GLint location, GLint v0, GLint v1, GLint v2)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glUniform3iv(GLint location, GLsizei count, const GLint *value)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glUniform4fv(GLint location, GLsizei count, const GLfloat *value)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glUniform4i(GLint location, GLint v0, GLint v1, GLint v2, GLint v3)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glUniform4iv(GLint location, GLsizei count, const GLint *value)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glUniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glUseProgram(GLuint program)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glValidateProgram(GLuint program)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glVertexAttrib1f(GLuint index, GLfloat x)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glVertexAttrib1fv(GLuint index, const GLfloat *v)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glVertexAttrib2f(GLuint index, GLfloat x, GLfloat y)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glVertexAttrib2fv(GLuint index, const GLfloat *v)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glVertexAttrib3f(GLuint index, GLfloat x, GLfloat y, GLfloat z)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glVertexAttrib3fv(GLuint index, const GLfloat *v)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glVertexAttrib4f(GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glVertexAttrib4fv(GLuint index, const GLfloat *v)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer)
+{
+}
+
+GL_APICALL void GL_APIENTRY
+glViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+}
@@ -0,0 +1,351 @@
+/******************************************************************************
+ @File          UILayoutCompiler.cpp
+ @Title         UILayoutCompiler
+ @Author        Siddharth Hathi
+ @Description   Offline tool that compiles a human readable layout source into
+				the binary layout format read by UILayoutView (UILayoutFile.h).
+
+				Build:	g++ -O2 -I.. -o UILayoutCompiler UILayoutCompiler.cpp ../UIFrame.cpp
+				Usage:	UILayoutCompiler input.layout output.uil
+
+				Source format, one element per line ('#' starts a comment):
+
+				states <UIState> ...
+				image <texture> x y width height
+				button "<text>" x y activeColor inactiveColor <UIBool>
+				textblock "<secondary text>" <font> <secondary font> x y color <UITextType>
+				statictext "<text>" x y scale color <font>
+				progressbar <bg texture> <fill texture> x y width height insetX insetY completion
+				composite <texture|-> x y width height
+				badges x y
+				workoutview <UIWorkoutStage>
+
+				Indented image and text lines are children of the composite
+				view above them, positioned relative to it:
+
+				    image <texture> x y width height
+				    text "<text>" x y scale color <UITextType|UINone> <font>
+
+				Any element line can end with "hidden" to start it hidden.
+				Colors are hex ABGR values like the ones used in code.
+******************************************************************************/
+
+#include "UILayoutFile.h"
+#include "UIMessageKeys.h"
+#include "UIFrame.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+// Font names in declaration order. These must match UIPrinter.h since the
+// binary format stores the enum values. The UIMessage key names come from
+// the key lists in UIMessageKeys.h.
+const char* c_fontNames[] = { "UIFBold", "UIFMedium", "UIFRegular", "UIFThin", "UIFLight" };
+
+#define NUM_NAMES(names) ((int) (sizeof(names) / sizeof(names[0])))
+
+// State of the compiler while reading the source
+struct CompileState {
+	const char* path;
+	int line;
+	int lastComposite;
+	uint32_t stateMask;
+	std::vector<UILayoutRecord> records;
+	std::string strings;
+	bool failed;
+};
+
+/*!****************************************************************************
+ @Function		fail
+ @Description	Reports an error at the current source line
+******************************************************************************/
+static void
+fail(CompileState* state, const char* message, const char* detail)
+{
+	fprintf(stderr, "%s:%d: %s%s%s\n", state->path, state->line, message,
+		detail != NULL ? " " : "", detail != NULL ? detail : "");
+	state->failed = true;
+}
+
+/*!****************************************************************************
+ @Function		tokenize
+ @Description	Splits a source line into tokens. Quoted tokens keep their
+				spaces, and everything after an unquoted '#' is ignored.
+******************************************************************************/
+static bool
+tokenize(const char* line, std::vector<std::string>* tokens)
+{
+	const char* c = line;
+	while (*c != '\0') {
+		if (*c == ' ' || *c == '\t' || *c == '\r' || *c == '\n') {
+			c ++;
+		} else if (*c == '#') {
+			break;
+		} else if (*c == '"') {
+			const char* end = strchr(c + 1, '"');
+			if (end == NULL) {
+				return false;
+			}
+			tokens->push_back(std::string(c + 1, end - c - 1));
+			c = end + 1;
+		} else {
+			const char* start = c;
+			while (*c != '\0' && *c != ' ' && *c != '\t' && *c != '\r' && *c != '\n' && *c != '#') {
+				c ++;
+			}
+			tokens->push_back(std::string(start, c - start));
+		}
+	}
+	return true;
+}
+
+/*!****************************************************************************
+ @Function		lookup
+ @Description	Returns the index of a name in an enum name table, or -1
+******************************************************************************/
+static int
+lookup(const char* const* names, int numNames, const std::string& name)
+{
+	for ( int i = 0; i < numNames; i ++ ) {
+		if (name == names[i]) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*!****************************************************************************
+ @Function		addString
+ @Description	Adds a string to the string table (reusing an existing copy)
+				and returns its offset
+******************************************************************************/
+static uint32_t
+addString(CompileState* state, const std::string& str)
+{
+	if (str == "-") {
+		return c_layoutNoString;
+	}
+	size_t offset = 0;
+	while ((offset = state->strings.find(str, offset)) != std::string::npos) {
+		// Only reuse whole strings (or tails of strings)
+		if (offset + str.size() < state->strings.size() && state->strings[offset + str.size()] == '\0') {
+			return (uint32_t) offset;
+		}
+		offset ++;
+	}
+	offset = state->strings.size();
+	state->strings += str;
+	state->strings += '\0';
+	return (uint32_t) offset;
+}
+
+/*!****************************************************************************
+ @Function		parseLine
+ @Description	Compiles a single source line into a record
+******************************************************************************/
+static void
+parseLine(CompileState* state, const std::vector<std::string>& tokens, bool child)
+{
+	const std::string& kind = tokens[0];
+	int numArgs = (int) tokens.size() - 1;
+
+	UILayoutRecord record;
+	memset(&record, 0, sizeof(record));
+	record.parent = c_layoutNoParent;
+	record.updateKey = c_layoutNoKey;
+	record.texture = record.secondaryTexture = c_layoutNoString;
+	record.text = record.secondaryText = c_layoutNoString;
+	if (numArgs > 0 && tokens.back() == "hidden") {
+		record.flags |= c_layoutFlagHidden;
+		numArgs --;
+	}
+
+	// Reads argument i (1 based) as a float, color or enum value
+	#define ARG(i) (tokens[(i)].c_str())
+	#define FLOAT(i) ((float) atof(ARG(i)))
+	#define COLOR(i) ((uint32_t) strtoul(ARG(i), NULL, 16))
+	#define EXPECT(n) if (numArgs != (n)) { fail(state, "wrong number of arguments for", kind.c_str()); return; }
+	#define ENUM(field, names, i) { int value = lookup(names, NUM_NAMES(names), tokens[(i)]); \
+		if (value < 0) { fail(state, "unknown name", ARG(i)); return; } field = value; }
+
+	if (kind == "states") {
+		for ( int i = 1; i <= numArgs; i ++ ) {
+			int value = lookup(c_stateNames, NUM_NAMES(c_stateNames), tokens[i]);
+			if (value < 0) {
+				fail(state, "unknown state", ARG(i));
+				return;
+			}
+			state->stateMask |= 1u << value;
+		}
+		return;
+	}
+
+	if (child) {
+		if (state->lastComposite < 0) {
+			fail(state, "indented element without a composite view", NULL);
+			return;
+		}
+		record.parent = (uint8_t) state->lastComposite;
+		if (kind == "image") {
+			EXPECT(5);
+			record.type = UILImage;
+			record.texture = addString(state, tokens[1]);
+			record.x = FLOAT(2), record.y = FLOAT(3), record.width = FLOAT(4), record.height = FLOAT(5);
+		} else if (kind == "text") {
+			EXPECT(7);
+			record.type = UILStaticText;
+			record.text = addString(state, tokens[1]);
+			record.x = FLOAT(2), record.y = FLOAT(3), record.scale = FLOAT(4), record.color = COLOR(5);
+			ENUM(record.updateKey, c_textKeyNames, 6);
+			ENUM(record.font, c_fontNames, 7);
+			if (record.updateKey == lookup(c_textKeyNames, NUM_NAMES(c_textKeyNames), "UINone")) {
+				record.updateKey = c_layoutNoKey;
+			}
+		} else {
+			fail(state, "composite views can only hold image and text, not", kind.c_str());
+			return;
+		}
+	} else if (kind == "image") {
+		EXPECT(5);
+		record.type = UILImage;
+		record.texture = addString(state, tokens[1]);
+		record.x = FLOAT(2), record.y = FLOAT(3), record.width = FLOAT(4), record.height = FLOAT(5);
+	} else if (kind == "button") {
+		EXPECT(6);
+		record.type = UILButton;
+		record.text = addString(state, tokens[1]);
+		record.x = FLOAT(2), record.y = FLOAT(3), record.color = COLOR(4), record.secondaryColor = COLOR(5);
+		ENUM(record.updateKey, c_boolKeyNames, 6);
+	} else if (kind == "textblock") {
+		EXPECT(7);
+		record.type = UILTextBlock;
+		record.secondaryText = addString(state, tokens[1]);
+		ENUM(record.font, c_fontNames, 2);
+		ENUM(record.secondaryFont, c_fontNames, 3);
+		record.x = FLOAT(4), record.y = FLOAT(5), record.color = COLOR(6);
+		ENUM(record.updateKey, c_textKeyNames, 7);
+	} else if (kind == "statictext") {
+		EXPECT(6);
+		record.type = UILStaticText;
+		record.text = addString(state, tokens[1]);
+		record.x = FLOAT(2), record.y = FLOAT(3), record.scale = FLOAT(4), record.color = COLOR(5);
+		ENUM(record.font, c_fontNames, 6);
+	} else if (kind == "progressbar") {
+		EXPECT(9);
+		record.type = UILProgressBar;
+		record.texture = addString(state, tokens[1]);
+		record.secondaryTexture = addString(state, tokens[2]);
+		record.x = FLOAT(3), record.y = FLOAT(4), record.width = FLOAT(5), record.height = FLOAT(6);
+		record.insetX = FLOAT(7), record.insetY = FLOAT(8), record.value = FLOAT(9);
+	} else if (kind == "composite") {
+		EXPECT(5);
+		record.type = UILCompositeView;
+		record.texture = addString(state, tokens[1]);
+		record.x = FLOAT(2), record.y = FLOAT(3), record.width = FLOAT(4), record.height = FLOAT(5);
+	} else if (kind == "badges") {
+		EXPECT(2);
+		record.type = UILBadges;
+		record.x = FLOAT(1), record.y = FLOAT(2);
+	} else if (kind == "workoutview") {
+		EXPECT(1);
+		record.type = UILWorkoutView;
+		ENUM(record.updateKey, c_workoutStageNames, 1);
+	} else {
+		fail(state, "unknown element", kind.c_str());
+		return;
+	}
+
+	#undef ARG
+	#undef FLOAT
+	#undef COLOR
+	#undef EXPECT
+	#undef ENUM
+
+	if ((int) state->records.size() >= c_maxLayoutRecords) {
+		fail(state, "too many elements", NULL);
+		return;
+	}
+	if (!child) {
+		state->lastComposite = record.type == UILCompositeView ? (int) state->records.size() : -1;
+	}
+	state->records.push_back(record);
+}
+
+/*!****************************************************************************
+ @Function		main
+ @Description	Compiles the layout source named on the command line
+******************************************************************************/
+int
+main(int argc, char** argv)
+{
+	if (argc != 3) {
+		fprintf(stderr, "Usage: %s input.layout output.uil\n", argv[0]);
+		return 1;
+	}
+
+	FILE* input = fopen(argv[1], "r");
+	if (input == NULL) {
+		fprintf(stderr, "Could not open %s\n", argv[1]);
+		return 1;
+	}
+	CompileState state;
+	state.path = argv[1];
+	state.line = 0;
+	state.lastComposite = -1;
+	state.stateMask = 0;
+	state.failed = false;
+
+	char line[1024];
+	while (fgets(line, sizeof(line), input) != NULL) {
+		state.line ++;
+		std::vector<std::string> tokens;
+		if (!tokenize(line, &tokens)) {
+			fail(&state, "unterminated string", NULL);
+			continue;
+		}
+		if (tokens.empty()) {
+			continue;
+		}
+		parseLine(&state, tokens, line[0] == ' ' || line[0] == '\t');
+	}
+	fclose(input);
+	if (state.failed) {
+		return 1;
+	}
+	if (state.stateMask == 0) {
+		fprintf(stderr, "%s: no states line, the view would never be shown\n", argv[1]);
+		return 1;
+	}
+	if (state.strings.empty()) {
+		state.strings += '\0';
+	}
+
+	UILayoutHeader header;
+	memset(&header, 0, sizeof(header));
+	header.magic = c_layoutMagic;
+	header.version = c_layoutVersion;
+	header.numRecords = (uint16_t) state.records.size();
+	header.schema = UIFrameSchema();
+	header.stateMask = state.stateMask;
+	header.stringsOffset = (uint32_t) (sizeof(header) + state.records.size() * sizeof(UILayoutRecord));
+	header.stringsSize = (uint32_t) state.strings.size();
+
+	FILE* output = fopen(argv[2], "wb");
+	if (output == NULL) {
+		fprintf(stderr, "Could not open %s\n", argv[2]);
+		return 1;
+	}
+	fwrite(&header, sizeof(header), 1, output);
+	if (!state.records.empty()) {
+		fwrite(&state.records[0], sizeof(UILayoutRecord), state.records.size(), output);
+	}
+	fwrite(state.strings.data(), 1, state.strings.size(), output);
+	fclose(output);
+
+	printf("%s: %d elements, %d bytes\n", argv[2], (int) state.records.size(),
+		(int) (header.stringsOffset + header.stringsSize));
+	return 0;
+}